@@ -0,0 +1,108 @@
+#include "benchmarkhelpers.hpp"
+#include "dlm/aabb.hpp"
+
+namespace {
+
+using dlm::bench::kCount;
+using dlm::bench::MakeInputs;
+
+// Boxes around pairs of consecutive inputs, a quarter of them overlap the
+// query box of the overlap benchmarks.
+template <typename V>
+std::vector<dlm::geometry::AABB<V>> MakeBoxes() {
+  const auto points = MakeInputs<V>(2 * kCount, 1);
+  std::vector<dlm::geometry::AABB<V>> boxes(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    boxes[i].Merge(points[2 * i]).Merge(points[2 * i] + 0.25f);
+  }
+  return boxes;
+}
+
+template <typename V>
+dlm::geometry::AABB<V> Query() {
+  return {V{} + 0.0f, V{} + 3.0f};
+}
+
+// Bounds of kCount points merged one at a time against the span reduction.
+template <typename V>
+void BM_BoundsLoop(benchmark::State& state) {
+  const auto points = MakeInputs<V>(kCount, 1);
+
+  for (auto _ : state) {
+    dlm::geometry::AABB<V> bounds;
+    for (const auto& point : points) {
+      bounds.Merge(point);
+    }
+    benchmark::DoNotOptimize(bounds);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename V>
+void BM_BoundsSpan(benchmark::State& state) {
+  const auto points = MakeInputs<V>(kCount, 1);
+
+  for (auto _ : state) {
+    auto bounds = dlm::geometry::Bounds(dlm::Span<const V>{points});
+    benchmark::DoNotOptimize(bounds);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+// Overlap of kCount boxes with one box, as bytes one at a time and as a
+// bit mask from the span kernel.
+template <typename V>
+void BM_OverlapsLoop(benchmark::State& state) {
+  const auto boxes = MakeBoxes<V>();
+  const auto query = Query<V>();
+  std::vector<unsigned char> out(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      out[i] = boxes[i].Overlaps(query);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename V>
+void BM_OverlapsSpan(benchmark::State& state) {
+  using Box = dlm::geometry::AABB<V>;
+  const auto boxes = MakeBoxes<V>();
+  const auto query = Query<V>();
+  std::vector<std::uint64_t> mask(kCount / 64);
+
+  for (auto _ : state) {
+    dlm::geometry::Overlaps(dlm::Span<const Box>{boxes}, query,
+                            dlm::Span<std::uint64_t>{mask});
+    benchmark::DoNotOptimize(mask.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename V>
+void RegisterAABBBenchmarks() {
+  benchmark::RegisterBenchmark(dlm::bench::Name<V>("Bounds/loop").c_str(),
+                               BM_BoundsLoop<V>);
+  benchmark::RegisterBenchmark(dlm::bench::Name<V>("Bounds/span").c_str(),
+                               BM_BoundsSpan<V>);
+  benchmark::RegisterBenchmark(dlm::bench::Name<V>("Overlaps/loop").c_str(),
+                               BM_OverlapsLoop<V>);
+  benchmark::RegisterBenchmark(dlm::bench::Name<V>("Overlaps/span").c_str(),
+                               BM_OverlapsSpan<V>);
+}
+
+const bool kRegistered = [] {
+  RegisterAABBBenchmarks<dlm::vector::Vector2F>();
+  RegisterAABBBenchmarks<dlm::vector::Vector3F>();
+  return true;
+}();
+
+}  // namespace
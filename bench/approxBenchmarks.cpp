@@ -0,0 +1,94 @@
+#include "benchmarkhelpers.hpp"
+#include "dlm/approx.hpp"
+
+namespace {
+
+using dlm::bench::kCount;
+using dlm::bench::MakeInputs;
+
+// b is a copy of a with every third vector moved, the change detection case.
+template <typename V>
+std::vector<V> MakeChanged(const std::vector<V>& a) {
+  std::vector<V> b = a;
+  for (std::size_t i = 0; i < b.size(); i += 3) {
+    b[i] += 0.01f;
+  }
+  return b;
+}
+
+// The change mask of kCount vector pairs built one comparison at a time
+// against the span version.
+template <typename V>
+void BM_MaskLoop(benchmark::State& state) {
+  const auto a = MakeInputs<V>(kCount, 1);
+  const auto b = MakeChanged(a);
+  std::vector<std::uint64_t> mask(kCount / 64);
+
+  for (auto _ : state) {
+    for (std::size_t word = 0; word < mask.size(); ++word) {
+      std::uint64_t bits = 0;
+      for (std::size_t i = 0; i < 64; ++i) {
+        bits |= static_cast<std::uint64_t>(dlm::vector::AbsoluteEqual(
+                    a[word * 64 + i], b[word * 64 + i], 1e-3f))
+                << i;
+      }
+      mask[word] = bits;
+    }
+    benchmark::DoNotOptimize(mask.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename V>
+void BM_MaskSpan(benchmark::State& state) {
+  const auto a = MakeInputs<V>(kCount, 1);
+  const auto b = MakeChanged(a);
+  std::vector<std::uint64_t> mask(kCount / 64);
+
+  for (auto _ : state) {
+    dlm::vector::AbsoluteEqual(dlm::Span<const V>{a}, dlm::Span<const V>{b},
+                               1e-3f, dlm::Span<std::uint64_t>{mask});
+    benchmark::DoNotOptimize(mask.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename V>
+void BM_UlpsMaskSpan(benchmark::State& state) {
+  const auto a = MakeInputs<V>(kCount, 1);
+  const auto b = MakeChanged(a);
+  std::vector<std::uint64_t> mask(kCount / 64);
+
+  for (auto _ : state) {
+    dlm::vector::UlpsEqual(dlm::Span<const V>{a}, dlm::Span<const V>{b}, 4,
+                           dlm::Span<std::uint64_t>{mask});
+    benchmark::DoNotOptimize(mask.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename V>
+void RegisterApproxBenchmarks() {
+  using dlm::bench::Name;
+  benchmark::RegisterBenchmark(Name<V>("AbsoluteEqual/mask/loop").c_str(),
+                               BM_MaskLoop<V>);
+  benchmark::RegisterBenchmark(Name<V>("AbsoluteEqual/mask/span").c_str(),
+                               BM_MaskSpan<V>);
+  benchmark::RegisterBenchmark(Name<V>("UlpsEqual/mask/span").c_str(),
+                               BM_UlpsMaskSpan<V>);
+}
+
+const bool kRegistered = [] {
+  RegisterApproxBenchmarks<dlm::vector::Vector2F>();
+  RegisterApproxBenchmarks<dlm::vector::Vector3F>();
+  RegisterApproxBenchmarks<dlm::vector::Vector4F>();
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,220 @@
+#pragma once
+
+// clang-format off
+#include "benchmark/benchmark.h"
+// clang-format on
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "dlm/matrix2x2.hpp"
+#include "dlm/matrix3x3.hpp"
+#include "dlm/matrix4x4.hpp"
+#include "dlm/quaternion.hpp"
+#include "dlm/vector2.hpp"
+#include "dlm/vector3.hpp"
+#include "dlm/vector4.hpp"
+
+namespace dlm {
+namespace bench {
+
+// Every operation is measured over a buffer of kCount inputs so the result
+// is throughput and the loop cannot be folded away.
+constexpr std::size_t kCount = 4096;
+
+template <typename T>
+std::string TypeName();
+
+template <>
+inline std::string TypeName<float>() {
+  return "float";
+}
+
+template <>
+inline std::string TypeName<double>() {
+  return "double";
+}
+
+template <typename T>
+std::string TypeName(const vector::Vector2<T>*) {
+  return "Vector2<" + TypeName<T>() + ">";
+}
+
+template <typename T>
+std::string TypeName(const vector::Vector3<T>*) {
+  return "Vector3<" + TypeName<T>() + ">";
+}
+
+template <typename T>
+std::string TypeName(const vector::Vector4<T>*) {
+  return "Vector4<" + TypeName<T>() + ">";
+}
+
+template <typename T>
+std::string TypeName(const matrix::Matrix2x2<T>*) {
+  return "Matrix2x2<" + TypeName<T>() + ">";
+}
+
+template <typename T>
+std::string TypeName(const matrix::Matrix3x3<T>*) {
+  return "Matrix3x3<" + TypeName<T>() + ">";
+}
+
+template <typename T>
+std::string TypeName(const matrix::Matrix4x4<T>*) {
+  return "Matrix4x4<" + TypeName<T>() + ">";
+}
+
+template <typename T>
+std::string TypeName(const Quaternion<T>*) {
+  return "Quaternion<" + TypeName<T>() + ">";
+}
+
+template <typename type>
+std::string Name(const std::string& operation) {
+  return TypeName(static_cast<const type*>(nullptr)) + "/" + operation;
+}
+
+// Deterministic, non-zero values in [0.5, 4.5) so divisions and
+// normalizations stay finite.
+template <typename T>
+T Value(std::uint32_t& state) {
+  state = state * 1664525u + 1013904223u;
+  return static_cast<T>(0.5) +
+         static_cast<T>(state >> 8) / static_cast<T>(1u << 24) *
+             static_cast<T>(4);
+}
+
+template <typename T>
+void Fill(vector::Vector2<T>& v, std::uint32_t& state) {
+  v = {Value<T>(state), Value<T>(state)};
+}
+
+template <typename T>
+void Fill(vector::Vector3<T>& v, std::uint32_t& state) {
+  v = {Value<T>(state), Value<T>(state), Value<T>(state)};
+}
+
+template <typename T>
+void Fill(vector::Vector4<T>& v, std::uint32_t& state) {
+  v = {Value<T>(state), Value<T>(state), Value<T>(state), Value<T>(state)};
+}
+
+template <typename T>
+void Fill(matrix::Matrix2x2<T>& m, std::uint32_t& state) {
+  m = {Value<T>(state), Value<T>(state), Value<T>(state), Value<T>(state)};
+}
+
+template <typename T>
+void Fill(matrix::Matrix3x3<T>& m, std::uint32_t& state) {
+  for (int row = 0; row < 3; ++row) {
+    Fill(m[row], state);
+  }
+}
+
+template <typename T>
+void Fill(matrix::Matrix4x4<T>& m, std::uint32_t& state) {
+  for (int row = 0; row < 4; ++row) {
+    Fill(m[row], state);
+  }
+}
+
+// Unit length so every input is a rotation.
+template <typename T>
+void Fill(Quaternion<T>& q, std::uint32_t& state) {
+  q = {Value<T>(state), Value<T>(state), Value<T>(state), Value<T>(state)};
+  q.Normalize();
+}
+
+template <typename type>
+std::vector<type> MakeInputs(std::size_t count, std::uint32_t seed) {
+  std::vector<type> inputs(count);
+  for (auto& input : inputs) {
+    Fill(input, seed);
+  }
+  return inputs;
+}
+
+// std::vector<bool> has no data(), comparison results are stored as bytes.
+template <typename result_type>
+using ResultStorage =
+    std::conditional_t<std::is_same<result_type, bool>::value, unsigned char,
+                       result_type>;
+
+// Measures out[i] = operation(a[i]) over kCount inputs.
+template <typename type, typename Operation>
+void BM_Unary(benchmark::State& state, Operation operation) {
+  const auto a = MakeInputs<type>(kCount, 1);
+  std::vector<ResultStorage<decltype(operation(a[0]))>> out(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      out[i] = operation(a[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+// Measures out[i] = operation(a[i], b[i]) over kCount inputs.
+template <typename type, typename Operation>
+void BM_Binary(benchmark::State& state, Operation operation) {
+  const auto a = MakeInputs<type>(kCount, 1);
+  const auto b = MakeInputs<type>(kCount, 2);
+  std::vector<ResultStorage<decltype(operation(a[0], b[0]))>> out(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      out[i] = operation(a[i], b[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+// Measures out[i] = operation(a[i], b[i], c[i]) over kCount inputs.
+template <typename type, typename Operation>
+void BM_Ternary(benchmark::State& state, Operation operation) {
+  const auto a = MakeInputs<type>(kCount, 1);
+  const auto b = MakeInputs<type>(kCount, 2);
+  const auto c = MakeInputs<type>(kCount, 3);
+  std::vector<type> out(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      out[i] = operation(a[i], b[i], c[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename type, typename Operation>
+void RegisterUnary(const std::string& operation_name, Operation operation) {
+  benchmark::RegisterBenchmark(Name<type>(operation_name).c_str(),
+                               BM_Unary<type, Operation>, operation);
+}
+
+template <typename type, typename Operation>
+void RegisterBinary(const std::string& operation_name, Operation operation) {
+  benchmark::RegisterBenchmark(Name<type>(operation_name).c_str(),
+                               BM_Binary<type, Operation>, operation);
+}
+
+template <typename type, typename Operation>
+void RegisterTernary(const std::string& operation_name, Operation operation) {
+  benchmark::RegisterBenchmark(Name<type>(operation_name).c_str(),
+                               BM_Ternary<type, Operation>, operation);
+}
+
+}  // namespace bench
+}  // namespace dlm
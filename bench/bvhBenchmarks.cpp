@@ -0,0 +1,151 @@
+#include <cmath>
+
+#include "benchmarkhelpers.hpp"
+#include "dlm/bvh.hpp"
+
+namespace {
+
+using dlm::bench::kCount;
+using dlm::geometry::BVHF;
+using dlm::geometry::RayF;
+using dlm::geometry::TriangleF;
+using dlm::vector::Vector3F;
+
+// 708 x 708 quads, just over a million triangles, of a rolling height field
+// over [0, 708) x [0, 708).
+constexpr int kQuads = 708;
+
+float Height(int x, int y) {
+  return 8.0f * std::sin(0.05f * static_cast<float>(x)) *
+         std::cos(0.07f * static_cast<float>(y));
+}
+
+const std::vector<TriangleF>& Terrain() {
+  static const std::vector<TriangleF> triangles = [] {
+    std::vector<TriangleF> mesh;
+    mesh.reserve(2 * kQuads * kQuads);
+    for (int y = 0; y < kQuads; ++y) {
+      for (int x = 0; x < kQuads; ++x) {
+        const auto vertex = [](int vx, int vy) {
+          return Vector3F{static_cast<float>(vx), static_cast<float>(vy),
+                          Height(vx, vy)};
+        };
+        mesh.push_back({vertex(x, y), vertex(x + 1, y), vertex(x, y + 1)});
+        mesh.push_back(
+            {vertex(x + 1, y), vertex(x + 1, y + 1), vertex(x, y + 1)});
+      }
+    }
+    return mesh;
+  }();
+  return triangles;
+}
+
+const BVHF& TerrainBVH() {
+  static const BVHF bvh{dlm::Span<const TriangleF>{Terrain()}};
+  return bvh;
+}
+
+// kCount rays from above the terrain at a slant, every one of them hits.
+std::vector<RayF> MakeRays() {
+  const auto targets = dlm::bench::MakeInputs<Vector3F>(kCount, 1);
+  std::vector<RayF> rays(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    const Vector3F target{targets[i].x * 150.0f, targets[i].y * 150.0f, 0.0f};
+    const Vector3F origin = target + Vector3F{-20.0f, 10.0f, 50.0f};
+    rays[i] = {origin, target - origin};
+  }
+  return rays;
+}
+
+void BM_Build(benchmark::State& state) {
+  const dlm::Span<const TriangleF> triangles{Terrain()};
+
+  for (auto _ : state) {
+    BVHF bvh{triangles, static_cast<std::size_t>(state.range(0))};
+    benchmark::DoNotOptimize(bvh.Nodes().data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(triangles.size()));
+}
+
+void BM_Refit(benchmark::State& state) {
+  const dlm::Span<const TriangleF> triangles{Terrain()};
+  BVHF bvh{triangles};
+
+  for (auto _ : state) {
+    bvh.Refit(triangles);
+    benchmark::DoNotOptimize(bvh.Nodes().data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(triangles.size()));
+}
+
+// One ray against every triangle with the span kernel, what a query costs
+// without the tree.
+void BM_BruteForce(benchmark::State& state) {
+  const dlm::Span<const TriangleF> triangles{Terrain()};
+  const RayF ray = MakeRays()[0];
+  std::vector<float> distances(triangles.size());
+  std::vector<std::uint64_t> mask((triangles.size() + 63) / 64);
+
+  for (auto _ : state) {
+    dlm::geometry::Intersect(ray, triangles, dlm::Span<float>{distances},
+                             dlm::Span<std::uint64_t>{mask});
+    benchmark::DoNotOptimize(distances.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+void BM_ClosestHit(benchmark::State& state) {
+  const dlm::Span<const TriangleF> triangles{Terrain()};
+  const BVHF& bvh = TerrainBVH();
+  const auto rays = MakeRays();
+  std::vector<float> distances(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      distances[i] = bvh.ClosestHit(rays[i], triangles).distance;
+    }
+    benchmark::DoNotOptimize(distances.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+void BM_AnyHit(benchmark::State& state) {
+  const dlm::Span<const TriangleF> triangles{Terrain()};
+  const BVHF& bvh = TerrainBVH();
+  const auto rays = MakeRays();
+  std::vector<unsigned char> hits(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      hits[i] = bvh.AnyHit(rays[i], triangles);
+    }
+    benchmark::DoNotOptimize(hits.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+const bool kRegistered = [] {
+  benchmark::RegisterBenchmark("BVH/Triangle/Build", BM_Build)
+      ->Arg(1)
+      ->Arg(0)
+      ->Unit(benchmark::kMillisecond);
+  benchmark::RegisterBenchmark("BVH/Triangle/Refit", BM_Refit)
+      ->Unit(benchmark::kMillisecond);
+  benchmark::RegisterBenchmark("BVH/Triangle/BruteForce", BM_BruteForce)
+      ->Unit(benchmark::kMillisecond);
+  benchmark::RegisterBenchmark("BVH/Triangle/ClosestHit", BM_ClosestHit);
+  benchmark::RegisterBenchmark("BVH/Triangle/AnyHit", BM_AnyHit);
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,108 @@
+#include "benchmarkhelpers.hpp"
+
+namespace {
+
+using dlm::bench::kCount;
+using dlm::bench::MakeInputs;
+
+// The switch based accessor Component used before indexing became
+// (&x)[index], kept as the baseline.
+template <typename T>
+T SwitchComponent(const dlm::vector::Vector2<T>& v, int index) {
+  switch (index) {
+    default:
+    case 0:
+      return v.x;
+    case 1:
+      return v.y;
+  }
+}
+
+template <typename T>
+T SwitchComponent(const dlm::vector::Vector3<T>& v, int index) {
+  switch (index) {
+    default:
+    case 0:
+      return v.x;
+    case 1:
+      return v.y;
+    case 2:
+      return v.z;
+  }
+}
+
+template <typename T>
+T SwitchComponent(const dlm::vector::Vector4<T>& v, int index) {
+  switch (index) {
+    default:
+    case 0:
+      return v.x;
+    case 1:
+      return v.y;
+    case 2:
+      return v.z;
+    case 3:
+      return v.w;
+  }
+}
+
+struct SwitchAccess {
+  template <typename V>
+  auto operator()(const V& v, int index) const {
+    return SwitchComponent(v, index);
+  }
+};
+
+struct IndexAccess {
+  template <typename V>
+  auto operator()(const V& v, int index) const {
+    return v[index];
+  }
+};
+
+// Generic code that walks the components with a loop, the pattern the
+// branch free accessor is for. The component count is read at run time so
+// the loop cannot be unrolled into named member accesses.
+template <typename V, typename Access>
+void BM_ComponentLoop(benchmark::State& state, Access access) {
+  using T = typename V::ValueType;
+  const auto a = MakeInputs<V>(kCount, 1);
+  const auto b = MakeInputs<V>(kCount, 2);
+  std::vector<T> out(kCount);
+  int components = static_cast<int>(sizeof(V) / sizeof(T));
+  benchmark::DoNotOptimize(components);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      T sum = static_cast<T>(0);
+      for (int c = 0; c < components; ++c) {
+        sum += access(a[i], c) * access(b[i], c);
+      }
+      out[i] = sum;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename V>
+void RegisterComponentBenchmarks() {
+  benchmark::RegisterBenchmark(
+      dlm::bench::Name<V>("ComponentLoop/switch").c_str(),
+      BM_ComponentLoop<V, SwitchAccess>, SwitchAccess{});
+  benchmark::RegisterBenchmark(
+      dlm::bench::Name<V>("ComponentLoop/operator[]").c_str(),
+      BM_ComponentLoop<V, IndexAccess>, IndexAccess{});
+}
+
+const bool kRegistered = [] {
+  RegisterComponentBenchmarks<dlm::vector::Vector2<float>>();
+  RegisterComponentBenchmarks<dlm::vector::Vector3<float>>();
+  RegisterComponentBenchmarks<dlm::vector::Vector4<float>>();
+  RegisterComponentBenchmarks<dlm::vector::Vector3<double>>();
+  return true;
+}();
+
+}  // namespace
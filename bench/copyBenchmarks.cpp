@@ -0,0 +1,67 @@
+// clang-format off
+#include "benchmark/benchmark.h"
+// clang-format on
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "dlm/vector3.hpp"
+
+namespace {
+
+constexpr std::size_t kBufferSize = 10'000'000;
+
+// Mirrors the pre-trivially-copyable Vector3 layout: the user-provided
+// destructor forces element-wise copies and relocation.
+struct LegacyVector3F {
+  LegacyVector3F() : x{0.0f}, y{0.0f}, z{0.0f} {};
+  LegacyVector3F(float x, float y, float z) : x{x}, y{y}, z{z} {};
+  ~LegacyVector3F(){};
+
+  float x;
+  float y;
+  float z;
+};
+
+template <typename vector_type>
+void BM_BulkCopy(benchmark::State& state) {
+  const std::vector<vector_type> source(kBufferSize,
+                                        vector_type{1.0f, 2.0f, 3.0f});
+  std::vector<vector_type> destination(kBufferSize);
+
+  for (auto _ : state) {
+    std::copy(source.begin(), source.end(), destination.begin());
+    benchmark::DoNotOptimize(destination.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          kBufferSize * sizeof(vector_type));
+}
+
+template <typename vector_type>
+void BM_Reallocate(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<vector_type> buffer(kBufferSize,
+                                    vector_type{1.0f, 2.0f, 3.0f});
+    state.ResumeTiming();
+
+    buffer.reserve(kBufferSize * 2);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          kBufferSize * sizeof(vector_type));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_BulkCopy, dlm::vector::Vector3F)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BulkCopy, LegacyVector3F)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Reallocate, dlm::vector::Vector3F)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Reallocate, LegacyVector3F)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,59 @@
+#include "benchmarkhelpers.hpp"
+#include "dlm/expression.hpp"
+
+namespace {
+
+using dlm::bench::RegisterTernary;
+using dlm::vector::Lazy;
+
+// The same physics expressions evaluated with the eager operators and as a
+// single lazy expression.
+template <typename V>
+void RegisterExpressionBenchmarks() {
+  using T = typename V::ValueType;
+  const T dt = static_cast<T>(1.0 / 60.0);
+  const T half_dt_squared = static_cast<T>(0.5) * dt * dt;
+  const T stiffness = static_cast<T>(40);
+  const T damping = static_cast<T>(0.3);
+  const T t = static_cast<T>(0.25);
+
+  // Position update from position, velocity and acceleration.
+  RegisterTernary<V>("Integrate/eager", [=](const V& p, const V& v,
+                                            const V& a) {
+    return p + v * dt + a * half_dt_squared;
+  });
+  RegisterTernary<V>("Integrate/lazy", [=](const V& p, const V& v,
+                                           const V& a) -> V {
+    return Lazy(p) + Lazy(v) * dt + Lazy(a) * half_dt_squared;
+  });
+
+  // Damped spring force between two positions.
+  RegisterTernary<V>("Spring/eager", [=](const V& x0, const V& x1,
+                                         const V& relative_velocity) {
+    return (x1 - x0) * stiffness - relative_velocity * damping;
+  });
+  RegisterTernary<V>("Spring/lazy", [=](const V& x0, const V& x1,
+                                        const V& relative_velocity) -> V {
+    return (Lazy(x1) - x0) * stiffness - Lazy(relative_velocity) * damping;
+  });
+
+  // Three point blend a * (1 - t) + b * t - c * t * t.
+  RegisterTernary<V>("Blend/eager", [=](const V& a, const V& b, const V& c) {
+    return a * (static_cast<T>(1) - t) + b * t - c * (t * t);
+  });
+  RegisterTernary<V>("Blend/lazy", [=](const V& a, const V& b,
+                                       const V& c) -> V {
+    return Lazy(a) * (static_cast<T>(1) - t) + Lazy(b) * t -
+           Lazy(c) * (t * t);
+  });
+}
+
+const bool kRegistered = [] {
+  RegisterExpressionBenchmarks<dlm::vector::Vector3<float>>();
+  RegisterExpressionBenchmarks<dlm::vector::Vector4<float>>();
+  RegisterExpressionBenchmarks<dlm::vector::Vector3<double>>();
+  RegisterExpressionBenchmarks<dlm::vector::Vector4<double>>();
+  return true;
+}();
+
+}  // namespace
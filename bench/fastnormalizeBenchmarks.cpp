@@ -0,0 +1,43 @@
+#include "benchmarkhelpers.hpp"
+#include "dlm/fastnormalize.hpp"
+#include "dlm/geometricfunctions.hpp"
+
+namespace {
+
+using dlm::bench::RegisterUnary;
+namespace precision = dlm::vector::precision;
+
+// Normalize against every FastNormalize policy, the exact policy shows the
+// gain of a reciprocal multiply over three divides on its own.
+template <typename V>
+void RegisterFastNormalizeBenchmarks() {
+  RegisterUnary<V>("Normalize",
+                   [](const V& a) { return dlm::vector::Normalize(a); });
+  RegisterUnary<V>("FastNormalize/Exact", [](const V& a) {
+    return dlm::vector::FastNormalize<precision::Exact>(a);
+  });
+  RegisterUnary<V>("FastNormalize/Refined", [](const V& a) {
+    return dlm::vector::FastNormalize<precision::Refined>(a);
+  });
+  RegisterUnary<V>("FastNormalize/Estimate", [](const V& a) {
+    return dlm::vector::FastNormalize<precision::Estimate>(a);
+  });
+  RegisterUnary<V>("FastNormalizeSafe/Refined", [](const V& a) {
+    return dlm::vector::FastNormalizeSafe<precision::Refined>(a);
+  });
+}
+
+template <typename T>
+void RegisterAll() {
+  RegisterFastNormalizeBenchmarks<dlm::vector::Vector2<T>>();
+  RegisterFastNormalizeBenchmarks<dlm::vector::Vector3<T>>();
+  RegisterFastNormalizeBenchmarks<dlm::vector::Vector4<T>>();
+}
+
+const bool kRegistered = [] {
+  RegisterAll<float>();
+  RegisterAll<double>();
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,232 @@
+#include "benchmarkhelpers.hpp"
+#include "dlm/geometricfunctions.hpp"
+
+namespace {
+
+using dlm::bench::RegisterBinary;
+using dlm::bench::RegisterUnary;
+
+// Project as it was before it used LengthSquared, kept as the baseline.
+template <typename V>
+V ProjectWithSqrt(const V& v1, const V& v2) {
+  const typename V::ValueType v2_length = dlm::vector::Length(v2);
+  return v2 * ((v1 | v2) / (v2_length * v2_length));
+}
+
+constexpr std::size_t kSpanCount = 1 << 16;
+
+// Measures an operation that fills out from the spans a and b.
+template <typename V, typename Operation>
+void BM_Spans(benchmark::State& state, Operation operation) {
+  const auto a = dlm::bench::MakeInputs<V>(kSpanCount, 1);
+  const auto b = dlm::bench::MakeInputs<V>(kSpanCount, 2);
+  std::vector<V> out(kSpanCount);
+
+  for (auto _ : state) {
+    operation(dlm::Span<const V>{a}, dlm::Span<const V>{b}, dlm::Span<V>{out});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          kSpanCount);
+}
+
+template <typename V, typename Operation>
+void RegisterSpans(const std::string& name, Operation operation) {
+  benchmark::RegisterBenchmark(dlm::bench::Name<V>(name).c_str(),
+                               BM_Spans<V, Operation>, operation);
+}
+
+// Measures an operation that fills the scalars out from the span points and
+// one query point.
+template <typename V, typename Operation>
+void BM_ToPoint(benchmark::State& state, Operation operation) {
+  using T = typename V::ValueType;
+  const auto points = dlm::bench::MakeInputs<V>(kSpanCount, 1);
+  const V point = dlm::bench::MakeInputs<V>(1, 2)[0];
+  std::vector<T> out(kSpanCount);
+
+  for (auto _ : state) {
+    operation(dlm::Span<const V>{points}, point, dlm::Span<T>{out});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          kSpanCount);
+}
+
+template <typename V, typename Operation>
+void RegisterToPoint(const std::string& name, Operation operation) {
+  benchmark::RegisterBenchmark(dlm::bench::Name<V>(name).c_str(),
+                               BM_ToPoint<V, Operation>, operation);
+}
+
+// Distances from one point to a span, and the nearest of them, with a loop
+// of single calls as the baseline.
+template <typename V>
+void RegisterDistanceBenchmarks() {
+  using T = typename V::ValueType;
+  using Points = dlm::Span<const V>;
+  using Out = dlm::Span<T>;
+
+  RegisterBinary<V>("Distance", [](const V& a, const V& b) {
+    return dlm::vector::Distance(a, b);
+  });
+  RegisterBinary<V>("DistanceSquared", [](const V& a, const V& b) {
+    return dlm::vector::DistanceSquared(a, b);
+  });
+
+  RegisterToPoint<V>("DistanceSquared/to_point/loop",
+                     [](Points points, const V& point, Out out) {
+                       for (std::size_t i = 0; i < points.size(); ++i) {
+                         out[i] = dlm::vector::DistanceSquared(points[i],
+                                                               point);
+                       }
+                     });
+  RegisterToPoint<V>("DistanceSquared/to_point/span",
+                     [](Points points, const V& point, Out out) {
+                       dlm::vector::DistanceSquared(points, point, out);
+                     });
+  RegisterToPoint<V>("Distance/to_point/span",
+                     [](Points points, const V& point, Out out) {
+                       dlm::vector::Distance(points, point, out);
+                     });
+  RegisterToPoint<V>("Nearest/loop", [](Points points, const V& point,
+                                        Out out) {
+    std::size_t nearest = 0;
+    T nearest_distance = dlm::vector::DistanceSquared(points[0], point);
+    for (std::size_t i = 1; i < points.size(); ++i) {
+      const T distance = dlm::vector::DistanceSquared(points[i], point);
+      if (distance < nearest_distance) {
+        nearest = i;
+        nearest_distance = distance;
+      }
+    }
+    out[0] = static_cast<T>(nearest);
+  });
+  RegisterToPoint<V>("Nearest/span", [](Points points, const V& point,
+                                        Out out) {
+    out[0] = static_cast<T>(dlm::vector::Nearest(points, point));
+  });
+  RegisterToPoint<V>("KNearest/16", [](Points points, const V& point,
+                                       Out out) {
+    std::size_t nearest[16];
+    dlm::vector::KNearest(points, point, dlm::Span<std::size_t>{nearest});
+    out[0] = static_cast<T>(nearest[0]);
+  });
+}
+
+// Per call and per span projection, with and without the sqrt.
+template <typename V>
+void RegisterProjectBenchmarks() {
+  using Spans = dlm::Span<const V>;
+  using Out = dlm::Span<V>;
+
+  RegisterBinary<V>("Project/with_sqrt", [](const V& a, const V& b) {
+    return ProjectWithSqrt(a, b);
+  });
+  RegisterBinary<V>("Reject", [](const V& a, const V& b) {
+    return dlm::vector::Reject(a, b);
+  });
+
+  RegisterSpans<V>("Project/span/with_sqrt", [](Spans a, Spans b, Out out) {
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      out[i] = ProjectWithSqrt(a[i], b[i]);
+    }
+  });
+  RegisterSpans<V>("Project/span", [](Spans a, Spans b, Out out) {
+    dlm::vector::Project(a, b, out);
+  });
+  RegisterSpans<V>("Project/span_onto_one", [](Spans a, Spans b, Out out) {
+    dlm::vector::Project(a, b[0], out);
+  });
+  RegisterSpans<V>("Reject/span", [](Spans a, Spans b, Out out) {
+    dlm::vector::Reject(a, b, out);
+  });
+}
+
+// Reflect and Refract over spans, with and without normalizing the normal,
+// against a loop of single calls.
+template <typename V>
+void RegisterReflectBenchmarks() {
+  using T = typename V::ValueType;
+  using Spans = dlm::Span<const V>;
+  using Out = dlm::Span<V>;
+  const T eta = static_cast<T>(0.75);
+
+  RegisterSpans<V>("Reflect/span/loop", [](Spans a, Spans b, Out out) {
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      out[i] = dlm::vector::Reflect(a[i], b[i]);
+    }
+  });
+  RegisterSpans<V>("Reflect/span", [](Spans a, Spans b, Out out) {
+    dlm::vector::Reflect(a, b, out);
+  });
+  RegisterSpans<V>("Reflect/span/unit_normal", [](Spans a, Spans b, Out out) {
+    dlm::vector::Reflect(a, b, out, dlm::vector::kUnitNormal);
+  });
+  RegisterSpans<V>("Refract/span/loop", [eta](Spans a, Spans b, Out out) {
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      out[i] = dlm::vector::Refract(a[i], b[i], eta);
+    }
+  });
+  RegisterSpans<V>("Refract/span", [eta](Spans a, Spans b, Out out) {
+    dlm::vector::Refract(a, b, eta, out);
+  });
+  RegisterSpans<V>("Refract/span/unit_normal",
+                   [eta](Spans a, Spans b, Out out) {
+                     dlm::vector::Refract(a, b, eta, out,
+                                          dlm::vector::kUnitNormal);
+                   });
+}
+
+// Registers the free functions that accept any vector width.
+template <typename V>
+void RegisterGeometricBenchmarks() {
+  RegisterUnary<V>("Normalize",
+                   [](const V& a) { return dlm::vector::Normalize(a); });
+  RegisterUnary<V>("Length", [](const V& a) { return dlm::vector::Length(a); });
+  RegisterBinary<V>("Dot", [](const V& a, const V& b) {
+    return dlm::vector::Dot(a, b);
+  });
+  RegisterBinary<V>("Reflect", [](const V& a, const V& b) {
+    return dlm::vector::Reflect(a, b);
+  });
+  RegisterBinary<V>("Reflect/unit_normal", [](const V& a, const V& b) {
+    return dlm::vector::Reflect(a, b, dlm::vector::kUnitNormal);
+  });
+  RegisterBinary<V>("Project", [](const V& a, const V& b) {
+    return dlm::vector::Project(a, b);
+  });
+}
+
+template <typename T>
+void RegisterAll() {
+  RegisterGeometricBenchmarks<dlm::vector::Vector2<T>>();
+  RegisterGeometricBenchmarks<dlm::vector::Vector3<T>>();
+  RegisterGeometricBenchmarks<dlm::vector::Vector4<T>>();
+  RegisterProjectBenchmarks<dlm::vector::Vector2<T>>();
+  RegisterProjectBenchmarks<dlm::vector::Vector3<T>>();
+  RegisterProjectBenchmarks<dlm::vector::Vector4<T>>();
+  RegisterDistanceBenchmarks<dlm::vector::Vector2<T>>();
+  RegisterDistanceBenchmarks<dlm::vector::Vector3<T>>();
+  RegisterDistanceBenchmarks<dlm::vector::Vector4<T>>();
+  RegisterReflectBenchmarks<dlm::vector::Vector2<T>>();
+  RegisterReflectBenchmarks<dlm::vector::Vector3<T>>();
+  RegisterReflectBenchmarks<dlm::vector::Vector4<T>>();
+
+  using V3 = dlm::vector::Vector3<T>;
+  RegisterBinary<V3>("Cross", [](const V3& a, const V3& b) {
+    return dlm::vector::Cross(a, b);
+  });
+}
+
+const bool kRegistered = [] {
+  RegisterAll<float>();
+  RegisterAll<double>();
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,128 @@
+#include "benchmarkhelpers.hpp"
+#include "dlm/intersection.hpp"
+
+namespace {
+
+using dlm::bench::kCount;
+using dlm::bench::MakeInputs;
+using dlm::geometry::AABB3F;
+using dlm::geometry::PlaneF;
+using dlm::geometry::RayF;
+using dlm::geometry::SphereF;
+using dlm::geometry::TriangleF;
+using dlm::vector::Vector3F;
+
+// Rays from around the origin towards the inputs in [0.5, 4.5), primitives
+// placed among the inputs so a good share of the pairs hit.
+std::vector<RayF> MakeRays() {
+  const auto targets = MakeInputs<Vector3F>(kCount, 1);
+  const auto origins = MakeInputs<Vector3F>(kCount, 2);
+  std::vector<RayF> rays(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    rays[i] = {origins[i] - 2.5f, targets[i] - origins[i] + 2.5f};
+  }
+  return rays;
+}
+
+void Make(const Vector3F* p, PlaneF& plane) { plane = {p[0] - 2.5f, 1.0f}; }
+
+void Make(const Vector3F* p, SphereF& sphere) {
+  sphere = {p[0], p[1].x * 0.25f};
+}
+
+void Make(const Vector3F* p, AABB3F& box) {
+  box = AABB3F{}.Merge(p[0]).Merge(p[0] + p[1] * 0.25f);
+}
+
+void Make(const Vector3F* p, TriangleF& triangle) {
+  triangle = {p[0], p[1], p[2]};
+}
+
+template <typename Primitive>
+std::vector<Primitive> MakePrimitives() {
+  const auto points = MakeInputs<Vector3F>(3 * kCount, 3);
+  std::vector<Primitive> primitives(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    Make(&points[3 * i], primitives[i]);
+  }
+  return primitives;
+}
+
+// One ray against kCount primitives, one Intersect at a time against the
+// span kernel.
+template <typename Primitive>
+void BM_ToPrimitivesLoop(benchmark::State& state) {
+  const RayF ray = MakeRays()[0];
+  const auto primitives = MakePrimitives<Primitive>();
+  std::vector<float> distances(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      distances[i] = dlm::geometry::Intersect(ray, primitives[i]);
+    }
+    benchmark::DoNotOptimize(distances.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename Primitive>
+void BM_ToPrimitivesSpan(benchmark::State& state) {
+  const RayF ray = MakeRays()[0];
+  const auto primitives = MakePrimitives<Primitive>();
+  std::vector<float> distances(kCount);
+  std::vector<std::uint64_t> mask(kCount / 64);
+
+  for (auto _ : state) {
+    dlm::geometry::Intersect(ray, dlm::Span<const Primitive>{primitives},
+                             dlm::Span<float>{distances},
+                             dlm::Span<std::uint64_t>{mask});
+    benchmark::DoNotOptimize(distances.data());
+    benchmark::DoNotOptimize(mask.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+// kCount rays against one primitive.
+template <typename Primitive>
+void BM_FromRaysSpan(benchmark::State& state) {
+  const auto rays = MakeRays();
+  const Primitive primitive = MakePrimitives<Primitive>()[0];
+  std::vector<float> distances(kCount);
+  std::vector<std::uint64_t> mask(kCount / 64);
+
+  for (auto _ : state) {
+    dlm::geometry::Intersect(dlm::Span<const RayF>{rays}, primitive,
+                             dlm::Span<float>{distances},
+                             dlm::Span<std::uint64_t>{mask});
+    benchmark::DoNotOptimize(distances.data());
+    benchmark::DoNotOptimize(mask.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename Primitive>
+void RegisterIntersectBenchmarks(const std::string& primitive) {
+  const std::string name = "Ray/" + primitive + "/";
+  benchmark::RegisterBenchmark((name + "loop").c_str(),
+                               BM_ToPrimitivesLoop<Primitive>);
+  benchmark::RegisterBenchmark((name + "span").c_str(),
+                               BM_ToPrimitivesSpan<Primitive>);
+  benchmark::RegisterBenchmark((name + "span_of_rays").c_str(),
+                               BM_FromRaysSpan<Primitive>);
+}
+
+const bool kRegistered = [] {
+  RegisterIntersectBenchmarks<PlaneF>("Plane");
+  RegisterIntersectBenchmarks<SphereF>("Sphere");
+  RegisterIntersectBenchmarks<AABB3F>("AABB");
+  RegisterIntersectBenchmarks<TriangleF>("Triangle");
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,117 @@
+#include <vector>
+
+#include "benchmarkhelpers.hpp"
+#include "dlm/kdtree.hpp"
+
+namespace {
+
+using dlm::bench::kCount;
+using dlm::geometry::KDTree3F;
+using dlm::vector::Vector3F;
+
+// The agents of the SpatialHash benchmarks, a quarter million points in a
+// 64 x 64 x 64 box, so the two structures can be compared.
+constexpr std::size_t kPoints = 1u << 18;
+constexpr float kSide = 64.0f;
+constexpr float kRadius = 2.0f;
+
+const std::vector<Vector3F>& Points() {
+  static const std::vector<Vector3F> points = [] {
+    const auto inputs = dlm::bench::MakeInputs<Vector3F>(kPoints, 1);
+    std::vector<Vector3F> scaled(kPoints);
+    for (std::size_t i = 0; i < kPoints; ++i) {
+      scaled[i] = (inputs[i] - 0.5f) * (0.25f * kSide);
+    }
+    return scaled;
+  }();
+  return points;
+}
+
+const KDTree3F& PointTree() {
+  static const KDTree3F tree{dlm::Span<const Vector3F>{Points()}};
+  return tree;
+}
+
+dlm::Span<const Vector3F> Queries() {
+  return dlm::Span<const Vector3F>{Points()}.subspan(0, kCount);
+}
+
+void BM_Build(benchmark::State& state) {
+  const dlm::Span<const Vector3F> points{Points()};
+
+  for (auto _ : state) {
+    KDTree3F tree{points, static_cast<std::size_t>(state.range(0))};
+    benchmark::DoNotOptimize(tree.Indices().data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(points.size()));
+}
+
+void BM_Within(benchmark::State& state) {
+  const dlm::Span<const Vector3F> points{Points()};
+  const KDTree3F& tree = PointTree();
+  std::vector<std::size_t> found;
+
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (const auto& query : Queries()) {
+      tree.Within(points, query, kRadius, found);
+      count += found.size();
+    }
+    benchmark::DoNotOptimize(count);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+void BM_KNearest(benchmark::State& state) {
+  const dlm::Span<const Vector3F> points{Points()};
+  const KDTree3F& tree = PointTree();
+  std::vector<std::size_t> nearest(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    for (const auto& query : Queries()) {
+      tree.KNearest(points, query, dlm::Span<std::size_t>{nearest});
+    }
+    benchmark::DoNotOptimize(nearest.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+// k = 8 for every query at once, on one thread and on all of them.
+void BM_KNearestBatch(benchmark::State& state) {
+  constexpr std::size_t kK = 8;
+  const dlm::Span<const Vector3F> points{Points()};
+  const KDTree3F& tree = PointTree();
+  std::vector<std::size_t> nearest(kCount * kK);
+
+  for (auto _ : state) {
+    tree.KNearest(points, Queries(), kK, dlm::Span<std::size_t>{nearest},
+                  static_cast<std::size_t>(state.range(0)));
+    benchmark::DoNotOptimize(nearest.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+const bool kRegistered = [] {
+  benchmark::RegisterBenchmark("KDTree/Vector3<float>/Build", BM_Build)
+      ->Arg(1)
+      ->Arg(0)
+      ->Unit(benchmark::kMillisecond);
+  benchmark::RegisterBenchmark("KDTree/Vector3<float>/Within", BM_Within);
+  benchmark::RegisterBenchmark("KDTree/Vector3<float>/KNearest", BM_KNearest)
+      ->Arg(1)
+      ->Arg(8);
+  benchmark::RegisterBenchmark("KDTree/Vector3<float>/KNearestBatch",
+                               BM_KNearestBatch)
+      ->Arg(1)
+      ->Arg(0);
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,93 @@
+#include "benchmarkhelpers.hpp"
+
+namespace {
+
+using dlm::bench::RegisterBinary;
+using dlm::bench::RegisterUnary;
+
+template <typename T>
+void BM_TransformScalar(benchmark::State& state) {
+  using V = dlm::vector::Vector2<T>;
+  const auto points = dlm::bench::MakeInputs<V>(dlm::bench::kCount, 1);
+  const auto m = dlm::bench::MakeInputs<dlm::matrix::Matrix2x2<T>>(1, 2)[0];
+  std::vector<V> out(dlm::bench::kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      out[i] = m * points[i];
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          dlm::bench::kCount);
+}
+
+template <typename T>
+void BM_TransformBatch(benchmark::State& state) {
+  using V = dlm::vector::Vector2<T>;
+  const auto points = dlm::bench::MakeInputs<V>(dlm::bench::kCount, 1);
+  const auto m = dlm::bench::MakeInputs<dlm::matrix::Matrix2x2<T>>(1, 2)[0];
+  std::vector<V> out(dlm::bench::kCount);
+
+  for (auto _ : state) {
+    dlm::matrix::Transform(m, dlm::Span<const V>{points}, dlm::Span<V>{out});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          dlm::bench::kCount);
+}
+
+template <typename T>
+void RegisterMatrix2x2Benchmarks() {
+  using M = dlm::matrix::Matrix2x2<T>;
+  const T s = static_cast<T>(1.5);
+
+  RegisterUnary<M>("operator-(scalar)", [s](const M& a) { return a - s; });
+  RegisterBinary<M>("operator-(matrix)",
+                    [](const M& a, const M& b) { return a - b; });
+  RegisterUnary<M>("operator-=(scalar)", [s](M a) { return a -= s; });
+  RegisterBinary<M>("operator-=(matrix)",
+                    [](M a, const M& b) { return a -= b; });
+
+  RegisterUnary<M>("operator+(scalar)", [s](const M& a) { return a + s; });
+  RegisterBinary<M>("operator+(matrix)",
+                    [](const M& a, const M& b) { return a + b; });
+  RegisterUnary<M>("operator+=(scalar)", [s](M a) { return a += s; });
+  RegisterBinary<M>("operator+=(matrix)",
+                    [](M a, const M& b) { return a += b; });
+
+  RegisterBinary<M>("operator*(matrix)",
+                    [](const M& a, const M& b) { return a * b; });
+  RegisterBinary<M>("operator*=(matrix)",
+                    [](M a, const M& b) { return a *= b; });
+  const typename M::ColumnType v{s, -s};
+  RegisterUnary<M>("operator*(vector)", [v](const M& a) { return a * v; });
+
+  RegisterUnary<M>("operator[]", [](const M& a) { return a[1]; });
+
+  RegisterUnary<M>("Transpose", [](const M& a) { return a.Transpose(); });
+  RegisterUnary<M>("Determinant", [](const M& a) { return a.Determinant(); });
+  RegisterUnary<M>("Inverse", [](const M& a) { return a.Inverse(); });
+  RegisterUnary<M>("TryInverse", [](const M& a) {
+    M inverse;
+    a.TryInverse(inverse);
+    return inverse;
+  });
+
+  benchmark::RegisterBenchmark(
+      dlm::bench::Name<M>("Transform/scalar").c_str(), BM_TransformScalar<T>);
+  benchmark::RegisterBenchmark(
+      dlm::bench::Name<M>("Transform/batch").c_str(), BM_TransformBatch<T>);
+}
+
+const bool kRegistered = [] {
+  RegisterMatrix2x2Benchmarks<float>();
+  RegisterMatrix2x2Benchmarks<double>();
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,43 @@
+#include "benchmarkhelpers.hpp"
+
+namespace {
+
+using dlm::bench::RegisterBinary;
+using dlm::bench::RegisterUnary;
+
+template <typename T>
+void RegisterMatrix3x3Benchmarks() {
+  using M = dlm::matrix::Matrix3x3<T>;
+  const T s = static_cast<T>(1.5);
+
+  RegisterUnary<M>("operator-(scalar)", [s](const M& a) { return a - s; });
+  RegisterBinary<M>("operator-(matrix)",
+                    [](const M& a, const M& b) { return a - b; });
+  RegisterUnary<M>("operator+(scalar)", [s](const M& a) { return a + s; });
+  RegisterBinary<M>("operator+(matrix)",
+                    [](const M& a, const M& b) { return a + b; });
+
+  RegisterBinary<M>("operator*(matrix)",
+                    [](const M& a, const M& b) { return a * b; });
+  RegisterBinary<M>("operator*=(matrix)",
+                    [](M a, const M& b) { return a *= b; });
+  const typename M::ColumnType v{s, -s, s};
+  RegisterUnary<M>("operator*(vector)", [v](const M& a) { return a * v; });
+
+  RegisterUnary<M>("Transpose", [](const M& a) { return a.Transpose(); });
+  RegisterUnary<M>("Determinant", [](const M& a) { return a.Determinant(); });
+  RegisterUnary<M>("Inverse", [](const M& a) { return a.Inverse(); });
+  RegisterUnary<M>("TryInverse", [](const M& a) {
+    M inverse;
+    a.TryInverse(inverse);
+    return inverse;
+  });
+}
+
+const bool kRegistered = [] {
+  RegisterMatrix3x3Benchmarks<float>();
+  RegisterMatrix3x3Benchmarks<double>();
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,154 @@
+#include "benchmarkhelpers.hpp"
+
+namespace {
+
+using dlm::bench::RegisterBinary;
+using dlm::bench::RegisterUnary;
+
+// Makes every input affine so the general and affine paths see the same
+// matrices.
+template <typename T>
+std::vector<dlm::matrix::Matrix4x4<T>> MakeAffineInputs(std::size_t count,
+                                                         std::uint32_t seed) {
+  auto inputs = dlm::bench::MakeInputs<dlm::matrix::Matrix4x4<T>>(count, seed);
+  for (auto& input : inputs) {
+    input[3] = {static_cast<T>(0), static_cast<T>(0), static_cast<T>(0),
+                static_cast<T>(1)};
+  }
+  return inputs;
+}
+
+template <typename T, typename Operation>
+void BM_AffineBinary(benchmark::State& state, Operation operation) {
+  const auto a = MakeAffineInputs<T>(dlm::bench::kCount, 1);
+  const auto b = MakeAffineInputs<T>(dlm::bench::kCount, 2);
+  std::vector<dlm::matrix::Matrix4x4<T>> out(dlm::bench::kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < dlm::bench::kCount; ++i) {
+      out[i] = operation(a[i], b[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          dlm::bench::kCount);
+}
+
+template <typename T, typename Operation>
+void BM_AffineUnary(benchmark::State& state, Operation operation) {
+  const auto a = MakeAffineInputs<T>(dlm::bench::kCount, 1);
+  std::vector<dlm::matrix::Matrix4x4<T>> out(dlm::bench::kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < dlm::bench::kCount; ++i) {
+      out[i] = operation(a[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          dlm::bench::kCount);
+}
+
+template <typename T>
+void BM_TransformScalar(benchmark::State& state) {
+  using V = dlm::vector::Vector4<T>;
+  const auto points = dlm::bench::MakeInputs<V>(dlm::bench::kCount, 1);
+  const auto m = MakeAffineInputs<T>(1, 2)[0];
+  std::vector<V> out(dlm::bench::kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      out[i] = m * points[i];
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          dlm::bench::kCount);
+}
+
+template <typename T, bool affine>
+void BM_TransformBatch(benchmark::State& state) {
+  using V = dlm::vector::Vector4<T>;
+  const auto points = dlm::bench::MakeInputs<V>(dlm::bench::kCount, 1);
+  const auto m = MakeAffineInputs<T>(1, 2)[0];
+  std::vector<V> out(dlm::bench::kCount);
+
+  for (auto _ : state) {
+    if (affine) {
+      dlm::matrix::TransformAffine(m, dlm::Span<const V>{points},
+                                   dlm::Span<V>{out});
+    } else {
+      dlm::matrix::Transform(m, dlm::Span<const V>{points}, dlm::Span<V>{out});
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          dlm::bench::kCount);
+}
+
+template <typename T>
+void RegisterMatrix4x4Benchmarks() {
+  using M = dlm::matrix::Matrix4x4<T>;
+  const T s = static_cast<T>(1.5);
+
+  RegisterUnary<M>("operator-(scalar)", [s](const M& a) { return a - s; });
+  RegisterBinary<M>("operator-(matrix)",
+                    [](const M& a, const M& b) { return a - b; });
+  RegisterUnary<M>("operator+(scalar)", [s](const M& a) { return a + s; });
+  RegisterBinary<M>("operator+(matrix)",
+                    [](const M& a, const M& b) { return a + b; });
+
+  RegisterBinary<M>("operator*(matrix)",
+                    [](const M& a, const M& b) { return a * b; });
+  RegisterBinary<M>("operator*=(matrix)",
+                    [](M a, const M& b) { return a *= b; });
+  const typename M::ColumnType v{s, -s, s, static_cast<T>(1)};
+  RegisterUnary<M>("operator*(vector)", [v](const M& a) { return a * v; });
+
+  RegisterUnary<M>("Transpose", [](const M& a) { return a.Transpose(); });
+  RegisterUnary<M>("Determinant", [](const M& a) { return a.Determinant(); });
+  RegisterUnary<M>("Inverse", [](const M& a) { return a.Inverse(); });
+
+  const auto multiply = [](const M& a, const M& b) { return a * b; };
+  const auto multiply_affine = [](const M& a, const M& b) {
+    return a.MultiplyAffine(b);
+  };
+  const auto inverse = [](const M& a) { return a.Inverse(); };
+  const auto inverse_affine = [](const M& a) { return a.InverseAffine(); };
+  benchmark::RegisterBenchmark(
+      dlm::bench::Name<M>("Multiply/general").c_str(),
+      BM_AffineBinary<T, decltype(multiply)>, multiply);
+  benchmark::RegisterBenchmark(
+      dlm::bench::Name<M>("Multiply/affine").c_str(),
+      BM_AffineBinary<T, decltype(multiply_affine)>, multiply_affine);
+  benchmark::RegisterBenchmark(dlm::bench::Name<M>("Inverse/general").c_str(),
+                               BM_AffineUnary<T, decltype(inverse)>, inverse);
+  benchmark::RegisterBenchmark(
+      dlm::bench::Name<M>("Inverse/affine").c_str(),
+      BM_AffineUnary<T, decltype(inverse_affine)>, inverse_affine);
+
+  benchmark::RegisterBenchmark(
+      dlm::bench::Name<M>("Transform/scalar").c_str(), BM_TransformScalar<T>);
+  benchmark::RegisterBenchmark(
+      dlm::bench::Name<M>("Transform/batch").c_str(),
+      BM_TransformBatch<T, false>);
+  benchmark::RegisterBenchmark(
+      dlm::bench::Name<M>("Transform/batch_affine").c_str(),
+      BM_TransformBatch<T, true>);
+}
+
+const bool kRegistered = [] {
+  RegisterMatrix4x4Benchmarks<float>();
+  RegisterMatrix4x4Benchmarks<double>();
+  return true;
+}();
+
+}  // namespace
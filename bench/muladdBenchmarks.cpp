@@ -0,0 +1,87 @@
+#include "benchmarkhelpers.hpp"
+#include "dlm/muladd.hpp"
+
+namespace {
+
+using dlm::bench::kCount;
+using dlm::bench::MakeInputs;
+using dlm::bench::RegisterTernary;
+
+template <typename V>
+void RegisterMulAddBenchmarks() {
+  using T = typename V::ValueType;
+  const T dt = static_cast<T>(1.0 / 60.0);
+
+  RegisterTernary<V>("a*b+c", [](const V& a, const V& b, const V& c) {
+    return a * b + c;
+  });
+  RegisterTernary<V>("MulAdd", [](const V& a, const V& b, const V& c) {
+    return dlm::vector::MulAdd(a, b, c);
+  });
+  RegisterTernary<V>("p+v*dt", [dt](const V& p, const V& v, const V&) {
+    return p + v * dt;
+  });
+  RegisterTernary<V>("MulAdd(dt)", [dt](const V& p, const V& v, const V&) {
+    return dlm::vector::MulAdd(v, dt, p);
+  });
+}
+
+// In place position update over kCount points, p += v * dt per element
+// against the span MulAdd.
+template <typename V>
+void BM_UpdateLoop(benchmark::State& state) {
+  using T = typename V::ValueType;
+  auto positions = MakeInputs<V>(kCount, 1);
+  const auto velocities = MakeInputs<V>(kCount, 2);
+  const T dt = static_cast<T>(1.0 / 60.0);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      positions[i] += velocities[i] * dt;
+    }
+    benchmark::DoNotOptimize(positions.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename V>
+void BM_UpdateSpan(benchmark::State& state) {
+  using T = typename V::ValueType;
+  auto positions = MakeInputs<V>(kCount, 1);
+  const auto velocities = MakeInputs<V>(kCount, 2);
+  const T dt = static_cast<T>(1.0 / 60.0);
+
+  for (auto _ : state) {
+    dlm::vector::MulAdd(dlm::Span<const V>{velocities}, dt,
+                        dlm::Span<const V>{positions}, dlm::Span<V>{positions});
+    benchmark::DoNotOptimize(positions.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename V>
+void RegisterUpdateBenchmarks() {
+  benchmark::RegisterBenchmark(dlm::bench::Name<V>("Update/loop").c_str(),
+                               BM_UpdateLoop<V>);
+  benchmark::RegisterBenchmark(dlm::bench::Name<V>("Update/span").c_str(),
+                               BM_UpdateSpan<V>);
+}
+
+const bool kRegistered = [] {
+  RegisterMulAddBenchmarks<dlm::vector::Vector2<float>>();
+  RegisterMulAddBenchmarks<dlm::vector::Vector3<float>>();
+  RegisterMulAddBenchmarks<dlm::vector::Vector4<float>>();
+  RegisterMulAddBenchmarks<dlm::vector::Vector3<double>>();
+  RegisterMulAddBenchmarks<dlm::vector::Vector4<double>>();
+  RegisterUpdateBenchmarks<dlm::vector::Vector2<float>>();
+  RegisterUpdateBenchmarks<dlm::vector::Vector3<float>>();
+  RegisterUpdateBenchmarks<dlm::vector::Vector4<float>>();
+  RegisterUpdateBenchmarks<dlm::vector::Vector3<double>>();
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,181 @@
+#include "benchmarkhelpers.hpp"
+#include "dlm/packing.hpp"
+
+namespace {
+
+using dlm::bench::kCount;
+using dlm::bench::MakeInputs;
+
+// One encoding: its vector and packed types, inputs in its valid range and
+// the single value and span functions.
+struct Octahedral {
+  using Vector = dlm::vector::Vector3F;
+  using Packed = dlm::vector::OctahedralNormal;
+
+  static const char* Name() { return "Vector3<float>/Octahedral"; }
+
+  static std::vector<Vector> Inputs() {
+    auto normals = MakeInputs<Vector>(kCount, 1);
+    for (std::size_t i = 0; i < normals.size(); ++i) {
+      // Half of them below the equator so the fold is taken.
+      normals[i] -= Vector{2.5f, 2.5f, i % 2 == 0 ? 2.5f : 0.0f};
+      normals[i].Normalize();
+    }
+    return normals;
+  }
+
+  static Packed Encode(const Vector& v) {
+    return dlm::vector::EncodeOctahedral(v);
+  }
+  static Vector Decode(Packed p) { return dlm::vector::DecodeOctahedral(p); }
+  static void Encode(dlm::Span<const Vector> in, dlm::Span<Packed> out) {
+    dlm::vector::EncodeOctahedral(in, out);
+  }
+  static void Decode(dlm::Span<const Packed> in, dlm::Span<Vector> out) {
+    dlm::vector::DecodeOctahedral(in, out);
+  }
+};
+
+struct Packed1010102 {
+  using Vector = dlm::vector::Vector4F;
+  using Packed = dlm::vector::PackedVector4;
+
+  static const char* Name() { return "Vector4<float>/1010102"; }
+
+  static std::vector<Vector> Inputs() {
+    auto vectors = MakeInputs<Vector>(kCount, 1);
+    for (auto& v : vectors) {
+      v = (v - 2.5f) * 0.5f;
+    }
+    return vectors;
+  }
+
+  static Packed Encode(const Vector& v) {
+    return dlm::vector::Encode1010102(v);
+  }
+  static Vector Decode(Packed p) { return dlm::vector::Decode1010102(p); }
+  static void Encode(dlm::Span<const Vector> in, dlm::Span<Packed> out) {
+    dlm::vector::Encode1010102(in, out);
+  }
+  static void Decode(dlm::Span<const Packed> in, dlm::Span<Vector> out) {
+    dlm::vector::Decode1010102(in, out);
+  }
+};
+
+struct Quantized {
+  using Vector = dlm::vector::Vector3F;
+  using Packed = dlm::vector::QuantizedPosition;
+
+  static const char* Name() { return "Vector3<float>/Quantized"; }
+
+  static std::vector<Vector> Inputs() { return MakeInputs<Vector>(kCount, 1); }
+
+  static const dlm::vector::PositionQuantizer& Quantizer() {
+    static const dlm::vector::PositionQuantizer quantizer{
+        {0.5f, 0.5f, 0.5f}, {4.5f, 4.5f, 4.5f}};
+    return quantizer;
+  }
+
+  static Packed Encode(const Vector& v) { return Quantizer().Encode(v); }
+  static Vector Decode(Packed p) { return Quantizer().Decode(p); }
+  static void Encode(dlm::Span<const Vector> in, dlm::Span<Packed> out) {
+    Quantizer().Encode(in, out);
+  }
+  static void Decode(dlm::Span<const Packed> in, dlm::Span<Vector> out) {
+    Quantizer().Decode(in, out);
+  }
+};
+
+template <typename Codec>
+std::vector<typename Codec::Packed> PackedInputs() {
+  const auto in = Codec::Inputs();
+  std::vector<typename Codec::Packed> packed(in.size());
+  Codec::Encode(dlm::Span<const typename Codec::Vector>{in},
+                dlm::Span<typename Codec::Packed>{packed});
+  return packed;
+}
+
+// Encode and decode kCount vectors one at a time against the span kernels.
+template <typename Codec>
+void BM_EncodeLoop(benchmark::State& state) {
+  const auto in = Codec::Inputs();
+  std::vector<typename Codec::Packed> out(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      out[i] = Codec::Encode(in[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename Codec>
+void BM_EncodeSpan(benchmark::State& state) {
+  const auto in = Codec::Inputs();
+  std::vector<typename Codec::Packed> out(kCount);
+
+  for (auto _ : state) {
+    Codec::Encode(dlm::Span<const typename Codec::Vector>{in},
+                  dlm::Span<typename Codec::Packed>{out});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename Codec>
+void BM_DecodeLoop(benchmark::State& state) {
+  const auto in = PackedInputs<Codec>();
+  std::vector<typename Codec::Vector> out(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      out[i] = Codec::Decode(in[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename Codec>
+void BM_DecodeSpan(benchmark::State& state) {
+  const auto in = PackedInputs<Codec>();
+  std::vector<typename Codec::Vector> out(kCount);
+
+  for (auto _ : state) {
+    Codec::Decode(dlm::Span<const typename Codec::Packed>{in},
+                  dlm::Span<typename Codec::Vector>{out});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename Codec>
+void RegisterCodecBenchmarks() {
+  const std::string name = std::string{Codec::Name()} + "/";
+  benchmark::RegisterBenchmark((name + "Encode/loop").c_str(),
+                               BM_EncodeLoop<Codec>);
+  benchmark::RegisterBenchmark((name + "Encode/span").c_str(),
+                               BM_EncodeSpan<Codec>);
+  benchmark::RegisterBenchmark((name + "Decode/loop").c_str(),
+                               BM_DecodeLoop<Codec>);
+  benchmark::RegisterBenchmark((name + "Decode/span").c_str(),
+                               BM_DecodeSpan<Codec>);
+}
+
+const bool kRegistered = [] {
+  RegisterCodecBenchmarks<Octahedral>();
+  RegisterCodecBenchmarks<Packed1010102>();
+  RegisterCodecBenchmarks<Quantized>();
+  return true;
+}();
+
+}  // namespace
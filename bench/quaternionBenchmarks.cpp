@@ -0,0 +1,120 @@
+#include <cmath>
+
+#include "benchmarkhelpers.hpp"
+
+namespace {
+
+using dlm::bench::RegisterBinary;
+using dlm::bench::RegisterUnary;
+
+// Textbook slerp with acos and sin, the baseline for the polynomial Slerp.
+template <typename T>
+dlm::Quaternion<T> SlerpTrigonometric(const dlm::Quaternion<T>& q1,
+                                      dlm::Quaternion<T> q2, T t) {
+  T cos_angle = q1 | q2;
+  if (cos_angle < static_cast<T>(0)) {
+    q2 = -q2;
+    cos_angle = -cos_angle;
+  }
+  const T angle = std::acos(std::fmin(cos_angle, static_cast<T>(1)));
+  const T sin_angle = std::sin(angle);
+  if (sin_angle < static_cast<T>(1e-6)) {
+    return dlm::Nlerp(q1, q2, t);
+  }
+  return q1 * (std::sin((static_cast<T>(1) - t) * angle) / sin_angle) +
+         q2 * (std::sin(t * angle) / sin_angle);
+}
+
+template <typename T>
+void BM_RotateScalar(benchmark::State& state) {
+  using V = dlm::vector::Vector3<T>;
+  const auto points = dlm::bench::MakeInputs<V>(dlm::bench::kCount, 1);
+  const auto q = dlm::bench::MakeInputs<dlm::Quaternion<T>>(1, 2)[0];
+  std::vector<V> out(dlm::bench::kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      out[i] = q.Rotate(points[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          dlm::bench::kCount);
+}
+
+template <typename T>
+void BM_RotateSpan(benchmark::State& state) {
+  using V = dlm::vector::Vector3<T>;
+  const auto points = dlm::bench::MakeInputs<V>(dlm::bench::kCount, 1);
+  const auto q = dlm::bench::MakeInputs<dlm::Quaternion<T>>(1, 2)[0];
+  std::vector<V> out(dlm::bench::kCount);
+
+  for (auto _ : state) {
+    dlm::Rotate(q, dlm::Span<const V>{points}, dlm::Span<V>{out});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          dlm::bench::kCount);
+}
+
+template <typename T>
+void BM_RotateBatch(benchmark::State& state) {
+  using V = dlm::vector::Vector3<T>;
+  const auto inputs = dlm::bench::MakeInputs<V>(dlm::bench::kCount, 1);
+  const dlm::vector::Vector3Batch<T> points{dlm::Span<const V>{inputs}};
+  const auto q = dlm::bench::MakeInputs<dlm::Quaternion<T>>(1, 2)[0];
+  dlm::vector::Vector3Batch<T> out{dlm::bench::kCount};
+
+  for (auto _ : state) {
+    dlm::Rotate(q, points, out);
+    benchmark::DoNotOptimize(out.X());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          dlm::bench::kCount);
+}
+
+template <typename T>
+void RegisterQuaternionBenchmarks() {
+  using Q = dlm::Quaternion<T>;
+  const T t = static_cast<T>(0.3);
+
+  RegisterBinary<Q>("operator*(quaternion)",
+                    [](const Q& a, const Q& b) { return a * b; });
+  RegisterUnary<Q>("Conjugate", [](const Q& a) { return a.Conjugate(); });
+  RegisterUnary<Q>("Inverse", [](const Q& a) { return a.Inverse(); });
+  RegisterUnary<Q>("ToMatrix", [](const Q& a) { return a.ToMatrix(); });
+  const dlm::vector::Vector3<T> v{static_cast<T>(1.5), static_cast<T>(-2),
+                                  static_cast<T>(0.5)};
+  RegisterUnary<Q>("Rotate", [v](const Q& a) { return a.Rotate(v); });
+
+  RegisterBinary<Q>("Nlerp", [t](const Q& a, const Q& b) {
+    return dlm::Nlerp(a, b, t);
+  });
+  RegisterBinary<Q>("Slerp/polynomial", [t](const Q& a, const Q& b) {
+    return dlm::Slerp(a, b, t);
+  });
+  RegisterBinary<Q>("Slerp/trigonometric", [t](const Q& a, const Q& b) {
+    return SlerpTrigonometric(a, b, t);
+  });
+
+  benchmark::RegisterBenchmark(dlm::bench::Name<Q>("Rotate/scalar").c_str(),
+                               BM_RotateScalar<T>);
+  benchmark::RegisterBenchmark(dlm::bench::Name<Q>("Rotate/span").c_str(),
+                               BM_RotateSpan<T>);
+  benchmark::RegisterBenchmark(dlm::bench::Name<Q>("Rotate/batch").c_str(),
+                               BM_RotateBatch<T>);
+}
+
+const bool kRegistered = [] {
+  RegisterQuaternionBenchmarks<float>();
+  RegisterQuaternionBenchmarks<double>();
+  return true;
+}();
+
+}  // namespace
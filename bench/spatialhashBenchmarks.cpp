@@ -0,0 +1,123 @@
+#include <vector>
+
+#include "benchmarkhelpers.hpp"
+#include "dlm/spatialhash.hpp"
+
+namespace {
+
+using dlm::bench::kCount;
+using dlm::geometry::SpatialHash3F;
+using dlm::vector::Vector3F;
+
+// A quarter million agents in a 64 x 64 x 64 box, about 33 within the
+// radius 2 of the queries.
+constexpr std::size_t kAgents = 1u << 18;
+constexpr float kSide = 64.0f;
+constexpr float kRadius = 2.0f;
+
+const std::vector<Vector3F>& Agents() {
+  static const std::vector<Vector3F> agents = [] {
+    const auto inputs = dlm::bench::MakeInputs<Vector3F>(kAgents, 1);
+    std::vector<Vector3F> scaled(kAgents);
+    for (std::size_t i = 0; i < kAgents; ++i) {
+      scaled[i] = (inputs[i] - 0.5f) * (0.25f * kSide);
+    }
+    return scaled;
+  }();
+  return agents;
+}
+
+const SpatialHash3F& AgentHash() {
+  static const SpatialHash3F hash = [] {
+    SpatialHash3F built{kRadius};
+    built.Build(dlm::Span<const Vector3F>{Agents()});
+    return built;
+  }();
+  return hash;
+}
+
+// Agents themselves, the neighbor lookup of one simulation tick.
+dlm::Span<const Vector3F> Queries() {
+  return dlm::Span<const Vector3F>{Agents()}.subspan(0, kCount);
+}
+
+void BM_Build(benchmark::State& state) {
+  const dlm::Span<const Vector3F> agents{Agents()};
+  SpatialHash3F hash{kRadius};
+
+  for (auto _ : state) {
+    hash.Build(agents, static_cast<std::size_t>(state.range(0)));
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(agents.size()));
+}
+
+// Every agent tested against the query, what a lookup costs without the
+// grid.
+void BM_BruteForce(benchmark::State& state) {
+  const dlm::Span<const Vector3F> agents{Agents()};
+  std::vector<float> distances(agents.size());
+
+  for (auto _ : state) {
+    dlm::vector::DistanceSquared(agents, Queries()[0],
+                                 dlm::Span<float>{distances});
+    std::size_t count = 0;
+    for (float distance : distances) {
+      count += distance <= kRadius * kRadius;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+void BM_Within(benchmark::State& state) {
+  const SpatialHash3F& hash = AgentHash();
+  std::vector<std::size_t> found;
+
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (const auto& query : Queries()) {
+      hash.Within(query, kRadius, found);
+      count += found.size();
+    }
+    benchmark::DoNotOptimize(count);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+void BM_KNearest(benchmark::State& state) {
+  const SpatialHash3F& hash = AgentHash();
+  std::vector<std::size_t> nearest(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    for (const auto& query : Queries()) {
+      hash.KNearest(query, dlm::Span<std::size_t>{nearest});
+    }
+    benchmark::DoNotOptimize(nearest.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+const bool kRegistered = [] {
+  benchmark::RegisterBenchmark("SpatialHash/Vector3<float>/Build", BM_Build)
+      ->Arg(1)
+      ->Arg(0)
+      ->Unit(benchmark::kMillisecond);
+  benchmark::RegisterBenchmark("SpatialHash/Vector3<float>/BruteForce",
+                               BM_BruteForce)
+      ->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("SpatialHash/Vector3<float>/Within", BM_Within);
+  benchmark::RegisterBenchmark("SpatialHash/Vector3<float>/KNearest",
+                               BM_KNearest)
+      ->Arg(1)
+      ->Arg(8);
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,164 @@
+#include <algorithm>
+
+#include "benchmarkhelpers.hpp"
+#include "dlm/fixed.hpp"
+#include "dlm/half.hpp"
+
+namespace {
+
+using dlm::bench::kCount;
+using dlm::bench::MakeInputs;
+
+// Large enough to leave the caches, the buffers are memory bound.
+constexpr std::size_t kLargeCount = std::size_t{1} << 21;
+constexpr std::size_t kBlock = 256;
+
+template <typename S>
+std::string StorageName();
+
+template <>
+std::string StorageName<dlm::Half>() {
+  return "Half";
+}
+
+template <>
+std::string StorageName<dlm::Fixed>() {
+  return "Fixed";
+}
+
+// count packed copies of the benchmark inputs.
+template <typename S>
+std::vector<dlm::vector::Vector3<S>> MakePacked(std::size_t count) {
+  const auto floats = MakeInputs<dlm::vector::Vector3F>(count, 1);
+  std::vector<dlm::vector::Vector3<S>> packed(count);
+  dlm::vector::Pack(dlm::Span<const dlm::vector::Vector3F>{floats},
+                    dlm::Span<dlm::vector::Vector3<S>>{packed});
+  return packed;
+}
+
+// Pack and unpack kCount Vector3F one vector at a time against the span
+// kernels.
+template <typename S>
+void BM_PackLoop(benchmark::State& state) {
+  const auto in = MakeInputs<dlm::vector::Vector3F>(kCount, 1);
+  std::vector<dlm::vector::Vector3<S>> out(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      out[i] = dlm::vector::Convert<S>(in[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename S>
+void BM_PackSpan(benchmark::State& state) {
+  const auto in = MakeInputs<dlm::vector::Vector3F>(kCount, 1);
+  std::vector<dlm::vector::Vector3<S>> out(kCount);
+
+  for (auto _ : state) {
+    dlm::vector::Pack(dlm::Span<const dlm::vector::Vector3F>{in},
+                      dlm::Span<dlm::vector::Vector3<S>>{out});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename S>
+void BM_UnpackLoop(benchmark::State& state) {
+  const auto in = MakePacked<S>(kCount);
+  std::vector<dlm::vector::Vector3F> out(kCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      out[i] = dlm::vector::Convert<float>(in[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+template <typename S>
+void BM_UnpackSpan(benchmark::State& state) {
+  const auto in = MakePacked<S>(kCount);
+  std::vector<dlm::vector::Vector3F> out(kCount);
+
+  for (auto _ : state) {
+    dlm::vector::Unpack(dlm::Span<const dlm::vector::Vector3<S>>{in},
+                        dlm::Span<dlm::vector::Vector3F>{out});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kCount);
+}
+
+// A memory bound stage: the centroid of kLargeCount positions, read as
+// floats against unpacked block by block from the compact storage.
+void BM_CentroidFloat(benchmark::State& state) {
+  const auto positions = MakeInputs<dlm::vector::Vector3F>(kLargeCount, 1);
+
+  for (auto _ : state) {
+    dlm::vector::Vector3F sum;
+    for (const auto& position : positions) {
+      sum += position;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          kLargeCount * sizeof(dlm::vector::Vector3F));
+}
+
+template <typename S>
+void BM_CentroidPacked(benchmark::State& state) {
+  const auto positions = MakePacked<S>(kLargeCount);
+  dlm::vector::Vector3F block[kBlock];
+
+  for (auto _ : state) {
+    dlm::vector::Vector3F sum;
+    for (std::size_t i = 0; i < kLargeCount; i += kBlock) {
+      const std::size_t count = std::min(kBlock, kLargeCount - i);
+      dlm::vector::Unpack(
+          dlm::Span<const dlm::vector::Vector3<S>>{positions.data() + i,
+                                                   count},
+          dlm::Span<dlm::vector::Vector3F>{block});
+      for (std::size_t j = 0; j < count; ++j) {
+        sum += block[j];
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          kLargeCount * sizeof(dlm::vector::Vector3<S>));
+}
+
+template <typename S>
+void RegisterStorageBenchmarks() {
+  const std::string name = "Vector3<" + StorageName<S>() + ">/";
+  benchmark::RegisterBenchmark((name + "Pack/loop").c_str(), BM_PackLoop<S>);
+  benchmark::RegisterBenchmark((name + "Pack/span").c_str(), BM_PackSpan<S>);
+  benchmark::RegisterBenchmark((name + "Unpack/loop").c_str(),
+                               BM_UnpackLoop<S>);
+  benchmark::RegisterBenchmark((name + "Unpack/span").c_str(),
+                               BM_UnpackSpan<S>);
+  benchmark::RegisterBenchmark((name + "Centroid").c_str(),
+                               BM_CentroidPacked<S>);
+}
+
+const bool kRegistered = [] {
+  benchmark::RegisterBenchmark("Vector3<float>/Centroid", BM_CentroidFloat);
+  RegisterStorageBenchmarks<dlm::Half>();
+  RegisterStorageBenchmarks<dlm::Fixed>();
+  return true;
+}();
+
+}  // namespace
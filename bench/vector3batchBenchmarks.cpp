@@ -0,0 +1,126 @@
+#include "benchmarkhelpers.hpp"
+#include "dlm/fastnormalize.hpp"
+#include "dlm/geometricfunctions.hpp"
+#include "dlm/vector3batch.hpp"
+
+namespace {
+
+constexpr std::size_t kBatchCount = 1 << 16;
+
+// Array of structs: the scalar operation applied to every Vector3<T>.
+template <typename T, typename Operation>
+void BM_ScalarLoop(benchmark::State& state, Operation operation) {
+  using V = dlm::vector::Vector3<T>;
+  const auto a = dlm::bench::MakeInputs<V>(kBatchCount, 1);
+  const auto b = dlm::bench::MakeInputs<V>(kBatchCount, 2);
+  std::vector<decltype(operation(a[0], b[0]))> out(kBatchCount);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kBatchCount; ++i) {
+      out[i] = operation(a[i], b[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          kBatchCount);
+}
+
+// Structure of arrays: the batch function over a Vector3Batch<T>. Out is
+// either a Vector3Batch<T> or a std::vector<T>.
+template <typename T, typename Out, typename Operation>
+void BM_Batch(benchmark::State& state, Operation operation) {
+  using V = dlm::vector::Vector3<T>;
+  const auto a_vectors = dlm::bench::MakeInputs<V>(kBatchCount, 1);
+  const auto b_vectors = dlm::bench::MakeInputs<V>(kBatchCount, 2);
+  const dlm::vector::Vector3Batch<T> a{a_vectors};
+  const dlm::vector::Vector3Batch<T> b{b_vectors};
+  Out out(kBatchCount);
+
+  for (auto _ : state) {
+    operation(a, b, out);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          kBatchCount);
+}
+
+template <typename T, typename Operation>
+void RegisterScalar(const std::string& name, Operation operation) {
+  benchmark::RegisterBenchmark(
+      ("Vector3<" + dlm::bench::TypeName<T>() + ">/scalar/" + name).c_str(),
+      BM_ScalarLoop<T, Operation>, operation);
+}
+
+template <typename T, typename Out, typename Operation>
+void RegisterBatch(const std::string& name, Operation operation) {
+  benchmark::RegisterBenchmark(
+      ("Vector3<" + dlm::bench::TypeName<T>() + ">/batch/" + name).c_str(),
+      BM_Batch<T, Out, Operation>, operation);
+}
+
+template <typename T>
+void RegisterAll() {
+  using V = dlm::vector::Vector3<T>;
+  using Batch = dlm::vector::Vector3Batch<T>;
+  using Scalars = std::vector<T>;
+  const T s = static_cast<T>(1.5);
+
+  RegisterScalar<T>("Add", [](const V& a, const V& b) { return a + b; });
+  RegisterScalar<T>("Subtract", [](const V& a, const V& b) { return a - b; });
+  RegisterScalar<T>("Scale", [s](const V& a, const V&) { return a * s; });
+  RegisterScalar<T>("Dot", [](const V& a, const V& b) { return a | b; });
+  RegisterScalar<T>("Cross", [](const V& a, const V& b) { return a ^ b; });
+  RegisterScalar<T>("Length", [](const V& a, const V&) { return a.Length(); });
+  RegisterScalar<T>("Normalize", [](const V& a, const V&) {
+    return dlm::vector::Normalize(a);
+  });
+  RegisterScalar<T>("Distance",
+                    [](const V& a, const V& b) { return (a - b).Length(); });
+  RegisterScalar<T>("Project", [](const V& a, const V& b) {
+    return dlm::vector::Project(a, b);
+  });
+
+  RegisterBatch<T, Batch>("Add", [](const Batch& a, const Batch& b,
+                                    Batch& out) { Add(a, b, out); });
+  RegisterBatch<T, Batch>("Subtract", [](const Batch& a, const Batch& b,
+                                         Batch& out) { Subtract(a, b, out); });
+  RegisterBatch<T, Batch>("Scale", [s](const Batch& a, const Batch&,
+                                       Batch& out) { Scale(a, s, out); });
+  RegisterBatch<T, Scalars>(
+      "Dot", [](const Batch& a, const Batch& b, Scalars& out) {
+        Dot(a, b, dlm::Span<T>{out});
+      });
+  RegisterBatch<T, Batch>("Cross", [](const Batch& a, const Batch& b,
+                                      Batch& out) { Cross(a, b, out); });
+  RegisterBatch<T, Scalars>(
+      "Length", [](const Batch& a, const Batch&, Scalars& out) {
+        Length(a, dlm::Span<T>{out});
+      });
+  RegisterBatch<T, Batch>("Normalize", [](const Batch& a, const Batch&,
+                                          Batch& out) { Normalize(a, out); });
+  RegisterBatch<T, Batch>(
+      "FastNormalize/Refined", [](const Batch& a, const Batch&, Batch& out) {
+        dlm::vector::FastNormalize<dlm::vector::precision::Refined>(a, out);
+      });
+  RegisterBatch<T, Batch>(
+      "FastNormalize/Estimate", [](const Batch& a, const Batch&, Batch& out) {
+        dlm::vector::FastNormalize<dlm::vector::precision::Estimate>(a, out);
+      });
+  RegisterBatch<T, Scalars>(
+      "Distance", [](const Batch& a, const Batch& b, Scalars& out) {
+        Distance(a, b, dlm::Span<T>{out});
+      });
+  RegisterBatch<T, Batch>("Project", [](const Batch& a, const Batch& b,
+                                        Batch& out) { Project(a, b, out); });
+}
+
+const bool kRegistered = [] {
+  RegisterAll<float>();
+  RegisterAll<double>();
+  return true;
+}();
+
+}  // namespace
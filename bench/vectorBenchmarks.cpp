@@ -0,0 +1,93 @@
+#include "benchmarkhelpers.hpp"
+
+namespace {
+
+using dlm::bench::RegisterBinary;
+using dlm::bench::RegisterUnary;
+
+// Registers every member operator and helper shared by Vector2/3/4.
+template <typename V>
+void RegisterVectorBenchmarks() {
+  using T = typename V::ValueType;
+  const T s = static_cast<T>(1.5);
+
+  RegisterUnary<V>("operator-", [](const V& a) { return -a; });
+  RegisterUnary<V>("operator-(scalar)", [s](const V& a) { return a - s; });
+  RegisterBinary<V>("operator-(vector)",
+                    [](const V& a, const V& b) { return a - b; });
+  RegisterUnary<V>("operator-=(scalar)", [s](V a) { return a -= s; });
+  RegisterBinary<V>("operator-=(vector)",
+                    [](V a, const V& b) { return a -= b; });
+
+  RegisterUnary<V>("operator+(scalar)", [s](const V& a) { return a + s; });
+  RegisterBinary<V>("operator+(vector)",
+                    [](const V& a, const V& b) { return a + b; });
+  RegisterUnary<V>("operator+=(scalar)", [s](V a) { return a += s; });
+  RegisterBinary<V>("operator+=(vector)",
+                    [](V a, const V& b) { return a += b; });
+
+  RegisterUnary<V>("operator*(scalar)", [s](const V& a) { return a * s; });
+  RegisterBinary<V>("operator*(vector)",
+                    [](const V& a, const V& b) { return a * b; });
+  RegisterUnary<V>("operator*=(scalar)", [s](V a) { return a *= s; });
+  RegisterBinary<V>("operator*=(vector)",
+                    [](V a, const V& b) { return a *= b; });
+
+  RegisterUnary<V>("operator/(scalar)", [s](const V& a) { return a / s; });
+  RegisterBinary<V>("operator/(vector)",
+                    [](const V& a, const V& b) { return a / b; });
+  RegisterUnary<V>("operator/=(scalar)", [s](V a) { return a /= s; });
+  RegisterBinary<V>("operator/=(vector)",
+                    [](V a, const V& b) { return a /= b; });
+
+  RegisterUnary<V>("operator[]", [](const V& a) { return a[1]; });
+  RegisterBinary<V>("operator|", [](const V& a, const V& b) { return a | b; });
+
+  RegisterBinary<V>("operator==",
+                    [](const V& a, const V& b) { return a == b; });
+  RegisterBinary<V>("operator!=",
+                    [](const V& a, const V& b) { return a != b; });
+  RegisterBinary<V>("operator<",
+                    [](const V& a, const V& b) { return a < b; });
+  RegisterBinary<V>("operator<=",
+                    [](const V& a, const V& b) { return a <= b; });
+  RegisterBinary<V>("operator>",
+                    [](const V& a, const V& b) { return a > b; });
+  RegisterBinary<V>("operator>=",
+                    [](const V& a, const V& b) { return a >= b; });
+
+  RegisterUnary<V>("Zero", [](V a) {
+    a.Zero();
+    return a;
+  });
+  RegisterUnary<V>("IsZero", [](const V& a) { return a.IsZero(); });
+  RegisterUnary<V>("Component", [](const V& a) { return a.Component(1); });
+  RegisterBinary<V>("Equals",
+                    [s](const V& a, const V& b) { return a.Equals(b, s); });
+  RegisterUnary<V>("Normalize", [](V a) {
+    a.Normalize();
+    return a;
+  });
+  RegisterUnary<V>("Length", [](const V& a) { return a.Length(); });
+  RegisterUnary<V>("LengthSquared",
+                   [](const V& a) { return a.LengthSquared(); });
+}
+
+template <typename T>
+void RegisterAll() {
+  RegisterVectorBenchmarks<dlm::vector::Vector2<T>>();
+  RegisterVectorBenchmarks<dlm::vector::Vector3<T>>();
+  RegisterVectorBenchmarks<dlm::vector::Vector4<T>>();
+
+  using V3 = dlm::vector::Vector3<T>;
+  RegisterBinary<V3>("operator^",
+                     [](const V3& a, const V3& b) { return a ^ b; });
+}
+
+const bool kRegistered = [] {
+  RegisterAll<float>();
+  RegisterAll<double>();
+  return true;
+}();
+
+}  // namespace
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "dlm/config.hpp"
+#include "dlm/parallel.hpp"
+#include "dlm/simd.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector.hpp"
+#include "dlm/vector2.hpp"
+#include "dlm/vector3.hpp"
+
+namespace dlm {
+namespace geometry {
+
+// Axis-aligned bounding box of Vector2 or Vector3 points, the points p with
+// min <= p <= max in every component. The box is closed, points on a face
+// are inside and boxes sharing a face overlap. A box with min > max in any
+// component is empty, Empty() is the one that every Merge replaces.
+template <typename vector_type>
+struct AABB {
+  using VectorType = vector_type;
+  using ValueType = typename vector_type::ValueType;
+
+  static_assert(vector_type::kSize == 2 || vector_type::kSize == 3,
+                "AABB supports Vector2 and Vector3");
+
+  // Empty box.
+  constexpr AABB() : min{Empty().min}, max{Empty().max} {};
+  constexpr AABB(const vector_type& min, const vector_type& max)
+      : min{min}, max{max} {};
+
+  // min at the largest value and max at the smallest.
+  static constexpr AABB Empty();
+
+  constexpr bool IsEmpty() const;
+
+  constexpr vector_type Center() const;
+  constexpr vector_type Size() const;
+
+  constexpr bool Contains(const vector_type& point) const;
+  constexpr bool Contains(const AABB& box) const;
+  constexpr bool Overlaps(const AABB& box) const;
+
+  // Grows the box to include point or box.
+  constexpr AABB& Merge(const vector_type& point);
+  constexpr AABB& Merge(const AABB& box);
+
+  constexpr bool operator==(const AABB& box) const;
+  constexpr bool operator!=(const AABB& box) const;
+
+  vector_type min;
+  vector_type max;
+};
+
+template <typename T>
+using AABB2 = AABB<vector::Vector2<T>>;
+template <typename T>
+using AABB3 = AABB<vector::Vector3<T>>;
+
+using AABB2F = AABB2<float>;
+using AABB3F = AABB3<float>;
+
+static_assert(sizeof(AABB3F) == 6 * sizeof(float));
+
+template <typename vector_type>
+constexpr AABB<vector_type> AABB<vector_type>::Empty() {
+  using T = ValueType;
+  constexpr T kLargest = std::numeric_limits<T>::has_infinity
+                             ? std::numeric_limits<T>::infinity()
+                             : std::numeric_limits<T>::max();
+  constexpr T kSmallest = std::numeric_limits<T>::has_infinity
+                              ? -std::numeric_limits<T>::infinity()
+                              : std::numeric_limits<T>::lowest();
+  vector_type min;
+  vector_type max;
+  for (int c = 0; c < static_cast<int>(vector_type::kSize); ++c) {
+    min[c] = kLargest;
+    max[c] = kSmallest;
+  }
+  return {min, max};
+}
+
+template <typename vector_type>
+constexpr bool AABB<vector_type>::IsEmpty() const {
+  return !(min <= max);
+}
+
+template <typename vector_type>
+constexpr vector_type AABB<vector_type>::Center() const {
+  return (min + max) * static_cast<ValueType>(0.5);
+}
+
+template <typename vector_type>
+constexpr vector_type AABB<vector_type>::Size() const {
+  return max - min;
+}
+
+template <typename vector_type>
+constexpr bool AABB<vector_type>::Contains(const vector_type& point) const {
+  return min <= point && point <= max;
+}
+
+template <typename vector_type>
+constexpr bool AABB<vector_type>::Contains(const AABB& box) const {
+  return min <= box.min && box.max <= max;
+}
+
+template <typename vector_type>
+constexpr bool AABB<vector_type>::Overlaps(const AABB& box) const {
+  return min <= box.max && box.min <= max;
+}
+
+// The argument goes first so a NaN component in it keeps the current bound.
+template <typename vector_type>
+constexpr AABB<vector_type>& AABB<vector_type>::Merge(
+    const vector_type& point) {
+  min = vector::Min(point, min);
+  max = vector::Max(point, max);
+  return *this;
+}
+
+template <typename vector_type>
+constexpr AABB<vector_type>& AABB<vector_type>::Merge(const AABB& box) {
+  min = vector::Min(box.min, min);
+  max = vector::Max(box.max, max);
+  return *this;
+}
+
+template <typename vector_type>
+constexpr bool AABB<vector_type>::operator==(const AABB& box) const {
+  return min == box.min && max == box.max;
+}
+
+template <typename vector_type>
+constexpr bool AABB<vector_type>::operator!=(const AABB& box) const {
+  return !(*this == box);
+}
+
+template <typename vector_type>
+constexpr AABB<vector_type> Merge(AABB<vector_type> a,
+                                  const AABB<vector_type>& b) {
+  return a.Merge(b);
+}
+
+template <typename vector_type>
+constexpr AABB<vector_type> Merge(AABB<vector_type> box,
+                                  const vector_type& point) {
+  return box.Merge(point);
+}
+
+template <typename vector_type>
+constexpr bool Overlaps(const AABB<vector_type>& a,
+                        const AABB<vector_type>& b) {
+  return a.Overlaps(b);
+}
+
+template <typename vector_type>
+constexpr bool Contains(const AABB<vector_type>& box,
+                        const vector_type& point) {
+  return box.Contains(point);
+}
+
+namespace detail {
+#if defined(DLM_SSE2)
+// Elements of floats floats stored back to back line up with the 4 float
+// registers again every PeriodRegisters(floats) registers.
+constexpr std::size_t PeriodRegisters(std::size_t floats) {
+  return floats % 4 == 0 ? floats / 4 : floats % 2 == 0 ? floats / 2 : floats;
+}
+
+// Whole periods adding up to at least 4 registers, enough independent
+// chains to hide the latency of minps and maxps.
+constexpr std::size_t BlockRegisters(std::size_t floats) {
+  return PeriodRegisters(floats) * ((PeriodRegisters(floats) + 3) /
+                                    PeriodRegisters(floats));
+}
+
+// Splits values into blocks of kRegisters registers and writes the
+// smallest and largest float at every position of a block to minimum and
+// maximum. NaN is skipped, positions that only saw NaN keep +-infinity.
+template <std::size_t kRegisters>
+void BlockMinMax(const float* values, std::size_t blocks,
+                  float (&minimum)[4 * kRegisters],
+                  float (&maximum)[4 * kRegisters]) {
+  __m128 low[kRegisters];
+  __m128 high[kRegisters];
+  simd::Unroll<kRegisters>([&](std::size_t r) {
+    low[r] = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    high[r] = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+  });
+  for (std::size_t block = 0; block < blocks; ++block) {
+    const float* block_values = values + block * 4 * kRegisters;
+    simd::Unroll<kRegisters>([&](std::size_t r) {
+      const __m128 v = _mm_loadu_ps(block_values + 4 * r);
+      // minps and maxps return the second operand for NaN.
+      low[r] = _mm_min_ps(v, low[r]);
+      high[r] = _mm_max_ps(v, high[r]);
+    });
+  }
+  simd::Unroll<kRegisters>([&](std::size_t r) {
+    _mm_storeu_ps(minimum + 4 * r, low[r]);
+    _mm_storeu_ps(maximum + 4 * r, high[r]);
+  });
+}
+#endif
+
+// Bounds of points on the calling thread.
+template <std::size_t N, typename T>
+AABB<vector::Vector<N, T>> Bounds(Span<const vector::Vector<N, T>> points) {
+  auto bounds = AABB<vector::Vector<N, T>>::Empty();
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    // No transpose, position p of a block always holds component p % N.
+    constexpr std::size_t kRegisters = detail::BlockRegisters(N);
+    constexpr std::size_t kPerBlock = 4 * kRegisters / N;
+    float minimum[4 * kRegisters];
+    float maximum[4 * kRegisters];
+    detail::BlockMinMax<kRegisters>(
+        reinterpret_cast<const float*>(points.data()),
+        points.size() / kPerBlock, minimum, maximum);
+    for (std::size_t p = 0; p < 4 * kRegisters; ++p) {
+      const int c = static_cast<int>(p % N);
+      bounds.min[c] = minimum[p] < bounds.min[c] ? minimum[p] : bounds.min[c];
+      bounds.max[c] = maximum[p] > bounds.max[c] ? maximum[p] : bounds.max[c];
+    }
+    i = points.size() / kPerBlock * kPerBlock;
+  }
+#endif
+  for (; i < points.size(); ++i) {
+    bounds.Merge(points[i]);
+  }
+  return bounds;
+}
+}  // namespace detail
+
+// Smallest box holding every element of points, Empty() for no points.
+// Components that are NaN are ignored. The points are split into contiguous
+// chunks over up to threads threads, 0 uses one per hardware thread, and
+// the chunk boxes merged. Small inputs run on the calling thread.
+template <std::size_t N, typename T>
+AABB<vector::Vector<N, T>> Bounds(Span<const vector::Vector<N, T>> points,
+                                  std::size_t threads = 0) {
+  const std::size_t count = points.size();
+  threads = dlm::detail::ThreadCount(threads, count);
+  if (threads == 1) {
+    return detail::Bounds(points);
+  }
+  std::vector<AABB<vector::Vector<N, T>>> chunks(threads);
+  dlm::detail::ParallelFor(threads, threads, [&](std::size_t t, std::size_t) {
+    const std::size_t begin = count * t / threads;
+    chunks[t] = detail::Bounds(
+        points.subspan(begin, count * (t + 1) / threads - begin));
+  });
+  auto bounds = AABB<vector::Vector<N, T>>::Empty();
+  for (const auto& chunk : chunks) {
+    bounds.Merge(chunk);
+  }
+  return bounds;
+}
+
+// Smallest box holding every element of boxes, Empty() for no boxes.
+template <std::size_t N, typename T>
+AABB<vector::Vector<N, T>> Bounds(
+    Span<const AABB<vector::Vector<N, T>>> boxes) {
+  auto bounds = AABB<vector::Vector<N, T>>::Empty();
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    // A box is N min components followed by N max components.
+    constexpr std::size_t kRegisters = detail::BlockRegisters(2 * N);
+    constexpr std::size_t kPerBlock = 4 * kRegisters / (2 * N);
+    float minimum[4 * kRegisters];
+    float maximum[4 * kRegisters];
+    detail::BlockMinMax<kRegisters>(
+        reinterpret_cast<const float*>(boxes.data()),
+        boxes.size() / kPerBlock, minimum, maximum);
+    for (std::size_t p = 0; p < 4 * kRegisters; ++p) {
+      const int c = static_cast<int>(p % N);
+      if (p % (2 * N) < N) {
+        bounds.min[c] =
+            minimum[p] < bounds.min[c] ? minimum[p] : bounds.min[c];
+      } else {
+        bounds.max[c] =
+            maximum[p] > bounds.max[c] ? maximum[p] : bounds.max[c];
+      }
+    }
+    i = boxes.size() / kPerBlock * kPerBlock;
+  }
+#endif
+  for (; i < boxes.size(); ++i) {
+    bounds.Merge(boxes[i]);
+  }
+  return bounds;
+}
+
+// Sets bit i % 64 of mask[i / 64] when boxes[i] overlaps box, the bits past
+// boxes.size() in the last word are cleared.
+template <std::size_t N, typename T>
+void Overlaps(Span<const AABB<vector::Vector<N, T>>> boxes,
+              const AABB<vector::Vector<N, T>>& box,
+              Span<std::uint64_t> mask) {
+  assert(mask.size() >= (boxes.size() + 63) / 64);
+  const std::size_t count = boxes.size();
+  std::size_t i = 0;
+  std::uint64_t bits = 0;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    // boxes[i].min <= box.max and -boxes[i].max <= -box.min, one compare
+    // per register once the max lanes have their sign flipped. A block of 8
+    // boxes is N groups of 4 registers narrowed to 16 bits each, then every
+    // 2 * N lane bits are reduced to the bit of their box.
+    float signs[16 * N];
+    float limits[16 * N];
+    for (std::size_t p = 0; p < 16 * N; ++p) {
+      const int c = static_cast<int>(p % N);
+      const bool is_min = p % (2 * N) < N;
+      signs[p] = is_min ? 0.0f : -0.0f;
+      limits[p] = is_min ? box.max[c] : -box.min[c];
+    }
+    const float* values = reinterpret_cast<const float*>(boxes.data());
+    for (; i + 8 <= count; i += 8) {
+      std::uint64_t lanes = 0;
+      for (std::size_t g = 0; g < N; ++g) {
+        const std::size_t offset = 16 * g;
+        const auto compare = [&](std::size_t r) {
+          const std::size_t at = offset + 4 * r;
+          return _mm_cmple_ps(
+              _mm_xor_ps(_mm_loadu_ps(values + i * 2 * N + at),
+                         _mm_loadu_ps(signs + at)),
+              _mm_loadu_ps(limits + at));
+        };
+        lanes |= static_cast<std::uint64_t>(simd::Mask16(
+                     compare(0), compare(1), compare(2), compare(3)))
+                 << offset;
+      }
+      std::uint64_t all = lanes;
+      for (std::size_t c = 1; c < 2 * N; ++c) {
+        all &= lanes >> c;
+      }
+      bits |= (simd::CompactEveryNth<2 * N>(all) & 0xFFu) << (i % 64);
+      if ((i + 8) % 64 == 0) {
+        mask[i / 64] = bits;
+        bits = 0;
+      }
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    bits |= static_cast<std::uint64_t>(boxes[i].Overlaps(box)) << (i % 64);
+    if ((i + 1) % 64 == 0) {
+      mask[i / 64] = bits;
+      bits = 0;
+    }
+  }
+  if (count % 64 != 0) {
+    mask[count / 64] = bits;
+  }
+}
+
+}  // namespace geometry
+}  // namespace dlm
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "dlm/config.hpp"
+#include "dlm/matrix2x2.hpp"
+#include "dlm/matrix3x3.hpp"
+#include "dlm/matrix4x4.hpp"
+#include "dlm/quaternion.hpp"
+#include "dlm/simd.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector.hpp"
+
+namespace dlm {
+
+// Approximate comparisons of floating point values, and element-wise of
+// vectors, matrices and quaternions. Every element has to pass.
+//
+// - AbsoluteEqual: |a - b| <= tolerance. Suited to values of a known scale.
+// - RelativeEqual: |a - b| <= tolerance * max(|a|, |b|). Scale invariant,
+//   but only exactly equal values pass near zero.
+// - UlpsEqual: a and b are at most max_ulps representable values apart,
+//   +0 and -0 are the same value. max_ulps is below 2^22.
+//
+// NaN never compares equal. Equal infinities pass UlpsEqual only, their
+// difference is NaN.
+template <typename T>
+constexpr bool AbsoluteEqual(T a, T b, T tolerance) noexcept {
+  static_assert(std::is_floating_point<T>::value);
+  return (a < b ? b - a : a - b) <= tolerance;
+}
+
+template <typename T>
+constexpr bool RelativeEqual(T a, T b, T tolerance) noexcept {
+  static_assert(std::is_floating_point<T>::value);
+  const T abs_a = a < 0 ? -a : a;
+  const T abs_b = b < 0 ? -b : b;
+  const T largest = abs_a < abs_b ? abs_b : abs_a;
+  return (a < b ? b - a : a - b) <= tolerance * largest;
+}
+
+namespace detail {
+template <typename T>
+using UlpsInt =
+    std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+
+// Maps the bits of value to an integer that orders like the value, with
+// consecutive floats one apart and both zeros at 0.
+template <typename T>
+UlpsInt<T> OrderedBits(T value) noexcept {
+  using Int = UlpsInt<T>;
+  static_assert(sizeof(Int) == sizeof(T));
+  Int bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  constexpr Int kMagnitude = ~(Int{1} << (8 * sizeof(Int) - 1));
+  return bits < 0 ? -(bits & kMagnitude) : bits;
+}
+}  // namespace detail
+
+template <typename T>
+bool UlpsEqual(T a, T b, int max_ulps) noexcept {
+  static_assert(std::is_floating_point<T>::value);
+  assert(max_ulps >= 0 && max_ulps < (1 << 22));
+  if (a != a || b != b) {
+    return false;
+  }
+  const auto ordered_a = detail::OrderedBits(a);
+  const auto ordered_b = detail::OrderedBits(b);
+  // Both are at most 2^63 - 1 in magnitude, the difference of the unsigned
+  // values is exact.
+  using Unsigned = std::make_unsigned_t<detail::UlpsInt<T>>;
+  const Unsigned distance =
+      ordered_a < ordered_b
+          ? static_cast<Unsigned>(ordered_b) - static_cast<Unsigned>(ordered_a)
+          : static_cast<Unsigned>(ordered_a) - static_cast<Unsigned>(ordered_b);
+  return distance <= static_cast<Unsigned>(max_ulps);
+}
+
+namespace vector {
+template <std::size_t N, typename T, typename Layout>
+constexpr bool AbsoluteEqual(const Vector<N, T, Layout>& a,
+                             const Vector<N, T, Layout>& b,
+                             T tolerance) noexcept {
+  return a.Equals(b, tolerance);
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr bool RelativeEqual(const Vector<N, T, Layout>& a,
+                             const Vector<N, T, Layout>& b,
+                             T tolerance) noexcept {
+  return detail::All(a, b, [tolerance](const T& x, const T& y) {
+    return dlm::RelativeEqual(x, y, tolerance);
+  });
+}
+
+template <std::size_t N, typename T, typename Layout>
+bool UlpsEqual(const Vector<N, T, Layout>& a,
+               const Vector<N, T, Layout>& b,
+               int max_ulps) noexcept {
+  return detail::All(a, b, [max_ulps](const T& x, const T& y) {
+    return dlm::UlpsEqual(x, y, max_ulps);
+  });
+}
+
+namespace detail {
+// Sets bit i % 64 of mask[i / 64] when equal(a[i], b[i]), the bits past
+// a.size() in the last word are cleared.
+template <typename value_type, typename Equal>
+void CompareToMask(Span<const value_type> a, Span<const value_type> b,
+                   Span<std::uint64_t> mask, Equal equal) {
+  assert(b.size() >= a.size() && mask.size() >= (a.size() + 63) / 64);
+  for (std::size_t word = 0; word * 64 < a.size(); ++word) {
+    const std::size_t begin = word * 64;
+    const std::size_t end = a.size() - begin < 64 ? a.size() : begin + 64;
+    std::uint64_t bits = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+      bits |= static_cast<std::uint64_t>(equal(a[i], b[i])) << (i - begin);
+    }
+    mask[word] = bits;
+  }
+}
+
+#if defined(DLM_SSE2)
+// Bit i of the result is the lane mask of a[i] and b[i], 16 floats.
+template <typename SimdEqual>
+inline std::uint64_t EqualBits16(const float* a, const float* b,
+                                 SimdEqual simd_equal) {
+  return simd::Mask16(simd_equal(_mm_loadu_ps(a), _mm_loadu_ps(b)),
+                      simd_equal(_mm_loadu_ps(a + 4), _mm_loadu_ps(b + 4)),
+                      simd_equal(_mm_loadu_ps(a + 8), _mm_loadu_ps(b + 8)),
+                      simd_equal(_mm_loadu_ps(a + 12), _mm_loadu_ps(b + 12)));
+}
+
+// CompareToMask for Vector<N, float> on the flat component arrays. A block
+// of 16 vectors is N groups of 16 floats, simd_equal maps two registers to
+// a lane mask. The masks are narrowed to one bit per component and every N
+// component bits are reduced to the bit of their vector. The tail uses
+// equal, which has to agree with simd_equal.
+template <std::size_t N, typename SimdEqual, typename Equal>
+void CompareToMask(Span<const vector::Vector<N, float>> a,
+                   Span<const vector::Vector<N, float>> b,
+                   Span<std::uint64_t> mask, SimdEqual simd_equal,
+                   Equal equal) {
+  assert(b.size() >= a.size() && mask.size() >= (a.size() + 63) / 64);
+  const float* a_values = reinterpret_cast<const float*>(a.data());
+  const float* b_values = reinterpret_cast<const float*>(b.data());
+  const std::size_t count = a.size();
+  std::size_t i = 0;
+  std::uint64_t bits = 0;
+  for (; i + 16 <= count; i += 16) {
+    std::uint64_t components = 0;
+    for (std::size_t r = 0; r < N; ++r) {
+      const std::size_t offset = i * N + 16 * r;
+      components |=
+          EqualBits16(a_values + offset, b_values + offset, simd_equal)
+          << (16 * r);
+    }
+    std::uint64_t all = components;
+    for (std::size_t c = 1; c < N; ++c) {
+      all &= components >> c;
+    }
+    bits |= simd::CompactEveryNth<N>(all) << (i % 64);
+    if ((i + 16) % 64 == 0) {
+      mask[i / 64] = bits;
+      bits = 0;
+    }
+  }
+  for (; i < count; ++i) {
+    bits |= static_cast<std::uint64_t>(equal(a[i], b[i])) << (i % 64);
+    if ((i + 1) % 64 == 0) {
+      mask[i / 64] = bits;
+      bits = 0;
+    }
+  }
+  if (count % 64 != 0) {
+    mask[count / 64] = bits;
+  }
+}
+
+inline __m128 AbsoluteEqual(__m128 a, __m128 b, __m128 tolerance) {
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  return _mm_cmple_ps(_mm_andnot_ps(sign, _mm_sub_ps(a, b)), tolerance);
+}
+
+inline __m128 RelativeEqual(__m128 a, __m128 b, __m128 tolerance) {
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 largest =
+      _mm_max_ps(_mm_andnot_ps(sign, a), _mm_andnot_ps(sign, b));
+  return _mm_cmple_ps(_mm_andnot_ps(sign, _mm_sub_ps(a, b)),
+                      _mm_mul_ps(tolerance, largest));
+}
+
+// OrderedBits on four lanes.
+inline __m128i OrderedBits(__m128 value) {
+  const __m128i bits = _mm_castps_si128(value);
+  const __m128i negative = _mm_srai_epi32(bits, 31);
+  const __m128i negated = _mm_sub_epi32(
+      _mm_setzero_si128(),
+      _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF)));
+  return _mm_or_si128(_mm_and_si128(negative, negated),
+                      _mm_andnot_si128(negative, bits));
+}
+
+// The difference of the ordered values wraps around only for values more
+// than 2^31 apart, for non-NaN floats that leaves it above 2^24 in
+// magnitude and max_ulps below 2^22 keeps the check exact.
+inline __m128 UlpsEqual(__m128 a, __m128 b, __m128i max_ulps) {
+  const __m128i difference = _mm_sub_epi32(OrderedBits(a), OrderedBits(b));
+  const __m128i negative = _mm_srai_epi32(difference, 31);
+  const __m128i distance =
+      _mm_sub_epi32(_mm_xor_si128(difference, negative), negative);
+  const __m128i within = _mm_andnot_si128(_mm_cmpgt_epi32(distance, max_ulps),
+                                          _mm_set1_epi32(-1));
+  return _mm_and_ps(_mm_castsi128_ps(within), _mm_cmpord_ps(a, b));
+}
+#endif
+}  // namespace detail
+
+// Span versions for change detection: bit i % 64 of mask[i / 64] is set
+// when a[i] and b[i] compare equal. mask holds at least (a.size() + 63) / 64
+// words, the unused bits of the last word are cleared. Vectors of floats are
+// compared 16 at a time with SSE2.
+template <std::size_t N, typename T>
+void AbsoluteEqual(Span<const Vector<N, T>> a, Span<const Vector<N, T>> b,
+                   T tolerance, Span<std::uint64_t> mask) {
+  const auto equal = [tolerance](const Vector<N, T>& x,
+                                 const Vector<N, T>& y) {
+    return AbsoluteEqual(x, y, tolerance);
+  };
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    const __m128 broadcast = _mm_set1_ps(tolerance);
+    detail::CompareToMask(
+        a, b, mask,
+        [broadcast](__m128 x, __m128 y) {
+          return detail::AbsoluteEqual(x, y, broadcast);
+        },
+        equal);
+    return;
+  }
+#endif
+  detail::CompareToMask(a, b, mask, equal);
+}
+
+template <std::size_t N, typename T>
+void RelativeEqual(Span<const Vector<N, T>> a, Span<const Vector<N, T>> b,
+                   T tolerance, Span<std::uint64_t> mask) {
+  const auto equal = [tolerance](const Vector<N, T>& x,
+                                 const Vector<N, T>& y) {
+    return RelativeEqual(x, y, tolerance);
+  };
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    const __m128 broadcast = _mm_set1_ps(tolerance);
+    detail::CompareToMask(
+        a, b, mask,
+        [broadcast](__m128 x, __m128 y) {
+          return detail::RelativeEqual(x, y, broadcast);
+        },
+        equal);
+    return;
+  }
+#endif
+  detail::CompareToMask(a, b, mask, equal);
+}
+
+template <std::size_t N, typename T>
+void UlpsEqual(Span<const Vector<N, T>> a, Span<const Vector<N, T>> b,
+               int max_ulps, Span<std::uint64_t> mask) {
+  assert(max_ulps >= 0 && max_ulps < (1 << 22));
+  const auto equal = [max_ulps](const Vector<N, T>& x,
+                                const Vector<N, T>& y) {
+    return UlpsEqual(x, y, max_ulps);
+  };
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    const __m128i broadcast = _mm_set1_epi32(max_ulps);
+    detail::CompareToMask(
+        a, b, mask,
+        [broadcast](__m128 x, __m128 y) {
+          return detail::UlpsEqual(x, y, broadcast);
+        },
+        equal);
+    return;
+  }
+#endif
+  detail::CompareToMask(a, b, mask, equal);
+}
+}  // namespace vector
+
+namespace matrix {
+namespace detail {
+template <typename matrix_type>
+struct Rows {};
+
+template <typename T>
+struct Rows<Matrix2x2<T>> : std::integral_constant<int, 2> {};
+
+template <typename T>
+struct Rows<Matrix3x3<T>> : std::integral_constant<int, 3> {};
+
+template <typename T>
+struct Rows<Matrix4x4<T>> : std::integral_constant<int, 4> {};
+
+template <typename matrix_type, typename Equal>
+constexpr bool AllRows(const matrix_type& a, const matrix_type& b,
+                       Equal equal) {
+  for (int row = 0; row < Rows<matrix_type>::value; ++row) {
+    if (!equal(a[row], b[row])) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace detail
+
+// Matrices compare row by row.
+template <typename matrix_type, int = detail::Rows<matrix_type>::value>
+constexpr bool AbsoluteEqual(
+    const matrix_type& a, const matrix_type& b,
+    typename matrix_type::ValueType tolerance) noexcept {
+  return detail::AllRows(a, b, [tolerance](const auto& x, const auto& y) {
+    return vector::AbsoluteEqual(x, y, tolerance);
+  });
+}
+
+template <typename matrix_type, int = detail::Rows<matrix_type>::value>
+constexpr bool RelativeEqual(
+    const matrix_type& a, const matrix_type& b,
+    typename matrix_type::ValueType tolerance) noexcept {
+  return detail::AllRows(a, b, [tolerance](const auto& x, const auto& y) {
+    return vector::RelativeEqual(x, y, tolerance);
+  });
+}
+
+template <typename matrix_type, int = detail::Rows<matrix_type>::value>
+bool UlpsEqual(const matrix_type& a, const matrix_type& b,
+               int max_ulps) noexcept {
+  return detail::AllRows(a, b, [max_ulps](const auto& x, const auto& y) {
+    return vector::UlpsEqual(x, y, max_ulps);
+  });
+}
+}  // namespace matrix
+
+// Quaternions compare as their Vector4. q and -q are the same rotation but
+// do not compare equal.
+template <typename T>
+constexpr bool AbsoluteEqual(const Quaternion<T>& a, const Quaternion<T>& b,
+                             T tolerance) noexcept {
+  return vector::AbsoluteEqual(a.ToVector4(), b.ToVector4(), tolerance);
+}
+
+template <typename T>
+constexpr bool RelativeEqual(const Quaternion<T>& a, const Quaternion<T>& b,
+                             T tolerance) noexcept {
+  return vector::RelativeEqual(a.ToVector4(), b.ToVector4(), tolerance);
+}
+
+template <typename T>
+bool UlpsEqual(const Quaternion<T>& a, const Quaternion<T>& b,
+               int max_ulps) noexcept {
+  return vector::UlpsEqual(a.ToVector4(), b.ToVector4(), max_ulps);
+}
+
+}  // namespace dlm
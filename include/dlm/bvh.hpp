@@ -0,0 +1,394 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dlm/aabb.hpp"
+#include "dlm/intersection.hpp"
+#include "dlm/parallel.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector3.hpp"
+
+namespace dlm {
+namespace geometry {
+
+// Boxes of the primitives a BVH can be built over.
+template <typename T>
+constexpr AABB3<T> Bounds(const AABB3<T>& box) {
+  return box;
+}
+
+template <typename T>
+constexpr AABB3<T> Bounds(const Sphere<T>& sphere) {
+  const vector::Vector3<T> radius{sphere.radius, sphere.radius,
+                                  sphere.radius};
+  return {sphere.center - radius, sphere.center + radius};
+}
+
+template <typename T>
+constexpr AABB3<T> Bounds(const Triangle<T>& triangle) {
+  return AABB3<T>{}.Merge(triangle.a).Merge(triangle.b).Merge(triangle.c);
+}
+
+// Bounding volume hierarchy over a span of primitives with a Bounds and an
+// Intersect with Ray, e.g. Triangle, Sphere or AABB3. The tree refers to the
+// primitives by index only, the queries and Refit take the span again and
+// it has to hold the same primitives in the same order.
+//
+// Built top down with the surface area heuristic evaluated over kBins bins
+// of the centroids per axis. Subtrees are built on up to threads threads, 0
+// uses one per hardware thread. The nodes are stored depth first in one
+// array, a left child directly follows its parent.
+template <typename T>
+class BVH {
+ public:
+  // 32 bytes for float. An inner node has count 0, its left child is the
+  // next node and offset is the index of its right child. A leaf holds the
+  // primitives Indices()[offset, offset + count).
+  struct Node {
+    AABB3<T> bounds;
+    std::uint32_t offset;
+    std::uint32_t count;
+
+    constexpr bool IsLeaf() const { return count != 0; }
+  };
+
+  // Closest hit, index is the number of primitives when there is none.
+  struct Hit {
+    T distance;
+    std::size_t index;
+  };
+
+  static constexpr std::size_t kBins = 16;
+  static constexpr std::size_t kMaxLeafSize = 8;
+  // Deeper nodes become leaves so traversal fits a fixed stack.
+  static constexpr std::size_t kMaxDepth = 64;
+
+  BVH() = default;
+  template <typename primitive_type>
+  explicit BVH(Span<const primitive_type> primitives, std::size_t threads = 0);
+
+  // Closest primitive hit by ray at a distance below max_distance.
+  template <typename primitive_type>
+  Hit ClosestHit(const Ray<T>& ray, Span<const primitive_type> primitives,
+                 T max_distance = std::numeric_limits<T>::infinity()) const;
+
+  // Whether any primitive is hit by ray at a distance below max_distance,
+  // stops at the first one found.
+  template <typename primitive_type>
+  bool AnyHit(const Ray<T>& ray, Span<const primitive_type> primitives,
+              T max_distance = std::numeric_limits<T>::infinity()) const;
+
+  // Recomputes every node box from the moved primitives, keeping the tree.
+  // Queries stay correct but slow down as the primitives drift from the
+  // layout the tree was built for.
+  template <typename primitive_type>
+  void Refit(Span<const primitive_type> primitives);
+
+  Span<const Node> Nodes() const { return Span<const Node>{nodes_}; }
+  Span<const std::uint32_t> Indices() const {
+    return Span<const std::uint32_t>{indices_};
+  }
+
+ private:
+  struct Builder;
+
+  std::vector<Node> nodes_;
+  std::vector<std::uint32_t> indices_;
+};
+
+// Primitive boxes and centroids shared by the threads of a build. Each node
+// sorts its own range of indices, subtrees on other threads write to their
+// own node arrays which are appended to the parent's afterwards.
+template <typename T>
+struct BVH<T>::Builder {
+  struct Bin {
+    AABB3<T> bounds;
+    std::size_t count = 0;
+  };
+
+  // Surface area up to a factor of 2, 0 for an empty box.
+  static T HalfArea(const AABB3<T>& box) {
+    if (box.IsEmpty()) {
+      return static_cast<T>(0);
+    }
+    const vector::Vector3<T> size = box.Size();
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+  }
+
+  // Builds the subtree over indices[begin, end) into nodes and returns the
+  // index of its root.
+  std::uint32_t Build(std::vector<Node>& nodes, std::uint32_t begin,
+                      std::uint32_t end, std::size_t depth,
+                      std::size_t threads) const {
+    const auto index = static_cast<std::uint32_t>(nodes.size());
+    nodes.push_back({});
+    AABB3<T> bounds;
+    AABB3<T> centroid_bounds;
+    for (std::uint32_t i = begin; i < end; ++i) {
+      bounds.Merge(boxes[(*indices)[i]]);
+      centroid_bounds.Merge(centroids[(*indices)[i]]);
+    }
+    nodes[index].bounds = bounds;
+
+    const std::uint32_t middle =
+        Split(begin, end, bounds, centroid_bounds, depth);
+    if (middle == begin) {
+      nodes[index].offset = begin;
+      nodes[index].count = end - begin;
+      return index;
+    }
+
+    if (threads > 1 && end - begin >= dlm::detail::kMinParallelCount) {
+      std::vector<Node> right_nodes;
+      std::thread right([&] {
+        Build(right_nodes, middle, end, depth + 1, threads / 2);
+      });
+      Build(nodes, begin, middle, depth + 1, threads - threads / 2);
+      right.join();
+      const auto base = static_cast<std::uint32_t>(nodes.size());
+      for (Node& node : right_nodes) {
+        node.offset += node.IsLeaf() ? 0 : base;
+      }
+      nodes[index].offset = base;
+      nodes.insert(nodes.end(), right_nodes.begin(), right_nodes.end());
+    } else {
+      Build(nodes, begin, middle, depth + 1, threads);
+      nodes[index].offset = Build(nodes, middle, end, depth + 1, threads);
+    }
+    nodes[index].count = 0;
+    return index;
+  }
+
+  // Partitions indices[begin, end) by the cheapest bin boundary and returns
+  // where the right side starts, or begin when a leaf is cheaper or the
+  // centroids cannot be told apart.
+  std::uint32_t Split(std::uint32_t begin, std::uint32_t end,
+                      const AABB3<T>& bounds,
+                      const AABB3<T>& centroid_bounds,
+                      std::size_t depth) const {
+    const std::uint32_t count = end - begin;
+    if (count <= 1 || depth + 1 >= kMaxDepth) {
+      return begin;
+    }
+    const vector::Vector3<T> extent = centroid_bounds.Size();
+    // All three axes in one pass over the primitives. An axis whose
+    // centroids all coincide puts everything in bin 0 and never splits.
+    Bin bins[3][kBins];
+    vector::Vector3<T> scale;
+    for (int axis = 0; axis < 3; ++axis) {
+      scale[axis] = extent[axis] > static_cast<T>(0)
+                        ? static_cast<T>(kBins) / extent[axis]
+                        : static_cast<T>(0);
+    }
+    for (std::uint32_t i = begin; i < end; ++i) {
+      const std::uint32_t primitive = (*indices)[i];
+      for (int axis = 0; axis < 3; ++axis) {
+        Bin& bin = bins[axis][BinOf(centroids[primitive][axis],
+                                    centroid_bounds.min[axis], scale[axis])];
+        bin.bounds.Merge(boxes[primitive]);
+        ++bin.count;
+      }
+    }
+    T best_cost = std::numeric_limits<T>::infinity();
+    int best_axis = -1;
+    std::size_t best_bin = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+      // Cost of splitting after bin b, the right side swept first.
+      T right_cost[kBins];
+      AABB3<T> right;
+      std::size_t right_count = 0;
+      for (std::size_t b = kBins - 1; b > 0; --b) {
+        right.Merge(bins[axis][b].bounds);
+        right_count += bins[axis][b].count;
+        right_cost[b - 1] = HalfArea(right) * static_cast<T>(right_count);
+      }
+      AABB3<T> left;
+      std::size_t left_count = 0;
+      for (std::size_t b = 0; b + 1 < kBins; ++b) {
+        left.Merge(bins[axis][b].bounds);
+        left_count += bins[axis][b].count;
+        const T cost =
+            HalfArea(left) * static_cast<T>(left_count) + right_cost[b];
+        if (left_count != 0 && left_count != count && cost < best_cost) {
+          best_cost = cost;
+          best_axis = axis;
+          best_bin = b;
+        }
+      }
+    }
+    if (best_axis < 0) {
+      return begin;
+    }
+    // Leaf cost count, a split costs one box test plus the expected
+    // primitive tests of its children.
+    const T leaf_cost = static_cast<T>(count);
+    const T split_cost = static_cast<T>(1) + best_cost / HalfArea(bounds);
+    if (count <= kMaxLeafSize && leaf_cost <= split_cost) {
+      return begin;
+    }
+    const T min = centroid_bounds.min[best_axis];
+    const auto first = indices->begin() + begin;
+    const auto middle = std::partition(
+        first, indices->begin() + end, [&](std::uint32_t primitive) {
+          return BinOf(centroids[primitive][best_axis], min,
+                       scale[best_axis]) <= best_bin;
+        });
+    return begin + static_cast<std::uint32_t>(middle - first);
+  }
+
+  static std::size_t BinOf(T centroid, T min, T scale) {
+    const auto bin = static_cast<std::size_t>((centroid - min) * scale);
+    return bin < kBins ? bin : kBins - 1;
+  }
+
+  std::vector<AABB3<T>> boxes;
+  std::vector<vector::Vector3<T>> centroids;
+  std::vector<std::uint32_t>* indices;
+};
+
+template <typename T>
+template <typename primitive_type>
+BVH<T>::BVH(Span<const primitive_type> primitives, std::size_t threads) {
+  assert(primitives.size() <= std::numeric_limits<std::uint32_t>::max());
+  const auto count = static_cast<std::uint32_t>(primitives.size());
+  if (count == 0) {
+    return;
+  }
+  threads = dlm::detail::ThreadCount(threads);
+  Builder builder;
+  builder.boxes.reserve(count);
+  builder.centroids.reserve(count);
+  for (const auto& primitive : primitives) {
+    builder.boxes.push_back(Bounds(primitive));
+    builder.centroids.push_back(builder.boxes.back().Center());
+  }
+  indices_.resize(count);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    indices_[i] = i;
+  }
+  builder.indices = &indices_;
+  nodes_.reserve(2 * (count / kMaxLeafSize) + 1);
+  builder.Build(nodes_, 0, count, 0, threads);
+}
+
+template <typename T>
+template <typename primitive_type>
+typename BVH<T>::Hit BVH<T>::ClosestHit(const Ray<T>& ray,
+                                        Span<const primitive_type> primitives,
+                                        T max_distance) const {
+  Hit hit{max_distance, primitives.size()};
+  if (nodes_.empty()) {
+    return hit;
+  }
+  const vector::Vector3<T> inverse = detail::Inverse(ray.direction);
+  // Nodes still to visit and the distance at which the ray enters them.
+  std::pair<std::uint32_t, T> stack[kMaxDepth];
+  std::size_t size = 0;
+  std::uint32_t node = 0;
+  T entry = detail::Intersect(ray.origin, inverse, nodes_[0].bounds);
+  while (true) {
+    if (entry < hit.distance) {
+      const Node& current = nodes_[node];
+      if (current.IsLeaf()) {
+        for (std::uint32_t i = 0; i < current.count; ++i) {
+          const std::uint32_t primitive = indices_[current.offset + i];
+          const T distance = Intersect(ray, primitives[primitive]);
+          if (distance < hit.distance) {
+            hit = {distance, primitive};
+          }
+        }
+      } else {
+        // The nearer child next, the other one on the stack.
+        std::uint32_t near = node + 1;
+        std::uint32_t far = current.offset;
+        T near_entry = detail::Intersect(ray.origin, inverse,
+                                         nodes_[near].bounds);
+        T far_entry = detail::Intersect(ray.origin, inverse,
+                                        nodes_[far].bounds);
+        if (far_entry < near_entry) {
+          std::swap(near, far);
+          std::swap(near_entry, far_entry);
+        }
+        if (far_entry < hit.distance) {
+          stack[size++] = {far, far_entry};
+        }
+        node = near;
+        entry = near_entry;
+        continue;
+      }
+    }
+    if (size == 0) {
+      break;
+    }
+    --size;
+    node = stack[size].first;
+    entry = stack[size].second;
+  }
+  if (hit.index == primitives.size()) {
+    hit.distance = std::numeric_limits<T>::infinity();
+  }
+  return hit;
+}
+
+template <typename T>
+template <typename primitive_type>
+bool BVH<T>::AnyHit(const Ray<T>& ray, Span<const primitive_type> primitives,
+                    T max_distance) const {
+  if (nodes_.empty()) {
+    return false;
+  }
+  const vector::Vector3<T> inverse = detail::Inverse(ray.direction);
+  std::uint32_t stack[kMaxDepth];
+  std::size_t size = 0;
+  stack[size++] = 0;
+  while (size != 0) {
+    const Node& node = nodes_[stack[--size]];
+    if (!(detail::Intersect(ray.origin, inverse, node.bounds) <
+          max_distance)) {
+      continue;
+    }
+    if (node.IsLeaf()) {
+      for (std::uint32_t i = 0; i < node.count; ++i) {
+        if (Intersect(ray, primitives[indices_[node.offset + i]]) <
+            max_distance) {
+          return true;
+        }
+      }
+    } else {
+      stack[size++] = node.offset;
+      stack[size++] = static_cast<std::uint32_t>(&node - nodes_.data()) + 1;
+    }
+  }
+  return false;
+}
+
+template <typename T>
+template <typename primitive_type>
+void BVH<T>::Refit(Span<const primitive_type> primitives) {
+  assert(primitives.size() == indices_.size());
+  // Children follow their parent, so walking backwards visits them first.
+  for (std::size_t n = nodes_.size(); n-- > 0;) {
+    Node& node = nodes_[n];
+    AABB3<T> bounds;
+    if (node.IsLeaf()) {
+      for (std::uint32_t i = 0; i < node.count; ++i) {
+        bounds.Merge(Bounds(primitives[indices_[node.offset + i]]));
+      }
+    } else {
+      bounds = Merge(nodes_[n + 1].bounds, nodes_[node.offset].bounds);
+    }
+    node.bounds = bounds;
+  }
+}
+
+using BVHF = BVH<float>;
+
+}  // namespace geometry
+}  // namespace dlm
@@ -0,0 +1,84 @@
+#pragma once
+
+// Instruction set selection. The SIMD code paths are picked at compile time
+// from the target flags (e.g. -msse4.1, -mavx2 or -march=native). Define
+// DLM_NO_SIMD to force the portable scalar implementations.
+
+// The SIMD specializations stay usable in constant expressions by falling
+// back to the scalar code during constant evaluation, so they are only
+// enabled when the compiler can tell the two apart.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define DLM_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+#endif
+
+#if !defined(DLM_HAS_IS_CONSTANT_EVALUATED) &&                \
+    ((defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || \
+     (defined(_MSC_VER) && _MSC_VER >= 1925))
+#define DLM_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+
+#if defined(DLM_HAS_IS_CONSTANT_EVALUATED)
+#define DLM_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define DLM_IS_CONSTANT_EVALUATED() false
+#endif
+
+// Vector components are indexed through a table of pointers to the members,
+// which is defined behavior and works in constant evaluation as well.
+//
+// The index is checked when DLM_CHECKED_INDEXING is 1, the default unless
+// NDEBUG is defined. An out of range index executes a trap instruction, or
+// fails to compile during constant evaluation.
+#if !defined(DLM_CHECKED_INDEXING)
+#if defined(NDEBUG)
+#define DLM_CHECKED_INDEXING 0
+#else
+#define DLM_CHECKED_INDEXING 1
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define DLM_TRAP() __debugbreak()
+#else
+#define DLM_TRAP() __builtin_trap()
+#endif
+
+#if DLM_CHECKED_INDEXING
+#define DLM_ASSERT_INDEX(index, size)                                   \
+  (static_cast<unsigned>(index) < static_cast<unsigned>(size) ? (void)0 \
+                                                                : DLM_TRAP())
+#else
+#define DLM_ASSERT_INDEX(index, size) ((void)0)
+#endif
+
+#if !defined(DLM_NO_SIMD) && defined(DLM_HAS_IS_CONSTANT_EVALUATED)
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DLM_SSE2 1
+#endif
+
+#if defined(DLM_SSE2) && (defined(__SSE4_1__) || defined(__AVX__))
+#define DLM_SSE4_1 1
+#endif
+
+#if defined(DLM_SSE2) && defined(__AVX__)
+#define DLM_AVX 1
+#endif
+
+// AVX2 does not imply FMA for GCC and Clang, -mavx2 alone leaves the FMA
+// intrinsics unusable. MSVC has no __FMA__ and enables FMA with /arch:AVX2.
+#if defined(DLM_SSE2) &&     \
+    (defined(__FMA__) ||     \
+     (defined(_MSC_VER) && !defined(__clang__) && defined(__AVX2__)))
+#define DLM_FMA 1
+#endif
+
+#if defined(DLM_SSE2) && defined(__F16C__)
+#define DLM_F16C 1
+#endif
+
+#endif
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "dlm/config.hpp"
+#include "dlm/muladd.hpp"
+#include "dlm/vector.hpp"
+#include "dlm/vector2.hpp"
+#include "dlm/vector3.hpp"
+#include "dlm/vector4.hpp"
+
+namespace dlm {
+namespace vector {
+
+// Opt-in lazy arithmetic for Vector2/3/4. Wrapping one operand in Lazy()
+// makes the operators build an expression tree instead of a temporary
+// vector per operator, the tree is evaluated once per component when it is
+// converted to a vector:
+//
+//   const Vector3F p =
+//       Lazy(position) + Lazy(velocity) * dt + Lazy(acceleration) * h;
+//
+// Only operators with a node on one side are lazy, and a product of plain
+// vectors is evaluated before the + that takes it. So every product has to
+// start from Lazy() itself or it is computed eagerly into a temporary and
+// is not fused. A lazy product that is added to or subtracted from
+// something is evaluated as a fused multiply-add when DLM_FMA is defined,
+// so lazy results can differ from the eager operators in the last bit. The
+// tree keeps references to its vector operands, evaluate it in the full
+// expression that builds it and never store it with auto.
+namespace expression {
+
+struct Add {
+  template <typename T>
+  static constexpr T Apply(T a, T b) {
+    return a + b;
+  }
+};
+
+struct Subtract {
+  template <typename T>
+  static constexpr T Apply(T a, T b) {
+    return a - b;
+  }
+};
+
+struct Multiply {
+  template <typename T>
+  static constexpr T Apply(T a, T b) {
+    return a * b;
+  }
+};
+
+// Component-wise like Vector::operator/, a zero divisor gives inf or NaN in
+// that component for floating point T.
+struct Divide {
+  template <typename T>
+  static constexpr T Apply(T a, T b) {
+    return a / b;
+  }
+};
+
+// A vector operand.
+template <typename vector_type>
+struct Terminal {
+  using VectorType = vector_type;
+  using ValueType = typename vector_type::ValueType;
+
+  const vector_type& value;
+};
+
+// A scalar operand, broadcast to every component.
+template <typename T>
+struct Scalar {
+  using ValueType = T;
+
+  T value;
+};
+
+template <typename E>
+struct Negate {
+  using VectorType = typename E::VectorType;
+  using ValueType = typename E::ValueType;
+
+  E operand;
+
+  constexpr operator VectorType() const;
+};
+
+template <typename Op, typename L, typename R>
+struct Binary;
+
+namespace detail {
+template <typename vector_type>
+struct VectorSize : std::integral_constant<std::size_t, 0> {};
+
+template <std::size_t N, typename T>
+struct VectorSize<Vector<N, T>> : std::integral_constant<std::size_t, N> {};
+
+template <typename E>
+struct IsNode : std::false_type {};
+
+template <typename V>
+struct IsNode<Terminal<V>> : std::true_type {};
+
+template <typename E>
+struct IsNode<Negate<E>> : std::true_type {};
+
+template <typename Op, typename L, typename R>
+struct IsNode<Binary<Op, L, R>> : std::true_type {};
+
+// Maps an operator argument to its node: nodes are kept, vectors become
+// terminals and arithmetic values become scalars of the value type T.
+template <typename T, typename Arg, typename = void>
+struct OperandOf {
+  using Type = Arg;
+  static constexpr const Arg& Make(const Arg& arg) { return arg; }
+};
+
+template <typename T, typename Arg>
+struct OperandOf<T, Arg, std::enable_if_t<(VectorSize<Arg>::value > 0)>> {
+  using Type = Terminal<Arg>;
+  static constexpr Type Make(const Arg& arg) { return {arg}; }
+};
+
+template <typename T, typename Arg>
+struct OperandOf<T, Arg, std::enable_if_t<std::is_arithmetic<Arg>::value>> {
+  using Type = Scalar<T>;
+  static constexpr Type Make(const Arg& arg) {
+    return {static_cast<T>(arg)};
+  }
+};
+
+template <typename Arg, typename = void>
+struct ValueTypeOf {
+  using Type = typename Arg::ValueType;
+};
+
+template <typename Arg>
+struct ValueTypeOf<Arg, std::enable_if_t<std::is_arithmetic<Arg>::value>> {
+  using Type = void;
+};
+
+// The value type of a binary node, taken from whichever side is not a
+// plain arithmetic value.
+template <typename L, typename R>
+using CommonValueType =
+    std::conditional_t<std::is_arithmetic<L>::value,
+                       typename ValueTypeOf<R>::Type,
+                       typename ValueTypeOf<L>::Type>;
+
+template <typename L, typename R>
+using EnableIfOperands = std::enable_if_t<
+    (IsNode<L>::value && (IsNode<R>::value || VectorSize<R>::value > 0 ||
+                          std::is_arithmetic<R>::value)) ||
+    (IsNode<R>::value &&
+     (VectorSize<L>::value > 0 || std::is_arithmetic<L>::value))>;
+}  // namespace detail
+
+template <typename Op, typename L, typename R>
+struct Binary {
+  using ValueType = typename L::ValueType;
+  using VectorType =
+      typename std::conditional_t<detail::IsNode<L>::value, L,
+                                  R>::VectorType;
+
+  static_assert(std::is_same<ValueType, typename R::ValueType>::value,
+                "Operands must have the same value type");
+
+  L left;
+  R right;
+
+  constexpr operator VectorType() const;
+};
+
+// Component I of a node. The overloads for a product on either side of
+// an addition or subtraction are more specialized than the generic one and
+// evaluate it as a single multiply-add.
+template <std::size_t I, typename V>
+constexpr typename V::ValueType Get(const Terminal<V>& e) {
+  return e.value[static_cast<int>(I)];
+}
+
+template <std::size_t I, typename T>
+constexpr T Get(const Scalar<T>& e) {
+  return e.value;
+}
+
+template <std::size_t I, typename E>
+constexpr typename E::ValueType Get(const Negate<E>& e) {
+  return -Get<I>(e.operand);
+}
+
+template <std::size_t I, typename Op, typename L, typename R>
+constexpr typename L::ValueType Get(const Binary<Op, L, R>& e) {
+  return Op::Apply(Get<I>(e.left), Get<I>(e.right));
+}
+
+template <std::size_t I, typename A, typename B, typename C>
+constexpr typename A::ValueType Get(
+    const Binary<Add, Binary<Multiply, A, B>, C>& e) {
+  return vector::MulAdd(Get<I>(e.left.left), Get<I>(e.left.right),
+                        Get<I>(e.right));
+}
+
+template <std::size_t I, typename A, typename B, typename C>
+constexpr typename A::ValueType Get(
+    const Binary<Add, C, Binary<Multiply, A, B>>& e) {
+  return vector::MulAdd(Get<I>(e.right.left), Get<I>(e.right.right),
+                        Get<I>(e.left));
+}
+
+template <std::size_t I, typename A, typename B, typename C, typename D>
+constexpr typename A::ValueType Get(
+    const Binary<Add, Binary<Multiply, A, B>, Binary<Multiply, C, D>>& e) {
+  return vector::MulAdd(Get<I>(e.left.left), Get<I>(e.left.right),
+                        Get<I>(e.right));
+}
+
+template <std::size_t I, typename A, typename B, typename C>
+constexpr typename A::ValueType Get(
+    const Binary<Subtract, Binary<Multiply, A, B>, C>& e) {
+  return vector::MulSub(Get<I>(e.left.left), Get<I>(e.left.right),
+                        Get<I>(e.right));
+}
+
+template <std::size_t I, typename A, typename B, typename C>
+constexpr typename A::ValueType Get(
+    const Binary<Subtract, C, Binary<Multiply, A, B>>& e) {
+  return vector::NegMulAdd(Get<I>(e.right.left), Get<I>(e.right.right),
+                           Get<I>(e.left));
+}
+
+template <std::size_t I, typename A, typename B, typename C, typename D>
+constexpr typename A::ValueType Get(
+    const Binary<Subtract, Binary<Multiply, A, B>, Binary<Multiply, C, D>>&
+        e) {
+  return vector::MulSub(Get<I>(e.left.left), Get<I>(e.left.right),
+                        Get<I>(e.right));
+}
+
+namespace detail {
+template <typename E, std::size_t... I>
+constexpr typename E::VectorType Evaluate(const E& e,
+                                          std::index_sequence<I...>) {
+  return {Get<I>(e)...};
+}
+}  // namespace detail
+
+// Evaluates the whole tree in a single pass over the components.
+template <typename E>
+constexpr typename E::VectorType Evaluate(const E& e) {
+  using VectorType = typename E::VectorType;
+  return detail::Evaluate(
+      e, std::make_index_sequence<detail::VectorSize<VectorType>::value>{});
+}
+
+template <typename E>
+constexpr Negate<E>::operator VectorType() const {
+  return Evaluate(*this);
+}
+
+template <typename Op, typename L, typename R>
+constexpr Binary<Op, L, R>::operator VectorType() const {
+  return Evaluate(*this);
+}
+
+namespace detail {
+template <typename Op, typename L, typename R>
+using BinaryOf = Binary<Op, typename OperandOf<CommonValueType<L, R>, L>::Type,
+                        typename OperandOf<CommonValueType<L, R>, R>::Type>;
+
+template <typename Op, typename L, typename R>
+constexpr BinaryOf<Op, L, R> MakeBinary(const L& left, const R& right) {
+  using T = CommonValueType<L, R>;
+  return {OperandOf<T, L>::Make(left), OperandOf<T, R>::Make(right)};
+}
+}  // namespace detail
+
+// The operators only take part when at least one side is already a node,
+// plain vector arithmetic keeps using the eager member operators.
+template <typename L, typename R, typename = detail::EnableIfOperands<L, R>>
+constexpr detail::BinaryOf<Add, L, R> operator+(const L& left,
+                                                const R& right) {
+  return detail::MakeBinary<Add>(left, right);
+}
+
+template <typename L, typename R, typename = detail::EnableIfOperands<L, R>>
+constexpr detail::BinaryOf<Subtract, L, R> operator-(const L& left,
+                                                     const R& right) {
+  return detail::MakeBinary<Subtract>(left, right);
+}
+
+template <typename L, typename R, typename = detail::EnableIfOperands<L, R>>
+constexpr detail::BinaryOf<Multiply, L, R> operator*(const L& left,
+                                                     const R& right) {
+  return detail::MakeBinary<Multiply>(left, right);
+}
+
+template <typename L, typename R, typename = detail::EnableIfOperands<L, R>>
+constexpr detail::BinaryOf<Divide, L, R> operator/(const L& left,
+                                                   const R& right) {
+  return detail::MakeBinary<Divide>(left, right);
+}
+
+template <typename E, typename = std::enable_if_t<detail::IsNode<E>::value>>
+constexpr Negate<E> operator-(const E& operand) {
+  return {operand};
+}
+}  // namespace expression
+
+// Starts a lazy expression, see expression.hpp.
+template <typename vector_type>
+constexpr expression::Terminal<vector_type> Lazy(const vector_type& v) {
+  static_assert(expression::detail::VectorSize<vector_type>::value > 0,
+                "Lazy expects a Vector2, Vector3 or Vector4");
+  return {v};
+}
+
+}  // namespace vector
+}  // namespace dlm
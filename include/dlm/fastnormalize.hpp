@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "dlm/simd.hpp"
+#include "dlm/vector2.hpp"
+#include "dlm/vector3.hpp"
+#include "dlm/vector3batch.hpp"
+#include "dlm/vector4.hpp"
+
+namespace dlm {
+namespace vector {
+
+// Precision policies for ReciprocalSqrt and FastNormalize. The error bounds
+// are for float against the correctly rounded result. ReciprocalSqrt is
+// checked for every float in [1, 4), the estimate only depends on the
+// mantissa and the parity of the exponent, FastNormalize on random vectors.
+namespace precision {
+// A 12 bit reciprocal square root estimate refined by steps Newton-Raphson
+// iterations, every step roughly doubles the number of correct bits.
+template <int steps>
+struct NewtonRaphson {
+  static constexpr int kSteps = steps;
+};
+
+// Raw estimate, relative error below 1.5 * 2^-12 (at most 6144 ULP).
+using Estimate = NewtonRaphson<0>;
+// One Newton-Raphson step, at most 5 ULP for ReciprocalSqrt and 6 ULP per
+// component for FastNormalize. For double this gives float like precision,
+// use NewtonRaphson<2> or Exact for more.
+using Refined = NewtonRaphson<1>;
+
+// std::sqrt and a divide, within 1 ULP of Normalize.
+struct Exact {};
+}  // namespace precision
+
+namespace detail {
+template <typename T>
+T NewtonRaphsonStep(T x, T estimate) {
+  const T half_x = static_cast<T>(0.5) * x;
+  return estimate * (static_cast<T>(1.5) - half_x * estimate * estimate);
+}
+
+template <typename T>
+T ReciprocalSqrtEstimate(T x) {
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+  }
+#endif
+  // Bit level estimate with a relative error below 3.5e-2, two
+  // Newton-Raphson steps bring it within the 12 bits rsqrtss guarantees.
+  using Bits =
+      std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+  constexpr Bits kMagic = sizeof(T) == 4
+                              ? static_cast<Bits>(0x5f375a86u)
+                              : static_cast<Bits>(0x5fe6eb50c7b537a9u);
+  Bits bits = 0;
+  std::memcpy(&bits, &x, sizeof(x));
+  bits = kMagic - (bits >> 1);
+  T estimate = static_cast<T>(0);
+  std::memcpy(&estimate, &bits, sizeof(estimate));
+  return NewtonRaphsonStep(x, NewtonRaphsonStep(x, estimate));
+}
+}  // namespace detail
+
+// 1 / sqrt(x) for positive normal x, the result for zero and denormals is
+// unspecified.
+template <typename Precision = precision::Refined, typename T>
+T ReciprocalSqrt(T x) {
+  static_assert(std::is_floating_point<T>::value,
+                "ReciprocalSqrt needs a floating point type");
+  if constexpr (std::is_same<Precision, precision::Exact>::value) {
+    return static_cast<T>(1) / std::sqrt(x);
+  } else {
+    T estimate = detail::ReciprocalSqrtEstimate(x);
+    for (int step = 0; step < Precision::kSteps; ++step) {
+      estimate = detail::NewtonRaphsonStep(x, estimate);
+    }
+    return estimate;
+  }
+}
+
+namespace detail {
+#if defined(DLM_SSE2)
+template <typename Precision>
+__m128 ReciprocalSqrt(__m128 x) {
+  if constexpr (std::is_same<Precision, precision::Exact>::value) {
+    return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x));
+  } else {
+    const __m128 half_x = _mm_mul_ps(_mm_set1_ps(0.5f), x);
+    __m128 estimate = _mm_rsqrt_ps(x);
+    for (int step = 0; step < Precision::kSteps; ++step) {
+      const __m128 square = _mm_mul_ps(estimate, estimate);
+      estimate = _mm_mul_ps(
+          estimate, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half_x, square)));
+    }
+    return estimate;
+  }
+}
+#endif
+
+#if defined(DLM_AVX)
+template <typename Precision>
+__m256 ReciprocalSqrt(__m256 x) {
+  if constexpr (std::is_same<Precision, precision::Exact>::value) {
+    return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(x));
+  } else {
+    const __m256 half_x = _mm256_mul_ps(_mm256_set1_ps(0.5f), x);
+    __m256 estimate = _mm256_rsqrt_ps(x);
+    for (int step = 0; step < Precision::kSteps; ++step) {
+      const __m256 square = _mm256_mul_ps(estimate, estimate);
+      estimate = _mm256_mul_ps(
+          estimate,
+          _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(half_x, square)));
+    }
+    return estimate;
+  }
+}
+#endif
+
+// Replaces every element of values with its reciprocal square root, the
+// counterpart of simd::Sqrt for the batch kernels.
+template <typename Precision, std::size_t N>
+void ReciprocalSqrt(float (&values)[N]) {
+  std::size_t i = 0;
+#if defined(DLM_AVX)
+  for (; i + 8 <= N; i += 8) {
+    _mm256_storeu_ps(values + i, detail::ReciprocalSqrt<Precision>(
+                                     _mm256_loadu_ps(values + i)));
+  }
+#endif
+#if defined(DLM_SSE2)
+  for (; i + 4 <= N; i += 4) {
+    _mm_storeu_ps(values + i,
+                  detail::ReciprocalSqrt<Precision>(_mm_loadu_ps(values + i)));
+  }
+#endif
+  for (; i < N; ++i) {
+    values[i] = vector::ReciprocalSqrt<Precision>(values[i]);
+  }
+}
+
+template <typename Precision, std::size_t N>
+void ReciprocalSqrt(double (&values)[N]) {
+  if constexpr (std::is_same<Precision, precision::Exact>::value) {
+    simd::Sqrt(values);
+    for (std::size_t i = 0; i < N; ++i) {
+      values[i] = 1.0 / values[i];
+    }
+  } else {
+    for (std::size_t i = 0; i < N; ++i) {
+      values[i] = vector::ReciprocalSqrt<Precision>(values[i]);
+    }
+  }
+}
+}  // namespace detail
+
+// Normalize with the reciprocal square root picked by Precision, a multiply
+// per component instead of a divide. Works for every vector width. The
+// result for a zero length vector is unspecified (NaN with SSE), use
+// FastNormalizeSafe when v may be zero.
+template <typename Precision = precision::Refined, typename vector_type>
+vector_type FastNormalize(const vector_type& v) {
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<vector_type, Vector4<float>>::value) {
+    const __m128 r = detail::Load(v);
+    return detail::FromRegister<4, float>(
+        _mm_mul_ps(r, detail::ReciprocalSqrt<Precision>(simd::Dot4(r, r))));
+  }
+#endif
+  return v * ReciprocalSqrt<Precision>(v.LengthSquared());
+}
+
+// FastNormalize that returns fallback when the squared length of v is zero,
+// denormal or NaN, none of which have a usable reciprocal square root.
+template <typename Precision = precision::Refined, typename vector_type>
+vector_type FastNormalizeSafe(const vector_type& v,
+                              const vector_type& fallback = vector_type{}) {
+  using T = typename vector_type::ValueType;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<vector_type, Vector4<float>>::value) {
+    const __m128 r = detail::Load(v);
+    const __m128 length_squared = simd::Dot4(r, r);
+    if (!(_mm_cvtss_f32(length_squared) >= std::numeric_limits<T>::min())) {
+      return fallback;
+    }
+    return detail::FromRegister<4, float>(
+        _mm_mul_ps(r, detail::ReciprocalSqrt<Precision>(length_squared)));
+  }
+#endif
+  const T length_squared = v.LengthSquared();
+  if (!(length_squared >= std::numeric_limits<T>::min())) {
+    return fallback;
+  }
+  return v * ReciprocalSqrt<Precision>(length_squared);
+}
+
+// Structure of arrays version of FastNormalize, the reciprocal square roots
+// of a whole block are computed in the widest available register.
+template <typename Precision = precision::Refined, typename T>
+void FastNormalize(const Vector3Batch<T>& v, Vector3Batch<T>& out) {
+  constexpr std::size_t kLanes = Vector3Batch<T>::kLanes;
+  out.Resize(v.Size());
+  const T* v_x = v.X();
+  const T* v_y = v.Y();
+  const T* v_z = v.Z();
+  T* out_x = out.X();
+  T* out_y = out.Y();
+  T* out_z = out.Z();
+  for (std::size_t i = 0; i < v.PaddedSize(); i += kLanes) {
+    T x[kLanes], y[kLanes], z[kLanes], scale[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      x[lane] = v_x[i + lane];
+      y[lane] = v_y[i + lane];
+      z[lane] = v_z[i + lane];
+      scale[lane] = x[lane] * x[lane] + y[lane] * y[lane] + z[lane] * z[lane];
+    }
+    detail::ReciprocalSqrt<Precision>(scale);
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      x[lane] *= scale[lane];
+      y[lane] *= scale[lane];
+      z[lane] *= scale[lane];
+    }
+    std::copy_n(x, kLanes, out_x + i);
+    std::copy_n(y, kLanes, out_y + i);
+    std::copy_n(z, kLanes, out_z + i);
+  }
+}
+
+}  // namespace vector
+}  // namespace dlm
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "dlm/config.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector.hpp"
+
+#if defined(DLM_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace dlm {
+
+namespace detail {
+// value * 2^16 rounded to nearest even, the rounding of the SSE conversion.
+// Out of range values are clamped to the largest value the float path can
+// represent, NaN becomes the minimum like the SSE max instruction makes it.
+template <typename F>
+constexpr std::int32_t ToFixedRaw(F value) {
+  constexpr F kMin = static_cast<F>(-2147483648.0);
+  // The largest float below 2^31, or 2^31 - 1 for double.
+  constexpr F kMax = std::is_same<F, float>::value
+                         ? static_cast<F>(2147483520.0)
+                         : static_cast<F>(2147483647.0);
+  F scaled = value * static_cast<F>(65536);
+  if (!(scaled > kMin)) {
+    return std::numeric_limits<std::int32_t>::min();
+  }
+  if (scaled > kMax) {
+    scaled = kMax;
+  }
+  const std::int64_t truncated = static_cast<std::int64_t>(scaled);
+  const F remainder = scaled - static_cast<F>(truncated);
+  const F half = static_cast<F>(0.5);
+  std::int64_t rounded = truncated;
+  if (remainder > half || (remainder == half && (truncated & 1) != 0)) {
+    ++rounded;
+  } else if (remainder < -half ||
+             (remainder == -half && (truncated & 1) != 0)) {
+    --rounded;
+  }
+  return static_cast<std::int32_t>(
+      rounded > std::numeric_limits<std::int32_t>::max()
+          ? std::numeric_limits<std::int32_t>::max()
+          : rounded);
+}
+
+// Two's complement wrap around without signed overflow.
+constexpr std::int32_t Wrap(std::int64_t value) {
+  return static_cast<std::int32_t>(static_cast<std::uint32_t>(value));
+}
+
+// value clamped to the int32 range.
+constexpr std::int32_t Saturate(std::int64_t value) {
+  return static_cast<std::int32_t>(
+      value > std::numeric_limits<std::int32_t>::max()
+          ? std::numeric_limits<std::int32_t>::max()
+      : value < std::numeric_limits<std::int32_t>::min()
+          ? std::numeric_limits<std::int32_t>::min()
+          : value);
+}
+}  // namespace detail
+
+// Signed Q16.16 fixed point: an int32 with 16 fraction bits, covering
+// [-32768, 32768) in steps of 2^-16 with the same precision everywhere.
+// Addition, subtraction and negation wrap around on overflow like the
+// underlying integer, multiplication and division round to nearest.
+// Conversion from an integer or a float outside the range clamps to the
+// largest or smallest value.
+// Division by zero saturates to the largest or smallest value by the sign
+// of the numerator, and 0 / 0 is 0. All of it is constexpr.
+struct Fixed {
+  static constexpr int kFractionBits = 16;
+  static constexpr std::int32_t kOne = 1 << kFractionBits;
+
+  constexpr Fixed() : raw{0} {};
+  constexpr explicit Fixed(int value)
+      : raw{detail::Saturate(static_cast<std::int64_t>(value) * kOne)} {};
+  constexpr explicit Fixed(float value) : raw{detail::ToFixedRaw(value)} {};
+  constexpr explicit Fixed(double value) : raw{detail::ToFixedRaw(value)} {};
+
+  static constexpr Fixed FromRaw(std::int32_t raw) {
+    Fixed fixed;
+    fixed.raw = raw;
+    return fixed;
+  }
+
+  constexpr explicit operator float() const {
+    return static_cast<float>(raw) * (1.0f / kOne);
+  }
+  constexpr explicit operator double() const {
+    return static_cast<double>(raw) * (1.0 / kOne);
+  }
+
+  constexpr Fixed operator-() const {
+    return FromRaw(detail::Wrap(-static_cast<std::int64_t>(raw)));
+  }
+
+  constexpr Fixed& operator+=(Fixed f);
+  constexpr Fixed& operator-=(Fixed f);
+  constexpr Fixed& operator*=(Fixed f);
+  constexpr Fixed& operator/=(Fixed f);
+
+  std::int32_t raw;
+};
+
+static_assert(std::is_trivially_copyable<Fixed>::value);
+static_assert(sizeof(Fixed) == 4);
+
+constexpr Fixed operator+(Fixed a, Fixed b) {
+  return Fixed::FromRaw(
+      detail::Wrap(static_cast<std::int64_t>(a.raw) + b.raw));
+}
+
+constexpr Fixed operator-(Fixed a, Fixed b) {
+  return Fixed::FromRaw(
+      detail::Wrap(static_cast<std::int64_t>(a.raw) - b.raw));
+}
+
+// The 64 bit product has 32 fraction bits, the dropped half rounds up.
+constexpr Fixed operator*(Fixed a, Fixed b) {
+  const std::int64_t product = static_cast<std::int64_t>(a.raw) * b.raw;
+  return Fixed::FromRaw(detail::Wrap(
+      (product + (std::int64_t{1} << (Fixed::kFractionBits - 1))) >>
+      Fixed::kFractionBits));
+}
+
+// Rounds half away from zero.
+constexpr Fixed operator/(Fixed a, Fixed b) {
+  if (b.raw == 0) {
+    return Fixed::FromRaw(a.raw > 0   ? std::numeric_limits<std::int32_t>::max()
+                          : a.raw < 0 ? std::numeric_limits<std::int32_t>::min()
+                                      : 0);
+  }
+  const std::int64_t numerator = static_cast<std::int64_t>(a.raw) * Fixed::kOne;
+  const std::int64_t denominator = b.raw;
+  std::int64_t quotient = numerator / denominator;
+  const std::int64_t remainder = numerator % denominator;
+  const std::int64_t twice = 2 * (remainder < 0 ? -remainder : remainder);
+  if (twice >= (denominator < 0 ? -denominator : denominator)) {
+    quotient += (numerator < 0) != (denominator < 0) ? -1 : 1;
+  }
+  return Fixed::FromRaw(detail::Wrap(quotient));
+}
+
+constexpr Fixed& Fixed::operator+=(Fixed f) { return *this = *this + f; }
+
+constexpr Fixed& Fixed::operator-=(Fixed f) { return *this = *this - f; }
+
+constexpr Fixed& Fixed::operator*=(Fixed f) { return *this = *this * f; }
+
+constexpr Fixed& Fixed::operator/=(Fixed f) { return *this = *this / f; }
+
+constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+
+constexpr bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+
+constexpr bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+
+constexpr bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+
+constexpr bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+
+constexpr bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+inline Fixed sqrt(Fixed f) {
+  return Fixed{std::sqrt(static_cast<double>(f))};
+}
+
+// Bulk conversions with the rounding and clamping of Fixed(float), out
+// holds at least in.size() values.
+inline void ToFixed(Span<const float> in, Span<Fixed> out) {
+  assert(out.size() >= in.size());
+  const float* source = in.data();
+  Fixed* destination = out.data();
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#if defined(DLM_AVX)
+  for (; i + 8 <= count; i += 8) {
+    __m256 scaled =
+        _mm256_mul_ps(_mm256_loadu_ps(source + i), _mm256_set1_ps(65536.0f));
+    // max returns its second operand for NaN.
+    scaled = _mm256_min_ps(
+        _mm256_max_ps(scaled, _mm256_set1_ps(-2147483648.0f)),
+        _mm256_set1_ps(2147483520.0f));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i),
+                        _mm256_cvtps_epi32(scaled));
+  }
+#endif
+#if defined(DLM_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128 scaled =
+        _mm_mul_ps(_mm_loadu_ps(source + i), _mm_set1_ps(65536.0f));
+    scaled = _mm_min_ps(_mm_max_ps(scaled, _mm_set1_ps(-2147483648.0f)),
+                        _mm_set1_ps(2147483520.0f));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i),
+                     _mm_cvtps_epi32(scaled));
+  }
+#endif
+  for (; i < count; ++i) {
+    destination[i] = Fixed{source[i]};
+  }
+}
+
+inline void ToFloat(Span<const Fixed> in, Span<float> out) {
+  assert(out.size() >= in.size());
+  const Fixed* source = in.data();
+  float* destination = out.data();
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#if defined(DLM_AVX)
+  for (; i + 8 <= count; i += 8) {
+    const __m256i raw =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+    _mm256_storeu_ps(destination + i,
+                     _mm256_mul_ps(_mm256_cvtepi32_ps(raw),
+                                   _mm256_set1_ps(1.0f / Fixed::kOne)));
+  }
+#endif
+#if defined(DLM_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    const __m128i raw =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+    _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_cvtepi32_ps(raw),
+                                              _mm_set1_ps(1.0f / Fixed::kOne)));
+  }
+#endif
+  for (; i < count; ++i) {
+    destination[i] = static_cast<float>(source[i]);
+  }
+}
+
+namespace vector {
+// Converts float vectors to fixed point vectors and back, a span of vectors
+// is converted as one array of components.
+template <std::size_t N>
+void Pack(Span<const Vector<N, float>> in, Span<Vector<N, Fixed>> out) {
+  assert(out.size() >= in.size());
+  ToFixed({reinterpret_cast<const float*>(in.data()), in.size() * N},
+          {reinterpret_cast<Fixed*>(out.data()), in.size() * N});
+}
+
+template <std::size_t N>
+void Unpack(Span<const Vector<N, Fixed>> in, Span<Vector<N, float>> out) {
+  assert(out.size() >= in.size());
+  ToFloat({reinterpret_cast<const Fixed*>(in.data()), in.size() * N},
+          {reinterpret_cast<float*>(out.data()), in.size() * N});
+}
+}  // namespace vector
+
+}  // namespace dlm
@@ -1,7 +1,22 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dlm/config.hpp"
+#include "dlm/parallel.hpp"
+#include "dlm/simd.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector.hpp"
 #include "dlm/vector2.hpp"
 #include "dlm/vector3.hpp"
+#include "dlm/vector4.hpp"
 
 namespace dlm {
 namespace vector {
@@ -18,43 +33,612 @@ typename vector_type::ValueType Length(const vector_type& v1) {
 }
 
 template <typename vector_type>
-typename vector_type::ValueType Dot(const vector_type& v1,
-                                    const vector_type& v2) {
+constexpr typename vector_type::ValueType Dot(const vector_type& v1,
+                                              const vector_type& v2) {
   return v1 | v2;
 }
 
 template <typename T>
-Vector3<T> Cross(const Vector3<T>& v1, const Vector3<T> v2) {
+constexpr Vector3<T> Cross(const Vector3<T>& v1, const Vector3<T> v2) {
   return v1 ^ v2;
 }
 
-template <typename T>
-T Distance(const Vector2<T>& v1, const Vector2<T>& v2) {
-  Vector2<T> diff = v1 - v2;
+template <std::size_t N, typename T, typename Layout>
+T Distance(const Vector<N, T, Layout>& v1, const Vector<N, T, Layout>& v2) {
+  Vector<N, T, Layout> diff = v1 - v2;
   return diff.Length();
 }
 
-template <typename T>
-T DistanceSquared(const Vector2<T>& v1, const Vector2<T>& v2) {
-  Vector2<T> diff = v1 - v2;
+template <std::size_t N, typename T, typename Layout>
+constexpr T DistanceSquared(const Vector<N, T, Layout>& v1,
+                            const Vector<N, T, Layout>& v2) {
+  Vector<N, T, Layout> diff = v1 - v2;
   return diff.LengthSquared();
 }
 
+// Tag for the Reflect and Refract overloads whose normal is already unit
+// length, they skip normalizing it.
+struct UnitNormal {};
+constexpr UnitNormal kUnitNormal{};
+
+// Mirror image of v about the line along n, 2 * Project(v, n) - v, which
+// is -v when n is zero. A ray travelling along d bounces off a surface with
+// normal n along Reflect(-d, n).
+template <typename vector_type>
+constexpr vector_type Reflect(const vector_type& v, const vector_type& n) {
+  using T = typename vector_type::ValueType;
+  const T length_squared = n.LengthSquared();
+  if (length_squared == static_cast<T>(0)) {
+    return -v;
+  }
+  return n * (static_cast<T>(2) * (n | v) / length_squared) - v;
+}
+
+template <typename vector_type>
+constexpr vector_type Reflect(const vector_type& v, const vector_type& n,
+                              UnitNormal) {
+  using T = typename vector_type::ValueType;
+  return n * (static_cast<T>(2) * (n | v)) - v;
+}
+
+// Direction of a ray travelling along incident after it crosses a surface
+// with normal n facing against it, eta is the ratio of the refractive index
+// it leaves to the one it enters. Returns the zero vector on total internal
+// reflection and, for the overload that normalizes n, when n is zero. Same
+// as GLSL refract.
 template <typename vector_type>
-vector_type Reflect(const vector_type& v, const vector_type& n) {
-  const auto normalized = Normalize(n);
-  const auto projected = n * (normalized | v);
-  return (projected * 2.0f) - v;
+vector_type Refract(const vector_type& incident, const vector_type& n,
+                    typename vector_type::ValueType eta, UnitNormal) {
+  using T = typename vector_type::ValueType;
+  using std::sqrt;
+  const T cosine = n | incident;
+  const T k = static_cast<T>(1) - eta * eta * (static_cast<T>(1) -
+                                               cosine * cosine);
+  if (k < static_cast<T>(0)) {
+    return vector_type{};
+  }
+  return incident * eta - n * (eta * cosine + sqrt(k));
 }
 
 template <typename vector_type>
-vector_type Project(const vector_type& v1, const vector_type& v2) {
+vector_type Refract(const vector_type& incident, const vector_type& n,
+                    typename vector_type::ValueType eta) {
+  using T = typename vector_type::ValueType;
+  if (n.LengthSquared() == static_cast<T>(0)) {
+    return vector_type{};
+  }
+  return Refract(incident, Normalize(n), eta, kUnitNormal);
+}
+
+template <typename vector_type>
+constexpr vector_type Project(const vector_type& v1, const vector_type& v2) {
   // vii = (v2 / || v2 ||) * (cos (angle) * || v1 ||)
   // vii = (v2 / || v2 ||) * ((cos (angle) * || v1 ||) * (||v2|| / ||v2||)
   // vii = v2 * ((cos(angle) * || v1|| * ||v2||)/ (||v2|| * ||v2||))
   // vii = v2 * (v1 | v2) / || v2 || ^ 2
-  const typename vector_type::ValueType v2Length = Length(v2);
-  return v2 * ((v1 | v2) / (v2Length * v2Length));
+  // The zero vector when v2 is zero.
+  return v1.ProjectOnTo(v2);
+}
+
+// Component of v1 perpendicular to v2, v1 itself when v2 is zero.
+template <typename vector_type>
+constexpr vector_type Reject(const vector_type& v1, const vector_type& v2) {
+  return v1 - v1.ProjectOnTo(v2);
+}
+
+// Writes Project(v1[i], v2[i]) to out[i]. out may alias v1 or v2.
+template <typename vector_type>
+void Project(Span<const vector_type> v1, Span<const vector_type> v2,
+             Span<vector_type> out) {
+  assert(v2.size() >= v1.size() && out.size() >= v1.size());
+  for (std::size_t i = 0; i < v1.size(); ++i) {
+    out[i] = v1[i].ProjectOnTo(v2[i]);
+  }
+}
+
+// Writes Project(v[i], onto) to out[i]. The division by the squared length
+// of onto happens once for the whole span. out may alias v.
+template <typename vector_type>
+void Project(Span<const vector_type> v, const vector_type& onto,
+             Span<vector_type> out) {
+  assert(out.size() >= v.size());
+  using T = typename vector_type::ValueType;
+  const T length_squared = onto.LengthSquared();
+  const vector_type scaled_onto = length_squared == static_cast<T>(0)
+                                      ? vector_type{}
+                                      : onto / length_squared;
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    out[i] = scaled_onto * (v[i] | onto);
+  }
+}
+
+// Writes Reject(v1[i], v2[i]) to out[i]. out may alias v1 or v2.
+template <typename vector_type>
+void Reject(Span<const vector_type> v1, Span<const vector_type> v2,
+            Span<vector_type> out) {
+  assert(v2.size() >= v1.size() && out.size() >= v1.size());
+  for (std::size_t i = 0; i < v1.size(); ++i) {
+    out[i] = v1[i] - v1[i].ProjectOnTo(v2[i]);
+  }
+}
+
+// Writes Reject(v[i], onto) to out[i]. out may alias v.
+template <typename vector_type>
+void Reject(Span<const vector_type> v, const vector_type& onto,
+            Span<vector_type> out) {
+  assert(out.size() >= v.size());
+  using T = typename vector_type::ValueType;
+  const T length_squared = onto.LengthSquared();
+  const vector_type scaled_onto = length_squared == static_cast<T>(0)
+                                      ? vector_type{}
+                                      : onto / length_squared;
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    out[i] = v[i] - scaled_onto * (v[i] | onto);
+  }
+}
+
+namespace detail {
+#if defined(DLM_SSE2)
+// Four vectors of N floats as one register per component.
+template <std::size_t N>
+inline void LoadTransposed(const float* values, __m128 (&v)[N]) {
+  if constexpr (N == 2) {
+    simd::LoadTransposed(values, v[0], v[1]);
+  } else if constexpr (N == 3) {
+    simd::LoadTransposed(values, v[0], v[1], v[2]);
+  } else {
+    simd::LoadTransposed(values, v[0], v[1], v[2], v[3]);
+  }
+}
+
+template <std::size_t N>
+inline void StoreTransposed(const __m128 (&v)[N], float* values) {
+  if constexpr (N == 2) {
+    simd::StoreTransposed(v[0], v[1], values);
+  } else if constexpr (N == 3) {
+    simd::StoreTransposed(v[0], v[1], v[2], values);
+  } else {
+    simd::StoreTransposed(v[0], v[1], v[2], v[3], values);
+  }
+}
+
+template <std::size_t N>
+inline __m128 Dot(const __m128 (&a)[N], const __m128 (&b)[N]) {
+  __m128 dot = _mm_mul_ps(a[0], b[0]);
+  simd::Unroll<N - 1>(
+      [&](std::size_t c) { dot = simd::MulAdd(a[c + 1], b[c + 1], dot); });
+  return dot;
+}
+
+// Squared distances of the four vectors of N floats at values to the point
+// whose components are broadcast in point, one distance per lane.
+template <std::size_t N>
+inline __m128 DistanceSquared4(const float* values, const __m128 (&point)[N]) {
+  __m128 difference[N];
+  LoadTransposed(values, difference);
+  simd::Unroll<N>([&](std::size_t c) {
+    difference[c] = _mm_sub_ps(difference[c], point[c]);
+  });
+  return Dot(difference, difference);
+}
+#endif
+
+// Writes DistanceSquared(points[i], point) to out[i] for i < count. Float
+// points are loaded four at a time and transposed so every lane holds one
+// point.
+template <std::size_t N, typename T>
+void DistanceSquared(const Vector<N, T>* points, std::size_t count,
+                     const Vector<N, T>& point, T* out) {
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    static_assert(sizeof(Vector<N, T>) == N * sizeof(T));
+    const float* values = reinterpret_cast<const float*>(points);
+    __m128 components[N];
+    for (std::size_t c = 0; c < N; ++c) {
+      components[c] = _mm_set1_ps(point[static_cast<int>(c)]);
+    }
+    for (; i + 4 <= count; i += 4) {
+      _mm_storeu_ps(out + i, DistanceSquared4(values + i * N, components));
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = DistanceSquared(points[i], point);
+  }
+}
+
+// Index of the smallest of values[0, count), the lowest one on a tie. Returns
+// count when every value is NaN. Float values take two passes, the minimum
+// over independent lanes and then the first index holding it, which keeps
+// the comparisons off the loop carried dependency.
+template <typename T>
+std::size_t ArgMin(const T* values, std::size_t count) {
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    // minps returns its second operand when either is NaN, NaN is skipped.
+    __m128 minimum0 = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    __m128 minimum1 = minimum0;
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+      minimum0 = _mm_min_ps(_mm_loadu_ps(values + i), minimum0);
+      minimum1 = _mm_min_ps(_mm_loadu_ps(values + i + 4), minimum1);
+    }
+    __m128 minimum = _mm_min_ps(minimum0, minimum1);
+    minimum = _mm_min_ps(
+        minimum, _mm_shuffle_ps(minimum, minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+    minimum = _mm_min_ps(
+        minimum, _mm_shuffle_ps(minimum, minimum, _MM_SHUFFLE(2, 3, 0, 1)));
+    float smallest = _mm_cvtss_f32(minimum);
+    for (; i < count; ++i) {
+      smallest = values[i] < smallest ? values[i] : smallest;
+    }
+
+    // No match when every value is NaN.
+    minimum = _mm_set1_ps(smallest);
+    std::size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+      const int equal =
+          _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(values + j), minimum));
+      if (equal != 0) {
+        for (int lane = 0;; ++lane) {
+          if ((equal >> lane) & 1) {
+            return j + static_cast<std::size_t>(lane);
+          }
+        }
+      }
+    }
+    for (; j < count; ++j) {
+      if (values[j] == smallest) {
+        return j;
+      }
+    }
+    return count;
+  }
+#endif
+  std::size_t best = count;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (values[i] == values[i] && (best == count || values[i] < values[best])) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+// Replaces every element of values with its square root.
+template <typename T>
+void Sqrt(T* values, std::size_t count) {
+  constexpr std::size_t kLanes = 64 / sizeof(T);
+  std::size_t i = 0;
+  for (; i + kLanes <= count; i += kLanes) {
+    T block[kLanes];
+    std::copy_n(values + i, kLanes, block);
+    simd::Sqrt(block);
+    std::copy_n(block, kLanes, values + i);
+  }
+  for (; i < count; ++i) {
+    values[i] = std::sqrt(values[i]);
+  }
+}
+}  // namespace detail
+
+// Writes DistanceSquared(points[i], point) to out[i].
+template <std::size_t N, typename T>
+void DistanceSquared(Span<const Vector<N, T>> points, const Vector<N, T>& point,
+                     Span<T> out) {
+  assert(out.size() >= points.size());
+  detail::DistanceSquared(points.data(), points.size(), point, out.data());
+}
+
+// Writes Distance(points[i], point) to out[i].
+template <std::size_t N, typename T>
+void Distance(Span<const Vector<N, T>> points, const Vector<N, T>& point,
+              Span<T> out) {
+  assert(out.size() >= points.size());
+  detail::DistanceSquared(points.data(), points.size(), point, out.data());
+  detail::Sqrt(out.data(), points.size());
+}
+
+// Writes DistanceSquared(a[i], b[j]) to out[i * b.size() + j], one row per
+// element of a. The rows are split over up to threads threads, 0 uses one
+// per hardware thread, small inputs run on the calling thread.
+template <std::size_t N, typename T>
+void PairwiseDistanceSquared(Span<const Vector<N, T>> a,
+                             Span<const Vector<N, T>> b, Span<T> out,
+                             std::size_t threads = 0) {
+  assert(out.size() >= a.size() * b.size());
+  dlm::detail::ParallelFor(
+      a.size(), dlm::detail::ThreadCount(threads, a.size() * b.size()),
+      [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          detail::DistanceSquared(b.data(), b.size(), a[i],
+                                  out.data() + i * b.size());
+        }
+      });
+}
+
+// Writes Distance(a[i], b[j]) to out[i * b.size() + j], see
+// PairwiseDistanceSquared.
+template <std::size_t N, typename T>
+void PairwiseDistance(Span<const Vector<N, T>> a, Span<const Vector<N, T>> b,
+                      Span<T> out, std::size_t threads = 0) {
+  assert(out.size() >= a.size() * b.size());
+  dlm::detail::ParallelFor(
+      a.size(), dlm::detail::ThreadCount(threads, a.size() * b.size()),
+      [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          detail::DistanceSquared(b.data(), b.size(), a[i],
+                                  out.data() + i * b.size());
+        }
+        detail::Sqrt(out.data() + begin * b.size(), (end - begin) * b.size());
+      });
+}
+
+namespace detail {
+// Adds candidate to best, a max heap of at most k > 0 (distance, index)
+// pairs with the worst on top, unless its distance is NaN or best is full
+// and it is not less than the top. Shared by every KNearest so they break
+// ties alike.
+template <typename T>
+void PushNearest(std::vector<std::pair<T, std::size_t>>& best, std::size_t k,
+                 const std::pair<T, std::size_t>& candidate) {
+  assert(k != 0);
+  if (!(candidate.first == candidate.first)) {
+    return;
+  }
+  if (best.size() < k) {
+    best.push_back(candidate);
+    std::push_heap(best.begin(), best.end());
+  } else if (candidate < best.front()) {
+    std::pop_heap(best.begin(), best.end());
+    best.back() = candidate;
+    std::push_heap(best.begin(), best.end());
+  }
+}
+
+// Nearest over points[begin, end) as (distance squared, index), index end
+// when there is none.
+template <std::size_t N, typename T>
+std::pair<T, std::size_t> Nearest(Span<const Vector<N, T>> points,
+                                  std::size_t begin, std::size_t end,
+                                  const Vector<N, T>& point) {
+  constexpr std::size_t kBlock = 256;
+  T distances[kBlock];
+  std::pair<T, std::size_t> nearest{static_cast<T>(0), end};
+  for (std::size_t block = begin; block < end; block += kBlock) {
+    const std::size_t count = std::min(kBlock, end - block);
+    DistanceSquared(points.data() + block, count, point, distances);
+    const std::size_t i = ArgMin(distances, count);
+    if (i != count && (nearest.second == end || distances[i] < nearest.first)) {
+      nearest = {distances[i], block + i};
+    }
+  }
+  return nearest;
+}
+
+// Fills best with the k closest of points[begin, end) as a max heap of
+// (distance squared, index), the worst on top.
+template <std::size_t N, typename T>
+void KNearest(Span<const Vector<N, T>> points, std::size_t begin,
+              std::size_t end, const Vector<N, T>& point, std::size_t k,
+              std::vector<std::pair<T, std::size_t>>& best) {
+  constexpr std::size_t kBlock = 256;
+  T distances[kBlock];
+  best.clear();
+  best.reserve(k);
+  // Distance a point has to beat once best is full. NaN never does.
+  T threshold = static_cast<T>(0);
+  for (std::size_t block = begin; block < end; block += kBlock) {
+    const std::size_t count = std::min(kBlock, end - block);
+    DistanceSquared(points.data() + block, count, point, distances);
+    std::size_t i = 0;
+    for (; i < count && best.size() < k; ++i) {
+      PushNearest(best, k, {distances[i], block + i});
+    }
+    if (!best.empty()) {
+      threshold = best.front().first;
+    }
+    for (; i < count; ++i) {
+      // Indices only grow, so an equal distance never replaces the top.
+      if (distances[i] < threshold) {
+        PushNearest(best, k, {distances[i], block + i});
+        threshold = best.front().first;
+      }
+    }
+  }
+}
+}  // namespace detail
+
+// Index of the element of points closest to point, the lowest one on a tie.
+// Returns points.size() when points is empty or every distance is NaN. The
+// points are split over up to threads threads, 0 uses one per hardware
+// thread, small inputs run on the calling thread. The result does not
+// depend on the number of threads.
+template <std::size_t N, typename T>
+std::size_t Nearest(Span<const Vector<N, T>> points, const Vector<N, T>& point,
+                    std::size_t threads = 0) {
+  const std::size_t count = points.size();
+  threads = dlm::detail::ThreadCount(threads, count);
+  if (threads == 1) {
+    return detail::Nearest(points, 0, count, point).second;
+  }
+  std::vector<std::pair<T, std::size_t>> chunks(threads);
+  dlm::detail::ParallelFor(threads, threads, [&](std::size_t t, std::size_t) {
+    chunks[t] = detail::Nearest(points, count * t / threads,
+                                count * (t + 1) / threads, point);
+  });
+  // In chunk order, so a tie keeps the lower index.
+  std::size_t nearest = count;
+  T nearest_distance = static_cast<T>(0);
+  for (std::size_t t = 0; t < threads; ++t) {
+    const std::size_t end = count * (t + 1) / threads;
+    if (chunks[t].second != end &&
+        (nearest == count || chunks[t].first < nearest_distance)) {
+      nearest = chunks[t].second;
+      nearest_distance = chunks[t].first;
+    }
+  }
+  return nearest;
+}
+
+// Writes the indices of the out.size() elements of points closest to point
+// to out, closest first and the lower index first on a tie. Returns the
+// number of indices written, which is smaller than out.size() when points
+// has fewer elements that are not at a NaN distance. Threads as in Nearest.
+template <std::size_t N, typename T>
+std::size_t KNearest(Span<const Vector<N, T>> points, const Vector<N, T>& point,
+                     Span<std::size_t> out, std::size_t threads = 0) {
+  const std::size_t k = out.size();
+  if (k == 0) {
+    return 0;
+  }
+  const std::size_t count = points.size();
+  std::vector<std::pair<T, std::size_t>> best;
+  threads = dlm::detail::ThreadCount(threads, count);
+  if (threads == 1) {
+    detail::KNearest(points, 0, count, point, k, best);
+    std::sort_heap(best.begin(), best.end());
+  } else {
+    // The k best of every chunk, merged by (distance, index) so ties keep
+    // the lower index whatever the split.
+    std::vector<std::vector<std::pair<T, std::size_t>>> chunks(threads);
+    dlm::detail::ParallelFor(threads, threads, [&](std::size_t t, std::size_t) {
+      detail::KNearest(points, count * t / threads, count * (t + 1) / threads,
+                       point, k, chunks[t]);
+    });
+    for (const auto& chunk : chunks) {
+      best.insert(best.end(), chunk.begin(), chunk.end());
+    }
+    const std::size_t found = std::min(k, best.size());
+    std::partial_sort(best.begin(), best.begin() + found, best.end());
+    best.resize(found);
+  }
+  for (std::size_t i = 0; i < best.size(); ++i) {
+    out[i] = best[i].second;
+  }
+  return best.size();
+}
+
+namespace detail {
+// Span Reflect, kUnit skips normalizing n. Float vectors are processed four
+// at a time, transposed so every lane holds one vector. Each block is loaded
+// before it is stored, out may alias v or n.
+template <bool kUnit, std::size_t N, typename T>
+void Reflect(const Vector<N, T>* v, const Vector<N, T>* n, std::size_t count,
+             Vector<N, T>* out) {
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    const __m128 two = _mm_set1_ps(2.0f);
+    for (; i + 4 <= count; i += 4) {
+      __m128 v4[N], n4[N];
+      LoadTransposed(&v[i].x, v4);
+      LoadTransposed(&n[i].x, n4);
+      __m128 scale = _mm_mul_ps(two, Dot(n4, v4));
+      if constexpr (!kUnit) {
+        // Zero normals get a zero scale instead of 0 / 0, so -v.
+        const __m128 length_squared = Dot(n4, n4);
+        scale = _mm_and_ps(
+            _mm_div_ps(scale, length_squared),
+            _mm_cmpneq_ps(length_squared, _mm_setzero_ps()));
+      }
+      simd::Unroll<N>([&](std::size_t c) {
+        v4[c] = _mm_sub_ps(_mm_mul_ps(n4[c], scale), v4[c]);
+      });
+      StoreTransposed(v4, &out[i].x);
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    if constexpr (kUnit) {
+      out[i] = vector::Reflect(v[i], n[i], kUnitNormal);
+    } else {
+      out[i] = vector::Reflect(v[i], n[i]);
+    }
+  }
+}
+
+// Span Refract, see Reflect.
+template <bool kUnit, std::size_t N, typename T>
+void Refract(const Vector<N, T>* incident, const Vector<N, T>* n, T eta,
+             std::size_t count, Vector<N, T>* out) {
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 eta4 = _mm_set1_ps(eta);
+    const __m128 eta_squared = _mm_set1_ps(eta * eta);
+    for (; i + 4 <= count; i += 4) {
+      __m128 incident4[N], n4[N];
+      LoadTransposed(&incident[i].x, incident4);
+      LoadTransposed(&n[i].x, n4);
+      __m128 nonzero = _mm_castsi128_ps(_mm_set1_epi32(-1));
+      if constexpr (!kUnit) {
+        const __m128 length_squared = Dot(n4, n4);
+        nonzero = _mm_cmpneq_ps(length_squared, _mm_setzero_ps());
+        const __m128 length = _mm_sqrt_ps(length_squared);
+        simd::Unroll<N>(
+            [&](std::size_t c) { n4[c] = _mm_div_ps(n4[c], length); });
+      }
+      const __m128 cosine = Dot(n4, incident4);
+      const __m128 k = _mm_sub_ps(
+          one, _mm_mul_ps(eta_squared,
+                          _mm_sub_ps(one, _mm_mul_ps(cosine, cosine))));
+      // Lanes with total internal reflection or a zero normal are cleared.
+      const __m128 refracts =
+          _mm_and_ps(nonzero, _mm_cmpge_ps(k, _mm_setzero_ps()));
+      const __m128 scale = _mm_add_ps(
+          _mm_mul_ps(eta4, cosine), _mm_sqrt_ps(_mm_and_ps(refracts, k)));
+      simd::Unroll<N>([&](std::size_t c) {
+        incident4[c] = _mm_and_ps(
+            refracts, _mm_sub_ps(_mm_mul_ps(incident4[c], eta4),
+                                 _mm_mul_ps(n4[c], scale)));
+      });
+      StoreTransposed(incident4, &out[i].x);
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    if constexpr (kUnit) {
+      out[i] = vector::Refract(incident[i], n[i], eta, kUnitNormal);
+    } else {
+      out[i] = vector::Refract(incident[i], n[i], eta);
+    }
+  }
+}
+}  // namespace detail
+
+// Writes Reflect(v[i], n[i]) to out[i]. out may alias v or n.
+template <std::size_t N, typename T>
+void Reflect(Span<const Vector<N, T>> v, Span<const Vector<N, T>> n,
+             Span<Vector<N, T>> out) {
+  assert(n.size() >= v.size() && out.size() >= v.size());
+  detail::Reflect<false>(v.data(), n.data(), v.size(), out.data());
+}
+
+template <std::size_t N, typename T>
+void Reflect(Span<const Vector<N, T>> v, Span<const Vector<N, T>> n,
+             Span<Vector<N, T>> out, UnitNormal) {
+  assert(n.size() >= v.size() && out.size() >= v.size());
+  detail::Reflect<true>(v.data(), n.data(), v.size(), out.data());
+}
+
+// Writes Refract(incident[i], n[i], eta) to out[i]. out may alias incident
+// or n.
+template <std::size_t N, typename T>
+void Refract(Span<const Vector<N, T>> incident, Span<const Vector<N, T>> n,
+             T eta, Span<Vector<N, T>> out) {
+  assert(n.size() >= incident.size() && out.size() >= incident.size());
+  detail::Refract<false>(incident.data(), n.data(), eta, incident.size(),
+                         out.data());
+}
+
+template <std::size_t N, typename T>
+void Refract(Span<const Vector<N, T>> incident, Span<const Vector<N, T>> n,
+             T eta, Span<Vector<N, T>> out, UnitNormal) {
+  assert(n.size() >= incident.size() && out.size() >= incident.size());
+  detail::Refract<true>(incident.data(), n.data(), eta, incident.size(),
+                        out.data());
 }
 
 }  // namespace vector
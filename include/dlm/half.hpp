@@ -0,0 +1,300 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "dlm/config.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector.hpp"
+
+#if defined(DLM_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace dlm {
+
+namespace detail {
+// Round to nearest even, overflow goes to infinity and NaN stays NaN.
+inline std::uint16_t FloatToHalf(float value) {
+#if defined(DLM_F16C)
+  return static_cast<std::uint16_t>(
+      _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const std::uint32_t sign = (bits >> 16) & 0x8000u;
+  bits &= 0x7FFFFFFFu;
+
+  std::uint32_t half;
+  if (bits >= 0x47800000u) {
+    // 65536 and above, infinity and NaN.
+    half = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+  } else if (bits < 0x38800000u) {
+    // Below 2^-14 the result is subnormal or zero. Adding 0.5 moves the ten
+    // mantissa bits to the bottom of the float and lets the addition do the
+    // rounding.
+    float magnitude;
+    std::memcpy(&magnitude, &bits, sizeof(magnitude));
+    magnitude += 0.5f;
+    std::memcpy(&bits, &magnitude, sizeof(bits));
+    half = bits - 0x3F000000u;
+  } else {
+    // Rebias the exponent and round the 13 dropped bits to nearest even,
+    // a carry out of the mantissa correctly bumps the exponent.
+    const std::uint32_t odd = (bits >> 13) & 1u;
+    half = (bits - 0x38000000u + 0xFFFu + odd) >> 13;
+  }
+  return static_cast<std::uint16_t>(half | sign);
+#endif
+}
+
+// Exact, every half is a float.
+inline float HalfToFloat(std::uint16_t half) {
+#if defined(DLM_F16C)
+  return _cvtsh_ss(half);
+#else
+  std::uint32_t bits = static_cast<std::uint32_t>(half & 0x7FFFu) << 13;
+  const std::uint32_t exponent = bits & 0x0F800000u;
+  bits += 0x38000000u;
+  float value;
+  if (exponent == 0x0F800000u) {
+    // Infinity and NaN.
+    bits += 0x38000000u;
+    std::memcpy(&value, &bits, sizeof(value));
+  } else if (exponent == 0) {
+    // Zero and subnormals, renormalized by the float subtraction.
+    bits += 0x00800000u;
+    std::memcpy(&value, &bits, sizeof(value));
+    value -= 6.103515625e-05f;
+  } else {
+    std::memcpy(&value, &bits, sizeof(value));
+  }
+  return (half & 0x8000u) != 0 ? -value : value;
+#endif
+}
+
+#if defined(DLM_SSE2) && !defined(DLM_F16C)
+// FloatToHalf on four lanes with integer SSE2, the same steps and results.
+// The halves come back sign extended to 32 bits so that a signed pack to 16
+// bits keeps them exact.
+inline __m128i FloatToHalf(__m128 value) {
+  const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+  const __m128 sign = _mm_and_ps(value, sign_mask);
+  const __m128 magnitude = _mm_xor_ps(value, sign);
+  const __m128i bits = _mm_castps_si128(magnitude);
+
+  const __m128i is_nan =
+      _mm_castps_si128(_mm_cmpunord_ps(magnitude, magnitude));
+  const __m128i is_finite = _mm_cmpgt_epi32(_mm_set1_epi32(0x47800000), bits);
+  const __m128i is_subnormal =
+      _mm_cmpgt_epi32(_mm_set1_epi32(0x38800000), bits);
+
+  const __m128i infinity_or_nan = _mm_or_si128(
+      _mm_and_si128(is_nan, _mm_set1_epi32(0x0200)), _mm_set1_epi32(0x7C00));
+  const __m128i subnormal = _mm_sub_epi32(
+      _mm_castps_si128(_mm_add_ps(magnitude, _mm_set1_ps(0.5f))),
+      _mm_set1_epi32(0x3F000000));
+  const __m128i odd = _mm_srli_epi32(_mm_slli_epi32(bits, 18), 31);
+  const __m128i normal = _mm_srli_epi32(
+      _mm_add_epi32(_mm_add_epi32(bits, _mm_set1_epi32(0xFFF - 0x38000000)),
+                    odd),
+      13);
+
+  const __m128i finite =
+      _mm_or_si128(_mm_and_si128(is_subnormal, subnormal),
+                   _mm_andnot_si128(is_subnormal, normal));
+  const __m128i half =
+      _mm_or_si128(_mm_and_si128(is_finite, finite),
+                   _mm_andnot_si128(is_finite, infinity_or_nan));
+  return _mm_or_si128(half, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+// HalfToFloat on four halves zero extended to 32 bit lanes. Scaling by
+// 2^112 rebiases the exponent and normalizes subnormals in one multiply.
+inline __m128 HalfToFloat(__m128i half) {
+  const __m128i magnitude = _mm_and_si128(half, _mm_set1_epi32(0x7FFF));
+  const __m128i sign = _mm_slli_epi32(_mm_xor_si128(half, magnitude), 16);
+  const __m128 scaled =
+      _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(magnitude, 13)),
+                 _mm_castsi128_ps(_mm_set1_epi32(0x77800000)));
+  const __m128i infinity_or_nan = _mm_and_si128(
+      _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7BFF)),
+      _mm_set1_epi32(0x7F800000));
+  return _mm_or_ps(scaled,
+                   _mm_castsi128_ps(_mm_or_si128(sign, infinity_or_nan)));
+}
+#endif
+}  // namespace detail
+
+// IEEE 754 binary16, a storage type for buffers that are bound by memory
+// bandwidth. It holds 11 significant bits and values up to 65504. The
+// arithmetic is done in float and rounded once to half, which gives the
+// correctly rounded result for + - * / and sqrt.
+struct Half {
+  constexpr Half() : bits{0} {};
+  explicit Half(float value) : bits{detail::FloatToHalf(value)} {};
+
+  static constexpr Half FromBits(std::uint16_t bits) {
+    Half half;
+    half.bits = bits;
+    return half;
+  }
+
+  explicit operator float() const { return detail::HalfToFloat(bits); }
+
+  constexpr Half operator-() const {
+    return FromBits(static_cast<std::uint16_t>(bits ^ 0x8000u));
+  }
+
+  Half& operator+=(Half h);
+  Half& operator-=(Half h);
+  Half& operator*=(Half h);
+  Half& operator/=(Half h);
+
+  std::uint16_t bits;
+};
+
+static_assert(std::is_trivially_copyable<Half>::value);
+static_assert(sizeof(Half) == 2);
+
+inline Half operator+(Half a, Half b) {
+  return Half{static_cast<float>(a) + static_cast<float>(b)};
+}
+
+inline Half operator-(Half a, Half b) {
+  return Half{static_cast<float>(a) - static_cast<float>(b)};
+}
+
+inline Half operator*(Half a, Half b) {
+  return Half{static_cast<float>(a) * static_cast<float>(b)};
+}
+
+// Division by zero gives inf or NaN, as for float.
+inline Half operator/(Half a, Half b) {
+  return Half{static_cast<float>(a) / static_cast<float>(b)};
+}
+
+inline Half& Half::operator+=(Half h) { return *this = *this + h; }
+
+inline Half& Half::operator-=(Half h) { return *this = *this - h; }
+
+inline Half& Half::operator*=(Half h) { return *this = *this * h; }
+
+inline Half& Half::operator/=(Half h) { return *this = *this / h; }
+
+// Compared as floats, so NaN is unordered and +0 equals -0.
+inline bool operator==(Half a, Half b) {
+  return static_cast<float>(a) == static_cast<float>(b);
+}
+
+inline bool operator!=(Half a, Half b) {
+  return static_cast<float>(a) != static_cast<float>(b);
+}
+
+inline bool operator<(Half a, Half b) {
+  return static_cast<float>(a) < static_cast<float>(b);
+}
+
+inline bool operator<=(Half a, Half b) {
+  return static_cast<float>(a) <= static_cast<float>(b);
+}
+
+inline bool operator>(Half a, Half b) {
+  return static_cast<float>(a) > static_cast<float>(b);
+}
+
+inline bool operator>=(Half a, Half b) {
+  return static_cast<float>(a) >= static_cast<float>(b);
+}
+
+inline Half sqrt(Half h) { return Half{std::sqrt(static_cast<float>(h))}; }
+
+// Bulk conversions, out holds at least in.size() values. With DLM_F16C eight
+// values are converted per instruction, with plain SSE2 eight at a time by
+// the bit manipulations of the scalar conversion.
+inline void ToHalf(Span<const float> in, Span<Half> out) {
+  assert(out.size() >= in.size());
+  const float* source = in.data();
+  Half* destination = out.data();
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#if defined(DLM_F16C)
+  for (; i + 8 <= count; i += 8) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i),
+                     _mm256_cvtps_ph(_mm256_loadu_ps(source + i),
+                                     _MM_FROUND_TO_NEAREST_INT));
+  }
+  for (; i + 4 <= count; i += 4) {
+    _mm_storel_epi64(
+        reinterpret_cast<__m128i*>(destination + i),
+        _mm_cvtps_ph(_mm_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT));
+  }
+#elif defined(DLM_SSE2)
+  for (; i + 8 <= count; i += 8) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i),
+                     _mm_packs_epi32(
+                         detail::FloatToHalf(_mm_loadu_ps(source + i)),
+                         detail::FloatToHalf(_mm_loadu_ps(source + i + 4))));
+  }
+#endif
+  for (; i < count; ++i) {
+    destination[i] = Half{source[i]};
+  }
+}
+
+inline void ToFloat(Span<const Half> in, Span<float> out) {
+  assert(out.size() >= in.size());
+  const Half* source = in.data();
+  float* destination = out.data();
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#if defined(DLM_F16C)
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_ps(destination + i,
+                     _mm256_cvtph_ps(_mm_loadu_si128(
+                         reinterpret_cast<const __m128i*>(source + i))));
+  }
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(destination + i,
+                  _mm_cvtph_ps(_mm_loadl_epi64(
+                      reinterpret_cast<const __m128i*>(source + i))));
+  }
+#elif defined(DLM_SSE2)
+  for (; i + 8 <= count; i += 8) {
+    const __m128i halves =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+    const __m128i zero = _mm_setzero_si128();
+    _mm_storeu_ps(destination + i,
+                  detail::HalfToFloat(_mm_unpacklo_epi16(halves, zero)));
+    _mm_storeu_ps(destination + i + 4,
+                  detail::HalfToFloat(_mm_unpackhi_epi16(halves, zero)));
+  }
+#endif
+  for (; i < count; ++i) {
+    destination[i] = static_cast<float>(source[i]);
+  }
+}
+
+namespace vector {
+// Converts float vectors to half vectors and back, a span of vectors is
+// converted as one array of components.
+template <std::size_t N>
+void Pack(Span<const Vector<N, float>> in, Span<Vector<N, Half>> out) {
+  assert(out.size() >= in.size());
+  ToHalf({reinterpret_cast<const float*>(in.data()), in.size() * N},
+         {reinterpret_cast<Half*>(out.data()), in.size() * N});
+}
+
+template <std::size_t N>
+void Unpack(Span<const Vector<N, Half>> in, Span<Vector<N, float>> out) {
+  assert(out.size() >= in.size());
+  ToFloat({reinterpret_cast<const Half*>(in.data()), in.size() * N},
+          {reinterpret_cast<float*>(out.data()), in.size() * N});
+}
+}  // namespace vector
+
+}  // namespace dlm
@@ -0,0 +1,556 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "dlm/aabb.hpp"
+#include "dlm/config.hpp"
+#include "dlm/geometricfunctions.hpp"
+#include "dlm/simd.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector3.hpp"
+
+namespace dlm {
+namespace geometry {
+
+// The points origin + t * direction for t >= 0. Distances returned by the
+// intersection functions are this t, in units of the length of direction.
+template <typename T>
+struct Ray {
+  vector::Vector3<T> origin;
+  vector::Vector3<T> direction;
+};
+
+// The points p with (normal | p) == distance.
+template <typename T>
+struct Plane {
+  vector::Vector3<T> normal;
+  T distance;
+};
+
+template <typename T>
+struct Sphere {
+  vector::Vector3<T> center;
+  T radius;
+};
+
+template <typename T>
+struct Triangle {
+  vector::Vector3<T> a;
+  vector::Vector3<T> b;
+  vector::Vector3<T> c;
+};
+
+using RayF = Ray<float>;
+using PlaneF = Plane<float>;
+using SphereF = Sphere<float>;
+using TriangleF = Triangle<float>;
+
+static_assert(sizeof(RayF) == 6 * sizeof(float));
+static_assert(sizeof(PlaneF) == 4 * sizeof(float));
+static_assert(sizeof(SphereF) == 4 * sizeof(float));
+static_assert(sizeof(TriangleF) == 9 * sizeof(float));
+
+// Each Intersect returns the distance to the first point of the primitive
+// along the ray, or infinity when the ray misses it. A ray starting inside
+// a sphere or box hits its far side or distance 0. Planes and triangles are
+// hit from either side, a ray lying in one misses it.
+
+template <typename T>
+constexpr T Intersect(const Ray<T>& ray, const Plane<T>& plane) {
+  const T denominator = plane.normal | ray.direction;
+  const T t = (plane.distance - (plane.normal | ray.origin)) / denominator;
+  return denominator != static_cast<T>(0) && t >= static_cast<T>(0)
+             ? t
+             : std::numeric_limits<T>::infinity();
+}
+
+template <typename T>
+T Intersect(const Ray<T>& ray, const Sphere<T>& sphere) {
+  using std::sqrt;
+  const vector::Vector3<T> offset = ray.origin - sphere.center;
+  const T a = ray.direction | ray.direction;
+  const T b = offset | ray.direction;
+  const T c = (offset | offset) - sphere.radius * sphere.radius;
+  const T discriminant = b * b - a * c;
+  if (!(discriminant >= static_cast<T>(0))) {
+    return std::numeric_limits<T>::infinity();
+  }
+  const T root = sqrt(discriminant);
+  const T near = (-b - root) / a;
+  const T t = near >= static_cast<T>(0) ? near : (-b + root) / a;
+  return t >= static_cast<T>(0) ? t : std::numeric_limits<T>::infinity();
+}
+
+namespace detail {
+template <typename T>
+constexpr vector::Vector3<T> Inverse(const vector::Vector3<T>& direction) {
+  return vector::Vector3<T>{static_cast<T>(1), static_cast<T>(1),
+                            static_cast<T>(1)} /
+         direction;
+}
+
+// Slab test with the inverse of the ray direction, shared by every box a
+// ray is tested against.
+template <typename T>
+constexpr T Intersect(const vector::Vector3<T>& origin,
+                      const vector::Vector3<T>& inverse, const AABB3<T>& box) {
+  const vector::Vector3<T> to_min = (box.min - origin) * inverse;
+  const vector::Vector3<T> to_max = (box.max - origin) * inverse;
+  const vector::Vector3<T> entry = vector::Min(to_min, to_max);
+  const vector::Vector3<T> exit = vector::Max(to_min, to_max);
+  T near = entry.x > static_cast<T>(0) ? entry.x : static_cast<T>(0);
+  near = entry.y > near ? entry.y : near;
+  near = entry.z > near ? entry.z : near;
+  T far = exit.x < exit.y ? exit.x : exit.y;
+  far = exit.z < far ? exit.z : far;
+  return near <= far && !box.IsEmpty() ? near
+                                       : std::numeric_limits<T>::infinity();
+}
+}  // namespace detail
+
+// Slab test, an empty box is never hit. The Min and Max of the slab
+// distances drop NaN from a ray parallel to an axis and starting on a face,
+// the same as minps and maxps.
+template <typename T>
+constexpr T Intersect(const Ray<T>& ray, const AABB3<T>& box) {
+  return detail::Intersect(ray.origin, detail::Inverse(ray.direction), box);
+}
+
+// Moller-Trumbore.
+template <typename T>
+constexpr T Intersect(const Ray<T>& ray, const Triangle<T>& triangle) {
+  const vector::Vector3<T> edge1 = triangle.b - triangle.a;
+  const vector::Vector3<T> edge2 = triangle.c - triangle.a;
+  const vector::Vector3<T> p = ray.direction ^ edge2;
+  const T determinant = edge1 | p;
+  const T inverse = static_cast<T>(1) / determinant;
+  const vector::Vector3<T> s = ray.origin - triangle.a;
+  const T u = (s | p) * inverse;
+  const vector::Vector3<T> q = s ^ edge1;
+  const T v = (ray.direction | q) * inverse;
+  const T t = (edge2 | q) * inverse;
+  return determinant != static_cast<T>(0) && u >= static_cast<T>(0) &&
+                 v >= static_cast<T>(0) && u + v <= static_cast<T>(1) &&
+                 t >= static_cast<T>(0)
+             ? t
+             : std::numeric_limits<T>::infinity();
+}
+
+namespace detail {
+#if defined(DLM_SSE2)
+// kCount float lanes of a register, the operations the packets below use
+// on __m128 and, with DLM_AVX, on __m256.
+template <std::size_t kCount>
+struct Lanes;
+
+template <>
+struct Lanes<4> {
+  using Register = __m128;
+  static constexpr std::size_t kCount = 4;
+
+  static Register Broadcast(float value) { return _mm_set1_ps(value); }
+  static Register Zero() { return _mm_setzero_ps(); }
+  static Register Add(Register a, Register b) { return _mm_add_ps(a, b); }
+  static Register Subtract(Register a, Register b) { return _mm_sub_ps(a, b); }
+  static Register Multiply(Register a, Register b) { return _mm_mul_ps(a, b); }
+  static Register Divide(Register a, Register b) { return _mm_div_ps(a, b); }
+  static Register MulAdd(Register a, Register b, Register c) {
+    return simd::MulAdd(a, b, c);
+  }
+  static Register Sqrt(Register a) { return _mm_sqrt_ps(a); }
+  // minps and maxps return b when either lane is NaN.
+  static Register Min(Register a, Register b) { return _mm_min_ps(a, b); }
+  static Register Max(Register a, Register b) { return _mm_max_ps(a, b); }
+  static Register And(Register a, Register b) { return _mm_and_ps(a, b); }
+  static Register Or(Register a, Register b) { return _mm_or_ps(a, b); }
+  // ~a & b.
+  static Register AndNot(Register a, Register b) { return _mm_andnot_ps(a, b); }
+  static Register Less(Register a, Register b) { return _mm_cmplt_ps(a, b); }
+  static Register LessEqual(Register a, Register b) {
+    return _mm_cmple_ps(a, b);
+  }
+  static Register GreaterEqual(Register a, Register b) {
+    return _mm_cmpge_ps(a, b);
+  }
+  // Set for NaN, like !=.
+  static Register NotEqual(Register a, Register b) {
+    return _mm_cmpneq_ps(a, b);
+  }
+  static std::uint32_t Mask(Register a) {
+    return static_cast<std::uint32_t>(_mm_movemask_ps(a));
+  }
+  static void Store(float* p, Register a) { _mm_storeu_ps(p, a); }
+};
+
+#if defined(DLM_AVX)
+template <>
+struct Lanes<8> {
+  using Register = __m256;
+  static constexpr std::size_t kCount = 8;
+
+  static Register Broadcast(float value) { return _mm256_set1_ps(value); }
+  static Register Zero() { return _mm256_setzero_ps(); }
+  static Register Add(Register a, Register b) { return _mm256_add_ps(a, b); }
+  static Register Subtract(Register a, Register b) {
+    return _mm256_sub_ps(a, b);
+  }
+  static Register Multiply(Register a, Register b) {
+    return _mm256_mul_ps(a, b);
+  }
+  static Register Divide(Register a, Register b) { return _mm256_div_ps(a, b); }
+  static Register MulAdd(Register a, Register b, Register c) {
+    return simd::MulAdd(a, b, c);
+  }
+  static Register Sqrt(Register a) { return _mm256_sqrt_ps(a); }
+  static Register Min(Register a, Register b) { return _mm256_min_ps(a, b); }
+  static Register Max(Register a, Register b) { return _mm256_max_ps(a, b); }
+  static Register And(Register a, Register b) { return _mm256_and_ps(a, b); }
+  static Register Or(Register a, Register b) { return _mm256_or_ps(a, b); }
+  static Register AndNot(Register a, Register b) {
+    return _mm256_andnot_ps(a, b);
+  }
+  // The predicates of the SSE compares: ordered, and unordered for !=.
+  static Register Less(Register a, Register b) {
+    return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+  }
+  static Register LessEqual(Register a, Register b) {
+    return _mm256_cmp_ps(a, b, _CMP_LE_OQ);
+  }
+  static Register GreaterEqual(Register a, Register b) {
+    return _mm256_cmp_ps(a, b, _CMP_GE_OQ);
+  }
+  static Register NotEqual(Register a, Register b) {
+    return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ);
+  }
+  static std::uint32_t Mask(Register a) {
+    return static_cast<std::uint32_t>(_mm256_movemask_ps(a));
+  }
+  static void Store(float* p, Register a) { _mm256_storeu_ps(p, a); }
+};
+#endif
+
+// Register version of Intersect for each primitive, templated on the Lanes
+// L. A packet holds L::kCount rays and primitives as one register per float
+// of the struct, lane j of every register belongs to ray j and primitive j.
+template <typename primitive_type>
+struct Packet;
+
+// Same operation order as vector::detail::Dot, so the lanes agree with
+// the SSE span kernels of geometricfunctions.hpp.
+template <typename L, typename R = typename L::Register>
+inline R Dot(const R (&a)[3], const R (&b)[3]) {
+  R dot = L::Multiply(a[0], b[0]);
+  dot = L::MulAdd(a[1], b[1], dot);
+  return L::MulAdd(a[2], b[2], dot);
+}
+
+template <typename L, typename R = typename L::Register>
+inline void Cross(const R (&a)[3], const R (&b)[3], R (&out)[3]) {
+  out[0] = L::Subtract(L::Multiply(a[1], b[2]), L::Multiply(a[2], b[1]));
+  out[1] = L::Subtract(L::Multiply(a[2], b[0]), L::Multiply(a[0], b[2]));
+  out[2] = L::Subtract(L::Multiply(a[0], b[1]), L::Multiply(a[1], b[0]));
+}
+
+template <typename L, typename R = typename L::Register>
+inline void Subtract(const R* a, const R* b, R (&out)[3]) {
+  simd::Unroll<3>([&](std::size_t c) { out[c] = L::Subtract(a[c], b[c]); });
+}
+
+// t where hit is set and infinity elsewhere.
+template <typename L, typename R = typename L::Register>
+inline R HitOrInfinity(R hit, R t) {
+  const R infinity = L::Broadcast(std::numeric_limits<float>::infinity());
+  return L::Or(L::And(hit, t), L::AndNot(hit, infinity));
+}
+
+template <>
+struct Packet<Plane<float>> {
+  static constexpr std::size_t kFloats = 4;
+
+  template <typename L, typename R = typename L::Register>
+  static R Intersect(const R (&ray)[6], const R (&plane)[kFloats]) {
+    const R normal[3] = {plane[0], plane[1], plane[2]};
+    const R origin[3] = {ray[0], ray[1], ray[2]};
+    const R direction[3] = {ray[3], ray[4], ray[5]};
+    const R denominator = Dot<L>(normal, direction);
+    const R t = L::Divide(L::Subtract(plane[3], Dot<L>(normal, origin)),
+                          denominator);
+    const R hit = L::And(L::NotEqual(denominator, L::Zero()),
+                         L::GreaterEqual(t, L::Zero()));
+    return HitOrInfinity<L>(hit, t);
+  }
+};
+
+template <>
+struct Packet<Sphere<float>> {
+  static constexpr std::size_t kFloats = 4;
+
+  template <typename L, typename R = typename L::Register>
+  static R Intersect(const R (&ray)[6], const R (&sphere)[kFloats]) {
+    const R direction[3] = {ray[3], ray[4], ray[5]};
+    R offset[3];
+    Subtract<L>(ray, sphere, offset);
+    const R a = Dot<L>(direction, direction);
+    const R b = Dot<L>(offset, direction);
+    const R c = L::Subtract(Dot<L>(offset, offset),
+                            L::Multiply(sphere[3], sphere[3]));
+    const R discriminant = L::Subtract(L::Multiply(b, b), L::Multiply(a, c));
+    const R crosses = L::GreaterEqual(discriminant, L::Zero());
+    const R root = L::Sqrt(L::And(crosses, discriminant));
+    const R minus_b = L::Subtract(L::Zero(), b);
+    const R near = L::Divide(L::Subtract(minus_b, root), a);
+    const R far = L::Divide(L::Add(minus_b, root), a);
+    const R near_hit = L::GreaterEqual(near, L::Zero());
+    const R t = L::Or(L::And(near_hit, near), L::AndNot(near_hit, far));
+    return HitOrInfinity<L>(L::And(crosses, L::GreaterEqual(t, L::Zero())), t);
+  }
+};
+
+template <>
+struct Packet<AABB3<float>> {
+  static constexpr std::size_t kFloats = 6;
+
+  template <typename L, typename R = typename L::Register>
+  static R Intersect(const R (&ray)[6], const R (&box)[kFloats]) {
+    const R one = L::Broadcast(1.0f);
+    R entry[3];
+    R exit[3];
+    simd::Unroll<3>([&](std::size_t c) {
+      const R inverse = L::Divide(one, ray[3 + c]);
+      const R to_min = L::Multiply(L::Subtract(box[c], ray[c]), inverse);
+      const R to_max = L::Multiply(L::Subtract(box[3 + c], ray[c]), inverse);
+      entry[c] = L::Min(to_min, to_max);
+      exit[c] = L::Max(to_min, to_max);
+    });
+    // Same operand order as the scalar version so NaN is dropped alike.
+    R near = L::Max(entry[0], L::Zero());
+    near = L::Max(entry[1], near);
+    near = L::Max(entry[2], near);
+    R far = L::Min(exit[0], exit[1]);
+    far = L::Min(exit[2], far);
+    // The slabs of an empty box swap into a valid one.
+    const R valid = L::And(L::And(L::LessEqual(box[0], box[3]),
+                                  L::LessEqual(box[1], box[4])),
+                           L::LessEqual(box[2], box[5]));
+    return HitOrInfinity<L>(L::And(L::LessEqual(near, far), valid), near);
+  }
+};
+
+template <>
+struct Packet<Triangle<float>> {
+  static constexpr std::size_t kFloats = 9;
+
+  template <typename L, typename R = typename L::Register>
+  static R Intersect(const R (&ray)[6], const R (&triangle)[kFloats]) {
+    const R zero = L::Zero();
+    const R direction[3] = {ray[3], ray[4], ray[5]};
+    R edge1[3];
+    R edge2[3];
+    R s[3];
+    Subtract<L>(triangle + 3, triangle, edge1);
+    Subtract<L>(triangle + 6, triangle, edge2);
+    Subtract<L>(ray, triangle, s);
+    R p[3];
+    R q[3];
+    Cross<L>(direction, edge2, p);
+    Cross<L>(s, edge1, q);
+    const R determinant = Dot<L>(edge1, p);
+    const R inverse = L::Divide(L::Broadcast(1.0f), determinant);
+    const R u = L::Multiply(Dot<L>(s, p), inverse);
+    const R v = L::Multiply(Dot<L>(direction, q), inverse);
+    const R t = L::Multiply(Dot<L>(edge2, q), inverse);
+    const R inside = L::And(
+        L::And(L::GreaterEqual(u, zero), L::GreaterEqual(v, zero)),
+        L::LessEqual(L::Add(u, v), L::Broadcast(1.0f)));
+    const R hit = L::And(L::And(L::NotEqual(determinant, zero), inside),
+                         L::GreaterEqual(t, zero));
+    return HitOrInfinity<L>(hit, t);
+  }
+};
+
+// Register f of lanes holds float f of the four structs of kFloats floats at
+// values, values + stride, ... A stride of 0 broadcasts one struct.
+template <std::size_t kFloats>
+inline void Gather(const float* values, std::size_t stride,
+                   __m128 (&lanes)[kFloats]) {
+  if constexpr (kFloats == 4) {
+    if (stride == 4) {
+      simd::LoadTransposed(values, lanes[0], lanes[1], lanes[2], lanes[3]);
+      return;
+    }
+  } else if constexpr (kFloats == 6) {
+    // Rays and boxes are two Vector3, the four structs are eight Vector3
+    // whose even ones are the first halves.
+    if (stride == 6) {
+      __m128 low[3];
+      __m128 high[3];
+      simd::LoadTransposed(values, low[0], low[1], low[2]);
+      simd::LoadTransposed(values + 12, high[0], high[1], high[2]);
+      simd::Unroll<3>([&](std::size_t c) {
+        lanes[c] = _mm_shuffle_ps(low[c], high[c], _MM_SHUFFLE(2, 0, 2, 0));
+        lanes[3 + c] = _mm_shuffle_ps(low[c], high[c], _MM_SHUFFLE(3, 1, 3, 1));
+      });
+      return;
+    }
+  } else if constexpr (kFloats == 9) {
+    // Triangles are three Vector3, vertex v of triangle j is Vector3 3j + v
+    // of the twelve loaded into r0, r1 and r2.
+    if (stride == 9) {
+      __m128 r0[3];
+      __m128 r1[3];
+      __m128 r2[3];
+      simd::LoadTransposed(values, r0[0], r0[1], r0[2]);
+      simd::LoadTransposed(values + 12, r1[0], r1[1], r1[2]);
+      simd::LoadTransposed(values + 24, r2[0], r2[1], r2[2]);
+      simd::Unroll<3>([&](std::size_t c) {
+        // _mm_shuffle_ps takes two lanes of its first operand and two of
+        // its second, each vertex combines two such pairs.
+        const __m128 a_high =
+            _mm_shuffle_ps(r1[c], r2[c], _MM_SHUFFLE(1, 1, 2, 2));
+        lanes[c] = _mm_shuffle_ps(r0[c], a_high, _MM_SHUFFLE(2, 0, 3, 0));
+        const __m128 b_low =
+            _mm_shuffle_ps(r0[c], r1[c], _MM_SHUFFLE(0, 0, 1, 1));
+        const __m128 b_high =
+            _mm_shuffle_ps(r1[c], r2[c], _MM_SHUFFLE(2, 2, 3, 3));
+        lanes[3 + c] = _mm_shuffle_ps(b_low, b_high, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 c_low =
+            _mm_shuffle_ps(r0[c], r1[c], _MM_SHUFFLE(1, 1, 2, 2));
+        const __m128 c_high =
+            _mm_shuffle_ps(r2[c], r2[c], _MM_SHUFFLE(3, 3, 0, 0));
+        lanes[6 + c] = _mm_shuffle_ps(c_low, c_high, _MM_SHUFFLE(2, 0, 2, 0));
+      });
+      return;
+    }
+  }
+  simd::Unroll<kFloats>([&](std::size_t f) {
+    lanes[f] = _mm_setr_ps(values[f], values[stride + f],
+                           values[2 * stride + f], values[3 * stride + f]);
+  });
+}
+
+#if defined(DLM_AVX)
+// Eight structs, the first four in the low half of every register.
+template <std::size_t kFloats>
+inline void Gather(const float* values, std::size_t stride,
+                   __m256 (&lanes)[kFloats]) {
+  __m128 low[kFloats];
+  __m128 high[kFloats];
+  Gather(values, stride, low);
+  Gather(values + 4 * stride, stride, high);
+  simd::Unroll<kFloats>([&](std::size_t f) {
+    lanes[f] = _mm256_insertf128_ps(_mm256_castps128_ps256(low[f]), high[f], 1);
+  });
+}
+#endif
+
+// Intersects the pairs of Intersect below from i on, L::kCount at a time
+// while a whole packet is left. Advances i and collects the hit bits the
+// same way. Only one side is gathered per packet, the other once up front.
+template <typename L, typename primitive_type>
+void IntersectPackets(const Ray<float>* rays, std::size_t ray_step,
+                      const primitive_type* primitives, std::size_t count,
+                      float* distances, std::uint64_t* mask, std::size_t& i,
+                      std::uint64_t& bits) {
+  using Packet = detail::Packet<primitive_type>;
+  using R = typename L::Register;
+  constexpr std::size_t kFloats = Packet::kFloats;
+  constexpr std::size_t kLanes = L::kCount;
+  const float* ray_values = reinterpret_cast<const float*>(rays);
+  const float* primitive_values = reinterpret_cast<const float*>(primitives);
+  R ray[6] = {};
+  R primitive[kFloats] = {};
+  if (ray_step == 0) {
+    Gather(ray_values, 0, ray);
+  } else {
+    Gather(primitive_values, 0, primitive);
+  }
+  const R infinity = L::Broadcast(std::numeric_limits<float>::infinity());
+  for (; i + kLanes <= count; i += kLanes) {
+    if (ray_step != 0) {
+      Gather(ray_values + i * 6, 6, ray);
+    } else {
+      Gather(primitive_values + i * kFloats, kFloats, primitive);
+    }
+    const R t = Packet::template Intersect<L>(ray, primitive);
+    L::Store(distances + i, t);
+    bits |= static_cast<std::uint64_t>(L::Mask(L::Less(t, infinity)))
+            << (i % 64);
+    if ((i + kLanes) % 64 == 0) {
+      mask[i / 64] = bits;
+      bits = 0;
+    }
+  }
+}
+#endif
+
+// Writes Intersect(rays[i * ray_step], primitives[i * primitive_step]) to
+// distances[i] for i < count and sets bit i % 64 of mask[i / 64] on a hit,
+// the bits past count in the last word are cleared. One of the steps is 0.
+// Float rays and primitives are intersected eight at a time with DLM_AVX
+// and four at a time otherwise, the one shared by every pair is broadcast
+// once.
+template <typename T, typename primitive_type>
+void Intersect(const Ray<T>* rays, std::size_t ray_step,
+               const primitive_type* primitives, std::size_t primitive_step,
+               std::size_t count, T* distances, std::uint64_t* mask) {
+  std::size_t i = 0;
+  std::uint64_t bits = 0;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    static_assert(sizeof(primitive_type) ==
+                  Packet<primitive_type>::kFloats * sizeof(float));
+#if defined(DLM_AVX)
+    IntersectPackets<Lanes<8>>(rays, ray_step, primitives, count, distances,
+                               mask, i, bits);
+#endif
+    IntersectPackets<Lanes<4>>(rays, ray_step, primitives, count, distances,
+                               mask, i, bits);
+  }
+#endif
+  for (; i < count; ++i) {
+    distances[i] =
+        geometry::Intersect(rays[i * ray_step], primitives[i * primitive_step]);
+    bits |= static_cast<std::uint64_t>(
+                distances[i] < std::numeric_limits<T>::infinity())
+            << (i % 64);
+    if ((i + 1) % 64 == 0) {
+      mask[i / 64] = bits;
+      bits = 0;
+    }
+  }
+  if (count % 64 != 0) {
+    mask[count / 64] = bits;
+  }
+}
+}  // namespace detail
+
+// Intersects ray with every primitive, a Plane, Sphere, AABB3 or Triangle.
+// distances[i] is Intersect(ray, primitives[i]) and bit i % 64 of
+// mask[i / 64] is set when it is a hit, the bits past primitives.size() in
+// the last word are cleared.
+template <typename T, typename primitive_type>
+void Intersect(const Ray<T>& ray, Span<const primitive_type> primitives,
+               Span<T> distances, Span<std::uint64_t> mask) {
+  assert(distances.size() >= primitives.size() &&
+         mask.size() >= (primitives.size() + 63) / 64);
+  detail::Intersect(&ray, 0, primitives.data(), 1, primitives.size(),
+                    distances.data(), mask.data());
+}
+
+// Intersects every ray with primitive, see above.
+template <typename T, typename primitive_type>
+void Intersect(Span<const Ray<T>> rays, const primitive_type& primitive,
+               Span<T> distances, Span<std::uint64_t> mask) {
+  assert(distances.size() >= rays.size() &&
+         mask.size() >= (rays.size() + 63) / 64);
+  detail::Intersect(rays.data(), 1, &primitive, 0, rays.size(),
+                    distances.data(), mask.data());
+}
+
+}  // namespace geometry
+}  // namespace dlm
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dlm/geometricfunctions.hpp"
+#include "dlm/parallel.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector.hpp"
+
+namespace dlm {
+namespace geometry {
+
+// k-d tree over a span of Vector<N, T> points for nearest neighbor and
+// radius queries. Like BVH it refers to the points by index only, the
+// queries take the span again and it has to hold the same points in the
+// same order.
+//
+// The tree is implicit: the range [begin, end) of Indices() is split at
+// its middle, the left half below the plane and the right half above it,
+// down to the first depth at which no range holds more than kMaxLeafSize
+// points, so every leaf is at the same depth. The inner nodes are numbered
+// in heap order, the root 0 and the children of node i 2i + 1 and 2i + 2,
+// and besides the index permutation the tree stores only the splitting
+// plane of each of them, the axis and the coordinate of the median. Splits
+// are along the axis in which the points of the range spread most.
+template <std::size_t N, typename T>
+class KDTree {
+ public:
+  using VectorType = vector::Vector<N, T>;
+
+  static constexpr std::size_t kMaxLeafSize = 8;
+
+  KDTree() = default;
+  // Built in O(n log n) on up to threads threads, 0 uses one per hardware
+  // thread, from a copy of the points that is freed afterwards. The result
+  // does not depend on the number of threads.
+  explicit KDTree(Span<const VectorType> points, std::size_t threads = 0);
+
+  // Same contract as vector::KNearest, the indices of the out.size() points
+  // closest to point, closest first and the lower index first on a tie.
+  // Returns the number of indices written.
+  std::size_t KNearest(Span<const VectorType> points, const VectorType& point,
+                       Span<std::size_t> out) const;
+
+  // KNearest of every query, row q of out holds the k indices of query q.
+  // Entries past the points found are points.size(). The queries are split
+  // over up to threads threads, 0 uses one per hardware thread, small
+  // batches run on the calling thread.
+  void KNearest(Span<const VectorType> points,
+                Span<const VectorType> queries, std::size_t k,
+                Span<std::size_t> out, std::size_t threads = 0) const;
+
+  // Calls function(index, distance_squared) for every point at most radius
+  // from point, in no particular order.
+  template <typename function_type>
+  void ForEachWithin(Span<const VectorType> points, const VectorType& point,
+                     T radius, function_type&& function) const;
+
+  // Replaces out with the indices of the points at most radius from point,
+  // in no particular order. Reusing out avoids allocating per query.
+  void Within(Span<const VectorType> points, const VectorType& point,
+              T radius, std::vector<std::size_t>& out) const;
+
+  Span<const std::uint32_t> Indices() const {
+    return Span<const std::uint32_t>{indices_};
+  }
+
+ private:
+  // Max heap of (distance squared, index), the worst on top.
+  using Heap = std::vector<std::pair<T, std::size_t>>;
+
+  struct Range {
+    std::uint32_t begin;
+    std::uint32_t end;
+    std::uint32_t node;
+    // Squared distance below which no point of the range can be.
+    T bound;
+  };
+
+  // The deepest tree of 2^32 points has 32 levels, and at most one range
+  // per level waits on the stack.
+  static constexpr std::size_t kMaxDepth = 64;
+
+  static std::uint32_t Middle(std::uint32_t begin, std::uint32_t end) {
+    return begin + (end - begin) / 2;
+  }
+
+  // A point and its index, the build sorts copies so it reads memory in
+  // order rather than through the permutation.
+  struct Item {
+    VectorType point;
+    std::uint32_t index;
+  };
+
+  // Inner node node holds [begin, end).
+  void Build(Item* items, std::uint32_t node, std::uint32_t begin,
+             std::uint32_t end, std::size_t threads);
+
+  // Fills best with the k closest points, sorted.
+  void KNearest(Span<const VectorType> points, const VectorType& point,
+                std::size_t k, Heap& best) const;
+
+  std::vector<std::uint32_t> indices_;
+  // Plane of inner node i, the leaves are the nodes past the last one.
+  std::vector<T> splits_;
+  std::vector<std::uint8_t> axes_;
+};
+
+template <std::size_t N, typename T>
+KDTree<N, T>::KDTree(Span<const VectorType> points, std::size_t threads) {
+  assert(points.size() <= std::numeric_limits<std::uint32_t>::max());
+  const auto count = static_cast<std::uint32_t>(points.size());
+  std::vector<Item> items(count);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    items[i] = {points[i], i};
+  }
+  std::size_t leaves = 1;
+  while ((count + leaves - 1) / leaves > kMaxLeafSize) {
+    leaves *= 2;
+  }
+  splits_.resize(leaves - 1);
+  axes_.resize(leaves - 1);
+  Build(items.data(), 0, 0, count, dlm::detail::ThreadCount(threads));
+  indices_.resize(count);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    indices_[i] = items[i].index;
+  }
+}
+
+template <std::size_t N, typename T>
+void KDTree<N, T>::Build(Item* items, std::uint32_t node,
+                         std::uint32_t begin, std::uint32_t end,
+                         std::size_t threads) {
+  if (node >= splits_.size()) {
+    return;
+  }
+  VectorType low = items[begin].point;
+  VectorType high = low;
+  for (std::uint32_t i = begin + 1; i < end; ++i) {
+    low = vector::Min(low, items[i].point);
+    high = vector::Max(high, items[i].point);
+  }
+  int axis = 0;
+  const VectorType spread = high - low;
+  for (int a = 1; a < static_cast<int>(N); ++a) {
+    axis = spread[a] > spread[axis] ? a : axis;
+  }
+  // NaN sorts above everything so the order stays strict.
+  const auto less = [&](const Item& a, const Item& b) {
+    const T first = a.point[axis];
+    const T second = b.point[axis];
+    return first < second || (first == first && second != second);
+  };
+  const std::uint32_t middle = Middle(begin, end);
+  std::nth_element(items + begin, items + middle, items + end, less);
+  splits_[node] = items[middle].point[axis];
+  axes_[node] = static_cast<std::uint8_t>(axis);
+
+  const std::uint32_t left = 2 * node + 1;
+  if (threads > 1 && end - begin >= dlm::detail::kMinParallelCount) {
+    std::thread right(
+        [&] { Build(items, left + 1, middle, end, threads / 2); });
+    Build(items, left, begin, middle, threads - threads / 2);
+    right.join();
+  } else {
+    Build(items, left, begin, middle, threads);
+    Build(items, left + 1, middle, end, threads);
+  }
+}
+
+template <std::size_t N, typename T>
+void KDTree<N, T>::KNearest(Span<const VectorType> points,
+                            const VectorType& point, std::size_t k,
+                            Heap& best) const {
+  assert(points.size() == indices_.size());
+  best.clear();
+  if (k == 0 || indices_.empty()) {
+    return;
+  }
+  Range stack[kMaxDepth];
+  std::size_t size = 0;
+  stack[size++] = {0, static_cast<std::uint32_t>(indices_.size()), 0,
+                   static_cast<T>(0)};
+  while (size != 0) {
+    Range range = stack[--size];
+    // Ranges that cannot hold a point at most as close as the worst found
+    // are skipped, ties still visit since a lower index wins them. NaN
+    // bounds are visited.
+    if (best.size() == k && range.bound > best.front().first) {
+      continue;
+    }
+    // Down to the leaf on the side of point, the other sides on the stack.
+    while (range.node < splits_.size()) {
+      const std::uint32_t middle = Middle(range.begin, range.end);
+      const T offset = point[axes_[range.node]] - splits_[range.node];
+      const T bound = std::max(range.bound, offset * offset);
+      const std::uint32_t left = 2 * range.node + 1;
+      if (offset < static_cast<T>(0)) {
+        stack[size++] = {middle, range.end, left + 1, bound};
+        range.end = middle;
+        range.node = left;
+      } else {
+        stack[size++] = {range.begin, middle, left, bound};
+        range.begin = middle;
+        range.node = left + 1;
+      }
+    }
+    for (std::uint32_t i = range.begin; i < range.end; ++i) {
+      vector::detail::PushNearest(
+          best, k,
+          {vector::DistanceSquared(points[indices_[i]], point), indices_[i]});
+    }
+  }
+  std::sort_heap(best.begin(), best.end());
+}
+
+template <std::size_t N, typename T>
+std::size_t KDTree<N, T>::KNearest(Span<const VectorType> points,
+                                   const VectorType& point,
+                                   Span<std::size_t> out) const {
+  Heap best;
+  best.reserve(out.size());
+  KNearest(points, point, out.size(), best);
+  for (std::size_t i = 0; i < best.size(); ++i) {
+    out[i] = best[i].second;
+  }
+  return best.size();
+}
+
+template <std::size_t N, typename T>
+void KDTree<N, T>::KNearest(Span<const VectorType> points,
+                            Span<const VectorType> queries, std::size_t k,
+                            Span<std::size_t> out,
+                            std::size_t threads) const {
+  assert(out.size() == queries.size() * k);
+  threads = dlm::detail::ThreadCount(threads, queries.size(),
+                                     dlm::detail::kMinParallelQueries);
+  dlm::detail::ParallelFor(
+      queries.size(), threads, [&](std::size_t begin, std::size_t end) {
+        Heap best;
+        best.reserve(k);
+        for (std::size_t q = begin; q < end; ++q) {
+          KNearest(points, queries[q], k, best);
+          for (std::size_t i = 0; i < k; ++i) {
+            out[q * k + i] = i < best.size() ? best[i].second : points.size();
+          }
+        }
+      });
+}
+
+template <std::size_t N, typename T>
+template <typename function_type>
+void KDTree<N, T>::ForEachWithin(Span<const VectorType> points,
+                                 const VectorType& point, T radius,
+                                 function_type&& function) const {
+  assert(points.size() == indices_.size());
+  if (indices_.empty() || !(radius >= static_cast<T>(0))) {
+    return;
+  }
+  const T radius_squared = radius * radius;
+  Range stack[kMaxDepth];
+  std::size_t size = 0;
+  stack[size++] = {0, static_cast<std::uint32_t>(indices_.size()), 0,
+                   static_cast<T>(0)};
+  while (size != 0) {
+    Range range = stack[--size];
+    while (range.node < splits_.size()) {
+      const std::uint32_t middle = Middle(range.begin, range.end);
+      const T offset = point[axes_[range.node]] - splits_[range.node];
+      const bool far_side = !(offset * offset > radius_squared);
+      const std::uint32_t left = 2 * range.node + 1;
+      if (offset < static_cast<T>(0)) {
+        if (far_side) {
+          stack[size++] = {middle, range.end, left + 1, static_cast<T>(0)};
+        }
+        range.end = middle;
+        range.node = left;
+      } else {
+        if (far_side) {
+          stack[size++] = {range.begin, middle, left, static_cast<T>(0)};
+        }
+        range.begin = middle;
+        range.node = left + 1;
+      }
+    }
+    for (std::uint32_t i = range.begin; i < range.end; ++i) {
+      const T distance_squared =
+          vector::DistanceSquared(points[indices_[i]], point);
+      if (distance_squared <= radius_squared) {
+        function(static_cast<std::size_t>(indices_[i]), distance_squared);
+      }
+    }
+  }
+}
+
+template <std::size_t N, typename T>
+void KDTree<N, T>::Within(Span<const VectorType> points,
+                          const VectorType& point, T radius,
+                          std::vector<std::size_t>& out) const {
+  out.clear();
+  ForEachWithin(points, point, radius,
+                [&](std::size_t index, T) { out.push_back(index); });
+}
+
+template <typename T>
+using KDTree2 = KDTree<2, T>;
+template <typename T>
+using KDTree3 = KDTree<3, T>;
+using KDTree2F = KDTree2<float>;
+using KDTree3F = KDTree3<float>;
+
+}  // namespace geometry
+}  // namespace dlm
@@ -1,105 +1,243 @@
 #pragma once
 
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+
+#include "simd.hpp"
+#include "span.hpp"
 #include "vector2.hpp"
 
 namespace dlm {
 namespace matrix {
+// Row major, the four elements are contiguous. Matrix2x2<float> is aligned
+// to 16 bytes so it loads into a single SSE register, other element types
+// keep their natural alignment.
 template <typename T>
-struct Matrix2x2 {
+struct alignas(std::is_same<T, float>::value ? 16 : alignof(T)) Matrix2x2 {
   using ValueType = T;
   using RowType = vector::Vector2<T>;
   using ColumnType = vector::Vector2<T>;
 
-  Matrix2x2()
+  constexpr Matrix2x2()
       : data{RowType{static_cast<T>(1), static_cast<T>(0)},
              RowType{static_cast<T>(0), static_cast<T>(1)}} {};
 
-  Matrix2x2(T m11, T m12, T m21, T m22)
+  constexpr Matrix2x2(T m11, T m12, T m21, T m22)
       : data{RowType{m11, m12}, RowType{m21, m22}} {};
 
-  Matrix2x2(const RowType& row1, const RowType& row2) : data{row1, row2} {};
-
-  // Destructors
-  ~Matrix2x2(){};
+  constexpr Matrix2x2(const RowType& row1, const RowType& row2)
+      : data{row1, row2} {};
 
   // Operators
-  Matrix2x2<T> operator-(T scalar) const;
-  Matrix2x2<T> operator-(const Matrix2x2<T>& other) const;
-  Matrix2x2<T>& operator-=(T scalar);
-  Matrix2x2<T>& operator-=(const Matrix2x2<T>& other);
+  constexpr Matrix2x2<T> operator-(T scalar) const;
+  constexpr Matrix2x2<T> operator-(const Matrix2x2<T>& other) const;
+  constexpr Matrix2x2<T>& operator-=(T scalar);
+  constexpr Matrix2x2<T>& operator-=(const Matrix2x2<T>& other);
+
+  constexpr Matrix2x2<T> operator+(T scalar) const;
+  constexpr Matrix2x2<T> operator+(const Matrix2x2<T>& other) const;
+  constexpr Matrix2x2<T>& operator+=(T scalar);
+  constexpr Matrix2x2<T>& operator+=(const Matrix2x2<T>& other);
+
+  constexpr Matrix2x2<T> operator*(const Matrix2x2<T>& other) const;
+  constexpr Matrix2x2<T>& operator*=(const Matrix2x2<T>& other);
 
-  Matrix2x2<T> operator+(T scalar) const;
-  Matrix2x2<T> operator+(const Matrix2x2<T>& other) const;
-  Matrix2x2<T>& operator+=(T scalar);
-  Matrix2x2<T>& operator+=(const Matrix2x2<T>& other);
+  // Transforms a column vector
+  constexpr ColumnType operator*(const ColumnType& v) const;
 
-  const RowType operator[](int index) const;
-  RowType& operator[](int index);
+  constexpr const RowType operator[](int index) const;
+  constexpr RowType& operator[](int index);
+
+  // Helper functions
+  constexpr Matrix2x2<T> Transpose() const;
+  constexpr T Determinant() const;
+
+  // Undefined for singular matrices, use TryInverse when the matrix may be
+  // singular.
+  constexpr Matrix2x2<T> Inverse() const;
+  // Writes the inverse and returns true when |determinant| > tolerance,
+  // otherwise returns false and leaves inverse untouched.
+  constexpr bool TryInverse(Matrix2x2<T>& inverse,
+                            T tolerance = static_cast<T>(0)) const;
 
  private:
   RowType data[2];
 };
 
 template <typename T>
-Matrix2x2<T> Matrix2x2<T>::operator-(T scalar) const {
+constexpr Matrix2x2<T> Matrix2x2<T>::operator-(T scalar) const {
   return {{data[0] - scalar}, {data[1] - scalar}};
 }
 
 template <typename T>
-Matrix2x2<T> Matrix2x2<T>::operator-(const Matrix2x2<T>& other) const {
+constexpr Matrix2x2<T> Matrix2x2<T>::operator-(
+    const Matrix2x2<T>& other) const {
   return {data[0] - other[0], data[1] - other[1]};
 }
 
 template <typename T>
-Matrix2x2<T>& Matrix2x2<T>::operator-=(T scalar) {
+constexpr Matrix2x2<T>& Matrix2x2<T>::operator-=(T scalar) {
   data[0] -= scalar;
   data[1] -= scalar;
   return *this;
 }
 
 template <typename T>
-Matrix2x2<T>& Matrix2x2<T>::operator-=(const Matrix2x2<T>& other) {
+constexpr Matrix2x2<T>& Matrix2x2<T>::operator-=(const Matrix2x2<T>& other) {
   data[0] -= other[0];
   data[1] -= other[1];
   return *this;
 }
 
 template <typename T>
-Matrix2x2<T> Matrix2x2<T>::operator+(T scalar) const {
+constexpr Matrix2x2<T> Matrix2x2<T>::operator+(T scalar) const {
   return {data[0] + scalar, data[1] + scalar};
 }
 
 template <typename T>
-Matrix2x2<T> Matrix2x2<T>::operator+(const Matrix2x2<T>& other) const {
+constexpr Matrix2x2<T> Matrix2x2<T>::operator+(
+    const Matrix2x2<T>& other) const {
   return {data[0] + other[0], data[1] + other[1]};
 }
 
 template <typename T>
-Matrix2x2<T>& Matrix2x2<T>::operator+=(T scalar) {
+constexpr Matrix2x2<T>& Matrix2x2<T>::operator+=(T scalar) {
   data[0] += scalar;
   data[1] += scalar;
   return *this;
 }
 
 template <typename T>
-Matrix2x2<T>& Matrix2x2<T>::operator+=(const Matrix2x2<T>& other) {
+constexpr Matrix2x2<T>& Matrix2x2<T>::operator+=(const Matrix2x2<T>& other) {
   data[0] += other[0];
   data[1] += other[1];
   return *this;
 }
 
 template <typename T>
-const typename Matrix2x2<T>::RowType Matrix2x2<T>::operator[](int index) const {
+constexpr Matrix2x2<T> Matrix2x2<T>::operator*(
+    const Matrix2x2<T>& other) const {
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      // [a b c d] * [e f g h] = [a a c c] * [e f e f] + [b b d d] * [g h g h]
+      const __m128 a = _mm_load_ps(&data[0].x);
+      const __m128 b = _mm_load_ps(&other.data[0].x);
+      const __m128 product = _mm_add_ps(
+          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 0, 0)),
+                     _mm_movelh_ps(b, b)),
+          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 1, 1)),
+                     _mm_movehl_ps(b, b)));
+      Matrix2x2<T> result;
+      _mm_store_ps(&result.data[0].x, product);
+      return result;
+    }
+  }
+#endif
+  return {data[0].x * other.data[0].x + data[0].y * other.data[1].x,
+          data[0].x * other.data[0].y + data[0].y * other.data[1].y,
+          data[1].x * other.data[0].x + data[1].y * other.data[1].x,
+          data[1].x * other.data[0].y + data[1].y * other.data[1].y};
+}
+
+template <typename T>
+constexpr Matrix2x2<T>& Matrix2x2<T>::operator*=(const Matrix2x2<T>& other) {
+  *this = *this * other;
+  return *this;
+}
+
+template <typename T>
+constexpr typename Matrix2x2<T>::ColumnType Matrix2x2<T>::operator*(
+    const ColumnType& v) const {
+  return {data[0] | v, data[1] | v};
+}
+
+template <typename T>
+constexpr const typename Matrix2x2<T>::RowType Matrix2x2<T>::operator[](
+    int index) const {
+  DLM_ASSERT_INDEX(index, 2);
   return data[index];
 }
 
 template <typename T>
-typename Matrix2x2<T>::RowType& Matrix2x2<T>::operator[](int index) {
+constexpr typename Matrix2x2<T>::RowType& Matrix2x2<T>::operator[](int index) {
+  DLM_ASSERT_INDEX(index, 2);
   return data[index];
 }
 
+template <typename T>
+constexpr Matrix2x2<T> Matrix2x2<T>::Transpose() const {
+  return {data[0].x, data[1].x, data[0].y, data[1].y};
+}
+
+template <typename T>
+constexpr T Matrix2x2<T>::Determinant() const {
+  return data[0].x * data[1].y - data[0].y * data[1].x;
+}
+
+template <typename T>
+constexpr Matrix2x2<T> Matrix2x2<T>::Inverse() const {
+  const T inverse_determinant = static_cast<T>(1) / Determinant();
+  return {data[1].y * inverse_determinant, -data[0].y * inverse_determinant,
+          -data[1].x * inverse_determinant, data[0].x * inverse_determinant};
+}
+
+template <typename T>
+constexpr bool Matrix2x2<T>::TryInverse(Matrix2x2<T>& inverse,
+                                        T tolerance) const {
+  const T determinant = Determinant();
+  if (!(determinant > tolerance || determinant < -tolerance)) {
+    return false;
+  }
+  inverse = Inverse();
+  return true;
+}
+
+// Writes m * points[i] to out[i] for every point. out may alias points.
+template <typename T>
+void Transform(const Matrix2x2<T>& m, Span<const vector::Vector2<T>> points,
+               Span<vector::Vector2<T>> out) {
+  assert(out.size() >= points.size());
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    // Two points per register: [x0 y0 x1 y1] -> [x0 x0 x1 x1] * [a c a c] +
+    // [y0 y0 y1 y1] * [b d b d]
+    const __m128 rows = _mm_setr_ps(m[0].x, m[0].y, m[1].x, m[1].y);
+    const __m128 column0 = _mm_shuffle_ps(rows, rows, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 column1 = _mm_shuffle_ps(rows, rows, _MM_SHUFFLE(3, 1, 3, 1));
+    const auto transform = [&](__m128 p) {
+      const __m128 xx = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+      const __m128 yy = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+      return simd::MulAdd(xx, column0, _mm_mul_ps(yy, column1));
+    };
+    const float* source = reinterpret_cast<const float*>(points.data());
+    float* destination = reinterpret_cast<float*>(out.data());
+    for (; i + 2 <= points.size(); i += 2) {
+      _mm_storeu_ps(destination + 2 * i,
+                    transform(_mm_loadu_ps(source + 2 * i)));
+    }
+    // The last point of an odd span goes through the same lanes, so it
+    // rounds like the others.
+    if (i < points.size()) {
+      const __m128 p = _mm_loadl_pi(
+          _mm_setzero_ps(), reinterpret_cast<const __m64*>(source + 2 * i));
+      _mm_storel_pi(reinterpret_cast<__m64*>(destination + 2 * i),
+                    transform(p));
+      ++i;
+    }
+  }
+#endif
+  for (; i < points.size(); ++i) {
+    out[i] = m * points[i];
+  }
+}
+
 using Matrix2x2F = Matrix2x2<float>;
 
 static_assert(std::is_move_constructible<Matrix2x2F>::value);
+static_assert(std::is_trivially_copyable<Matrix2x2F>::value);
+static_assert(std::is_standard_layout<Matrix2x2F>::value);
 }  // namespace matrix
 }  // namespace dlm
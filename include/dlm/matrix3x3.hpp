@@ -0,0 +1,205 @@
+#pragma once
+
+#include <type_traits>
+
+#include "vector3.hpp"
+
+namespace dlm {
+namespace matrix {
+// Row major, each row is a Vector3.
+template <typename T>
+struct Matrix3x3 {
+  using ValueType = T;
+  using RowType = vector::Vector3<T>;
+  using ColumnType = vector::Vector3<T>;
+
+  constexpr Matrix3x3()
+      : data{RowType{static_cast<T>(1), static_cast<T>(0), static_cast<T>(0)},
+             RowType{static_cast<T>(0), static_cast<T>(1), static_cast<T>(0)},
+             RowType{static_cast<T>(0), static_cast<T>(0),
+                     static_cast<T>(1)}} {};
+
+  constexpr Matrix3x3(T m11, T m12, T m13, T m21, T m22, T m23, T m31, T m32,
+                      T m33)
+      : data{RowType{m11, m12, m13}, RowType{m21, m22, m23},
+             RowType{m31, m32, m33}} {};
+
+  constexpr Matrix3x3(const RowType& row1, const RowType& row2,
+                      const RowType& row3)
+      : data{row1, row2, row3} {};
+
+  // Operators
+  constexpr Matrix3x3<T> operator-(T scalar) const;
+  constexpr Matrix3x3<T> operator-(const Matrix3x3<T>& other) const;
+  constexpr Matrix3x3<T>& operator-=(T scalar);
+  constexpr Matrix3x3<T>& operator-=(const Matrix3x3<T>& other);
+
+  constexpr Matrix3x3<T> operator+(T scalar) const;
+  constexpr Matrix3x3<T> operator+(const Matrix3x3<T>& other) const;
+  constexpr Matrix3x3<T>& operator+=(T scalar);
+  constexpr Matrix3x3<T>& operator+=(const Matrix3x3<T>& other);
+
+  constexpr Matrix3x3<T> operator*(T scalar) const;
+  constexpr Matrix3x3<T> operator*(const Matrix3x3<T>& other) const;
+  constexpr Matrix3x3<T>& operator*=(const Matrix3x3<T>& other);
+
+  // Transforms a column vector
+  constexpr ColumnType operator*(const ColumnType& v) const;
+
+  constexpr const RowType operator[](int index) const;
+  constexpr RowType& operator[](int index);
+
+  // Helper functions
+  constexpr Matrix3x3<T> Transpose() const;
+  constexpr T Determinant() const;
+
+  // Undefined for singular matrices, use TryInverse when the matrix may be
+  // singular.
+  constexpr Matrix3x3<T> Inverse() const;
+  // Writes the inverse and returns true when |determinant| > tolerance,
+  // otherwise returns false and leaves inverse untouched.
+  constexpr bool TryInverse(Matrix3x3<T>& inverse,
+                            T tolerance = static_cast<T>(0)) const;
+
+ private:
+  RowType data[3];
+};
+
+template <typename T>
+constexpr Matrix3x3<T> Matrix3x3<T>::operator-(T scalar) const {
+  return {data[0] - scalar, data[1] - scalar, data[2] - scalar};
+}
+
+template <typename T>
+constexpr Matrix3x3<T> Matrix3x3<T>::operator-(
+    const Matrix3x3<T>& other) const {
+  return {data[0] - other.data[0], data[1] - other.data[1],
+          data[2] - other.data[2]};
+}
+
+template <typename T>
+constexpr Matrix3x3<T>& Matrix3x3<T>::operator-=(T scalar) {
+  data[0] -= scalar;
+  data[1] -= scalar;
+  data[2] -= scalar;
+  return *this;
+}
+
+template <typename T>
+constexpr Matrix3x3<T>& Matrix3x3<T>::operator-=(const Matrix3x3<T>& other) {
+  data[0] -= other.data[0];
+  data[1] -= other.data[1];
+  data[2] -= other.data[2];
+  return *this;
+}
+
+template <typename T>
+constexpr Matrix3x3<T> Matrix3x3<T>::operator+(T scalar) const {
+  return {data[0] + scalar, data[1] + scalar, data[2] + scalar};
+}
+
+template <typename T>
+constexpr Matrix3x3<T> Matrix3x3<T>::operator+(
+    const Matrix3x3<T>& other) const {
+  return {data[0] + other.data[0], data[1] + other.data[1],
+          data[2] + other.data[2]};
+}
+
+template <typename T>
+constexpr Matrix3x3<T>& Matrix3x3<T>::operator+=(T scalar) {
+  data[0] += scalar;
+  data[1] += scalar;
+  data[2] += scalar;
+  return *this;
+}
+
+template <typename T>
+constexpr Matrix3x3<T>& Matrix3x3<T>::operator+=(const Matrix3x3<T>& other) {
+  data[0] += other.data[0];
+  data[1] += other.data[1];
+  data[2] += other.data[2];
+  return *this;
+}
+
+template <typename T>
+constexpr Matrix3x3<T> Matrix3x3<T>::operator*(T scalar) const {
+  return {data[0] * scalar, data[1] * scalar, data[2] * scalar};
+}
+
+template <typename T>
+constexpr Matrix3x3<T> Matrix3x3<T>::operator*(
+    const Matrix3x3<T>& other) const {
+  // Row i of the product is the rows of other weighted by row i of this.
+  Matrix3x3<T> result;
+  for (int i = 0; i < 3; ++i) {
+    result.data[i] = other.data[0] * data[i].x + other.data[1] * data[i].y +
+                     other.data[2] * data[i].z;
+  }
+  return result;
+}
+
+template <typename T>
+constexpr Matrix3x3<T>& Matrix3x3<T>::operator*=(const Matrix3x3<T>& other) {
+  *this = *this * other;
+  return *this;
+}
+
+template <typename T>
+constexpr typename Matrix3x3<T>::ColumnType Matrix3x3<T>::operator*(
+    const ColumnType& v) const {
+  return {data[0] | v, data[1] | v, data[2] | v};
+}
+
+template <typename T>
+constexpr const typename Matrix3x3<T>::RowType Matrix3x3<T>::operator[](
+    int index) const {
+  DLM_ASSERT_INDEX(index, 3);
+  return data[index];
+}
+
+template <typename T>
+constexpr typename Matrix3x3<T>::RowType& Matrix3x3<T>::operator[](int index) {
+  DLM_ASSERT_INDEX(index, 3);
+  return data[index];
+}
+
+template <typename T>
+constexpr Matrix3x3<T> Matrix3x3<T>::Transpose() const {
+  return {data[0].x, data[1].x, data[2].x, data[0].y, data[1].y,
+          data[2].y, data[0].z, data[1].z, data[2].z};
+}
+
+template <typename T>
+constexpr T Matrix3x3<T>::Determinant() const {
+  return data[0] | (data[1] ^ data[2]);
+}
+
+template <typename T>
+constexpr Matrix3x3<T> Matrix3x3<T>::Inverse() const {
+  // The columns of the inverse are the cross products of the rows divided
+  // by the determinant.
+  const RowType c0 = data[1] ^ data[2];
+  const RowType c1 = data[2] ^ data[0];
+  const RowType c2 = data[0] ^ data[1];
+  const T inverse_determinant = static_cast<T>(1) / (data[0] | c0);
+  return Matrix3x3<T>{c0, c1, c2}.Transpose() * inverse_determinant;
+}
+
+template <typename T>
+constexpr bool Matrix3x3<T>::TryInverse(Matrix3x3<T>& inverse,
+                                        T tolerance) const {
+  const T determinant = Determinant();
+  if (!(determinant > tolerance || determinant < -tolerance)) {
+    return false;
+  }
+  inverse = Inverse();
+  return true;
+}
+
+using Matrix3x3F = Matrix3x3<float>;
+
+static_assert(std::is_move_constructible<Matrix3x3F>::value);
+static_assert(std::is_trivially_copyable<Matrix3x3F>::value);
+static_assert(std::is_standard_layout<Matrix3x3F>::value);
+}  // namespace matrix
+}  // namespace dlm
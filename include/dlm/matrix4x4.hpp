@@ -0,0 +1,432 @@
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+
+#include "matrix3x3.hpp"
+#include "simd.hpp"
+#include "span.hpp"
+#include "vector3.hpp"
+#include "vector4.hpp"
+
+namespace dlm {
+namespace matrix {
+// Row major, each row is a Vector4 and transforms column vectors, so the
+// translation of an affine transform is the w column. A Matrix4x4<float> is
+// four SSE registers.
+template <typename T>
+struct Matrix4x4 {
+  using ValueType = T;
+  using RowType = vector::Vector4<T>;
+  using ColumnType = vector::Vector4<T>;
+
+  constexpr Matrix4x4()
+      : data{RowType{static_cast<T>(1), static_cast<T>(0), static_cast<T>(0),
+                     static_cast<T>(0)},
+             RowType{static_cast<T>(0), static_cast<T>(1), static_cast<T>(0),
+                     static_cast<T>(0)},
+             RowType{static_cast<T>(0), static_cast<T>(0), static_cast<T>(1),
+                     static_cast<T>(0)},
+             RowType{static_cast<T>(0), static_cast<T>(0), static_cast<T>(0),
+                     static_cast<T>(1)}} {};
+
+  constexpr Matrix4x4(T m11, T m12, T m13, T m14, T m21, T m22, T m23, T m24,
+                      T m31, T m32, T m33, T m34, T m41, T m42, T m43, T m44)
+      : data{RowType{m11, m12, m13, m14}, RowType{m21, m22, m23, m24},
+             RowType{m31, m32, m33, m34}, RowType{m41, m42, m43, m44}} {};
+
+  constexpr Matrix4x4(const RowType& row1, const RowType& row2,
+                      const RowType& row3, const RowType& row4)
+      : data{row1, row2, row3, row4} {};
+
+  // Operators
+  constexpr Matrix4x4<T> operator-(T scalar) const;
+  constexpr Matrix4x4<T> operator-(const Matrix4x4<T>& other) const;
+  constexpr Matrix4x4<T>& operator-=(T scalar);
+  constexpr Matrix4x4<T>& operator-=(const Matrix4x4<T>& other);
+
+  constexpr Matrix4x4<T> operator+(T scalar) const;
+  constexpr Matrix4x4<T> operator+(const Matrix4x4<T>& other) const;
+  constexpr Matrix4x4<T>& operator+=(T scalar);
+  constexpr Matrix4x4<T>& operator+=(const Matrix4x4<T>& other);
+
+  constexpr Matrix4x4<T> operator*(T scalar) const;
+  constexpr Matrix4x4<T> operator*(const Matrix4x4<T>& other) const;
+  constexpr Matrix4x4<T>& operator*=(const Matrix4x4<T>& other);
+
+  // Transforms a column vector
+  constexpr ColumnType operator*(const ColumnType& v) const;
+
+  constexpr const RowType operator[](int index) const;
+  constexpr RowType& operator[](int index);
+
+  // Helper functions
+  constexpr Matrix4x4<T> Transpose() const;
+  constexpr T Determinant() const;
+
+  // Undefined for singular matrices, use TryInverse when the matrix may be
+  // singular.
+  constexpr Matrix4x4<T> Inverse() const;
+  // Writes the inverse and returns true when |determinant| > tolerance,
+  // otherwise returns false and leaves inverse untouched.
+  constexpr bool TryInverse(Matrix4x4<T>& inverse,
+                            T tolerance = static_cast<T>(0)) const;
+
+  // Affine fast paths. They assume the fourth row of both operands is
+  // (0, 0, 0, 1) and skip the projective row entirely.
+  constexpr bool IsAffine() const;
+  constexpr Matrix4x4<T> MultiplyAffine(const Matrix4x4<T>& other) const;
+  constexpr Matrix4x4<T> InverseAffine() const;
+
+  // Rotation and scale part of an affine transform.
+  constexpr Matrix3x3<T> Linear() const;
+  constexpr vector::Vector3<T> Translation() const;
+
+ private:
+  RowType data[4];
+};
+
+template <typename T>
+constexpr Matrix4x4<T> Matrix4x4<T>::operator-(T scalar) const {
+  return {data[0] - scalar, data[1] - scalar, data[2] - scalar,
+          data[3] - scalar};
+}
+
+template <typename T>
+constexpr Matrix4x4<T> Matrix4x4<T>::operator-(
+    const Matrix4x4<T>& other) const {
+  return {data[0] - other.data[0], data[1] - other.data[1],
+          data[2] - other.data[2], data[3] - other.data[3]};
+}
+
+template <typename T>
+constexpr Matrix4x4<T>& Matrix4x4<T>::operator-=(T scalar) {
+  data[0] -= scalar;
+  data[1] -= scalar;
+  data[2] -= scalar;
+  data[3] -= scalar;
+  return *this;
+}
+
+template <typename T>
+constexpr Matrix4x4<T>& Matrix4x4<T>::operator-=(const Matrix4x4<T>& other) {
+  data[0] -= other.data[0];
+  data[1] -= other.data[1];
+  data[2] -= other.data[2];
+  data[3] -= other.data[3];
+  return *this;
+}
+
+template <typename T>
+constexpr Matrix4x4<T> Matrix4x4<T>::operator+(T scalar) const {
+  return {data[0] + scalar, data[1] + scalar, data[2] + scalar,
+          data[3] + scalar};
+}
+
+template <typename T>
+constexpr Matrix4x4<T> Matrix4x4<T>::operator+(
+    const Matrix4x4<T>& other) const {
+  return {data[0] + other.data[0], data[1] + other.data[1],
+          data[2] + other.data[2], data[3] + other.data[3]};
+}
+
+template <typename T>
+constexpr Matrix4x4<T>& Matrix4x4<T>::operator+=(T scalar) {
+  data[0] += scalar;
+  data[1] += scalar;
+  data[2] += scalar;
+  data[3] += scalar;
+  return *this;
+}
+
+template <typename T>
+constexpr Matrix4x4<T>& Matrix4x4<T>::operator+=(const Matrix4x4<T>& other) {
+  data[0] += other.data[0];
+  data[1] += other.data[1];
+  data[2] += other.data[2];
+  data[3] += other.data[3];
+  return *this;
+}
+
+template <typename T>
+constexpr Matrix4x4<T> Matrix4x4<T>::operator*(T scalar) const {
+  return {data[0] * scalar, data[1] * scalar, data[2] * scalar,
+          data[3] * scalar};
+}
+
+#if defined(DLM_SSE2)
+namespace detail {
+using vector::detail::FromRegister;
+using vector::detail::Load;
+
+// Linear combination of the four rows of b weighted by the lanes of a_row.
+inline __m128 CombineRows(__m128 a_row, const __m128 (&b)[4]) {
+  const __m128 x = _mm_shuffle_ps(a_row, a_row, _MM_SHUFFLE(0, 0, 0, 0));
+  const __m128 y = _mm_shuffle_ps(a_row, a_row, _MM_SHUFFLE(1, 1, 1, 1));
+  const __m128 z = _mm_shuffle_ps(a_row, a_row, _MM_SHUFFLE(2, 2, 2, 2));
+  const __m128 w = _mm_shuffle_ps(a_row, a_row, _MM_SHUFFLE(3, 3, 3, 3));
+#if defined(DLM_FMA)
+  return _mm_fmadd_ps(
+      x, b[0],
+      _mm_fmadd_ps(y, b[1], _mm_fmadd_ps(z, b[2], _mm_mul_ps(w, b[3]))));
+#else
+  return _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, b[0]), _mm_mul_ps(y, b[1])),
+                    _mm_add_ps(_mm_mul_ps(z, b[2]), _mm_mul_ps(w, b[3])));
+#endif
+}
+}  // namespace detail
+#endif
+
+template <typename T>
+constexpr Matrix4x4<T> Matrix4x4<T>::operator*(
+    const Matrix4x4<T>& other) const {
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      const __m128 b[4] = {
+          detail::Load(other.data[0]), detail::Load(other.data[1]),
+          detail::Load(other.data[2]), detail::Load(other.data[3])};
+      Matrix4x4<T> result;
+      for (int i = 0; i < 4; ++i) {
+        result.data[i] = detail::FromRegister<4, float>(
+            detail::CombineRows(detail::Load(data[i]), b));
+      }
+      return result;
+    }
+  }
+#endif
+  // Row i of the product is the rows of other weighted by row i of this.
+  Matrix4x4<T> result;
+  for (int i = 0; i < 4; ++i) {
+    result.data[i] = other.data[0] * data[i].x + other.data[1] * data[i].y +
+                     other.data[2] * data[i].z + other.data[3] * data[i].w;
+  }
+  return result;
+}
+
+template <typename T>
+constexpr Matrix4x4<T>& Matrix4x4<T>::operator*=(const Matrix4x4<T>& other) {
+  *this = *this * other;
+  return *this;
+}
+
+template <typename T>
+constexpr typename Matrix4x4<T>::ColumnType Matrix4x4<T>::operator*(
+    const ColumnType& v) const {
+  return {data[0] | v, data[1] | v, data[2] | v, data[3] | v};
+}
+
+template <typename T>
+constexpr const typename Matrix4x4<T>::RowType Matrix4x4<T>::operator[](
+    int index) const {
+  DLM_ASSERT_INDEX(index, 4);
+  return data[index];
+}
+
+template <typename T>
+constexpr typename Matrix4x4<T>::RowType& Matrix4x4<T>::operator[](int index) {
+  DLM_ASSERT_INDEX(index, 4);
+  return data[index];
+}
+
+template <typename T>
+constexpr Matrix4x4<T> Matrix4x4<T>::Transpose() const {
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      __m128 r0 = detail::Load(data[0]), r1 = detail::Load(data[1]),
+             r2 = detail::Load(data[2]), r3 = detail::Load(data[3]);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      Matrix4x4<T> result;
+      result.data[0] = detail::FromRegister<4, float>(r0);
+      result.data[1] = detail::FromRegister<4, float>(r1);
+      result.data[2] = detail::FromRegister<4, float>(r2);
+      result.data[3] = detail::FromRegister<4, float>(r3);
+      return result;
+    }
+  }
+#endif
+  return {data[0].x, data[1].x, data[2].x, data[3].x,
+          data[0].y, data[1].y, data[2].y, data[3].y,
+          data[0].z, data[1].z, data[2].z, data[3].z,
+          data[0].w, data[1].w, data[2].w, data[3].w};
+}
+
+namespace detail {
+// 2x2 sub-determinants of the upper (s) and lower (c) row pairs shared by the
+// 4x4 determinant and inverse.
+template <typename T>
+struct Minors4x4 {
+  constexpr explicit Minors4x4(const Matrix4x4<T>& m)
+      : s0{m[0].x * m[1].y - m[1].x * m[0].y},
+        s1{m[0].x * m[1].z - m[1].x * m[0].z},
+        s2{m[0].x * m[1].w - m[1].x * m[0].w},
+        s3{m[0].y * m[1].z - m[1].y * m[0].z},
+        s4{m[0].y * m[1].w - m[1].y * m[0].w},
+        s5{m[0].z * m[1].w - m[1].z * m[0].w},
+        c0{m[2].x * m[3].y - m[3].x * m[2].y},
+        c1{m[2].x * m[3].z - m[3].x * m[2].z},
+        c2{m[2].x * m[3].w - m[3].x * m[2].w},
+        c3{m[2].y * m[3].z - m[3].y * m[2].z},
+        c4{m[2].y * m[3].w - m[3].y * m[2].w},
+        c5{m[2].z * m[3].w - m[3].z * m[2].w} {};
+
+  constexpr T Determinant() const {
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  }
+
+  T s0, s1, s2, s3, s4, s5;
+  T c0, c1, c2, c3, c4, c5;
+};
+}  // namespace detail
+
+template <typename T>
+constexpr T Matrix4x4<T>::Determinant() const {
+  return detail::Minors4x4<T>{*this}.Determinant();
+}
+
+template <typename T>
+constexpr Matrix4x4<T> Matrix4x4<T>::Inverse() const {
+  const detail::Minors4x4<T> n{*this};
+  const RowType* m = data;
+  const Matrix4x4<T> adjugate{
+      m[1].y * n.c5 - m[1].z * n.c4 + m[1].w * n.c3,
+      -m[0].y * n.c5 + m[0].z * n.c4 - m[0].w * n.c3,
+      m[3].y * n.s5 - m[3].z * n.s4 + m[3].w * n.s3,
+      -m[2].y * n.s5 + m[2].z * n.s4 - m[2].w * n.s3,
+
+      -m[1].x * n.c5 + m[1].z * n.c2 - m[1].w * n.c1,
+      m[0].x * n.c5 - m[0].z * n.c2 + m[0].w * n.c1,
+      -m[3].x * n.s5 + m[3].z * n.s2 - m[3].w * n.s1,
+      m[2].x * n.s5 - m[2].z * n.s2 + m[2].w * n.s1,
+
+      m[1].x * n.c4 - m[1].y * n.c2 + m[1].w * n.c0,
+      -m[0].x * n.c4 + m[0].y * n.c2 - m[0].w * n.c0,
+      m[3].x * n.s4 - m[3].y * n.s2 + m[3].w * n.s0,
+      -m[2].x * n.s4 + m[2].y * n.s2 - m[2].w * n.s0,
+
+      -m[1].x * n.c3 + m[1].y * n.c1 - m[1].z * n.c0,
+      m[0].x * n.c3 - m[0].y * n.c1 + m[0].z * n.c0,
+      -m[3].x * n.s3 + m[3].y * n.s1 - m[3].z * n.s0,
+      m[2].x * n.s3 - m[2].y * n.s1 + m[2].z * n.s0};
+  return adjugate * (static_cast<T>(1) / n.Determinant());
+}
+
+template <typename T>
+constexpr bool Matrix4x4<T>::TryInverse(Matrix4x4<T>& inverse,
+                                        T tolerance) const {
+  const T determinant = Determinant();
+  if (!(determinant > tolerance || determinant < -tolerance)) {
+    return false;
+  }
+  inverse = Inverse();
+  return true;
+}
+
+template <typename T>
+constexpr bool Matrix4x4<T>::IsAffine() const {
+  return data[3] == RowType{static_cast<T>(0), static_cast<T>(0),
+                            static_cast<T>(0), static_cast<T>(1)};
+}
+
+template <typename T>
+constexpr Matrix4x4<T> Matrix4x4<T>::MultiplyAffine(
+    const Matrix4x4<T>& other) const {
+  // With a fourth row of (0, 0, 0, 1) in other, row i of the product is the
+  // first three rows of other weighted by row i plus the translation of row
+  // i, and the fourth row stays (0, 0, 0, 1).
+  const RowType w{static_cast<T>(0), static_cast<T>(0), static_cast<T>(0),
+                  static_cast<T>(1)};
+  Matrix4x4<T> result;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      const __m128 b[4] = {
+          detail::Load(other.data[0]), detail::Load(other.data[1]),
+          detail::Load(other.data[2]), detail::Load(w)};
+      for (int i = 0; i < 3; ++i) {
+        result.data[i] = detail::FromRegister<4, float>(
+            detail::CombineRows(detail::Load(data[i]), b));
+      }
+      return result;
+    }
+  }
+#endif
+  for (int i = 0; i < 3; ++i) {
+    result.data[i] = other.data[0] * data[i].x + other.data[1] * data[i].y +
+                     other.data[2] * data[i].z + w * data[i].w;
+  }
+  return result;
+}
+
+template <typename T>
+constexpr Matrix4x4<T> Matrix4x4<T>::InverseAffine() const {
+  // inverse([L t; 0 1]) = [inverse(L) -inverse(L) * t; 0 1]
+  const Matrix3x3<T> linear = Linear().Inverse();
+  const vector::Vector3<T> translation = -(linear * Translation());
+  return {RowType{linear[0].x, linear[0].y, linear[0].z, translation.x},
+          RowType{linear[1].x, linear[1].y, linear[1].z, translation.y},
+          RowType{linear[2].x, linear[2].y, linear[2].z, translation.z},
+          RowType{static_cast<T>(0), static_cast<T>(0), static_cast<T>(0),
+                  static_cast<T>(1)}};
+}
+
+template <typename T>
+constexpr Matrix3x3<T> Matrix4x4<T>::Linear() const {
+  return {data[0].x, data[0].y, data[0].z, data[1].x, data[1].y,
+          data[1].z, data[2].x, data[2].y, data[2].z};
+}
+
+template <typename T>
+constexpr vector::Vector3<T> Matrix4x4<T>::Translation() const {
+  return {data[0].w, data[1].w, data[2].w};
+}
+
+// Writes m * points[i] to out[i] for every point. out may alias points.
+template <typename T>
+void Transform(const Matrix4x4<T>& m, Span<const vector::Vector4<T>> points,
+               Span<vector::Vector4<T>> out) {
+  assert(out.size() >= points.size());
+  // The product is the columns of m weighted by the point, the transpose
+  // turns the columns into rows once for the whole span.
+  const Matrix4x4<T> columns = m.Transpose();
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    const __m128 c[4] = {detail::Load(columns[0]), detail::Load(columns[1]),
+                         detail::Load(columns[2]), detail::Load(columns[3])};
+    for (; i < points.size(); ++i) {
+      out[i] = detail::FromRegister<4, float>(
+          detail::CombineRows(detail::Load(points[i]), c));
+    }
+  }
+#endif
+  for (; i < points.size(); ++i) {
+    const vector::Vector4<T> p = points[i];
+    out[i] = columns[0] * p.x + columns[1] * p.y + columns[2] * p.z +
+             columns[3] * p.w;
+  }
+}
+
+// Affine version of Transform, the fourth row of m is taken to be
+// (0, 0, 0, 1) whatever it holds, so the w component of every point passes
+// through unchanged. Points are stored one per register, so the broadcast
+// of each component costs as much as the fourth row it would save and the
+// work is the same as Transform.
+template <typename T>
+void TransformAffine(const Matrix4x4<T>& m,
+                     Span<const vector::Vector4<T>> points,
+                     Span<vector::Vector4<T>> out) {
+  Matrix4x4<T> affine = m;
+  affine[3] = {static_cast<T>(0), static_cast<T>(0), static_cast<T>(0),
+               static_cast<T>(1)};
+  Transform(affine, points, out);
+}
+
+using Matrix4x4F = Matrix4x4<float>;
+
+static_assert(std::is_move_constructible<Matrix4x4F>::value);
+static_assert(std::is_trivially_copyable<Matrix4x4F>::value);
+static_assert(std::is_standard_layout<Matrix4x4F>::value);
+}  // namespace matrix
+}  // namespace dlm
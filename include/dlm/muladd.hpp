@@ -0,0 +1,343 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "dlm/config.hpp"
+#include "dlm/matrix2x2.hpp"
+#include "dlm/simd.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector.hpp"
+#include "dlm/vector2.hpp"
+#include "dlm/vector3.hpp"
+#include "dlm/vector4.hpp"
+
+namespace dlm {
+namespace vector {
+
+// Fused multiply-add: MulAdd is a * b + c, MulSub is a * b - c and
+// NegMulAdd is c - a * b, component wise. When DLM_FMA is defined every
+// component is rounded once and compiles to a single FMA instruction,
+// otherwise, and during constant evaluation, the product is rounded before
+// the addition. std::fma is not used as a fallback since without the
+// instruction it is a slow library call.
+template <typename T,
+          typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+constexpr T MulAdd(T a, T b, T c) {
+#if defined(DLM_FMA)
+  if constexpr (std::is_floating_point<T>::value) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return std::fma(a, b, c);
+    }
+  }
+#endif
+  return a * b + c;
+}
+
+// Negating an operand is exact, so these round exactly like MulAdd.
+template <typename T,
+          typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+constexpr T MulSub(T a, T b, T c) {
+  return MulAdd(a, b, -c);
+}
+
+template <typename T,
+          typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+constexpr T NegMulAdd(T a, T b, T c) {
+  return MulAdd(-a, b, c);
+}
+
+namespace detail {
+// b broadcast when it is a scalar, its component I otherwise.
+template <std::size_t I, typename B>
+constexpr auto ComponentOf(const B& b) {
+  if constexpr (std::is_arithmetic<B>::value) {
+    return b;
+  } else {
+    return At<I>(b);
+  }
+}
+
+template <std::size_t N, typename T, typename Layout, typename B,
+          std::size_t... I>
+constexpr Vector<N, T, Layout> MulAdd(std::index_sequence<I...>,
+                                      const Vector<N, T, Layout>& a,
+                                      const B& b,
+                                      const Vector<N, T, Layout>& c) {
+  return {vector::MulAdd(At<I>(a), ComponentOf<I>(b), At<I>(c))...};
+}
+
+template <std::size_t N, typename T, typename Layout, typename B>
+constexpr Vector<N, T, Layout> MulAdd(const Vector<N, T, Layout>& a,
+                                      const B& b,
+                                      const Vector<N, T, Layout>& c) {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      typename Simd::Register b_register;
+      if constexpr (std::is_arithmetic<B>::value) {
+        b_register = Simd::Broadcast(b);
+      } else {
+        b_register = Load(b);
+      }
+      return FromRegister<N, T, Layout>(
+          Simd::MulAdd(Load(a), b_register, Load(c)));
+    }
+  }
+  return MulAdd(std::make_index_sequence<N>{}, a, b, c);
+}
+
+template <typename vector_type>
+struct IsVector : std::false_type {};
+
+template <std::size_t N, typename T, typename Layout>
+struct IsVector<Vector<N, T, Layout>> : std::true_type {};
+
+template <typename vector_type>
+using EnableIfVector = std::enable_if_t<IsVector<vector_type>::value>;
+}  // namespace detail
+
+// Vector2/3/4 overloads, b is either a vector or a scalar that scales every
+// component, e.g. MulAdd(velocity, dt, position).
+template <typename vector_type, typename = detail::EnableIfVector<vector_type>>
+constexpr vector_type MulAdd(const vector_type& a, const vector_type& b,
+                             const vector_type& c) {
+  return detail::MulAdd(a, b, c);
+}
+
+template <typename vector_type, typename = detail::EnableIfVector<vector_type>>
+constexpr vector_type MulAdd(const vector_type& a,
+                             typename vector_type::ValueType b,
+                             const vector_type& c) {
+  return detail::MulAdd(a, b, c);
+}
+
+template <typename vector_type, typename = detail::EnableIfVector<vector_type>>
+constexpr vector_type MulSub(const vector_type& a, const vector_type& b,
+                             const vector_type& c) {
+  return detail::MulAdd(a, b, -c);
+}
+
+template <typename vector_type, typename = detail::EnableIfVector<vector_type>>
+constexpr vector_type MulSub(const vector_type& a,
+                             typename vector_type::ValueType b,
+                             const vector_type& c) {
+  return detail::MulAdd(a, b, -c);
+}
+
+template <typename vector_type, typename = detail::EnableIfVector<vector_type>>
+constexpr vector_type NegMulAdd(const vector_type& a, const vector_type& b,
+                                const vector_type& c) {
+  return detail::MulAdd(-a, b, c);
+}
+
+template <typename vector_type, typename = detail::EnableIfVector<vector_type>>
+constexpr vector_type NegMulAdd(const vector_type& a,
+                                typename vector_type::ValueType b,
+                                const vector_type& c) {
+  return detail::MulAdd(-a, b, c);
+}
+
+namespace detail {
+// The components of a span of vectors are one contiguous array of scalars
+// (the headers assert the layout), so the bulk versions run over the
+// scalars in the widest available register, across vector boundaries.
+template <typename vector_type>
+constexpr std::size_t kComponents =
+    sizeof(vector_type) / sizeof(typename vector_type::ValueType);
+
+#if defined(DLM_SSE2)
+template <typename T>
+struct Wide;
+
+#if defined(DLM_AVX)
+template <>
+struct Wide<float> {
+  using Type = __m256;
+  static constexpr std::size_t kLanes = 8;
+  static Type Load(const float* p) { return _mm256_loadu_ps(p); }
+  static Type Broadcast(float value) { return _mm256_set1_ps(value); }
+  static Type Negate(Type v) {
+    return _mm256_xor_ps(v, _mm256_set1_ps(-0.0f));
+  }
+  static void Store(float* p, Type v) { _mm256_storeu_ps(p, v); }
+};
+
+template <>
+struct Wide<double> {
+  using Type = __m256d;
+  static constexpr std::size_t kLanes = 4;
+  static Type Load(const double* p) { return _mm256_loadu_pd(p); }
+  static Type Broadcast(double value) { return _mm256_set1_pd(value); }
+  static Type Negate(Type v) {
+    return _mm256_xor_pd(v, _mm256_set1_pd(-0.0));
+  }
+  static void Store(double* p, Type v) { _mm256_storeu_pd(p, v); }
+};
+#else
+template <>
+struct Wide<float> {
+  using Type = __m128;
+  static constexpr std::size_t kLanes = 4;
+  static Type Load(const float* p) { return _mm_loadu_ps(p); }
+  static Type Broadcast(float value) { return _mm_set1_ps(value); }
+  static Type Negate(Type v) { return _mm_xor_ps(v, _mm_set1_ps(-0.0f)); }
+  static void Store(float* p, Type v) { _mm_storeu_ps(p, v); }
+};
+
+template <>
+struct Wide<double> {
+  using Type = __m128d;
+  static constexpr std::size_t kLanes = 2;
+  static Type Load(const double* p) { return _mm_loadu_pd(p); }
+  static Type Broadcast(double value) { return _mm_set1_pd(value); }
+  static Type Negate(Type v) { return _mm_xor_pd(v, _mm_set1_pd(-0.0)); }
+  static void Store(double* p, Type v) { _mm_storeu_pd(p, v); }
+};
+#endif
+#endif
+
+// b is a scalar or a pointer to count scalars. Every register is loaded
+// before it is stored, so out may alias the inputs element for element.
+template <bool kNegateA, bool kNegateC, typename T, typename B>
+void MulAdd(const T* a, B b, const T* c, T* out, std::size_t count) {
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value ||
+                std::is_same<T, double>::value) {
+    using W = Wide<T>;
+    for (; i + W::kLanes <= count; i += W::kLanes) {
+      typename W::Type a_lanes = W::Load(a + i);
+      typename W::Type c_lanes = W::Load(c + i);
+      if constexpr (kNegateA) {
+        a_lanes = W::Negate(a_lanes);
+      }
+      if constexpr (kNegateC) {
+        c_lanes = W::Negate(c_lanes);
+      }
+      if constexpr (std::is_pointer<B>::value) {
+        W::Store(out + i, simd::MulAdd(a_lanes, W::Load(b + i), c_lanes));
+      } else {
+        W::Store(out + i, simd::MulAdd(a_lanes, W::Broadcast(b), c_lanes));
+      }
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    T b_value;
+    if constexpr (std::is_pointer<B>::value) {
+      b_value = b[i];
+    } else {
+      b_value = b;
+    }
+    out[i] = vector::MulAdd(kNegateA ? -a[i] : a[i], b_value,
+                            kNegateC ? -c[i] : c[i]);
+  }
+}
+
+template <bool kNegateA, bool kNegateC, typename vector_type, typename B>
+void MulAdd(Span<const vector_type> a, const B& b, Span<const vector_type> c,
+            Span<vector_type> out) {
+  assert(c.size() == a.size());
+  assert(out.size() >= a.size());
+  using T = typename vector_type::ValueType;
+  const std::size_t count = a.size() * kComponents<vector_type>;
+  const T* a_values = reinterpret_cast<const T*>(a.data());
+  const T* c_values = reinterpret_cast<const T*>(c.data());
+  T* out_values = reinterpret_cast<T*>(out.data());
+  if constexpr (std::is_arithmetic<B>::value) {
+    MulAdd<kNegateA, kNegateC>(a_values, b, c_values, out_values, count);
+  } else {
+    MulAdd<kNegateA, kNegateC>(a_values, reinterpret_cast<const T*>(b.data()),
+                               c_values, out_values, count);
+  }
+}
+}  // namespace detail
+
+// Writes MulAdd(a[i], b, c[i]) to out[i]. out may alias a or c, a
+// bulk position update is MulAdd(velocities, dt, positions, positions).
+template <typename vector_type>
+void MulAdd(Span<const vector_type> a, typename vector_type::ValueType b,
+            Span<const vector_type> c, Span<vector_type> out) {
+  detail::MulAdd<false, false>(a, b, c, out);
+}
+
+// Writes MulAdd(a[i], b[i], c[i]) to out[i]. out may alias any input.
+template <typename vector_type>
+void MulAdd(Span<const vector_type> a, Span<const vector_type> b,
+            Span<const vector_type> c, Span<vector_type> out) {
+  assert(b.size() == a.size());
+  detail::MulAdd<false, false>(a, b, c, out);
+}
+
+template <typename vector_type>
+void MulSub(Span<const vector_type> a, typename vector_type::ValueType b,
+            Span<const vector_type> c, Span<vector_type> out) {
+  detail::MulAdd<false, true>(a, b, c, out);
+}
+
+template <typename vector_type>
+void MulSub(Span<const vector_type> a, Span<const vector_type> b,
+            Span<const vector_type> c, Span<vector_type> out) {
+  assert(b.size() == a.size());
+  detail::MulAdd<false, true>(a, b, c, out);
+}
+
+template <typename vector_type>
+void NegMulAdd(Span<const vector_type> a, typename vector_type::ValueType b,
+               Span<const vector_type> c, Span<vector_type> out) {
+  detail::MulAdd<true, false>(a, b, c, out);
+}
+
+template <typename vector_type>
+void NegMulAdd(Span<const vector_type> a, Span<const vector_type> b,
+               Span<const vector_type> c, Span<vector_type> out) {
+  assert(b.size() == a.size());
+  detail::MulAdd<true, false>(a, b, c, out);
+}
+
+}  // namespace vector
+
+namespace matrix {
+// Element wise MulAdd, MulSub and NegMulAdd, one fused operation per row.
+template <typename T>
+constexpr Matrix2x2<T> MulAdd(const Matrix2x2<T>& a, const Matrix2x2<T>& b,
+                              const Matrix2x2<T>& c) {
+  return {vector::MulAdd(a[0], b[0], c[0]), vector::MulAdd(a[1], b[1], c[1])};
+}
+
+template <typename T>
+constexpr Matrix2x2<T> MulAdd(const Matrix2x2<T>& a, T b,
+                              const Matrix2x2<T>& c) {
+  return {vector::MulAdd(a[0], b, c[0]), vector::MulAdd(a[1], b, c[1])};
+}
+
+template <typename T>
+constexpr Matrix2x2<T> MulSub(const Matrix2x2<T>& a, const Matrix2x2<T>& b,
+                              const Matrix2x2<T>& c) {
+  return {vector::MulSub(a[0], b[0], c[0]), vector::MulSub(a[1], b[1], c[1])};
+}
+
+template <typename T>
+constexpr Matrix2x2<T> MulSub(const Matrix2x2<T>& a, T b,
+                              const Matrix2x2<T>& c) {
+  return {vector::MulSub(a[0], b, c[0]), vector::MulSub(a[1], b, c[1])};
+}
+
+template <typename T>
+constexpr Matrix2x2<T> NegMulAdd(const Matrix2x2<T>& a, const Matrix2x2<T>& b,
+                                 const Matrix2x2<T>& c) {
+  return {vector::NegMulAdd(a[0], b[0], c[0]),
+          vector::NegMulAdd(a[1], b[1], c[1])};
+}
+
+template <typename T>
+constexpr Matrix2x2<T> NegMulAdd(const Matrix2x2<T>& a, T b,
+                                 const Matrix2x2<T>& c) {
+  return {vector::NegMulAdd(a[0], b, c[0]), vector::NegMulAdd(a[1], b, c[1])};
+}
+}  // namespace matrix
+}  // namespace dlm
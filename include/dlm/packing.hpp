@@ -0,0 +1,479 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "dlm/config.hpp"
+#include "dlm/simd.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector3.hpp"
+#include "dlm/vector4.hpp"
+
+#if defined(DLM_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace dlm {
+namespace vector {
+
+// Compact encodings of float vectors for storage and transport:
+//
+// - OctahedralNormal, a unit Vector3F in 32 bits (3x smaller). The sphere
+//   is folded onto the octahedron |x| + |y| + |z| = 1 and its two
+//   coordinates are stored as 16 bit signed normalized integers. The
+//   decoded direction is within 7e-5 radians (0.004 degrees) of the input.
+// - PackedVector4, a Vector4F with components in [-1, 1] as signed
+//   normalized 10:10:10:2 (4x smaller). x, y and z have a step of 1/511, w
+//   is one of -1, 0 and 1, e.g. the handedness of a tangent frame.
+// - QuantizedPosition, a Vector3F inside a known box as 16 bit unsigned
+//   integers per axis (2x smaller), see PositionQuantizer.
+//
+// The span overloads encode and decode whole buffers four vectors at a time
+// with SSE2 and give the same bits as the single vector functions.
+struct OctahedralNormal {
+  std::uint32_t bits;
+};
+
+struct PackedVector4 {
+  std::uint32_t bits;
+};
+
+struct QuantizedPosition {
+  std::uint16_t x;
+  std::uint16_t y;
+  std::uint16_t z;
+};
+
+static_assert(sizeof(OctahedralNormal) == 4);
+static_assert(sizeof(PackedVector4) == 4);
+static_assert(sizeof(QuantizedPosition) == 6);
+
+namespace detail {
+// Clamps to [low, high], NaN becomes low like the SSE max instruction with
+// the value as the first operand makes it.
+constexpr float Clamp(float value, float low, float high) {
+  return value > low ? (value < high ? value : high) : low;
+}
+
+// Rounds to nearest even, the rounding of the SSE conversion. value must
+// fit in an int32.
+constexpr std::int32_t RoundToInt(float value) {
+  const std::int32_t truncated = static_cast<std::int32_t>(value);
+  const float remainder = value - static_cast<float>(truncated);
+  if (remainder > 0.5f || (remainder == 0.5f && (truncated & 1) != 0)) {
+    return truncated + 1;
+  }
+  if (remainder < -0.5f || (remainder == -0.5f && (truncated & 1) != 0)) {
+    return truncated - 1;
+  }
+  return truncated;
+}
+
+constexpr float Abs(float value) { return value < 0.0f ? -value : value; }
+
+// The sign of an octahedral coordinate, +0 and -0 count as positive.
+constexpr float SignNotZero(float value) {
+  return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+// Sign extends the bits [shift, shift + width) of bits.
+constexpr std::int32_t SignedField(std::uint32_t bits, int shift, int width) {
+  const std::uint32_t field = (bits >> shift) & ((1u << width) - 1u);
+  const std::uint32_t sign = 1u << (width - 1);
+  return static_cast<std::int32_t>(field ^ sign) -
+         static_cast<std::int32_t>(sign);
+}
+
+constexpr float kSnorm16 = 32767.0f;
+constexpr float kSnorm10 = 511.0f;
+constexpr float kUnorm16 = 65535.0f;
+}  // namespace detail
+
+// n should be a unit vector, a zero vector encodes an arbitrary direction.
+constexpr OctahedralNormal EncodeOctahedral(const Vector3F& n) {
+  const float inverse =
+      1.0f / (detail::Abs(n.x) + detail::Abs(n.y) + detail::Abs(n.z));
+  float u = n.x * inverse;
+  float v = n.y * inverse;
+  if (n.z < 0.0f) {
+    // Fold the lower half over the diagonals.
+    const float folded_u = (1.0f - detail::Abs(v)) * detail::SignNotZero(u);
+    v = (1.0f - detail::Abs(u)) * detail::SignNotZero(v);
+    u = folded_u;
+  }
+  const std::int32_t x =
+      detail::RoundToInt(detail::Clamp(u, -1.0f, 1.0f) * detail::kSnorm16);
+  const std::int32_t y =
+      detail::RoundToInt(detail::Clamp(v, -1.0f, 1.0f) * detail::kSnorm16);
+  return {(static_cast<std::uint32_t>(x) & 0xFFFFu) |
+          (static_cast<std::uint32_t>(y) << 16)};
+}
+
+// Returns a unit vector.
+inline Vector3F DecodeOctahedral(OctahedralNormal normal) {
+  float x = std::fmax(
+      static_cast<float>(detail::SignedField(normal.bits, 0, 16)) *
+          (1.0f / detail::kSnorm16),
+      -1.0f);
+  float y = std::fmax(
+      static_cast<float>(detail::SignedField(normal.bits, 16, 16)) *
+          (1.0f / detail::kSnorm16),
+      -1.0f);
+  const float z = 1.0f - std::fabs(x) - std::fabs(y);
+  // Unfold the lower half, a no-op above the equator.
+  const float t = std::fmax(-z, 0.0f);
+  x += x >= 0.0f ? -t : t;
+  y += y >= 0.0f ? -t : t;
+  const float length = std::sqrt(x * x + y * y + z * z);
+  return {x / length, y / length, z / length};
+}
+
+// Components are clamped to [-1, 1] and rounded to nearest, w to the
+// nearest of -1, 0 and 1.
+constexpr PackedVector4 Encode1010102(const Vector4F& v) {
+  const std::int32_t x =
+      detail::RoundToInt(detail::Clamp(v.x, -1.0f, 1.0f) * detail::kSnorm10);
+  const std::int32_t y =
+      detail::RoundToInt(detail::Clamp(v.y, -1.0f, 1.0f) * detail::kSnorm10);
+  const std::int32_t z =
+      detail::RoundToInt(detail::Clamp(v.z, -1.0f, 1.0f) * detail::kSnorm10);
+  const std::int32_t w = detail::RoundToInt(detail::Clamp(v.w, -1.0f, 1.0f));
+  return {(static_cast<std::uint32_t>(x) & 0x3FFu) |
+          ((static_cast<std::uint32_t>(y) & 0x3FFu) << 10) |
+          ((static_cast<std::uint32_t>(z) & 0x3FFu) << 20) |
+          (static_cast<std::uint32_t>(w) << 30)};
+}
+
+// The most negative encodings, -512 and -2, decode to -1 like the GPU
+// formats do.
+constexpr Vector4F Decode1010102(PackedVector4 packed) {
+  const auto decode = [](std::int32_t value, float scale) {
+    const float decoded = static_cast<float>(value) * scale;
+    return decoded > -1.0f ? decoded : -1.0f;
+  };
+  return {decode(detail::SignedField(packed.bits, 0, 10),
+                 1.0f / detail::kSnorm10),
+          decode(detail::SignedField(packed.bits, 10, 10),
+                 1.0f / detail::kSnorm10),
+          decode(detail::SignedField(packed.bits, 20, 10),
+                 1.0f / detail::kSnorm10),
+          decode(detail::SignedField(packed.bits, 30, 2), 1.0f)};
+}
+
+// Quantizes positions inside the box [min, max] to 65536 steps per axis.
+// Positions outside the box are clamped to it. A position inside the box
+// decodes to within MaxError() of itself, half a step per axis plus float
+// rounding.
+class PositionQuantizer {
+ public:
+  PositionQuantizer(const Vector3F& min, const Vector3F& max);
+
+  QuantizedPosition Encode(const Vector3F& position) const;
+  Vector3F Decode(QuantizedPosition position) const;
+
+  void Encode(Span<const Vector3F> in, Span<QuantizedPosition> out) const;
+  void Decode(Span<const QuantizedPosition> in, Span<Vector3F> out) const;
+
+  Vector3F Min() const { return min_; }
+  Vector3F Step() const { return step_; }
+  Vector3F MaxError() const { return step_ * 0.5f; }
+
+ private:
+  Vector3F min_;
+  // 1 / step_, zero for an empty axis.
+  Vector3F scale_;
+  Vector3F step_;
+};
+
+inline PositionQuantizer::PositionQuantizer(const Vector3F& min,
+                                            const Vector3F& max)
+    : min_{min} {
+  assert(min <= max);
+  for (int i = 0; i < 3; ++i) {
+    const float extent = max[i] - min[i];
+    step_[i] = extent / detail::kUnorm16;
+    scale_[i] = extent > 0.0f ? detail::kUnorm16 / extent : 0.0f;
+  }
+}
+
+inline QuantizedPosition PositionQuantizer::Encode(
+    const Vector3F& position) const {
+  const auto encode = [](float value, float min, float scale) {
+    return static_cast<std::uint16_t>(detail::RoundToInt(
+        detail::Clamp((value - min) * scale, 0.0f, detail::kUnorm16)));
+  };
+  return {encode(position.x, min_.x, scale_.x),
+          encode(position.y, min_.y, scale_.y),
+          encode(position.z, min_.z, scale_.z)};
+}
+
+inline Vector3F PositionQuantizer::Decode(QuantizedPosition position) const {
+  return {min_.x + static_cast<float>(position.x) * step_.x,
+          min_.y + static_cast<float>(position.y) * step_.y,
+          min_.z + static_cast<float>(position.z) * step_.z};
+}
+
+#if defined(DLM_SSE2)
+namespace detail {
+inline __m128 Clamp(__m128 value, float low, float high) {
+  return _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(low)), _mm_set1_ps(high));
+}
+
+// mask ? a : b
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Packs two registers of values in [0, 65535] to unsigned 16 bits.
+inline __m128i PackUnsigned16(__m128i a, __m128i b) {
+#if defined(DLM_SSE4_1)
+  return _mm_packus_epi32(a, b);
+#else
+  // Only the signed saturating pack exists, shift the range into it.
+  const __m128i bias = _mm_set1_epi32(0x8000);
+  return _mm_xor_si128(
+      _mm_packs_epi32(_mm_sub_epi32(a, bias), _mm_sub_epi32(b, bias)),
+      _mm_set1_epi16(static_cast<short>(0x8000)));
+#endif
+}
+}  // namespace detail
+#endif
+
+inline void EncodeOctahedral(Span<const Vector3F> in,
+                             Span<OctahedralNormal> out) {
+  assert(out.size() >= in.size());
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 minus_one = _mm_set1_ps(-1.0f);
+  for (; i + 4 <= count; i += 4) {
+    __m128 x, y, z;
+    simd::LoadTransposed(&in[i].x, x, y, z);
+    const __m128 inverse = _mm_div_ps(
+        one, _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign_mask, x),
+                                   _mm_andnot_ps(sign_mask, y)),
+                        _mm_andnot_ps(sign_mask, z)));
+    const __m128 u = _mm_mul_ps(x, inverse);
+    const __m128 v = _mm_mul_ps(y, inverse);
+    const __m128 u_sign =
+        detail::Select(_mm_cmpge_ps(u, _mm_setzero_ps()), one, minus_one);
+    const __m128 v_sign =
+        detail::Select(_mm_cmpge_ps(v, _mm_setzero_ps()), one, minus_one);
+    const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+    const __m128 folded_u = _mm_mul_ps(
+        _mm_sub_ps(one, _mm_andnot_ps(sign_mask, v)), u_sign);
+    const __m128 folded_v = _mm_mul_ps(
+        _mm_sub_ps(one, _mm_andnot_ps(sign_mask, u)), v_sign);
+    const __m128i encoded_u = _mm_cvtps_epi32(
+        _mm_mul_ps(detail::Clamp(detail::Select(lower, folded_u, u), -1.0f,
+                                 1.0f),
+                   _mm_set1_ps(detail::kSnorm16)));
+    const __m128i encoded_v = _mm_cvtps_epi32(
+        _mm_mul_ps(detail::Clamp(detail::Select(lower, folded_v, v), -1.0f,
+                                 1.0f),
+                   _mm_set1_ps(detail::kSnorm16)));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(out.data() + i),
+        _mm_or_si128(_mm_and_si128(encoded_u, _mm_set1_epi32(0xFFFF)),
+                     _mm_slli_epi32(encoded_v, 16)));
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = EncodeOctahedral(in[i]);
+  }
+}
+
+inline void DecodeOctahedral(Span<const OctahedralNormal> in,
+                             Span<Vector3F> out) {
+  assert(out.size() >= in.size());
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  const __m128 scale = _mm_set1_ps(1.0f / detail::kSnorm16);
+  const __m128 minus_one = _mm_set1_ps(-1.0f);
+  for (; i + 4 <= count; i += 4) {
+    const __m128i bits =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+    __m128 x = _mm_max_ps(
+        _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(bits, 16),
+                                                  16)),
+                   scale),
+        minus_one);
+    __m128 y = _mm_max_ps(
+        _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(bits, 16)), scale),
+        minus_one);
+    const __m128 z = _mm_sub_ps(
+        _mm_sub_ps(_mm_set1_ps(1.0f), _mm_andnot_ps(sign_mask, x)),
+        _mm_andnot_ps(sign_mask, y));
+    const __m128 t = _mm_max_ps(_mm_xor_ps(z, sign_mask), _mm_setzero_ps());
+    const __m128 minus_t = _mm_xor_ps(t, sign_mask);
+    x = _mm_add_ps(
+        x, detail::Select(_mm_cmpge_ps(x, _mm_setzero_ps()), minus_t, t));
+    y = _mm_add_ps(
+        y, detail::Select(_mm_cmpge_ps(y, _mm_setzero_ps()), minus_t, t));
+    const __m128 length = _mm_sqrt_ps(_mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+    simd::StoreTransposed(_mm_div_ps(x, length), _mm_div_ps(y, length),
+                          _mm_div_ps(z, length), &out[i].x);
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = DecodeOctahedral(in[i]);
+  }
+}
+
+inline void Encode1010102(Span<const Vector4F> in, Span<PackedVector4> out) {
+  assert(out.size() >= in.size());
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  const __m128 snorm10 = _mm_set1_ps(detail::kSnorm10);
+  const __m128i mask10 = _mm_set1_epi32(0x3FF);
+  for (; i + 4 <= count; i += 4) {
+    const float* values = &in.data()[i].x;
+    __m128 x = _mm_loadu_ps(values);
+    __m128 y = _mm_loadu_ps(values + 4);
+    __m128 z = _mm_loadu_ps(values + 8);
+    __m128 w = _mm_loadu_ps(values + 12);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    const __m128i encoded_x = _mm_cvtps_epi32(
+        _mm_mul_ps(detail::Clamp(x, -1.0f, 1.0f), snorm10));
+    const __m128i encoded_y = _mm_cvtps_epi32(
+        _mm_mul_ps(detail::Clamp(y, -1.0f, 1.0f), snorm10));
+    const __m128i encoded_z = _mm_cvtps_epi32(
+        _mm_mul_ps(detail::Clamp(z, -1.0f, 1.0f), snorm10));
+    const __m128i encoded_w = _mm_cvtps_epi32(detail::Clamp(w, -1.0f, 1.0f));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(out.data() + i),
+        _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(encoded_x, mask10),
+                         _mm_slli_epi32(_mm_and_si128(encoded_y, mask10), 10)),
+            _mm_or_si128(_mm_slli_epi32(_mm_and_si128(encoded_z, mask10), 20),
+                         _mm_slli_epi32(encoded_w, 30))));
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = Encode1010102(in[i]);
+  }
+}
+
+inline void Decode1010102(Span<const PackedVector4> in, Span<Vector4F> out) {
+  assert(out.size() >= in.size());
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  const __m128 scale = _mm_set1_ps(1.0f / detail::kSnorm10);
+  const __m128 minus_one = _mm_set1_ps(-1.0f);
+  for (; i + 4 <= count; i += 4) {
+    const __m128i bits =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+    // Shift each field to the top and back down to sign extend it.
+    __m128 x = _mm_max_ps(
+        _mm_mul_ps(
+            _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(bits, 22), 22)),
+            scale),
+        minus_one);
+    __m128 y = _mm_max_ps(
+        _mm_mul_ps(
+            _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(bits, 12), 22)),
+            scale),
+        minus_one);
+    __m128 z = _mm_max_ps(
+        _mm_mul_ps(
+            _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(bits, 2), 22)),
+            scale),
+        minus_one);
+    __m128 w =
+        _mm_max_ps(_mm_cvtepi32_ps(_mm_srai_epi32(bits, 30)), minus_one);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    float* values = &out.data()[i].x;
+    _mm_storeu_ps(values, x);
+    _mm_storeu_ps(values + 4, y);
+    _mm_storeu_ps(values + 8, z);
+    _mm_storeu_ps(values + 12, w);
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = Decode1010102(in[i]);
+  }
+}
+
+// Four positions are 12 floats and 12 integers, handled as three registers
+// whose lanes cycle through the axes.
+inline void PositionQuantizer::Encode(Span<const Vector3F> in,
+                                      Span<QuantizedPosition> out) const {
+  assert(out.size() >= in.size());
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  const __m128 min[3] = {_mm_setr_ps(min_.x, min_.y, min_.z, min_.x),
+                         _mm_setr_ps(min_.y, min_.z, min_.x, min_.y),
+                         _mm_setr_ps(min_.z, min_.x, min_.y, min_.z)};
+  const __m128 scale[3] = {
+      _mm_setr_ps(scale_.x, scale_.y, scale_.z, scale_.x),
+      _mm_setr_ps(scale_.y, scale_.z, scale_.x, scale_.y),
+      _mm_setr_ps(scale_.z, scale_.x, scale_.y, scale_.z)};
+  for (; i + 4 <= count; i += 4) {
+    const float* values = &in.data()[i].x;
+    __m128i encoded[3];
+    for (int r = 0; r < 3; ++r) {
+      encoded[r] = _mm_cvtps_epi32(detail::Clamp(
+          _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(values + 4 * r), min[r]),
+                     scale[r]),
+          0.0f, detail::kUnorm16));
+    }
+    std::uint16_t* destination = &out.data()[i].x;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination),
+                     detail::PackUnsigned16(encoded[0], encoded[1]));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(destination + 8),
+                     detail::PackUnsigned16(encoded[2], encoded[2]));
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = Encode(in[i]);
+  }
+}
+
+inline void PositionQuantizer::Decode(Span<const QuantizedPosition> in,
+                                      Span<Vector3F> out) const {
+  assert(out.size() >= in.size());
+  const std::size_t count = in.size();
+  std::size_t i = 0;
+#if defined(DLM_SSE2)
+  const __m128 min[3] = {_mm_setr_ps(min_.x, min_.y, min_.z, min_.x),
+                         _mm_setr_ps(min_.y, min_.z, min_.x, min_.y),
+                         _mm_setr_ps(min_.z, min_.x, min_.y, min_.z)};
+  const __m128 step[3] = {_mm_setr_ps(step_.x, step_.y, step_.z, step_.x),
+                          _mm_setr_ps(step_.y, step_.z, step_.x, step_.y),
+                          _mm_setr_ps(step_.z, step_.x, step_.y, step_.z)};
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 4 <= count; i += 4) {
+    const std::uint16_t* source = &in.data()[i].x;
+    const __m128i first =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+    const __m128i last =
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + 8));
+    const __m128i encoded[3] = {_mm_unpacklo_epi16(first, zero),
+                                _mm_unpackhi_epi16(first, zero),
+                                _mm_unpacklo_epi16(last, zero)};
+    float* values = &out.data()[i].x;
+    for (int r = 0; r < 3; ++r) {
+      _mm_storeu_ps(values + 4 * r,
+                    _mm_add_ps(min[r], _mm_mul_ps(_mm_cvtepi32_ps(encoded[r]),
+                                                  step[r])));
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = Decode(in[i]);
+  }
+}
+
+}  // namespace vector
+}  // namespace dlm
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "dlm/simd.hpp"
+#include "dlm/vector.hpp"
+#include "dlm/vector3.hpp"
+
+namespace dlm {
+namespace vector {
+
+namespace layout {
+// Storage rounded up to a full SIMD register, see PaddedVector3F.
+struct Padded {};
+
+// Vector3<float> padded to 16 bytes so it occupies exactly one SSE register.
+// The padding lane holds an unspecified value. Component and operator[]
+// stop at z.
+template <>
+struct alignas(16) Components<3, float, Padded> {
+  constexpr Components() : x{0.0f}, y{0.0f}, z{0.0f}, padding{0.0f} {};
+  constexpr Components(float x, float y, float z)
+      : x{x}, y{y}, z{z}, padding{0.0f} {};
+
+  float x;
+  float y;
+  float z;
+  float padding;
+
+  // The components in index order, for Component.
+  static constexpr float Components::*kMembers[] = {
+      &Components::x, &Components::y, &Components::z};
+};
+}  // namespace layout
+
+#if defined(DLM_SSE2)
+namespace detail {
+// The Vector4<float> backend with the padding lane left out of the dot and
+// cross products and of the comparisons. The lane wise arithmetic carries
+// it along, whatever it computes there is ignored.
+template <>
+struct Simd<3, float, layout::Padded> : Simd<4, float> {
+  static Register Dot(Register a, Register b) { return simd::Dot3(a, b); }
+  static Register Cross(Register a, Register b) {
+    return simd::Cross3(a, b);
+  }
+  static bool All(Register mask) { return (simd::Mask(mask) & 0x7) == 0x7; }
+  static bool Any(Register mask) { return (simd::Mask(mask) & 0x7) != 0; }
+};
+}  // namespace detail
+#endif
+
+// Vector3<float> in one SSE register. Every Vector operator and the free
+// functions over Vector<N, T, Layout> apply, it converts explicitly to and
+// from Vector3F.
+using PaddedVector3F = Vector<3, float, layout::Padded>;
+
+static_assert(sizeof(PaddedVector3F) == 4 * sizeof(float));
+static_assert(alignof(PaddedVector3F) == 16);
+static_assert(std::is_trivially_copyable<PaddedVector3F>::value);
+static_assert(std::is_standard_layout<PaddedVector3F>::value);
+static_assert(offsetof(PaddedVector3F, z) == 2 * sizeof(float));
+
+}  // namespace vector
+}  // namespace dlm
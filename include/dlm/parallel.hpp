@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace dlm {
+namespace detail {
+
+// Below this many items a range or subtree is not worth a thread.
+constexpr std::size_t kMinParallelCount = std::size_t{1} << 14;
+
+// The same for tree queries, which walk a tree of tens of points each.
+constexpr std::size_t kMinParallelQueries = kMinParallelCount / 16;
+
+// Number of threads to use when threads were requested, 0 meaning one per
+// hardware thread.
+inline std::size_t ThreadCount(std::size_t threads) {
+  if (threads != 0) {
+    return threads;
+  }
+  return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+// ThreadCount for count items, at most one thread per min_count of them.
+inline std::size_t ThreadCount(std::size_t threads, std::size_t count,
+                               std::size_t min_count = kMinParallelCount) {
+  return std::max<std::size_t>(
+      1, std::min(ThreadCount(threads), count / min_count));
+}
+
+// Calls function(begin, end) for count items split evenly over up to
+// threads threads, the last chunk on the calling thread.
+template <typename function_type>
+void ParallelFor(std::size_t count, std::size_t threads,
+                 function_type&& function) {
+  threads = std::max<std::size_t>(1, std::min(threads, count));
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (std::size_t t = 0; t + 1 < threads; ++t) {
+    workers.emplace_back(function, count * t / threads,
+                         count * (t + 1) / threads);
+  }
+  function(count * (threads - 1) / threads, count);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+}  // namespace detail
+}  // namespace dlm
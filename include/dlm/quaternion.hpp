@@ -0,0 +1,364 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "dlm/matrix3x3.hpp"
+#include "dlm/simd.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector3.hpp"
+#include "dlm/vector3batch.hpp"
+#include "dlm/vector4.hpp"
+
+namespace dlm {
+
+// Rotation quaternion stored as a Vector4, x, y and z hold the imaginary
+// part and w the real part. Quaternion<float> is a single SSE register.
+template <typename T>
+struct Quaternion {
+  using ValueType = T;
+
+  // Constructors
+  constexpr Quaternion()
+      : data{static_cast<T>(0), static_cast<T>(0), static_cast<T>(0),
+             static_cast<T>(1)} {};
+  constexpr Quaternion(T x, T y, T z, T w) : data{x, y, z, w} {};
+  constexpr Quaternion(const vector::Vector3<T>& imaginary, T real)
+      : data{imaginary.x, imaginary.y, imaginary.z, real} {};
+  constexpr explicit Quaternion(const vector::Vector4<T>& xyzw)
+      : data{xyzw} {};
+
+  // Rotation of angle radians around a unit length axis.
+  static Quaternion<T> FromAxisAngle(const vector::Vector3<T>& axis, T angle);
+
+  // Operators
+  constexpr Quaternion<T> operator-() const;
+  constexpr Quaternion<T> operator+(const Quaternion<T>& q) const;
+  constexpr Quaternion<T> operator-(const Quaternion<T>& q) const;
+  constexpr Quaternion<T> operator*(T scalar) const;
+
+  // Hamilton product, applies q first and then this.
+  constexpr Quaternion<T> operator*(const Quaternion<T>& q) const;
+  constexpr Quaternion<T>& operator*=(const Quaternion<T>& q);
+
+  constexpr T operator[](int index) const;
+
+  // dot product
+  constexpr T operator|(const Quaternion<T>& q) const;
+
+  constexpr bool operator==(const Quaternion<T>& q) const;
+  constexpr bool operator!=(const Quaternion<T>& q) const;
+
+  // Helper functions
+  constexpr Quaternion<T> Conjugate() const;
+  // Conjugate divided by the squared length, equal to Conjugate for unit
+  // quaternions. The zero quaternion has no inverse, for floating point T
+  // every component comes out NaN.
+  constexpr Quaternion<T> Inverse() const;
+
+  void Normalize();
+
+  T Length() const;
+  constexpr T LengthSquared() const;
+
+  // Rotates v, the quaternion must be unit length.
+  constexpr vector::Vector3<T> Rotate(const vector::Vector3<T>& v) const;
+
+  // Rotation matrix of a unit quaternion.
+  constexpr matrix::Matrix3x3<T> ToMatrix() const;
+
+  constexpr vector::Vector3<T> Imaginary() const;
+  constexpr T Real() const;
+  constexpr const vector::Vector4<T>& ToVector4() const;
+
+ private:
+  vector::Vector4<T> data;
+};
+
+template <typename T>
+Quaternion<T> Quaternion<T>::FromAxisAngle(const vector::Vector3<T>& axis,
+                                           T angle) {
+  const T half_angle = angle * static_cast<T>(0.5);
+  return {axis * std::sin(half_angle), std::cos(half_angle)};
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::operator-() const {
+  return Quaternion<T>{-data};
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::operator+(const Quaternion<T>& q) const {
+  return Quaternion<T>{data + q.data};
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::operator-(const Quaternion<T>& q) const {
+  return Quaternion<T>{data - q.data};
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::operator*(T scalar) const {
+  return Quaternion<T>{data * scalar};
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::operator*(const Quaternion<T>& q) const {
+#if defined(DLM_SSE2)
+  if constexpr (std::is_same<T, float>::value) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      // Each lane of this scales a permutation of q with the signs of the
+      // Hamilton product folded in.
+      const __m128 a = vector::detail::Load(data);
+      const __m128 b = vector::detail::Load(q.data);
+      const __m128 ax = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0));
+      const __m128 ay = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1));
+      const __m128 az = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2));
+      const __m128 aw = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+      const __m128 b_wzyx = _mm_xor_ps(
+          _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)),
+          _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f));
+      const __m128 b_zwxy = _mm_xor_ps(
+          _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)),
+          _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f));
+      const __m128 b_yxwz = _mm_xor_ps(
+          _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)),
+          _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f));
+#if defined(DLM_FMA)
+      const __m128 r = _mm_fmadd_ps(
+          ax, b_wzyx,
+          _mm_fmadd_ps(ay, b_zwxy,
+                       _mm_fmadd_ps(az, b_yxwz, _mm_mul_ps(aw, b))));
+#else
+      const __m128 r = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(aw, b), _mm_mul_ps(ax, b_wzyx)),
+          _mm_add_ps(_mm_mul_ps(ay, b_zwxy), _mm_mul_ps(az, b_yxwz)));
+#endif
+      return Quaternion<T>{vector::detail::FromRegister<4, float>(r)};
+    }
+  }
+#endif
+  const vector::Vector3<T> a_v = Imaginary();
+  const vector::Vector3<T> b_v = q.Imaginary();
+  return {b_v * data.w + a_v * q.data.w + (a_v ^ b_v),
+          data.w * q.data.w - (a_v | b_v)};
+}
+
+template <typename T>
+constexpr Quaternion<T>& Quaternion<T>::operator*=(const Quaternion<T>& q) {
+  *this = *this * q;
+  return *this;
+}
+
+template <typename T>
+constexpr T Quaternion<T>::operator[](int index) const {
+  return data[index];
+}
+
+template <typename T>
+constexpr T Quaternion<T>::operator|(const Quaternion<T>& q) const {
+  return data | q.data;
+}
+
+template <typename T>
+constexpr bool Quaternion<T>::operator==(const Quaternion<T>& q) const {
+  return data == q.data;
+}
+
+template <typename T>
+constexpr bool Quaternion<T>::operator!=(const Quaternion<T>& q) const {
+  return data != q.data;
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::Conjugate() const {
+  return {-data.x, -data.y, -data.z, data.w};
+}
+
+template <typename T>
+constexpr Quaternion<T> Quaternion<T>::Inverse() const {
+  return Conjugate() * (static_cast<T>(1) / LengthSquared());
+}
+
+template <typename T>
+void Quaternion<T>::Normalize() {
+  data.Normalize();
+}
+
+template <typename T>
+T Quaternion<T>::Length() const {
+  return data.Length();
+}
+
+template <typename T>
+constexpr T Quaternion<T>::LengthSquared() const {
+  return data.LengthSquared();
+}
+
+template <typename T>
+constexpr vector::Vector3<T> Quaternion<T>::Rotate(
+    const vector::Vector3<T>& v) const {
+  // v' = v + w * t + u x t with t = 2 * (u x v), two cross products instead
+  // of the two full quaternion products of q * v * q^-1.
+  const vector::Vector3<T> u = Imaginary();
+  const vector::Vector3<T> t = (u ^ v) * static_cast<T>(2);
+  return v + t * data.w + (u ^ t);
+}
+
+template <typename T>
+constexpr matrix::Matrix3x3<T> Quaternion<T>::ToMatrix() const {
+  const T one = static_cast<T>(1);
+  const T two = static_cast<T>(2);
+  const T xx = data.x * data.x, yy = data.y * data.y, zz = data.z * data.z;
+  const T xy = data.x * data.y, xz = data.x * data.z, yz = data.y * data.z;
+  const T wx = data.w * data.x, wy = data.w * data.y, wz = data.w * data.z;
+  return {one - two * (yy + zz), two * (xy - wz),       two * (xz + wy),
+          two * (xy + wz),       one - two * (xx + zz), two * (yz - wx),
+          two * (xz - wy),       two * (yz + wx),       one - two * (xx + yy)};
+}
+
+template <typename T>
+constexpr vector::Vector3<T> Quaternion<T>::Imaginary() const {
+  return {data.x, data.y, data.z};
+}
+
+template <typename T>
+constexpr T Quaternion<T>::Real() const {
+  return data.w;
+}
+
+template <typename T>
+constexpr const vector::Vector4<T>& Quaternion<T>::ToVector4() const {
+  return data;
+}
+
+// Normalized linear interpolation along the shortest arc. Cheaper than
+// Slerp, the angular speed is not constant but the path is the same.
+template <typename T>
+Quaternion<T> Nlerp(const Quaternion<T>& q1, const Quaternion<T>& q2, T t) {
+  const T t2 = (q1 | q2) < static_cast<T>(0) ? -t : t;
+  Quaternion<T> result = q1 * (static_cast<T>(1) - t) + q2 * t2;
+  result.Normalize();
+  return result;
+}
+
+namespace detail {
+// Coefficients of the polynomial slerp estimate from D. Eberly, "A Fast and
+// Accurate Algorithm for Computing SLERP". u[i] = 1 / (i (2i + 1)) and
+// v[i] = i / (2i + 1) for i = 1..8, the last pair is scaled by kSlerpMu to
+// cancel the truncation error.
+template <typename T>
+constexpr T kSlerpMu = static_cast<T>(1.85298109240830);
+template <typename T>
+constexpr T kSlerpU[8] = {
+    static_cast<T>(1.0 / (1 * 3)),  static_cast<T>(1.0 / (2 * 5)),
+    static_cast<T>(1.0 / (3 * 7)),  static_cast<T>(1.0 / (4 * 9)),
+    static_cast<T>(1.0 / (5 * 11)), static_cast<T>(1.0 / (6 * 13)),
+    static_cast<T>(1.0 / (7 * 15)), kSlerpMu<T> / static_cast<T>(8 * 17)};
+template <typename T>
+constexpr T kSlerpV[8] = {
+    static_cast<T>(1.0 / 3),  static_cast<T>(2.0 / 5),
+    static_cast<T>(3.0 / 7),  static_cast<T>(4.0 / 9),
+    static_cast<T>(5.0 / 11), static_cast<T>(6.0 / 13),
+    static_cast<T>(7.0 / 15), kSlerpMu<T> * static_cast<T>(8.0 / 17)};
+
+// sin((1 - t) angle) / sin(angle) and sin(t angle) / sin(angle) for
+// cos(angle) = x_minus_one + 1, evaluated with the nested polynomial instead
+// of acos and sin. Both weights go through the same loop so their dependency
+// chains overlap.
+template <typename T>
+constexpr void SlerpWeights(T t, T x_minus_one, T& weight1, T& weight2) {
+  const T s = static_cast<T>(1) - t;
+  const T s_squared = s * s;
+  const T t_squared = t * t;
+  T factors1[8] = {};
+  T factors2[8] = {};
+  for (int i = 0; i < 8; ++i) {
+    factors1[i] = (kSlerpU<T>[i] * s_squared - kSlerpV<T>[i]) * x_minus_one;
+    factors2[i] = (kSlerpU<T>[i] * t_squared - kSlerpV<T>[i]) * x_minus_one;
+  }
+  weight1 = static_cast<T>(1);
+  weight2 = static_cast<T>(1);
+  for (int i = 7; i >= 0; --i) {
+    weight1 = static_cast<T>(1) + factors1[i] * weight1;
+    weight2 = static_cast<T>(1) + factors2[i] * weight2;
+  }
+  weight1 *= s;
+  weight2 *= t;
+}
+}  // namespace detail
+
+// Spherical linear interpolation along the shortest arc between unit
+// quaternions. Uses a polynomial estimate of the sine weights, no
+// trigonometric calls or divisions. The estimate is exact at t = 0 and t = 1
+// and every component stays within 2.5e-5 of the exact slerp, the error
+// peaks for quaternions close to 90 degrees apart.
+template <typename T>
+constexpr Quaternion<T> Slerp(const Quaternion<T>& q1, const Quaternion<T>& q2,
+                              T t) {
+  T cos_angle = q1 | q2;
+  T sign = static_cast<T>(1);
+  if (cos_angle < static_cast<T>(0)) {
+    cos_angle = -cos_angle;
+    sign = static_cast<T>(-1);
+  }
+  T weight1 = static_cast<T>(0);
+  T weight2 = static_cast<T>(0);
+  detail::SlerpWeights(t, cos_angle - static_cast<T>(1), weight1, weight2);
+  return q1 * weight1 + q2 * (sign * weight2);
+}
+
+// Writes q.Rotate(points[i]) to out[i] for every point. out may alias
+// points. The quaternion is converted to a matrix once, which needs fewer
+// operations per point than the cross product formula.
+template <typename T>
+void Rotate(const Quaternion<T>& q, Span<const vector::Vector3<T>> points,
+            Span<vector::Vector3<T>> out) {
+  assert(out.size() >= points.size());
+  const matrix::Matrix3x3<T> m = q.ToMatrix();
+  const vector::Vector3<T> r0 = m[0], r1 = m[1], r2 = m[2];
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const vector::Vector3<T> p = points[i];
+    out[i] = {r0.x * p.x + r0.y * p.y + r0.z * p.z,
+              r1.x * p.x + r1.y * p.y + r1.z * p.z,
+              r2.x * p.x + r2.y * p.y + r2.z * p.z};
+  }
+}
+
+// Structure of arrays version of Rotate, processes whole blocks so every
+// lane maps to a vector register lane.
+template <typename T>
+void Rotate(const Quaternion<T>& q, const vector::Vector3Batch<T>& points,
+            vector::Vector3Batch<T>& out) {
+  constexpr std::size_t kLanes = vector::Vector3Batch<T>::kLanes;
+  out.Resize(points.Size());
+  const matrix::Matrix3x3<T> m = q.ToMatrix();
+  const vector::Vector3<T> r0 = m[0], r1 = m[1], r2 = m[2];
+  const T* in_x = points.X();
+  const T* in_y = points.Y();
+  const T* in_z = points.Z();
+  T* out_x = out.X();
+  T* out_y = out.Y();
+  T* out_z = out.Z();
+  for (std::size_t i = 0; i < points.PaddedSize(); i += kLanes) {
+    T x[kLanes], y[kLanes], z[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      const T px = in_x[i + lane], py = in_y[i + lane], pz = in_z[i + lane];
+      x[lane] = r0.x * px + r0.y * py + r0.z * pz;
+      y[lane] = r1.x * px + r1.y * py + r1.z * pz;
+      z[lane] = r2.x * px + r2.y * py + r2.z * pz;
+    }
+    std::copy_n(x, kLanes, out_x + i);
+    std::copy_n(y, kLanes, out_y + i);
+    std::copy_n(z, kLanes, out_z + i);
+  }
+}
+
+using QuaternionF = Quaternion<float>;
+
+static_assert(std::is_move_constructible<QuaternionF>::value);
+static_assert(std::is_trivially_copyable<QuaternionF>::value);
+static_assert(std::is_standard_layout<QuaternionF>::value);
+}  // namespace dlm
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "dlm/config.hpp"
+
+#if defined(DLM_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace dlm {
+namespace simd {
+
+// Calls f(i) for every i < N, unrolled at compile time so arrays of
+// registers indexed by i stay in registers.
+template <typename F, std::size_t... I>
+inline void Unroll(std::index_sequence<I...>, F f) {
+  (f(I), ...);
+}
+
+template <std::size_t N, typename F>
+inline void Unroll(F f) {
+  Unroll(std::make_index_sequence<N>{}, f);
+}
+
+// Replaces every element of values with its square root. std::sqrt sets
+// errno on negative inputs which keeps compilers from vectorizing it, so the
+// widest available register is used explicitly.
+template <std::size_t N>
+inline void Sqrt(float (&values)[N]) {
+  std::size_t i = 0;
+#if defined(DLM_AVX)
+  for (; i + 8 <= N; i += 8) {
+    _mm256_storeu_ps(values + i, _mm256_sqrt_ps(_mm256_loadu_ps(values + i)));
+  }
+#endif
+#if defined(DLM_SSE2)
+  for (; i + 4 <= N; i += 4) {
+    _mm_storeu_ps(values + i, _mm_sqrt_ps(_mm_loadu_ps(values + i)));
+  }
+#endif
+  for (; i < N; ++i) {
+    values[i] = std::sqrt(values[i]);
+  }
+}
+
+template <std::size_t N>
+inline void Sqrt(double (&values)[N]) {
+  std::size_t i = 0;
+#if defined(DLM_AVX)
+  for (; i + 4 <= N; i += 4) {
+    _mm256_storeu_pd(values + i, _mm256_sqrt_pd(_mm256_loadu_pd(values + i)));
+  }
+#endif
+#if defined(DLM_SSE2)
+  for (; i + 2 <= N; i += 2) {
+    _mm_storeu_pd(values + i, _mm_sqrt_pd(_mm_loadu_pd(values + i)));
+  }
+#endif
+  for (; i < N; ++i) {
+    values[i] = std::sqrt(values[i]);
+  }
+}
+
+#if defined(DLM_SSE2)
+
+// Sums the four lanes of a and b multiplied together and broadcasts the
+// result to every lane.
+inline __m128 Dot4(__m128 a, __m128 b) {
+#if defined(DLM_SSE4_1)
+  return _mm_dp_ps(a, b, 0xFF);
+#else
+  const __m128 product = _mm_mul_ps(a, b);
+  const __m128 pairs = _mm_add_ps(
+      product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_add_ps(pairs,
+                    _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+#endif
+}
+
+// Same as Dot4 but ignores the fourth lane.
+inline __m128 Dot3(__m128 a, __m128 b) {
+#if defined(DLM_SSE4_1)
+  return _mm_dp_ps(a, b, 0x7F);
+#else
+  const __m128 product = _mm_mul_ps(a, b);
+  const __m128 x = _mm_shuffle_ps(product, product, _MM_SHUFFLE(0, 0, 0, 0));
+  const __m128 y = _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 1, 1, 1));
+  const __m128 z = _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 2, 2, 2));
+  return _mm_add_ps(_mm_add_ps(x, y), z);
+#endif
+}
+
+// Cross product of the first three lanes, the fourth lane is zero when the
+// inputs have equal fourth lanes.
+inline __m128 Cross3(__m128 a, __m128 b) {
+  const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+  const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+#if defined(DLM_FMA)
+  const __m128 c = _mm_fmsub_ps(a, b_yzx, _mm_mul_ps(a_yzx, b));
+#else
+  const __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+#endif
+  return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+// Loads four vectors of two, three or four floats stored back to back as one
+// register per component. Each reads exactly the floats of the four vectors.
+inline void LoadTransposed(const float* values, __m128& x, __m128& y) {
+  const __m128 low = _mm_loadu_ps(values);
+  const __m128 high = _mm_loadu_ps(values + 4);
+  x = _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+  y = _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+inline void LoadTransposed(const float* values, __m128& x, __m128& y,
+                           __m128& z) {
+  __m128 v0 = _mm_loadu_ps(values);
+  __m128 v1 = _mm_loadu_ps(values + 3);
+  __m128 v2 = _mm_loadu_ps(values + 6);
+  const __m128 last = _mm_loadu_ps(values + 8);
+  __m128 v3 = _mm_shuffle_ps(last, last, _MM_SHUFFLE(0, 3, 2, 1));
+  _MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+  x = v0;
+  y = v1;
+  z = v2;
+}
+
+inline void LoadTransposed(const float* values, __m128& x, __m128& y,
+                           __m128& z, __m128& w) {
+  x = _mm_loadu_ps(values);
+  y = _mm_loadu_ps(values + 4);
+  z = _mm_loadu_ps(values + 8);
+  w = _mm_loadu_ps(values + 12);
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+// Stores one register per component as four vectors of two, three or four
+// floats back to back, the inverse of LoadTransposed. Each writes exactly the
+// floats of the four vectors.
+inline void StoreTransposed(__m128 x, __m128 y, float* values) {
+  _mm_storeu_ps(values, _mm_unpacklo_ps(x, y));
+  _mm_storeu_ps(values + 4, _mm_unpackhi_ps(x, y));
+}
+
+inline void StoreTransposed(__m128 x, __m128 y, __m128 z, float* values) {
+  __m128 w = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+  // Each store spills into the next vector, which the next store fixes.
+  _mm_storeu_ps(values, x);
+  _mm_storeu_ps(values + 3, y);
+  _mm_storeu_ps(values + 6, z);
+  _mm_storel_pi(reinterpret_cast<__m64*>(values + 9), w);
+  _mm_store_ss(values + 11, _mm_movehl_ps(w, w));
+}
+
+inline void StoreTransposed(__m128 x, __m128 y, __m128 z, __m128 w,
+                            float* values) {
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+  _mm_storeu_ps(values, x);
+  _mm_storeu_ps(values + 4, y);
+  _mm_storeu_ps(values + 8, z);
+  _mm_storeu_ps(values + 12, w);
+}
+
+// Returns the lanes of a compare result as a bit mask, lane 0 in bit 0.
+inline int Mask(__m128 compare) { return _mm_movemask_ps(compare); }
+
+// Mask of four compare results, lane j of a register r in bit 4 * r + j.
+inline std::uint32_t Mask16(__m128 compare0, __m128 compare1,
+                            __m128 compare2, __m128 compare3) {
+  const __m128i bytes =
+      _mm_packs_epi16(_mm_packs_epi32(_mm_castps_si128(compare0),
+                                      _mm_castps_si128(compare1)),
+                      _mm_packs_epi32(_mm_castps_si128(compare2),
+                                      _mm_castps_si128(compare3)));
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+}
+
+// The low width bits of every block of block bits.
+constexpr std::uint64_t RepeatedLowBits(std::size_t width, std::size_t block) {
+  std::uint64_t bits = 0;
+  for (std::size_t shift = 0; shift < 64; shift += block) {
+    bits |= ((std::uint64_t{1} << width) - 1) << shift;
+  }
+  return bits;
+}
+
+// Moves bit N * i of bits to bit i for i < 16, doubling the width of the
+// gathered groups in each step.
+template <std::size_t N>
+inline std::uint64_t CompactEveryNth(std::uint64_t bits) {
+  if constexpr (N == 1) {
+    return bits & 0xFFFFu;
+  } else {
+    bits &= RepeatedLowBits(1, N);
+    bits = (bits | bits >> (N - 1)) & RepeatedLowBits(2, 2 * N);
+    bits = (bits | bits >> (2 * (N - 1))) & RepeatedLowBits(4, 4 * N);
+    bits = (bits | bits >> (4 * (N - 1))) & RepeatedLowBits(8, 8 * N);
+    return (bits | bits >> (8 * (N - 1))) & 0xFFFFu;
+  }
+}
+
+// a * b + c, rounded once when DLM_FMA is defined.
+inline __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+#if defined(DLM_FMA)
+  return _mm_fmadd_ps(a, b, c);
+#else
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+inline __m128d MulAdd(__m128d a, __m128d b, __m128d c) {
+#if defined(DLM_FMA)
+  return _mm_fmadd_pd(a, b, c);
+#else
+  return _mm_add_pd(_mm_mul_pd(a, b), c);
+#endif
+}
+
+#endif
+
+#if defined(DLM_AVX)
+inline __m256 MulAdd(__m256 a, __m256 b, __m256 c) {
+#if defined(DLM_FMA)
+  return _mm256_fmadd_ps(a, b, c);
+#else
+  return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+inline __m256d MulAdd(__m256d a, __m256d b, __m256d c) {
+#if defined(DLM_FMA)
+  return _mm256_fmadd_pd(a, b, c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+#endif
+
+}  // namespace simd
+}  // namespace dlm
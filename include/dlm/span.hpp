@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace dlm {
+
+// Non-owning view over a contiguous sequence, a C++17 stand-in for
+// std::span used by the batch functions. Member names follow std::span so
+// range based for loops and standard algorithms work on it.
+template <typename T>
+class Span {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using pointer = T*;
+  using reference = T&;
+  using iterator = T*;
+
+  constexpr Span() noexcept : data_{nullptr}, size_{0} {};
+  constexpr Span(T* data, size_type size) noexcept
+      : data_{data}, size_{size} {};
+
+  template <std::size_t N>
+  constexpr Span(T (&array)[N]) noexcept : data_{array}, size_{N} {};
+
+  // Any contiguous container with data() and size(), e.g. std::vector or
+  // std::array.
+  template <typename Container,
+            typename = std::enable_if_t<
+                !std::is_same<std::decay_t<Container>, Span>::value &&
+                std::is_convertible<decltype(std::declval<Container&>()
+                                                 .data()),
+                                    T*>::value>>
+  constexpr Span(Container& container) noexcept
+      : data_{container.data()}, size_{container.size()} {};
+
+  // Span<T> converts to Span<const T>.
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  constexpr Span(const Span<U>& other) noexcept
+      : data_{other.data()}, size_{other.size()} {};
+
+  constexpr pointer data() const noexcept { return data_; }
+  constexpr size_type size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  constexpr reference operator[](size_type index) const {
+    assert(index < size_);
+    return data_[index];
+  }
+
+  constexpr iterator begin() const noexcept { return data_; }
+  constexpr iterator end() const noexcept { return data_ + size_; }
+
+  constexpr Span<T> subspan(size_type offset, size_type count) const {
+    assert(offset + count <= size_);
+    return {data_ + offset, count};
+  }
+
+ private:
+  T* data_;
+  size_type size_;
+};
+
+}  // namespace dlm
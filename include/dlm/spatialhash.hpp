@@ -0,0 +1,473 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "dlm/geometricfunctions.hpp"
+#include "dlm/parallel.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector.hpp"
+
+namespace dlm {
+namespace geometry {
+
+// Uniform grid over Vector<N, T> points with cells of CellSize() per side,
+// for radius and nearest neighbor queries. The grid is unbounded, each cell
+// is hashed into one of a power of two number of buckets, at least as many
+// as there are points.
+//
+// Build sorts the points by bucket with a counting sort into flat arrays
+// that are reused by the next Build, nothing is allocated per cell. The
+// queries return indices into the span passed to Build and read the copy of
+// the points kept in bucket order, the span does not have to outlive it.
+template <std::size_t N, typename T>
+class SpatialHash {
+  static_assert(N >= 2, "SpatialHash needs at least two dimensions");
+
+ public:
+  using VectorType = vector::Vector<N, T>;
+
+  // Cells are packed into 64 bit keys, 64 / N bits per axis. Coordinates
+  // beyond kMaxCell cells from the origin share the outermost cell, which
+  // keeps queries correct but slow there.
+  static constexpr int kBits = static_cast<int>(64 / N);
+  static constexpr std::int64_t kMaxCell = std::int64_t{1} << (kBits - 2);
+
+  SpatialHash() = default;
+  explicit SpatialHash(T cell_size);
+
+  // Replaces the points, on up to threads threads, 0 uses one per hardware
+  // thread. The result does not depend on the number of threads.
+  void Build(Span<const VectorType> points, std::size_t threads = 0);
+
+  // Calls function(index, distance_squared) for every point at most radius
+  // from point, in no particular order.
+  template <typename function_type>
+  void ForEachWithin(const VectorType& point, T radius,
+                     function_type&& function) const;
+
+  // Replaces out with the indices of the points at most radius from point,
+  // in no particular order. Reusing out avoids allocating per query.
+  void Within(const VectorType& point, T radius,
+              std::vector<std::size_t>& out) const;
+
+  // Same contract as vector::KNearest, the indices of the out.size() points
+  // closest to point, closest first and the lower index first on a tie.
+  // Returns the number of indices written.
+  std::size_t KNearest(const VectorType& point, Span<std::size_t> out) const;
+
+  T CellSize() const { return cell_size_; }
+  std::size_t Size() const { return entries_.size(); }
+
+ private:
+  using Cell = std::int64_t[N];
+
+  // Everything a query reads about a point, together so a cell costs one
+  // cache miss rather than one per array.
+  struct Entry {
+    std::uint64_t key;
+    VectorType point;
+    std::uint32_t index;
+  };
+
+  // A threaded Build first sorts by the top kGroupBits bits of the bucket,
+  // which keeps the histogram of each thread small, then the buckets of
+  // each group.
+  static constexpr int kGroupBits = 10;
+
+  void CellOf(const VectorType& point, Cell& cell) const;
+  static std::uint64_t KeyOf(const Cell& cell);
+  std::uint32_t BucketOf(std::uint64_t key) const {
+    return static_cast<std::uint32_t>((key * 0x9E3779B97F4A7C15ull) >>
+                                      (64 - bucket_bits_));
+  }
+
+  // Lower bound of the squared distance from point to any point in cell.
+  T DistanceSquared(const Cell& cell, const VectorType& point) const;
+
+  // Calls function(cell) for the cells of [low, high] in every axis, only
+  // those on the boundary of that box when inner is set.
+  template <typename function_type>
+  static void ForEachCell(const Cell& low, const Cell& high, bool inner,
+                          function_type&& function);
+
+  // Calls function(entry) for the points in the cells ForEachCell visits,
+  // except those for which skip(cell) is true. The bucket ranges of a batch
+  // of cells are read before any of their entries so the cache misses
+  // overlap, entries of other cells in the same bucket are skipped by
+  // their key.
+  template <typename skip_type, typename function_type>
+  void ForEachEntry(const Cell& low, const Cell& high, bool inner,
+                    skip_type&& skip, function_type&& function) const;
+
+  T cell_size_ = static_cast<T>(1);
+  T inverse_cell_size_ = static_cast<T>(1);
+  int bucket_bits_ = 1;
+  // Bucket b holds entries_[starts_[b], starts_[b + 1]).
+  std::vector<std::uint32_t> starts_;
+  std::vector<Entry> entries_;
+  // Only used by Build: the keys in input order, for each thread the group
+  // counts of its chunk turned into where it places them, where each group
+  // starts, and the entries sorted by group only.
+  std::vector<std::uint64_t> input_keys_;
+  std::vector<std::uint32_t> chunk_starts_;
+  std::vector<std::uint32_t> group_starts_;
+  std::vector<Entry> grouped_;
+};
+
+template <std::size_t N, typename T>
+SpatialHash<N, T>::SpatialHash(T cell_size)
+    : cell_size_{cell_size}, inverse_cell_size_{static_cast<T>(1) / cell_size} {
+  assert(cell_size > static_cast<T>(0));
+}
+
+template <std::size_t N, typename T>
+void SpatialHash<N, T>::CellOf(const VectorType& point, Cell& cell) const {
+  for (std::size_t axis = 0; axis < N; ++axis) {
+    const T coordinate =
+        std::floor(point[static_cast<int>(axis)] * inverse_cell_size_);
+    // NaN fails the first comparison and lands in the highest cell.
+    cell[axis] = coordinate < static_cast<T>(kMaxCell)
+                     ? coordinate > static_cast<T>(-kMaxCell)
+                           ? static_cast<std::int64_t>(coordinate)
+                           : -kMaxCell
+                     : kMaxCell;
+  }
+}
+
+template <std::size_t N, typename T>
+std::uint64_t SpatialHash<N, T>::KeyOf(const Cell& cell) {
+  constexpr std::uint64_t kMask = (std::uint64_t{1} << kBits) - 1;
+  std::uint64_t key = 0;
+  for (std::size_t axis = 0; axis < N; ++axis) {
+    key |= (static_cast<std::uint64_t>(cell[axis]) & kMask) << (axis * kBits);
+  }
+  return key;
+}
+
+template <std::size_t N, typename T>
+void SpatialHash<N, T>::Build(Span<const VectorType> points,
+                              std::size_t threads) {
+  assert(points.size() < std::numeric_limits<std::uint32_t>::max());
+  const std::size_t count = points.size();
+  threads = dlm::detail::ThreadCount(threads, count);
+  bucket_bits_ = 1;
+  while ((std::size_t{1} << bucket_bits_) < count) {
+    ++bucket_bits_;
+  }
+  const std::size_t buckets = std::size_t{1} << bucket_bits_;
+  // One thread sorts by bucket in a single pass, its groups are buckets.
+  const int shift = threads == 1 ? 0 : std::max(bucket_bits_ - kGroupBits, 0);
+  const std::size_t groups = buckets >> shift;
+  starts_.resize(buckets + 1);
+  entries_.resize(count);
+  input_keys_.resize(count);
+  chunk_starts_.resize(threads * groups);
+  group_starts_.resize(shift == 0 ? 0 : groups + 1);
+  grouped_.resize(shift == 0 ? 0 : count);
+  std::vector<std::uint32_t>& group_starts =
+      shift == 0 ? starts_ : group_starts_;
+  Entry* grouped = shift == 0 ? entries_.data() : grouped_.data();
+  const auto group_of = [&](std::uint64_t key) {
+    return BucketOf(key) >> shift;
+  };
+
+  // Thread t sorts the chunk [begin, end) of the input by group, counting
+  // into and then placing from its own row of chunk_starts_.
+  const auto chunk = [&](std::size_t t) {
+    return std::make_pair(count * t / threads, count * (t + 1) / threads);
+  };
+  dlm::detail::ParallelFor(threads, threads, [&](std::size_t t, std::size_t) {
+    std::uint32_t* counts = chunk_starts_.data() + t * groups;
+    std::fill(counts, counts + groups, 0);
+    const auto range = chunk(t);
+    for (std::size_t i = range.first; i < range.second; ++i) {
+      Cell cell;
+      CellOf(points[i], cell);
+      input_keys_[i] = KeyOf(cell);
+      ++counts[group_of(input_keys_[i])];
+    }
+  });
+  // Within a group the chunks go in input order, so the order within a
+  // bucket is the input order whatever the threads.
+  std::uint32_t start = 0;
+  for (std::size_t g = 0; g < groups; ++g) {
+    group_starts[g] = start;
+    for (std::size_t t = 0; t < threads; ++t) {
+      std::uint32_t& chunk_start = chunk_starts_[t * groups + g];
+      const std::uint32_t chunk_count = chunk_start;
+      chunk_start = start;
+      start += chunk_count;
+    }
+  }
+  group_starts[groups] = static_cast<std::uint32_t>(count);
+  dlm::detail::ParallelFor(threads, threads, [&](std::size_t t, std::size_t) {
+    std::uint32_t* starts = chunk_starts_.data() + t * groups;
+    const auto range = chunk(t);
+    for (std::size_t i = range.first; i < range.second; ++i) {
+      grouped[starts[group_of(input_keys_[i])]++] = {
+          input_keys_[i], points[i], static_cast<std::uint32_t>(i)};
+    }
+  });
+  if (shift == 0) {
+    return;
+  }
+  starts_[buckets] = static_cast<std::uint32_t>(count);
+
+  // Each group on its own, its buckets counted into their ends in starts_
+  // and counted down to their starts while placing it from the back.
+  const std::size_t group_size = std::size_t{1} << shift;
+  dlm::detail::ParallelFor(
+      groups, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t g = begin; g < end; ++g) {
+          std::uint32_t* bucket_ends = starts_.data() + g * group_size;
+          std::fill(bucket_ends, bucket_ends + group_size, 0);
+          for (std::uint32_t i = group_starts_[g]; i < group_starts_[g + 1];
+               ++i) {
+            ++starts_[BucketOf(grouped_[i].key)];
+          }
+          std::uint32_t bucket_end = group_starts_[g];
+          for (std::size_t b = 0; b < group_size; ++b) {
+            bucket_end += bucket_ends[b];
+            bucket_ends[b] = bucket_end;
+          }
+          for (std::uint32_t i = group_starts_[g + 1];
+               i-- > group_starts_[g];) {
+            entries_[--starts_[BucketOf(grouped_[i].key)]] = grouped_[i];
+          }
+        }
+      });
+}
+
+template <std::size_t N, typename T>
+T SpatialHash<N, T>::DistanceSquared(const Cell& cell,
+                                     const VectorType& point) const {
+  T sum = static_cast<T>(0);
+  for (std::size_t axis = 0; axis < N; ++axis) {
+    const T coordinate = point[static_cast<int>(axis)];
+    T low = static_cast<T>(cell[axis]) * cell_size_;
+    T high = low + cell_size_;
+    // Points are put in cells by rounding and can sit an ulp or so across
+    // the border, the outermost cells extend to infinity.
+    const T slack = static_cast<T>(4) * std::numeric_limits<T>::epsilon() *
+                    (std::abs(low) + std::abs(high));
+    low = cell[axis] == -kMaxCell ? -std::numeric_limits<T>::infinity()
+                                  : low - slack;
+    high = cell[axis] == kMaxCell ? std::numeric_limits<T>::infinity()
+                                  : high + slack;
+    const T distance = coordinate < low    ? low - coordinate
+                       : coordinate > high ? coordinate - high
+                                           : static_cast<T>(0);
+    sum += distance * distance;
+  }
+  return sum;
+}
+
+template <std::size_t N, typename T>
+template <typename function_type>
+void SpatialHash<N, T>::ForEachCell(const Cell& low, const Cell& high,
+                                    bool inner, function_type&& function) {
+  Cell cell;
+  for (std::size_t axis = 0; axis < N; ++axis) {
+    cell[axis] = low[axis];
+  }
+  while (true) {
+    // The last axis only takes its two ends when every other one is inside.
+    bool inside = inner;
+    for (std::size_t axis = 0; axis + 1 < N && inside; ++axis) {
+      inside = cell[axis] != low[axis] && cell[axis] != high[axis];
+    }
+    function(static_cast<const Cell&>(cell));
+    std::size_t axis = N - 1;
+    if (inside && cell[axis] == low[axis] && high[axis] != low[axis]) {
+      cell[axis] = high[axis];
+      continue;
+    }
+    while (cell[axis] == high[axis]) {
+      cell[axis] = low[axis];
+      if (axis == 0) {
+        return;
+      }
+      --axis;
+    }
+    ++cell[axis];
+  }
+}
+
+template <std::size_t N, typename T>
+template <typename skip_type, typename function_type>
+void SpatialHash<N, T>::ForEachEntry(const Cell& low, const Cell& high,
+                                     bool inner, skip_type&& skip,
+                                     function_type&& function) const {
+  struct Range {
+    std::uint64_t key;
+    std::uint32_t begin;
+    std::uint32_t end;
+  };
+  constexpr std::size_t kBatch = 32;
+  Range batch[kBatch];
+  std::size_t size = 0;
+  const auto flush = [&] {
+    for (std::size_t r = 0; r < size; ++r) {
+      for (std::uint32_t i = batch[r].begin; i < batch[r].end; ++i) {
+        if (entries_[i].key == batch[r].key) {
+          function(entries_[i]);
+        }
+      }
+    }
+    size = 0;
+  };
+  ForEachCell(low, high, inner, [&](const Cell& cell) {
+    if (skip(cell)) {
+      return;
+    }
+    const std::uint64_t key = KeyOf(cell);
+    const std::uint32_t bucket = BucketOf(key);
+    batch[size++] = {key, starts_[bucket], starts_[bucket + 1]};
+    if (size == kBatch) {
+      flush();
+    }
+  });
+  flush();
+}
+
+template <std::size_t N, typename T>
+template <typename function_type>
+void SpatialHash<N, T>::ForEachWithin(const VectorType& point, T radius,
+                                      function_type&& function) const {
+  const T radius_squared = radius * radius;
+  const auto visit = [&](const Entry& entry) {
+    const T distance_squared = vector::DistanceSquared(entry.point, point);
+    if (distance_squared <= radius_squared) {
+      function(static_cast<std::size_t>(entry.index), distance_squared);
+    }
+  };
+  if (entries_.empty() || !(radius >= static_cast<T>(0))) {
+    return;
+  }
+  Cell low;
+  Cell high;
+  VectorType offset;
+  for (std::size_t axis = 0; axis < N; ++axis) {
+    offset[static_cast<int>(axis)] = radius;
+  }
+  CellOf(point - offset, low);
+  CellOf(point + offset, high);
+  // Scanning every point is cheaper than visiting more cells than there are
+  // buckets.
+  std::size_t cells = 1;
+  for (std::size_t axis = 0; axis < N && cells <= starts_.size(); ++axis) {
+    cells *= static_cast<std::size_t>(high[axis] - low[axis] + 1);
+  }
+  if (cells > starts_.size()) {
+    for (const Entry& entry : entries_) {
+      visit(entry);
+    }
+    return;
+  }
+  // The corners of the box around the sphere are skipped.
+  ForEachEntry(
+      low, high, false,
+      [&](const Cell& cell) {
+        return DistanceSquared(cell, point) > radius_squared;
+      },
+      visit);
+}
+
+template <std::size_t N, typename T>
+void SpatialHash<N, T>::Within(const VectorType& point, T radius,
+                               std::vector<std::size_t>& out) const {
+  out.clear();
+  ForEachWithin(point, radius,
+                [&](std::size_t index, T) { out.push_back(index); });
+}
+
+template <std::size_t N, typename T>
+std::size_t SpatialHash<N, T>::KNearest(const VectorType& point,
+                                        Span<std::size_t> out) const {
+  const std::size_t k = std::min(out.size(), entries_.size());
+  if (k == 0) {
+    return 0;
+  }
+  // Max heap of the k best (distance, index) pairs so far, the worst on top.
+  std::vector<std::pair<T, std::size_t>> best;
+  best.reserve(k);
+  const auto visit = [&](const Entry& entry) {
+    vector::detail::PushNearest(
+        best, k, {vector::DistanceSquared(entry.point, point), entry.index});
+  };
+
+  // Rings of cells around the one holding point, growing until no point
+  // outside them can be closer than the k found.
+  Cell center;
+  CellOf(point, center);
+  std::size_t visited = 0;
+  for (std::int64_t ring = 0;; ++ring) {
+    Cell low;
+    Cell high;
+    bool clamped = false;
+    std::size_t cells = 1;
+    // Distance from point to the nearest cell outside the rings so far.
+    T outside = std::numeric_limits<T>::infinity();
+    for (std::size_t axis = 0; axis < N; ++axis) {
+      low[axis] = center[axis] - ring;
+      high[axis] = center[axis] + ring;
+      clamped = clamped || low[axis] < -kMaxCell || high[axis] > kMaxCell;
+      cells *= static_cast<std::size_t>(2 * ring + 1);
+      const T coordinate = point[static_cast<int>(axis)];
+      const T below = static_cast<T>(low[axis]) * cell_size_;
+      const T above = static_cast<T>(high[axis] + 1) * cell_size_;
+      // The same slack as in DistanceSquared.
+      const T slack = static_cast<T>(4) * std::numeric_limits<T>::epsilon() *
+                      (std::abs(below) + std::abs(above));
+      outside = std::min(
+          outside, std::min(coordinate - below, above - coordinate) - slack);
+    }
+    if (clamped || cells > starts_.size()) {
+      // Too sparse for rings, or past the outermost cells, every point is
+      // scanned instead.
+      best.clear();
+      for (const Entry& entry : entries_) {
+        visit(entry);
+      }
+      break;
+    }
+    // Once k are found, cells beyond the worst of them cannot help.
+    ForEachEntry(
+        low, high, ring != 0,
+        [&](const Cell& cell) {
+          return best.size() == k &&
+                 best.front().first < DistanceSquared(cell, point);
+        },
+        [&](const Entry& entry) {
+          ++visited;
+          visit(entry);
+        });
+    outside = std::max(outside, static_cast<T>(0));
+    if (visited == entries_.size() ||
+        (best.size() == k && best.front().first < outside * outside)) {
+      break;
+    }
+  }
+  std::sort_heap(best.begin(), best.end());
+  for (std::size_t i = 0; i < best.size(); ++i) {
+    out[i] = best[i].second;
+  }
+  return best.size();
+}
+
+template <typename T>
+using SpatialHash2 = SpatialHash<2, T>;
+template <typename T>
+using SpatialHash3 = SpatialHash<3, T>;
+using SpatialHash2F = SpatialHash2<float>;
+using SpatialHash3F = SpatialHash3<float>;
+
+}  // namespace geometry
+}  // namespace dlm
@@ -0,0 +1,765 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "dlm/config.hpp"
+
+namespace dlm {
+namespace vector {
+
+// Vector<N, T> is the single implementation behind Vector2, Vector3 and
+// Vector4. The named members come from a per-N layout::Components base, every
+// operator is written once as a compile-time unrolled loop over the
+// components, and detail::Simd<N, T> plugs in a register implementation for
+// the (N, T) pairs that have one. Only N = 2, 3 and 4 are supported.
+//
+// Layout picks the storage: layout::Packed holds exactly N components,
+// layout::Padded (paddedvector3.hpp) rounds Vector<3, float> up to a full
+// register with a padding lane the operators ignore.
+namespace layout {
+struct Packed {};
+}  // namespace layout
+
+template <std::size_t N, typename T, typename Layout = layout::Packed>
+struct Vector;
+
+// Storage and constructors. These live in their own namespace so that
+// argument dependent lookup on a vector does not pull in the helpers in
+// detail.
+namespace layout {
+template <std::size_t N, typename T, typename Layout = Packed>
+struct Components;
+
+template <typename T>
+struct Components<2, T, Packed> {
+  constexpr Components() : x{static_cast<T>(0)}, y{static_cast<T>(0)} {};
+  constexpr Components(T x, T y) : x{x}, y{y} {};
+
+  T x;
+  T y;
+
+  // The components in index order, for Component.
+  static constexpr T Components::*kMembers[] = {&Components::x,
+                                                &Components::y};
+};
+
+template <typename T>
+struct Components<3, T, Packed> {
+  constexpr Components()
+      : x{static_cast<T>(0)}, y{static_cast<T>(0)}, z{static_cast<T>(0)} {};
+  constexpr Components(T x, T y, T z) : x{x}, y{y}, z{z} {};
+
+  T x;
+  T y;
+  T z;
+
+  // The components in index order, for Component.
+  static constexpr T Components::*kMembers[] = {
+      &Components::x, &Components::y, &Components::z};
+};
+
+// Vector4<float> is aligned to 16 bytes so it loads into a single SSE
+// register. The alignment does not depend on the SIMD configuration, so
+// every translation unit sees the same layout.
+template <typename T>
+struct alignas(std::is_same<T, float>::value ? 16 : alignof(T))
+    Components<4, T, Packed> {
+  constexpr Components()
+      : x{static_cast<T>(0)},
+        y{static_cast<T>(0)},
+        z{static_cast<T>(0)},
+        w{static_cast<T>(0)} {};
+  constexpr Components(T x, T y, T z, T w) : x{x}, y{y}, z{z}, w{w} {};
+
+  T x;
+  T y;
+  T z;
+  T w;
+
+  // The components in index order, for Component.
+  static constexpr T Components::*kMembers[] = {
+      &Components::x, &Components::y, &Components::z, &Components::w};
+};
+}  // namespace layout
+
+namespace detail {
+// Register implementation of Vector<N, T>. A specialization sets kEnabled,
+// names the Register type that holds all N components and provides Load,
+// Store, Broadcast, the arithmetic (Negate, Abs, Add, Subtract, Multiply,
+// Divide, MulAdd, Sqrt, Min, Max), Dot broadcast to every lane, First, the
+// comparisons returning lane masks and All/Any to reduce them, and Cross
+// when N is 3. The operators use it outside constant evaluation only.
+template <std::size_t N, typename T, typename Layout = layout::Packed>
+struct Simd {
+  static constexpr bool kEnabled = false;
+};
+}  // namespace detail
+
+}  // namespace vector
+}  // namespace dlm
+
+#include "dlm/vector4simd.hpp"
+
+namespace dlm {
+namespace vector {
+
+template <std::size_t N, typename T, typename Layout>
+struct Vector : layout::Components<N, T, Layout> {
+  static_assert(N >= 2 && N <= 4, "Vector supports 2, 3 and 4 components");
+
+  using ValueType = T;
+  static constexpr std::size_t kSize = N;
+
+  // Constructors
+  using layout::Components<N, T, Layout>::Components;
+
+  // Explicit conversion from the same vector in the other layout.
+  template <typename OtherLayout,
+            typename = std::enable_if_t<
+                !std::is_same<OtherLayout, Layout>::value>>
+  constexpr explicit Vector(const Vector<N, T, OtherLayout>& v);
+
+  // Operators
+  constexpr Vector operator-() const;
+  constexpr Vector operator-(T scalar) const;
+  constexpr Vector operator-(const Vector& v) const;
+  constexpr Vector& operator-=(T scalar);
+  constexpr Vector& operator-=(const Vector& v);
+
+  constexpr Vector operator+(T scalar) const;
+  constexpr Vector operator+(const Vector& v) const;
+  constexpr Vector& operator+=(T scalar);
+  constexpr Vector& operator+=(const Vector& v);
+
+  constexpr Vector operator*(T scalar) const;
+  constexpr Vector operator*(const Vector& v) const;
+  constexpr Vector& operator*=(T scalar);
+  constexpr Vector& operator*=(const Vector& v);
+
+  // Division by zero follows IEEE 754 for floating point T, inf or NaN in
+  // the components concerned. Integral T must not divide by zero.
+  constexpr Vector operator/(T scalar) const;
+  constexpr Vector operator/(const Vector& v) const;
+  constexpr Vector& operator/=(T scalar);
+  constexpr Vector& operator/=(const Vector& v);
+
+  constexpr T operator[](int index) const;
+  constexpr T& operator[](int index);
+
+  // dot product
+  constexpr T operator|(const Vector& v) const;
+
+  // cross product, Vector3 only
+  template <std::size_t M = N, typename = std::enable_if_t<M == 3>>
+  constexpr Vector operator^(const Vector& v) const;
+
+  constexpr bool operator==(const Vector& v) const;
+  constexpr bool operator!=(const Vector& v) const;
+  constexpr bool operator<(const Vector& v) const;
+  constexpr bool operator<=(const Vector& v) const;
+  constexpr bool operator>(const Vector& v) const;
+  constexpr bool operator>=(const Vector& v) const;
+
+  // Helper functions
+  constexpr void Zero();
+  constexpr bool IsZero() const;
+
+  constexpr T Component(int index) const;
+  constexpr T& Component(int index);
+
+  // True when every component is within tolerance of the one in v1, see
+  // approx.hpp for relative and ULP based comparisons.
+  constexpr bool Equals(const Vector& v1, T tolerance) const noexcept;
+
+  void Normalize();
+
+  T Length() const;
+  constexpr T LengthSquared() const;
+
+  // Projection onto v, the zero vector when v is zero.
+  constexpr Vector ProjectOnTo(const Vector& v) const;
+};
+
+namespace detail {
+// Component I of v by name.
+template <std::size_t I, typename vector_type>
+constexpr auto& At(vector_type& v) {
+  if constexpr (I == 0) {
+    return v.x;
+  } else if constexpr (I == 1) {
+    return v.y;
+  } else if constexpr (I == 2) {
+    return v.z;
+  } else {
+    return v.w;
+  }
+}
+
+// The unrolled loops. Each one expands to a single expression over the
+// components, the overloads taking the index_sequence do the expansion.
+template <typename vector_type, typename F, std::size_t... I>
+constexpr vector_type Map(std::index_sequence<I...>, const vector_type& a,
+                          F f) {
+  return {f(At<I>(a))...};
+}
+
+template <typename vector_type, typename F, std::size_t... I>
+constexpr vector_type Map(std::index_sequence<I...>, const vector_type& a,
+                          const vector_type& b, F f) {
+  return {f(At<I>(a), At<I>(b))...};
+}
+
+template <typename vector_type, typename F, std::size_t... I>
+constexpr void ForEach(std::index_sequence<I...>, vector_type& a, F f) {
+  (f(At<I>(a)), ...);
+}
+
+template <typename vector_type, typename F, std::size_t... I>
+constexpr void ForEach(std::index_sequence<I...>, vector_type& a,
+                       const vector_type& b, F f) {
+  (f(At<I>(a), At<I>(b)), ...);
+}
+
+template <typename vector_type, typename F, std::size_t... I>
+constexpr bool All(std::index_sequence<I...>, const vector_type& a,
+                   const vector_type& b, F f) {
+  return (f(At<I>(a), At<I>(b)) && ...);
+}
+
+template <typename vector_type, typename F, std::size_t... I>
+constexpr bool Any(std::index_sequence<I...>, const vector_type& a,
+                   const vector_type& b, F f) {
+  return (f(At<I>(a), At<I>(b)) || ...);
+}
+
+// Summed left to right, x * v.x + y * v.y + ...
+template <typename vector_type, std::size_t... I>
+constexpr typename vector_type::ValueType Dot(std::index_sequence<I...>,
+                                              const vector_type& a,
+                                              const vector_type& b) {
+  return (... + (At<I>(a) * At<I>(b)));
+}
+
+template <typename vector_type>
+using Indices = std::make_index_sequence<vector_type::kSize>;
+
+template <typename vector_type, typename F>
+constexpr vector_type Map(const vector_type& a, F f) {
+  return Map(Indices<vector_type>{}, a, f);
+}
+
+template <typename vector_type, typename F>
+constexpr vector_type Map(const vector_type& a, const vector_type& b, F f) {
+  return Map(Indices<vector_type>{}, a, b, f);
+}
+
+template <typename vector_type, typename F>
+constexpr void ForEach(vector_type& a, F f) {
+  ForEach(Indices<vector_type>{}, a, f);
+}
+
+template <typename vector_type, typename F>
+constexpr void ForEach(vector_type& a, const vector_type& b, F f) {
+  ForEach(Indices<vector_type>{}, a, b, f);
+}
+
+template <typename vector_type, typename F>
+constexpr bool All(const vector_type& a, const vector_type& b, F f) {
+  return All(Indices<vector_type>{}, a, b, f);
+}
+
+template <typename vector_type, typename F>
+constexpr bool Any(const vector_type& a, const vector_type& b, F f) {
+  return Any(Indices<vector_type>{}, a, b, f);
+}
+
+template <typename vector_type>
+constexpr typename vector_type::ValueType Dot(const vector_type& a,
+                                              const vector_type& b) {
+  return Dot(Indices<vector_type>{}, a, b);
+}
+
+// v converted component by component to target_type.
+template <typename target_type, typename vector_type, std::size_t... I>
+constexpr target_type Convert(std::index_sequence<I...>, const vector_type& v) {
+  using U = typename target_type::ValueType;
+  return {static_cast<U>(At<I>(v))...};
+}
+
+template <std::size_t N, typename T, typename Layout>
+typename Simd<N, T, Layout>::Register Load(const Vector<N, T, Layout>& v) {
+  return Simd<N, T, Layout>::Load(&v.x);
+}
+
+template <std::size_t N, typename T, typename Layout = layout::Packed,
+          typename Register>
+Vector<N, T, Layout> FromRegister(Register r) {
+  Vector<N, T, Layout> result;
+  Simd<N, T, Layout>::Store(&result.x, r);
+  return result;
+}
+}  // namespace detail
+
+template <std::size_t N, typename T, typename Layout>
+template <typename OtherLayout, typename>
+constexpr Vector<N, T, Layout>::Vector(const Vector<N, T, OtherLayout>& v)
+    : Vector{detail::Convert<Vector>(std::make_index_sequence<N>{}, v)} {}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::operator-() const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Negate(detail::Load(*this)));
+    }
+  }
+  return detail::Map(*this, [](const T& a) { return -a; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::operator-(T scalar) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Subtract(detail::Load(*this), Simd::Broadcast(scalar)));
+    }
+  }
+  return detail::Map(*this, [scalar](const T& a) { return a - scalar; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::operator-(
+    const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Subtract(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::Map(*this, v, [](const T& a, const T& b) { return a - b; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout>& Vector<N, T, Layout>::operator-=(T scalar) {
+  if constexpr (detail::Simd<N, T, Layout>::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      *this = *this - scalar;
+      return *this;
+    }
+  }
+  detail::ForEach(*this, [&scalar](T& a) { a -= scalar; });
+  return *this;
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout>& Vector<N, T, Layout>::operator-=(
+    const Vector& v) {
+  if constexpr (detail::Simd<N, T, Layout>::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      *this = *this - v;
+      return *this;
+    }
+  }
+  detail::ForEach(*this, v, [](T& a, const T& b) { a -= b; });
+  return *this;
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::operator+(T scalar) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Add(detail::Load(*this), Simd::Broadcast(scalar)));
+    }
+  }
+  return detail::Map(*this, [scalar](const T& a) { return a + scalar; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::operator+(
+    const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Add(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::Map(*this, v, [](const T& a, const T& b) { return a + b; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout>& Vector<N, T, Layout>::operator+=(T scalar) {
+  if constexpr (detail::Simd<N, T, Layout>::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      *this = *this + scalar;
+      return *this;
+    }
+  }
+  detail::ForEach(*this, [&scalar](T& a) { a += scalar; });
+  return *this;
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout>& Vector<N, T, Layout>::operator+=(
+    const Vector& v) {
+  if constexpr (detail::Simd<N, T, Layout>::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      *this = *this + v;
+      return *this;
+    }
+  }
+  detail::ForEach(*this, v, [](T& a, const T& b) { a += b; });
+  return *this;
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::operator*(T scalar) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Multiply(detail::Load(*this), Simd::Broadcast(scalar)));
+    }
+  }
+  return detail::Map(*this, [scalar](const T& a) { return a * scalar; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::operator*(
+    const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Multiply(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::Map(*this, v, [](const T& a, const T& b) { return a * b; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout>& Vector<N, T, Layout>::operator*=(T scalar) {
+  if constexpr (detail::Simd<N, T, Layout>::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      *this = *this * scalar;
+      return *this;
+    }
+  }
+  detail::ForEach(*this, [&scalar](T& a) { a *= scalar; });
+  return *this;
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout>& Vector<N, T, Layout>::operator*=(
+    const Vector& v) {
+  if constexpr (detail::Simd<N, T, Layout>::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      *this = *this * v;
+      return *this;
+    }
+  }
+  detail::ForEach(*this, v, [](T& a, const T& b) { a *= b; });
+  return *this;
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::operator/(T scalar) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Divide(detail::Load(*this), Simd::Broadcast(scalar)));
+    }
+  }
+  return detail::Map(*this, [scalar](const T& a) { return a / scalar; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::operator/(
+    const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Divide(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::Map(*this, v, [](const T& a, const T& b) { return a / b; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout>& Vector<N, T, Layout>::operator/=(T scalar) {
+  if constexpr (detail::Simd<N, T, Layout>::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      *this = *this / scalar;
+      return *this;
+    }
+  }
+  detail::ForEach(*this, [&scalar](T& a) { a /= scalar; });
+  return *this;
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout>& Vector<N, T, Layout>::operator/=(
+    const Vector& v) {
+  if constexpr (detail::Simd<N, T, Layout>::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      *this = *this / v;
+      return *this;
+    }
+  }
+  detail::ForEach(*this, v, [](T& a, const T& b) { a /= b; });
+  return *this;
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr T Vector<N, T, Layout>::operator|(const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return Simd::First(Simd::Dot(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::Dot(*this, v);
+}
+
+template <std::size_t N, typename T, typename Layout>
+template <std::size_t M, typename>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::operator^(
+    const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Cross(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return {this->y * v.z - v.y * this->z, this->z * v.x - v.z * this->x,
+          this->x * v.y - v.x * this->y};
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr T& Vector<N, T, Layout>::operator[](int index) {
+  return Component(index);
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr T Vector<N, T, Layout>::operator[](int index) const {
+  return Component(index);
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr bool Vector<N, T, Layout>::operator==(const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return Simd::All(Simd::Equal(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::All(*this, v, [](const T& a, const T& b) { return a == b; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr bool Vector<N, T, Layout>::operator!=(const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return Simd::Any(Simd::NotEqual(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::Any(*this, v, [](const T& a, const T& b) { return a != b; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr bool Vector<N, T, Layout>::operator<(const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return Simd::All(Simd::Less(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::All(*this, v, [](const T& a, const T& b) { return a < b; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr bool Vector<N, T, Layout>::operator<=(const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return Simd::All(Simd::LessEqual(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::All(*this, v, [](const T& a, const T& b) { return a <= b; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr bool Vector<N, T, Layout>::operator>(const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return Simd::All(Simd::Greater(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::All(*this, v, [](const T& a, const T& b) { return a > b; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr bool Vector<N, T, Layout>::operator>=(const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return Simd::All(
+          Simd::GreaterEqual(detail::Load(*this), detail::Load(v)));
+    }
+  }
+  return detail::All(*this, v, [](const T& a, const T& b) { return a >= b; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr void Vector<N, T, Layout>::Zero() {
+  detail::ForEach(*this, [](T& a) { a = static_cast<T>(0); });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr bool Vector<N, T, Layout>::IsZero() const {
+  if constexpr (detail::Simd<N, T, Layout>::kEnabled) {
+    return *this == Vector{};
+  } else {
+    return detail::All(*this, *this, [](const T& a, const T&) {
+      return a == static_cast<T>(0);
+    });
+  }
+}
+
+// The compiler does not fold kMembers into index * sizeof(T), each index
+// loads the member offset. In a loop over the components that load is shared
+// by every vector indexed with the same index, and the table bounds the index
+// so short loops get unrolled.
+template <std::size_t N, typename T, typename Layout>
+constexpr T Vector<N, T, Layout>::Component(int index) const {
+  DLM_ASSERT_INDEX(index, N);
+  return this->*layout::Components<N, T, Layout>::kMembers[index];
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr T& Vector<N, T, Layout>::Component(int index) {
+  DLM_ASSERT_INDEX(index, N);
+  return this->*layout::Components<N, T, Layout>::kMembers[index];
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr bool Vector<N, T, Layout>::Equals(const Vector& v1,
+                                    T tolerance) const noexcept {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      const typename Simd::Register difference =
+          Simd::Subtract(detail::Load(*this), detail::Load(v1));
+      return Simd::All(Simd::LessEqual(Simd::Abs(difference),
+                                       Simd::Broadcast(tolerance)));
+    }
+  }
+  return detail::All(*this, v1, [tolerance](const T& a, const T& b) {
+    return (a < b ? b - a : a - b) <= tolerance;
+  });
+}
+
+template <std::size_t N, typename T, typename Layout>
+void Vector<N, T, Layout>::Normalize() {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    const typename Simd::Register v = detail::Load(*this);
+    Simd::Store(&this->x, Simd::Divide(v, Simd::Sqrt(Simd::Dot(v, v))));
+  } else {
+    *this /= Length();
+  }
+}
+
+template <std::size_t N, typename T, typename Layout>
+T Vector<N, T, Layout>::Length() const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    const typename Simd::Register v = detail::Load(*this);
+    return Simd::First(Simd::Sqrt(Simd::Dot(v, v)));
+  } else {
+    // Found by argument dependent lookup for Half and Fixed.
+    using std::sqrt;
+    return sqrt(LengthSquared());
+  }
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr T Vector<N, T, Layout>::LengthSquared() const {
+  return *this | *this;
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Vector<N, T, Layout>::ProjectOnTo(
+    const Vector& v) const {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      const typename Simd::Register onto = detail::Load(v);
+      const typename Simd::Register length_squared = Simd::Dot(onto, onto);
+      if (Simd::First(length_squared) == static_cast<T>(0)) {
+        return {};
+      }
+      return detail::FromRegister<N, T, Layout>(Simd::Multiply(
+          onto, Simd::Divide(Simd::Dot(detail::Load(*this), onto),
+                             length_squared)));
+    }
+  }
+  const T length_squared = v.LengthSquared();
+  if (length_squared == static_cast<T>(0)) {
+    return {};
+  }
+  return v * ((*this | v) / length_squared);
+}
+
+// Component-wise minimum and maximum. Each component is a < b ? a : b (or
+// a > b ? a : b), so where either one is NaN the result is the one of b.
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Min(const Vector<N, T, Layout>& a,
+                                   const Vector<N, T, Layout>& b) {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Min(detail::Load(a), detail::Load(b)));
+    }
+  }
+  return detail::Map(a, b,
+                     [](const T& x, const T& y) { return x < y ? x : y; });
+}
+
+template <std::size_t N, typename T, typename Layout>
+constexpr Vector<N, T, Layout> Max(const Vector<N, T, Layout>& a,
+                                   const Vector<N, T, Layout>& b) {
+  using Simd = detail::Simd<N, T, Layout>;
+  if constexpr (Simd::kEnabled) {
+    if (!DLM_IS_CONSTANT_EVALUATED()) {
+      return detail::FromRegister<N, T, Layout>(
+          Simd::Max(detail::Load(a), detail::Load(b)));
+    }
+  }
+  return detail::Map(a, b,
+                     [](const T& x, const T& y) { return x > y ? x : y; });
+}
+
+// Converts every component with static_cast, e.g. between float vectors and
+// the Half or Fixed storage types. The result is packed.
+template <typename U, std::size_t N, typename T, typename Layout>
+constexpr Vector<N, U> Convert(const Vector<N, T, Layout>& v) {
+  return detail::Convert<Vector<N, U>>(std::make_index_sequence<N>{}, v);
+}
+
+}  // namespace vector
+}  // namespace dlm
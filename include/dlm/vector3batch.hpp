@@ -0,0 +1,482 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "dlm/simd.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector3.hpp"
+
+namespace dlm {
+namespace vector {
+
+// Structure of arrays container for Vector3<T>. The x, y and z components
+// live in separate streams aligned to a cache line, and the capacity is
+// always a multiple of kLanes so the batch functions below can process whole
+// blocks of kLanes elements (16 floats or 8 doubles, one AVX-512 register or
+// two AVX registers) without a scalar tail. Padding lanes past Size() hold
+// unspecified values.
+template <typename T>
+class Vector3Batch {
+ public:
+  using ValueType = T;
+
+  static constexpr std::size_t kAlignment = 64;
+  static constexpr std::size_t kLanes = kAlignment / sizeof(T);
+
+  Vector3Batch() = default;
+  explicit Vector3Batch(std::size_t size);
+  explicit Vector3Batch(Span<const Vector3<T>> vectors);
+
+  Vector3Batch(const Vector3Batch<T>& other);
+  Vector3Batch(Vector3Batch<T>&& other) noexcept;
+  Vector3Batch<T>& operator=(const Vector3Batch<T>& other);
+  Vector3Batch<T>& operator=(Vector3Batch<T>&& other) noexcept;
+
+  ~Vector3Batch();
+
+  Vector3<T> operator[](std::size_t index) const;
+
+  std::size_t Size() const { return size_; }
+  std::size_t Capacity() const { return capacity_; }
+  bool Empty() const { return size_ == 0; }
+
+  // Number of elements the batch functions process, Size() rounded up to a
+  // whole block.
+  std::size_t PaddedSize() const;
+
+  void Reserve(std::size_t capacity);
+  // New elements are zero.
+  void Resize(std::size_t size);
+  void Clear() { size_ = 0; }
+
+  void PushBack(const Vector3<T>& v);
+  void Set(std::size_t index, const Vector3<T>& v);
+
+  void Assign(Span<const Vector3<T>> vectors);
+  void CopyTo(Span<Vector3<T>> vectors) const;
+
+  T* X() { return data_; }
+  T* Y() { return data_ + capacity_; }
+  T* Z() { return data_ + 2 * capacity_; }
+  const T* X() const { return data_; }
+  const T* Y() const { return data_ + capacity_; }
+  const T* Z() const { return data_ + 2 * capacity_; }
+
+ private:
+  static T* Allocate(std::size_t capacity);
+  static void Deallocate(T* data);
+
+  T* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t capacity_ = 0;
+};
+
+template <typename T>
+Vector3Batch<T>::Vector3Batch(std::size_t size) {
+  Resize(size);
+}
+
+template <typename T>
+Vector3Batch<T>::Vector3Batch(Span<const Vector3<T>> vectors) {
+  Assign(vectors);
+}
+
+template <typename T>
+Vector3Batch<T>::Vector3Batch(const Vector3Batch<T>& other) {
+  *this = other;
+}
+
+template <typename T>
+Vector3Batch<T>::Vector3Batch(Vector3Batch<T>&& other) noexcept
+    : data_{other.data_}, size_{other.size_}, capacity_{other.capacity_} {
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.capacity_ = 0;
+}
+
+template <typename T>
+Vector3Batch<T>& Vector3Batch<T>::operator=(const Vector3Batch<T>& other) {
+  if (this != &other) {
+    size_ = 0;
+    Reserve(other.size_);
+    std::copy_n(other.X(), other.size_, X());
+    std::copy_n(other.Y(), other.size_, Y());
+    std::copy_n(other.Z(), other.size_, Z());
+    size_ = other.size_;
+  }
+  return *this;
+}
+
+template <typename T>
+Vector3Batch<T>& Vector3Batch<T>::operator=(Vector3Batch<T>&& other) noexcept {
+  if (this != &other) {
+    Deallocate(data_);
+    data_ = other.data_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+  }
+  return *this;
+}
+
+template <typename T>
+Vector3Batch<T>::~Vector3Batch() {
+  Deallocate(data_);
+}
+
+template <typename T>
+Vector3<T> Vector3Batch<T>::operator[](std::size_t index) const {
+  assert(index < size_);
+  return {X()[index], Y()[index], Z()[index]};
+}
+
+template <typename T>
+std::size_t Vector3Batch<T>::PaddedSize() const {
+  return (size_ + kLanes - 1) / kLanes * kLanes;
+}
+
+template <typename T>
+void Vector3Batch<T>::Reserve(std::size_t capacity) {
+  capacity = (capacity + kLanes - 1) / kLanes * kLanes;
+  if (capacity <= capacity_) {
+    return;
+  }
+
+  T* data = Allocate(capacity);
+  std::fill_n(data, 3 * capacity, static_cast<T>(0));
+  std::copy_n(X(), size_, data);
+  std::copy_n(Y(), size_, data + capacity);
+  std::copy_n(Z(), size_, data + 2 * capacity);
+
+  Deallocate(data_);
+  data_ = data;
+  capacity_ = capacity;
+}
+
+template <typename T>
+void Vector3Batch<T>::Resize(std::size_t size) {
+  if (size > capacity_) {
+    Reserve(std::max(size, 2 * capacity_));
+  }
+  if (size > size_) {
+    std::fill(X() + size_, X() + size, static_cast<T>(0));
+    std::fill(Y() + size_, Y() + size, static_cast<T>(0));
+    std::fill(Z() + size_, Z() + size, static_cast<T>(0));
+  }
+  size_ = size;
+}
+
+template <typename T>
+void Vector3Batch<T>::PushBack(const Vector3<T>& v) {
+  if (size_ == capacity_) {
+    Reserve(std::max<std::size_t>(kLanes, 2 * capacity_));
+  }
+  ++size_;
+  Set(size_ - 1, v);
+}
+
+template <typename T>
+void Vector3Batch<T>::Set(std::size_t index, const Vector3<T>& v) {
+  assert(index < size_);
+  X()[index] = v.x;
+  Y()[index] = v.y;
+  Z()[index] = v.z;
+}
+
+template <typename T>
+void Vector3Batch<T>::Assign(Span<const Vector3<T>> vectors) {
+  size_ = 0;
+  Reserve(vectors.size());
+  size_ = vectors.size();
+
+  T* x = X();
+  T* y = Y();
+  T* z = Z();
+  for (std::size_t i = 0; i < size_; ++i) {
+    x[i] = vectors[i].x;
+    y[i] = vectors[i].y;
+    z[i] = vectors[i].z;
+  }
+}
+
+template <typename T>
+void Vector3Batch<T>::CopyTo(Span<Vector3<T>> vectors) const {
+  assert(vectors.size() >= size_);
+  const T* x = X();
+  const T* y = Y();
+  const T* z = Z();
+  for (std::size_t i = 0; i < size_; ++i) {
+    vectors[i] = {x[i], y[i], z[i]};
+  }
+}
+
+template <typename T>
+T* Vector3Batch<T>::Allocate(std::size_t capacity) {
+  return static_cast<T*>(::operator new(3 * capacity * sizeof(T),
+                                        std::align_val_t{kAlignment}));
+}
+
+template <typename T>
+void Vector3Batch<T>::Deallocate(T* data) {
+  if (data != nullptr) {
+    ::operator delete(data, std::align_val_t{kAlignment});
+  }
+}
+
+// Batch functions. Every function walks the inputs one block of kLanes
+// elements at a time: the block is loaded into local arrays, computed and
+// stored, which lets the compiler keep each block in vector registers and
+// makes in-place use (out aliasing an input) safe.
+
+template <typename T>
+void Add(const Vector3Batch<T>& v1, const Vector3Batch<T>& v2,
+         Vector3Batch<T>& out) {
+  assert(v1.Size() == v2.Size());
+  constexpr std::size_t kLanes = Vector3Batch<T>::kLanes;
+  out.Resize(v1.Size());
+  const T* v1_x = v1.X();
+  const T* v1_y = v1.Y();
+  const T* v1_z = v1.Z();
+  const T* v2_x = v2.X();
+  const T* v2_y = v2.Y();
+  const T* v2_z = v2.Z();
+  T* out_x = out.X();
+  T* out_y = out.Y();
+  T* out_z = out.Z();
+  for (std::size_t i = 0; i < v1.PaddedSize(); i += kLanes) {
+    T x[kLanes], y[kLanes], z[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      x[lane] = v1_x[i + lane] + v2_x[i + lane];
+      y[lane] = v1_y[i + lane] + v2_y[i + lane];
+      z[lane] = v1_z[i + lane] + v2_z[i + lane];
+    }
+    std::copy_n(x, kLanes, out_x + i);
+    std::copy_n(y, kLanes, out_y + i);
+    std::copy_n(z, kLanes, out_z + i);
+  }
+}
+
+template <typename T>
+void Subtract(const Vector3Batch<T>& v1, const Vector3Batch<T>& v2,
+              Vector3Batch<T>& out) {
+  assert(v1.Size() == v2.Size());
+  constexpr std::size_t kLanes = Vector3Batch<T>::kLanes;
+  out.Resize(v1.Size());
+  const T* v1_x = v1.X();
+  const T* v1_y = v1.Y();
+  const T* v1_z = v1.Z();
+  const T* v2_x = v2.X();
+  const T* v2_y = v2.Y();
+  const T* v2_z = v2.Z();
+  T* out_x = out.X();
+  T* out_y = out.Y();
+  T* out_z = out.Z();
+  for (std::size_t i = 0; i < v1.PaddedSize(); i += kLanes) {
+    T x[kLanes], y[kLanes], z[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      x[lane] = v1_x[i + lane] - v2_x[i + lane];
+      y[lane] = v1_y[i + lane] - v2_y[i + lane];
+      z[lane] = v1_z[i + lane] - v2_z[i + lane];
+    }
+    std::copy_n(x, kLanes, out_x + i);
+    std::copy_n(y, kLanes, out_y + i);
+    std::copy_n(z, kLanes, out_z + i);
+  }
+}
+
+template <typename T>
+void Scale(const Vector3Batch<T>& v, T scalar, Vector3Batch<T>& out) {
+  constexpr std::size_t kLanes = Vector3Batch<T>::kLanes;
+  out.Resize(v.Size());
+  const T* v_x = v.X();
+  const T* v_y = v.Y();
+  const T* v_z = v.Z();
+  T* out_x = out.X();
+  T* out_y = out.Y();
+  T* out_z = out.Z();
+  for (std::size_t i = 0; i < v.PaddedSize(); i += kLanes) {
+    T x[kLanes], y[kLanes], z[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      x[lane] = v_x[i + lane] * scalar;
+      y[lane] = v_y[i + lane] * scalar;
+      z[lane] = v_z[i + lane] * scalar;
+    }
+    std::copy_n(x, kLanes, out_x + i);
+    std::copy_n(y, kLanes, out_y + i);
+    std::copy_n(z, kLanes, out_z + i);
+  }
+}
+
+template <typename T>
+void Dot(const Vector3Batch<T>& v1, const Vector3Batch<T>& v2, Span<T> out) {
+  assert(v1.Size() == v2.Size());
+  assert(out.size() >= v1.Size());
+  constexpr std::size_t kLanes = Vector3Batch<T>::kLanes;
+  const T* v1_x = v1.X();
+  const T* v1_y = v1.Y();
+  const T* v1_z = v1.Z();
+  const T* v2_x = v2.X();
+  const T* v2_y = v2.Y();
+  const T* v2_z = v2.Z();
+  for (std::size_t i = 0; i < v1.Size(); i += kLanes) {
+    T dot[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      dot[lane] = v1_x[i + lane] * v2_x[i + lane] +
+                  v1_y[i + lane] * v2_y[i + lane] +
+                  v1_z[i + lane] * v2_z[i + lane];
+    }
+    std::copy_n(dot, std::min(kLanes, v1.Size() - i), out.data() + i);
+  }
+}
+
+template <typename T>
+void Cross(const Vector3Batch<T>& v1, const Vector3Batch<T>& v2,
+           Vector3Batch<T>& out) {
+  assert(v1.Size() == v2.Size());
+  constexpr std::size_t kLanes = Vector3Batch<T>::kLanes;
+  out.Resize(v1.Size());
+  const T* v1_x = v1.X();
+  const T* v1_y = v1.Y();
+  const T* v1_z = v1.Z();
+  const T* v2_x = v2.X();
+  const T* v2_y = v2.Y();
+  const T* v2_z = v2.Z();
+  T* out_x = out.X();
+  T* out_y = out.Y();
+  T* out_z = out.Z();
+  for (std::size_t i = 0; i < v1.PaddedSize(); i += kLanes) {
+    T x[kLanes], y[kLanes], z[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      const T x1 = v1_x[i + lane], y1 = v1_y[i + lane], z1 = v1_z[i + lane];
+      const T x2 = v2_x[i + lane], y2 = v2_y[i + lane], z2 = v2_z[i + lane];
+      x[lane] = y1 * z2 - y2 * z1;
+      y[lane] = z1 * x2 - z2 * x1;
+      z[lane] = x1 * y2 - x2 * y1;
+    }
+    std::copy_n(x, kLanes, out_x + i);
+    std::copy_n(y, kLanes, out_y + i);
+    std::copy_n(z, kLanes, out_z + i);
+  }
+}
+
+template <typename T>
+void Length(const Vector3Batch<T>& v, Span<T> out) {
+  assert(out.size() >= v.Size());
+  constexpr std::size_t kLanes = Vector3Batch<T>::kLanes;
+  const T* v_x = v.X();
+  const T* v_y = v.Y();
+  const T* v_z = v.Z();
+  for (std::size_t i = 0; i < v.Size(); i += kLanes) {
+    T length[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      const T x = v_x[i + lane], y = v_y[i + lane], z = v_z[i + lane];
+      length[lane] = x * x + y * y + z * z;
+    }
+    simd::Sqrt(length);
+    std::copy_n(length, std::min(kLanes, v.Size() - i), out.data() + i);
+  }
+}
+
+template <typename T>
+void Normalize(const Vector3Batch<T>& v, Vector3Batch<T>& out) {
+  constexpr std::size_t kLanes = Vector3Batch<T>::kLanes;
+  out.Resize(v.Size());
+  const T* v_x = v.X();
+  const T* v_y = v.Y();
+  const T* v_z = v.Z();
+  T* out_x = out.X();
+  T* out_y = out.Y();
+  T* out_z = out.Z();
+  for (std::size_t i = 0; i < v.PaddedSize(); i += kLanes) {
+    T x[kLanes], y[kLanes], z[kLanes], length[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      x[lane] = v_x[i + lane];
+      y[lane] = v_y[i + lane];
+      z[lane] = v_z[i + lane];
+      length[lane] = x[lane] * x[lane] + y[lane] * y[lane] + z[lane] * z[lane];
+    }
+    simd::Sqrt(length);
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      x[lane] /= length[lane];
+      y[lane] /= length[lane];
+      z[lane] /= length[lane];
+    }
+    std::copy_n(x, kLanes, out_x + i);
+    std::copy_n(y, kLanes, out_y + i);
+    std::copy_n(z, kLanes, out_z + i);
+  }
+}
+
+template <typename T>
+void Distance(const Vector3Batch<T>& v1, const Vector3Batch<T>& v2,
+              Span<T> out) {
+  assert(v1.Size() == v2.Size());
+  assert(out.size() >= v1.Size());
+  constexpr std::size_t kLanes = Vector3Batch<T>::kLanes;
+  const T* v1_x = v1.X();
+  const T* v1_y = v1.Y();
+  const T* v1_z = v1.Z();
+  const T* v2_x = v2.X();
+  const T* v2_y = v2.Y();
+  const T* v2_z = v2.Z();
+  for (std::size_t i = 0; i < v1.Size(); i += kLanes) {
+    T distance[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      const T x = v1_x[i + lane] - v2_x[i + lane];
+      const T y = v1_y[i + lane] - v2_y[i + lane];
+      const T z = v1_z[i + lane] - v2_z[i + lane];
+      distance[lane] = x * x + y * y + z * z;
+    }
+    simd::Sqrt(distance);
+    std::copy_n(distance, std::min(kLanes, v1.Size() - i), out.data() + i);
+  }
+}
+
+// Projects every element of v1 onto the matching element of v2. Elements
+// projected onto a zero vector come out as the zero vector.
+template <typename T>
+void Project(const Vector3Batch<T>& v1, const Vector3Batch<T>& v2,
+             Vector3Batch<T>& out) {
+  assert(v1.Size() == v2.Size());
+  constexpr std::size_t kLanes = Vector3Batch<T>::kLanes;
+  out.Resize(v1.Size());
+  const T* v1_x = v1.X();
+  const T* v1_y = v1.Y();
+  const T* v1_z = v1.Z();
+  const T* v2_x = v2.X();
+  const T* v2_y = v2.Y();
+  const T* v2_z = v2.Z();
+  T* out_x = out.X();
+  T* out_y = out.Y();
+  T* out_z = out.Z();
+  for (std::size_t i = 0; i < v1.PaddedSize(); i += kLanes) {
+    T x[kLanes], y[kLanes], z[kLanes];
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      const T x2 = v2_x[i + lane], y2 = v2_y[i + lane], z2 = v2_z[i + lane];
+      const T dot = v1_x[i + lane] * x2 + v1_y[i + lane] * y2 +
+                    v1_z[i + lane] * z2;
+      const T length_squared = x2 * x2 + y2 * y2 + z2 * z2;
+      const T scale = length_squared == static_cast<T>(0)
+                          ? static_cast<T>(0)
+                          : dot / length_squared;
+      x[lane] = x2 * scale;
+      y[lane] = y2 * scale;
+      z[lane] = z2 * scale;
+    }
+    std::copy_n(x, kLanes, out_x + i);
+    std::copy_n(y, kLanes, out_y + i);
+    std::copy_n(z, kLanes, out_z + i);
+  }
+}
+
+using Vector3BatchF = Vector3Batch<float>;
+
+}  // namespace vector
+}  // namespace dlm
@@ -0,0 +1,68 @@
+#pragma once
+
+// Included from vector.hpp before the Vector template is defined.
+#include "dlm/simd.hpp"
+
+#if defined(DLM_SSE2)
+
+namespace dlm {
+namespace vector {
+
+namespace detail {
+// SSE backed Vector4<float>.
+template <>
+struct Simd<4, float> {
+  static constexpr bool kEnabled = true;
+  using Register = __m128;
+
+  static Register Load(const float* p) { return _mm_load_ps(p); }
+  static void Store(float* p, Register r) { _mm_store_ps(p, r); }
+  static Register Broadcast(float value) { return _mm_set1_ps(value); }
+
+  static Register Negate(Register a) {
+    return _mm_xor_ps(a, _mm_set1_ps(-0.0f));
+  }
+  static Register Abs(Register a) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+  }
+  static Register Add(Register a, Register b) { return _mm_add_ps(a, b); }
+  static Register Subtract(Register a, Register b) {
+    return _mm_sub_ps(a, b);
+  }
+  static Register Multiply(Register a, Register b) {
+    return _mm_mul_ps(a, b);
+  }
+  static Register Divide(Register a, Register b) { return _mm_div_ps(a, b); }
+  static Register MulAdd(Register a, Register b, Register c) {
+    return simd::MulAdd(a, b, c);
+  }
+  static Register Sqrt(Register a) { return _mm_sqrt_ps(a); }
+  // minps and maxps return b when either lane is NaN, as the scalar code.
+  static Register Min(Register a, Register b) { return _mm_min_ps(a, b); }
+  static Register Max(Register a, Register b) { return _mm_max_ps(a, b); }
+  static Register Dot(Register a, Register b) { return simd::Dot4(a, b); }
+  static float First(Register a) { return _mm_cvtss_f32(a); }
+
+  static Register Equal(Register a, Register b) { return _mm_cmpeq_ps(a, b); }
+  static Register NotEqual(Register a, Register b) {
+    return _mm_cmpneq_ps(a, b);
+  }
+  static Register Less(Register a, Register b) { return _mm_cmplt_ps(a, b); }
+  static Register LessEqual(Register a, Register b) {
+    return _mm_cmple_ps(a, b);
+  }
+  static Register Greater(Register a, Register b) {
+    return _mm_cmpgt_ps(a, b);
+  }
+  static Register GreaterEqual(Register a, Register b) {
+    return _mm_cmpge_ps(a, b);
+  }
+  static bool All(Register mask) { return simd::Mask(mask) == 0xF; }
+  static bool Any(Register mask) { return simd::Mask(mask) != 0; }
+};
+}  // namespace detail
+
+}  // namespace vector
+}  // namespace dlm
+
+#endif
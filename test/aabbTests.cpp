@@ -0,0 +1,163 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "dlm/aabb.hpp"
+#include "dlm/vector4.hpp"
+#include "testhelpers.hpp"
+
+namespace {
+// Points spread around the origin with a few NaN components.
+template <typename vector_type>
+std::vector<vector_type> MakePoints(std::size_t count) {
+  using T = typename vector_type::ValueType;
+  std::vector<vector_type> points;
+  std::uint32_t state = 3;
+  for (std::size_t i = 0; i < count; ++i) {
+    vector_type point;
+    for (int c = 0; c < static_cast<int>(vector_type::kSize); ++c) {
+      dlm::test::NextRandom(state);
+      point[c] = static_cast<T>(static_cast<int>(state >> 16) - 32768) /
+                 static_cast<T>(256);
+    }
+    if (i % 13 == 5) {
+      point[static_cast<int>(i % vector_type::kSize)] =
+          std::numeric_limits<T>::quiet_NaN();
+    }
+    points.push_back(point);
+  }
+  return points;
+}
+
+// Bounds of points and boxes and the overlap mask against single calls, for
+// sizes with and without a partial period and word.
+template <typename vector_type>
+void ExpectBatchMatches() {
+  using Box = dlm::geometry::AABB<vector_type>;
+  for (std::size_t count : {0u, 1u, 3u, 4u, 7u, 64u, 130u}) {
+    const std::vector<vector_type> points = MakePoints<vector_type>(count);
+    Box expected;
+    for (const auto& point : points) {
+      expected.Merge(point);
+    }
+    ASSERT_EQ(dlm::geometry::Bounds(dlm::Span<const vector_type>{points}),
+              expected)
+        << count;
+
+    std::vector<Box> boxes;
+    for (std::size_t i = 0; i + 1 < points.size(); i += 2) {
+      boxes.push_back(Box{}.Merge(points[i]).Merge(points[i + 1]));
+    }
+    boxes.push_back(Box{});
+    Box merged;
+    for (const auto& box : boxes) {
+      merged.Merge(box);
+    }
+    ASSERT_EQ(dlm::geometry::Bounds(dlm::Span<const Box>{boxes}), merged)
+        << count;
+
+    const Box query{points.empty() ? vector_type{} : points[0] * 0.5f,
+                    points.empty() ? vector_type{} : points[0] * 0.5f + 40.0f};
+    std::vector<std::uint64_t> mask((boxes.size() + 63) / 64,
+                                    ~std::uint64_t{0});
+    dlm::geometry::Overlaps(dlm::Span<const Box>{boxes}, query,
+                            dlm::Span<std::uint64_t>{mask});
+    for (std::size_t i = 0; i < mask.size() * 64; ++i) {
+      const bool bit = ((mask[i / 64] >> (i % 64)) & 1u) != 0;
+      ASSERT_EQ(bit, i < boxes.size() && boxes[i].Overlaps(query))
+          << count << " " << i;
+    }
+  }
+}
+}  // namespace
+
+class AABBTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(AABBTest, min_and_max_are_component_wise) {
+  constexpr dlm::vector::Vector3F kA{1.0f, 5.0f, -2.0f};
+  constexpr dlm::vector::Vector3F kB{3.0f, -1.0f, -2.0f};
+
+  static_assert(dlm::vector::Min(kA, kB) ==
+                dlm::vector::Vector3F{1.0f, -1.0f, -2.0f});
+  static_assert(dlm::vector::Max(kA, kB) ==
+                dlm::vector::Vector3F{3.0f, 5.0f, -2.0f});
+  const dlm::vector::Vector4F a{1.0f, 5.0f, -2.0f, 0.0f};
+  const dlm::vector::Vector4F b{3.0f, -1.0f, -2.0f,
+                                std::numeric_limits<float>::quiet_NaN()};
+  ASSERT_EQ(dlm::vector::Min(a, b).x, 1.0f);
+  ASSERT_EQ(dlm::vector::Max(a, b).y, 5.0f);
+  // NaN in either gives the second argument.
+  ASSERT_NE(dlm::vector::Min(a, b).w, dlm::vector::Min(a, b).w);
+  ASSERT_EQ(dlm::vector::Max(b, a).w, 0.0f);
+}
+
+TEST_F(AABBTest, empty_box) {
+  constexpr dlm::geometry::AABB3F kEmpty;
+  static_assert(kEmpty.IsEmpty());
+  static_assert(!kEmpty.Contains(dlm::vector::Vector3F{}));
+  static_assert(!kEmpty.Overlaps(kEmpty));
+  constexpr dlm::geometry::AABB2<double> kPoint =
+      dlm::geometry::Merge(dlm::geometry::AABB2<double>{},
+                           dlm::vector::Vector2<double>{1.0, 2.0});
+  static_assert(!kPoint.IsEmpty());
+  static_assert(kPoint.min == kPoint.max);
+  static_assert(dlm::geometry::Merge(kPoint, dlm::geometry::AABB2<double>{}) ==
+                kPoint);
+}
+
+TEST_F(AABBTest, contains_and_overlaps_are_closed) {
+  const dlm::geometry::AABB3F box{{0.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 3.0f}};
+
+  ASSERT_EQ(box.Center(), (dlm::vector::Vector3F{0.5f, 1.0f, 1.5f}));
+  ASSERT_EQ(box.Size(), (dlm::vector::Vector3F{1.0f, 2.0f, 3.0f}));
+  ASSERT_TRUE(dlm::geometry::Contains(box, {1.0f, 2.0f, 3.0f}));
+  ASSERT_TRUE(box.Contains({0.5f, 0.0f, 1.0f}));
+  ASSERT_FALSE(box.Contains({0.5f, -0.1f, 1.0f}));
+  ASSERT_TRUE(box.Contains(dlm::geometry::AABB3F{{0.0f, 1.0f, 1.0f},
+                                                 {1.0f, 2.0f, 2.0f}}));
+  ASSERT_FALSE(box.Contains(dlm::geometry::AABB3F{{0.0f, 1.0f, 1.0f},
+                                                  {1.0f, 2.5f, 2.0f}}));
+
+  // Sharing a face overlaps, a gap on one axis does not.
+  const dlm::geometry::AABB3F touching{{1.0f, 2.0f, 3.0f},
+                                       {4.0f, 4.0f, 4.0f}};
+  const dlm::geometry::AABB3F apart{{0.0f, 0.0f, 3.5f}, {1.0f, 2.0f, 4.0f}};
+  ASSERT_TRUE(dlm::geometry::Overlaps(box, touching));
+  ASSERT_TRUE(touching.Overlaps(box));
+  ASSERT_FALSE(box.Overlaps(apart));
+  ASSERT_FALSE(apart.Overlaps(box));
+
+  const dlm::geometry::AABB3F merged = dlm::geometry::Merge(box, apart);
+  ASSERT_EQ(merged, (dlm::geometry::AABB3F{{0.0f, 0.0f, 0.0f},
+                                           {1.0f, 2.0f, 4.0f}}));
+}
+
+TEST_F(AABBTest, batch_functions_match_single_calls) {
+  ExpectBatchMatches<dlm::vector::Vector2F>();
+  ExpectBatchMatches<dlm::vector::Vector3F>();
+  ExpectBatchMatches<dlm::vector::Vector3<double>>();
+}
+
+TEST_F(AABBTest, threaded_bounds_match_one_thread) {
+  // Several chunks, not a multiple of the block size.
+  const auto points = MakePoints<dlm::vector::Vector3F>(70001);
+  const dlm::Span<const dlm::vector::Vector3F> span{points};
+  dlm::geometry::AABB3F expected;
+  for (const auto& point : points) {
+    expected.Merge(point);
+  }
+
+  ASSERT_EQ(dlm::geometry::Bounds(span, 4), expected);
+  ASSERT_EQ(dlm::geometry::Bounds(span, 1), expected);
+  ASSERT_EQ(dlm::geometry::Bounds(span.subspan(0, 40000), 3),
+            dlm::geometry::Bounds(span.subspan(0, 40000), 1));
+}
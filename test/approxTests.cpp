@@ -0,0 +1,195 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "dlm/approx.hpp"
+#include "testhelpers.hpp"
+
+namespace {
+// Fills a and b with 0, 1 or 2 components apart by varying amounts so each
+// family sees both outcomes, including NaN and signed zeros.
+template <typename vector_type>
+void MakePairs(std::size_t count, std::vector<vector_type>& a,
+               std::vector<vector_type>& b) {
+  using T = typename vector_type::ValueType;
+  std::uint32_t state = 7;
+  for (std::size_t i = 0; i < count; ++i) {
+    vector_type x;
+    for (int c = 0; c < static_cast<int>(vector_type::kSize); ++c) {
+      dlm::test::NextRandom(state);
+      x[c] = static_cast<T>(static_cast<int>(state >> 16) - 32768) /
+             static_cast<T>(64);
+    }
+    vector_type y = x;
+    dlm::test::NextRandom(state);
+    const int c = static_cast<int>((state >> 8) % vector_type::kSize);
+    switch ((state >> 16) % 6) {
+      case 0:
+        break;
+      case 1:
+        y[c] = std::nextafter(y[c], std::numeric_limits<T>::infinity());
+        break;
+      case 2:
+        y[c] += static_cast<T>(1e-4);
+        break;
+      case 3:
+        y[c] = y[c] * static_cast<T>(1.001) + static_cast<T>(0.01);
+        break;
+      case 4:
+        x[c] = static_cast<T>(0);
+        y[c] = -static_cast<T>(0);
+        break;
+      default:
+        y[c] = std::numeric_limits<T>::quiet_NaN();
+        break;
+    }
+    a.push_back(x);
+    b.push_back(y);
+  }
+}
+
+// Checks the span version of a family against the single vector version.
+template <typename vector_type, typename Batch, typename Single>
+void ExpectBatchMatches(Batch batch, Single single) {
+  // Sizes with and without a partial block and word.
+  for (std::size_t count : {0u, 5u, 16u, 64u, 100u, 203u}) {
+    std::vector<vector_type> a;
+    std::vector<vector_type> b;
+    MakePairs(count, a, b);
+    std::vector<std::uint64_t> mask((count + 63) / 64, ~std::uint64_t{0});
+    batch(dlm::Span<const vector_type>{a}, dlm::Span<const vector_type>{b},
+          dlm::Span<std::uint64_t>{mask});
+
+    for (std::size_t i = 0; i < mask.size() * 64; ++i) {
+      const bool bit = ((mask[i / 64] >> (i % 64)) & 1u) != 0;
+      ASSERT_EQ(bit, i < count && single(a[i], b[i])) << count << " " << i;
+    }
+  }
+}
+}  // namespace
+
+class ApproxTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(ApproxTest, equals_is_symmetric_and_const) {
+  const dlm::vector::Vector3F a{1.0f, 2.0f, 3.0f};
+  const dlm::vector::Vector3F b{1.0f, 2.0f, 30.0f};
+  const dlm::vector::Vector4F c{1.0f, 2.0f, 3.0f, 4.0f};
+  const dlm::vector::Vector4F d{1.0f, 2.0f, 3.0f, 40.0f};
+
+  // a < b used to pass by any amount.
+  ASSERT_FALSE(a.Equals(b, 1e-3f));
+  ASSERT_FALSE(b.Equals(a, 1e-3f));
+  ASSERT_FALSE(c.Equals(d, 1e-3f));
+  ASSERT_FALSE(d.Equals(c, 1e-3f));
+  ASSERT_TRUE(a.Equals(a + 1e-4f, 1e-3f));
+  ASSERT_TRUE((c - 1e-4f).Equals(c, 1e-3f));
+  constexpr dlm::vector::Vector2<double> kV{1.0, 2.0};
+  static_assert(kV.Equals({1.0, 2.5}, 0.5));
+  static_assert(!kV.Equals({1.0, 2.5}, 0.25));
+  static_assert(noexcept(a.Equals(b, 1.0f)));
+}
+
+TEST_F(ApproxTest, scalar_comparisons) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float infinity = std::numeric_limits<float>::infinity();
+
+  static_assert(dlm::AbsoluteEqual(1.0, 1.25, 0.25));
+  static_assert(!dlm::AbsoluteEqual(1.25, 1.0, 0.125));
+  static_assert(dlm::RelativeEqual(1000.0, 1001.0, 1e-3));
+  static_assert(!dlm::RelativeEqual(1e-9, 2e-9, 1e-3));
+  static_assert(!dlm::RelativeEqual(0.0, 1e-30, 1e-3));
+  ASSERT_FALSE(dlm::AbsoluteEqual(nan, nan, 1.0f));
+  ASSERT_FALSE(dlm::RelativeEqual(infinity, infinity, 1.0f));
+
+  ASSERT_TRUE(dlm::UlpsEqual(1.0f, std::nextafter(1.0f, 2.0f), 1));
+  ASSERT_FALSE(dlm::UlpsEqual(1.0f, std::nextafter(1.0f, 2.0f), 0));
+  ASSERT_TRUE(dlm::UlpsEqual(0.0f, -0.0f, 0));
+  // The smallest subnormals on either side of zero are two apart.
+  const float denormal = std::numeric_limits<float>::denorm_min();
+  ASSERT_TRUE(dlm::UlpsEqual(denormal, -denormal, 2));
+  ASSERT_FALSE(dlm::UlpsEqual(denormal, -denormal, 1));
+  ASSERT_TRUE(dlm::UlpsEqual(std::numeric_limits<float>::max(), infinity, 1));
+  ASSERT_FALSE(dlm::UlpsEqual(-infinity, infinity, (1 << 22) - 1));
+  ASSERT_FALSE(dlm::UlpsEqual(nan, nan, 4));
+  ASSERT_TRUE(dlm::UlpsEqual(1.0, std::nextafter(1.0, 0.0), 1));
+  ASSERT_FALSE(dlm::UlpsEqual(-1.0, 1.0, (1 << 22) - 1));
+}
+
+TEST_F(ApproxTest, vectors_matrices_and_quaternions) {
+  const dlm::vector::Vector3F v{100.0f, -2.0f, 0.5f};
+  const dlm::vector::Vector3F w{100.01f, -2.0f, 0.5f};
+
+  ASSERT_TRUE(dlm::vector::AbsoluteEqual(v, w, 0.02f));
+  ASSERT_FALSE(dlm::vector::AbsoluteEqual(v, w, 0.001f));
+  ASSERT_TRUE(dlm::vector::RelativeEqual(v, w, 1e-3f));
+  ASSERT_FALSE(dlm::vector::UlpsEqual(v, w, 4));
+  ASSERT_TRUE(dlm::vector::UlpsEqual(v, v, 0));
+
+  const dlm::matrix::Matrix3x3F m{1.0f, 2.0f, 3.0f, 4.0f, 5.0f,
+                                  6.0f, 7.0f, 8.0f, 9.0f};
+  dlm::matrix::Matrix3x3F n = m;
+  n[2][1] += 1e-3f;
+  ASSERT_TRUE(dlm::matrix::AbsoluteEqual(m, n, 2e-3f));
+  ASSERT_FALSE(dlm::matrix::AbsoluteEqual(m, n, 1e-4f));
+  ASSERT_TRUE(dlm::matrix::RelativeEqual(m, n, 1e-3f));
+  ASSERT_FALSE(dlm::matrix::UlpsEqual(m, n, 16));
+  constexpr dlm::matrix::Matrix2x2<double> kIdentity;
+  static_assert(dlm::matrix::AbsoluteEqual(kIdentity, kIdentity, 0.0));
+  ASSERT_TRUE(dlm::matrix::UlpsEqual(dlm::matrix::Matrix4x4F{},
+                                     dlm::matrix::Matrix4x4F{}, 0));
+
+  const dlm::QuaternionF q{0.0f, 0.6f, 0.0f, 0.8f};
+  ASSERT_TRUE(dlm::AbsoluteEqual(q, dlm::QuaternionF{0.0f, 0.6f, 0.0f,
+                                                     0.8000001f},
+                                 1e-6f));
+  ASSERT_FALSE(dlm::AbsoluteEqual(q, -q, 1e-6f));
+  ASSERT_TRUE(dlm::UlpsEqual(q, q, 0));
+}
+
+TEST_F(ApproxTest, batch_masks_match_single_comparisons) {
+  ExpectBatchMatches<dlm::vector::Vector2F>(
+      [](auto a, auto b, auto mask) {
+        dlm::vector::AbsoluteEqual(a, b, 1e-3f, mask);
+      },
+      [](const auto& a, const auto& b) {
+        return dlm::vector::AbsoluteEqual(a, b, 1e-3f);
+      });
+  ExpectBatchMatches<dlm::vector::Vector3F>(
+      [](auto a, auto b, auto mask) {
+        dlm::vector::AbsoluteEqual(a, b, 1e-3f, mask);
+      },
+      [](const auto& a, const auto& b) {
+        return dlm::vector::AbsoluteEqual(a, b, 1e-3f);
+      });
+  ExpectBatchMatches<dlm::vector::Vector4F>(
+      [](auto a, auto b, auto mask) {
+        dlm::vector::RelativeEqual(a, b, 1e-4f, mask);
+      },
+      [](const auto& a, const auto& b) {
+        return dlm::vector::RelativeEqual(a, b, 1e-4f);
+      });
+  ExpectBatchMatches<dlm::vector::Vector3F>(
+      [](auto a, auto b, auto mask) {
+        dlm::vector::UlpsEqual(a, b, 1, mask);
+      },
+      [](const auto& a, const auto& b) {
+        return dlm::vector::UlpsEqual(a, b, 1);
+      });
+  ExpectBatchMatches<dlm::vector::Vector3<double>>(
+      [](auto a, auto b, auto mask) {
+        dlm::vector::UlpsEqual(a, b, 1, mask);
+      },
+      [](const auto& a, const auto& b) {
+        return dlm::vector::UlpsEqual(a, b, 1);
+      });
+}
@@ -0,0 +1,199 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "dlm/bvh.hpp"
+#include "testhelpers.hpp"
+
+namespace {
+using dlm::test::Random;
+using dlm::test::RandomVector;
+
+// Small triangles scattered through a cube, with clusters so the SAH has
+// uneven splits to choose from.
+std::vector<dlm::geometry::TriangleF> MakeTriangles(std::size_t count,
+                                                    std::uint32_t state) {
+  std::vector<dlm::geometry::TriangleF> triangles;
+  for (std::size_t i = 0; i < count; ++i) {
+    const float spread = i % 3 == 0 ? 1.0f : 10.0f;
+    const auto a = RandomVector(state, -spread, spread);
+    triangles.push_back({a, a + RandomVector(state, -0.5f, 0.5f),
+                         a + RandomVector(state, -0.5f, 0.5f)});
+  }
+  return triangles;
+}
+
+std::vector<dlm::geometry::RayF> MakeRays(std::size_t count) {
+  std::uint32_t state = 5;
+  std::vector<dlm::geometry::RayF> rays;
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto origin = RandomVector(state, -15.0f, 15.0f);
+    rays.push_back({origin, RandomVector(state, -2.0f, 2.0f) - origin});
+  }
+  return rays;
+}
+
+// Checks that the tree covers every primitive once and every node box holds
+// its children.
+template <typename primitive_type>
+void ExpectValid(const dlm::geometry::BVHF& bvh,
+                 const std::vector<primitive_type>& primitives) {
+  const auto nodes = bvh.Nodes();
+  std::vector<int> seen(primitives.size());
+  for (std::size_t n = 0; n < nodes.size(); ++n) {
+    const auto& node = nodes[n];
+    if (node.IsLeaf()) {
+      ASSERT_LE(node.offset + node.count, bvh.Indices().size());
+      for (std::uint32_t i = 0; i < node.count; ++i) {
+        const std::uint32_t primitive = bvh.Indices()[node.offset + i];
+        ++seen[primitive];
+        ASSERT_TRUE(
+            node.bounds.Contains(dlm::geometry::Bounds(primitives[primitive])));
+      }
+    } else {
+      ASSERT_GT(node.offset, n + 1);
+      ASSERT_LT(node.offset, nodes.size());
+      ASSERT_TRUE(node.bounds.Contains(nodes[n + 1].bounds));
+      ASSERT_TRUE(node.bounds.Contains(nodes[node.offset].bounds));
+    }
+  }
+  for (int count : seen) {
+    ASSERT_EQ(count, 1);
+  }
+}
+
+// Compares the queries with testing every primitive.
+template <typename primitive_type>
+void ExpectQueriesMatchBruteForce(
+    const dlm::geometry::BVHF& bvh,
+    const std::vector<primitive_type>& primitives) {
+  const dlm::Span<const primitive_type> span{primitives};
+  std::size_t hits = 0;
+  for (const auto& ray : MakeRays(300)) {
+    float closest = std::numeric_limits<float>::infinity();
+    for (const auto& primitive : primitives) {
+      const float distance = dlm::geometry::Intersect(ray, primitive);
+      closest = distance < closest ? distance : closest;
+    }
+    const auto hit = bvh.ClosestHit(ray, span);
+    ASSERT_EQ(hit.distance, closest);
+    if (closest < std::numeric_limits<float>::infinity()) {
+      ASSERT_EQ(dlm::geometry::Intersect(ray, primitives[hit.index]),
+                closest);
+      ++hits;
+    } else {
+      ASSERT_EQ(hit.index, primitives.size());
+    }
+    ASSERT_EQ(bvh.AnyHit(ray, span),
+              closest < std::numeric_limits<float>::infinity());
+    // Bounded queries only see hits before the bound.
+    const float bound = 0.5f;
+    ASSERT_EQ(bvh.AnyHit(ray, span, bound), closest < bound);
+    ASSERT_EQ(bvh.ClosestHit(ray, span, bound).index,
+              closest < bound ? hit.index : primitives.size());
+  }
+  ASSERT_GT(hits, 10u);
+}
+}  // namespace
+
+class BVHTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(BVHTest, empty_and_single_primitive) {
+  const std::vector<dlm::geometry::TriangleF> none;
+  const dlm::geometry::BVHF empty{dlm::Span<const dlm::geometry::TriangleF>{
+      none}};
+  const dlm::geometry::RayF ray{{0.25f, 0.25f, -1.0f}, {0.0f, 0.0f, 1.0f}};
+
+  ASSERT_TRUE(empty.Nodes().empty());
+  ASSERT_EQ(empty.ClosestHit(ray, dlm::Span<const dlm::geometry::TriangleF>{
+                                      none})
+                .index,
+            0u);
+
+  const std::vector<dlm::geometry::TriangleF> one{
+      {{0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 1.0f}}};
+  const dlm::Span<const dlm::geometry::TriangleF> span{one};
+  const dlm::geometry::BVHF bvh{span};
+  ASSERT_EQ(bvh.Nodes().size(), 1u);
+  const auto hit = bvh.ClosestHit(ray, span);
+  ASSERT_EQ(hit.index, 0u);
+  ASSERT_FLOAT_EQ(hit.distance, 2.0f);
+  ASSERT_TRUE(bvh.AnyHit(ray, span));
+  ASSERT_FALSE(bvh.AnyHit(ray, span, 1.5f));
+}
+
+TEST_F(BVHTest, triangles_match_brute_force) {
+  const auto triangles = MakeTriangles(3000, 1);
+  const dlm::geometry::BVHF bvh{
+      dlm::Span<const dlm::geometry::TriangleF>{triangles}, 1};
+
+  ExpectValid(bvh, triangles);
+  ExpectQueriesMatchBruteForce(bvh, triangles);
+}
+
+TEST_F(BVHTest, boxes_and_spheres_match_brute_force) {
+  std::uint32_t state = 9;
+  std::vector<dlm::geometry::AABB3F> boxes;
+  std::vector<dlm::geometry::SphereF> spheres;
+  for (int i = 0; i < 1000; ++i) {
+    const auto corner = RandomVector(state, -10.0f, 10.0f);
+    boxes.push_back({corner, corner + RandomVector(state, 0.0f, 0.5f)});
+    spheres.push_back({corner, Random(state, 0.1f, 0.4f)});
+  }
+  // Identical centroids cannot be split and stay in one leaf.
+  for (int i = 0; i < 20; ++i) {
+    boxes.push_back({{1.0f, 1.0f, 1.0f}, {2.0f, 2.0f, 2.0f}});
+  }
+
+  const dlm::geometry::BVHF box_bvh{
+      dlm::Span<const dlm::geometry::AABB3F>{boxes}};
+  ExpectValid(box_bvh, boxes);
+  ExpectQueriesMatchBruteForce(box_bvh, boxes);
+  const dlm::geometry::BVHF sphere_bvh{
+      dlm::Span<const dlm::geometry::SphereF>{spheres}};
+  ExpectValid(sphere_bvh, spheres);
+  ExpectQueriesMatchBruteForce(sphere_bvh, spheres);
+}
+
+TEST_F(BVHTest, threaded_build_is_identical) {
+  const auto triangles = MakeTriangles(40000, 3);
+  const dlm::Span<const dlm::geometry::TriangleF> span{triangles};
+  const dlm::geometry::BVHF serial{span, 1};
+  const dlm::geometry::BVHF threaded{span, 4};
+
+  ASSERT_EQ(serial.Nodes().size(), threaded.Nodes().size());
+  for (std::size_t n = 0; n < serial.Nodes().size(); ++n) {
+    ASSERT_EQ(serial.Nodes()[n].bounds, threaded.Nodes()[n].bounds) << n;
+    ASSERT_EQ(serial.Nodes()[n].offset, threaded.Nodes()[n].offset) << n;
+    ASSERT_EQ(serial.Nodes()[n].count, threaded.Nodes()[n].count) << n;
+  }
+  for (std::size_t i = 0; i < triangles.size(); ++i) {
+    ASSERT_EQ(serial.Indices()[i], threaded.Indices()[i]);
+  }
+}
+
+TEST_F(BVHTest, refit_follows_moved_primitives) {
+  auto triangles = MakeTriangles(2000, 7);
+  dlm::geometry::BVHF bvh{
+      dlm::Span<const dlm::geometry::TriangleF>{triangles}};
+
+  std::uint32_t state = 13;
+  for (auto& triangle : triangles) {
+    const auto offset = RandomVector(state, -1.0f, 1.0f);
+    triangle = {triangle.a + offset, triangle.b + offset * 0.5f,
+                triangle.c - offset};
+  }
+  bvh.Refit(dlm::Span<const dlm::geometry::TriangleF>{triangles});
+
+  ExpectValid(bvh, triangles);
+  ExpectQueriesMatchBruteForce(bvh, triangles);
+}
@@ -0,0 +1,118 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cmath>
+#include <type_traits>
+
+#include "dlm/expression.hpp"
+
+class ExpressionTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+using dlm::vector::Lazy;
+
+TEST_F(ExpressionTest, eager_operators_are_the_default) {
+  const dlm::vector::Vector3F a{1.0f, 2.0f, 3.0f};
+
+  static_assert(
+      std::is_same<decltype(a * 2.0f + a), dlm::vector::Vector3F>::value);
+  static_assert(!std::is_same<decltype(Lazy(a) * 2.0f + a),
+                              dlm::vector::Vector3F>::value);
+  ASSERT_EQ(a * 2.0f + a, (dlm::vector::Vector3F{3.0f, 6.0f, 9.0f}));
+}
+
+TEST_F(ExpressionTest, documented_example_keeps_every_product_lazy) {
+  using dlm::vector::expression::Add;
+  using dlm::vector::expression::Binary;
+  using dlm::vector::expression::Multiply;
+  using dlm::vector::expression::Scalar;
+  using dlm::vector::expression::Terminal;
+  using V = dlm::vector::Vector3F;
+  using Product = Binary<Multiply, Terminal<V>, Scalar<float>>;
+  const V position{1.0f, 2.0f, 3.0f};
+  const V velocity{4.0f, 5.0f, 6.0f};
+  const V acceleration{7.0f, 8.0f, 9.0f};
+  const float dt = 0.5f;
+  const float h = 0.125f;
+
+  static_assert(
+      std::is_same<decltype(Lazy(position) + Lazy(velocity) * dt +
+                            Lazy(acceleration) * h),
+                   Binary<Add, Binary<Add, Terminal<V>, Product>,
+                          Product>>::value);
+  const V p = Lazy(position) + Lazy(velocity) * dt + Lazy(acceleration) * h;
+  ASSERT_EQ(p, position + velocity * dt + acceleration * h);
+}
+
+TEST_F(ExpressionTest, lazy_expression_matches_eager_operators) {
+  const dlm::vector::Vector3F a{1.0f, 2.0f, 3.0f};
+  const dlm::vector::Vector3F b{4.0f, 5.0f, 6.0f};
+  const dlm::vector::Vector3F c{7.0f, 8.0f, 9.0f};
+
+  const dlm::vector::Vector3F lazy = Lazy(a) * 2.0f + b - c * 0.5f;
+
+  ASSERT_EQ(lazy, a * 2.0f + b - c * 0.5f);
+}
+
+TEST_F(ExpressionTest, every_vector_width) {
+  const dlm::vector::Vector2F v2 = Lazy(dlm::vector::Vector2F{1.0f, 2.0f}) *
+                                   dlm::vector::Vector2F{3.0f, 4.0f};
+  const dlm::vector::Vector4F v4 =
+      Lazy(dlm::vector::Vector4F{1.0f, 2.0f, 3.0f, 4.0f}) - 1.0f;
+  const dlm::vector::Vector4<double> v4d =
+      Lazy(dlm::vector::Vector4<double>{2.0, 4.0, 6.0, 8.0}) / 2.0;
+
+  ASSERT_EQ(v2, (dlm::vector::Vector2F{3.0f, 8.0f}));
+  ASSERT_EQ(v4, (dlm::vector::Vector4F{0.0f, 1.0f, 2.0f, 3.0f}));
+  ASSERT_EQ(v4d, (dlm::vector::Vector4<double>{1.0, 2.0, 3.0, 4.0}));
+}
+
+TEST_F(ExpressionTest, scalar_on_the_left_negation_and_division) {
+  const dlm::vector::Vector3F a{1.0f, 2.0f, 4.0f};
+  const dlm::vector::Vector3F b{2.0f, 4.0f, 8.0f};
+
+  const dlm::vector::Vector3F result = -(2.0f * Lazy(a) / b) + 3;
+
+  ASSERT_EQ(result, (dlm::vector::Vector3F{2.0f, 2.0f, 2.0f}));
+}
+
+TEST_F(ExpressionTest, compound_assignment_takes_lazy_right_hand_side) {
+  dlm::vector::Vector3F position{1.0f, 1.0f, 1.0f};
+  const dlm::vector::Vector3F velocity{2.0f, 4.0f, 8.0f};
+
+  position += Lazy(velocity) * 0.5f - 1.0f;
+
+  ASSERT_EQ(position, (dlm::vector::Vector3F{1.0f, 2.0f, 4.0f}));
+}
+
+TEST_F(ExpressionTest, constexpr_expression_folds_at_compile_time) {
+  constexpr dlm::vector::Vector2<double> kResult =
+      Lazy(dlm::vector::Vector2<double>{1.0, 2.0}) * 3.0 -
+      dlm::vector::Vector2<double>{1.0, 1.0} *
+          Lazy(dlm::vector::Vector2<double>{1.0, 1.0});
+
+  static_assert(kResult == dlm::vector::Vector2<double>{2.0, 5.0});
+  ASSERT_EQ(kResult.y, 5.0);
+}
+
+TEST_F(ExpressionTest, product_sum_is_fused_when_fma_is_available) {
+  // (1 + 2^-12)^2 = 1 + 2^-11 + 2^-24, the last term is lost when the
+  // product is rounded before the subtraction.
+  const float e = 1.0f + std::ldexp(1.0f, -12);
+  const dlm::vector::Vector3F a{e, e, e};
+  const dlm::vector::Vector3F c{-(1.0f + std::ldexp(1.0f, -11)), 0.0f, 0.0f};
+
+  const dlm::vector::Vector3F fused = Lazy(a) * a + c;
+
+#if defined(DLM_FMA)
+  ASSERT_EQ(fused.x, std::ldexp(1.0f, -24));
+#else
+  ASSERT_EQ(fused, a * a + c);
+#endif
+  ASSERT_FLOAT_EQ(fused.y, e * e);
+}
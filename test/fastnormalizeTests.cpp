@@ -0,0 +1,204 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "dlm/fastnormalize.hpp"
+#include "dlm/paddedvector3.hpp"
+#include "testhelpers.hpp"
+
+namespace {
+// Distance in units in the last place between value and the float nearest
+// to reference.
+std::int64_t UlpError(float value, double reference) {
+  const float rounded = static_cast<float>(reference);
+  std::int32_t value_bits = 0;
+  std::int32_t reference_bits = 0;
+  std::memcpy(&value_bits, &value, sizeof(value));
+  std::memcpy(&reference_bits, &rounded, sizeof(rounded));
+  return std::abs(static_cast<std::int64_t>(value_bits) - reference_bits);
+}
+
+// Largest ULP error of ReciprocalSqrt over every float in [1, 4).
+template <typename Precision>
+std::int64_t MaxReciprocalSqrtError() {
+  std::int64_t max_error = 0;
+  for (float x = 1.0f; x < 4.0f; x = std::nextafter(x, 4.0f)) {
+    const double reference = 1.0 / std::sqrt(static_cast<double>(x));
+    max_error = std::max(
+        max_error, UlpError(dlm::vector::ReciprocalSqrt<Precision>(x),
+                            reference));
+  }
+  return max_error;
+}
+
+// Largest per component ULP error of FastNormalize over random vectors of
+// every width, with components spanning several orders of magnitude.
+template <typename Precision>
+std::int64_t MaxNormalizeError() {
+  std::uint32_t state = 1;
+  const auto random = [&state] {
+    const float unit = dlm::test::Random(state, -0.5f, 0.5f);
+    return unit * std::pow(10.0f, static_cast<float>(state % 7) - 3.0f);
+  };
+  std::int64_t max_error = 0;
+  for (int i = 0; i < 100000; ++i) {
+    const float x = random(), y = random(), z = random(), w = random();
+    const double length2 = std::sqrt(static_cast<double>(x) * x +
+                                     static_cast<double>(y) * y);
+    const double length3 =
+        std::sqrt(length2 * length2 + static_cast<double>(z) * z);
+    const double length4 =
+        std::sqrt(length3 * length3 + static_cast<double>(w) * w);
+
+    const auto v2 =
+        dlm::vector::FastNormalize<Precision>(dlm::vector::Vector2F{x, y});
+    const auto v3 =
+        dlm::vector::FastNormalize<Precision>(dlm::vector::Vector3F{x, y, z});
+    const auto v4 = dlm::vector::FastNormalize<Precision>(
+        dlm::vector::Vector4F{x, y, z, w});
+    const auto padded = dlm::vector::FastNormalize<Precision>(
+        dlm::vector::PaddedVector3F{x, y, z});
+    max_error = std::max({max_error, UlpError(v2.x, x / length2),
+                          UlpError(v2.y, y / length2),
+                          UlpError(v3.x, x / length3),
+                          UlpError(v3.y, y / length3),
+                          UlpError(v3.z, z / length3),
+                          UlpError(v4.x, x / length4),
+                          UlpError(v4.y, y / length4),
+                          UlpError(v4.z, z / length4),
+                          UlpError(v4.w, w / length4),
+                          UlpError(padded.x, x / length3),
+                          UlpError(padded.y, y / length3),
+                          UlpError(padded.z, z / length3)});
+  }
+  return max_error;
+}
+}  // namespace
+
+class FastNormalizeTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(FastNormalizeTest, reciprocal_sqrt_estimate_error_bound) {
+  ASSERT_LE(MaxReciprocalSqrtError<dlm::vector::precision::Estimate>(), 6144);
+}
+
+TEST_F(FastNormalizeTest, reciprocal_sqrt_refined_error_bound) {
+  ASSERT_LE(MaxReciprocalSqrtError<dlm::vector::precision::Refined>(), 5);
+}
+
+TEST_F(FastNormalizeTest, reciprocal_sqrt_exact_is_correctly_rounded) {
+  ASSERT_LE(MaxReciprocalSqrtError<dlm::vector::precision::Exact>(), 1);
+}
+
+TEST_F(FastNormalizeTest, reciprocal_sqrt_double) {
+  for (double x : {1e-300, 0.25, 2.0, 3.0, 1e10, 1e300}) {
+    const double reference = 1.0 / std::sqrt(x);
+    ASSERT_NEAR(dlm::vector::ReciprocalSqrt(x), reference, reference * 1e-6);
+    ASSERT_NEAR(
+        dlm::vector::ReciprocalSqrt<dlm::vector::precision::NewtonRaphson<2>>(
+            x),
+        reference, reference * 1e-12);
+  }
+}
+
+TEST_F(FastNormalizeTest, normalize_estimate_error_bound) {
+  ASSERT_LE(MaxNormalizeError<dlm::vector::precision::Estimate>(), 6144);
+}
+
+TEST_F(FastNormalizeTest, normalize_refined_error_bound) {
+  ASSERT_LE(MaxNormalizeError<dlm::vector::precision::Refined>(), 6);
+}
+
+TEST_F(FastNormalizeTest, normalize_exact_matches_normalize) {
+  dlm::vector::Vector3F expected{1.0f, -2.0f, 3.0f};
+  const dlm::vector::Vector3F normalized =
+      dlm::vector::FastNormalize<dlm::vector::precision::Exact>(expected);
+  expected.Normalize();
+
+  ASSERT_FLOAT_EQ(normalized.x, expected.x);
+  ASSERT_FLOAT_EQ(normalized.y, expected.y);
+  ASSERT_FLOAT_EQ(normalized.z, expected.z);
+}
+
+TEST_F(FastNormalizeTest, normalize_double) {
+  const dlm::vector::Vector3<double> normalized =
+      dlm::vector::FastNormalize(dlm::vector::Vector3<double>{3.0, 0.0, 4.0});
+
+  ASSERT_NEAR(normalized.x, 0.6, 1e-6);
+  ASSERT_EQ(normalized.y, 0.0);
+  ASSERT_NEAR(normalized.z, 0.8, 1e-6);
+}
+
+TEST_F(FastNormalizeTest, normalize_safe_returns_fallback_for_zero_length) {
+  const dlm::vector::Vector3F zero =
+      dlm::vector::FastNormalizeSafe(dlm::vector::Vector3F{});
+  ASSERT_TRUE(zero.IsZero());
+
+  const dlm::vector::Vector2F up{0.0f, 1.0f};
+  const dlm::vector::Vector2F fallback =
+      dlm::vector::FastNormalizeSafe(dlm::vector::Vector2F{}, up);
+  ASSERT_EQ(fallback, up);
+
+  const float denormal = std::numeric_limits<float>::denorm_min();
+  const dlm::vector::Vector4F tiny = dlm::vector::FastNormalizeSafe(
+      dlm::vector::Vector4F{denormal, 0.0f, 0.0f, 0.0f});
+  ASSERT_TRUE(tiny.IsZero());
+
+  const dlm::vector::Vector3F exact =
+      dlm::vector::FastNormalizeSafe<dlm::vector::precision::Exact>(
+          dlm::vector::Vector3F{});
+  ASSERT_TRUE(exact.IsZero());
+}
+
+TEST_F(FastNormalizeTest, normalize_safe_normalizes_non_zero_vectors) {
+  const dlm::vector::Vector3F normalized =
+      dlm::vector::FastNormalizeSafe(dlm::vector::Vector3F{0.0f, 0.0f, 5.0f});
+
+  ASSERT_FLOAT_EQ(normalized.z, 1.0f);
+}
+
+TEST_F(FastNormalizeTest, normalize_batch_matches_single_normalize) {
+  std::vector<dlm::vector::Vector3F> vectors;
+  for (int i = 1; i < 40; ++i) {
+    vectors.push_back({static_cast<float>(i), static_cast<float>(3 - i),
+                       0.25f * static_cast<float>(i % 7)});
+  }
+  const dlm::vector::Vector3BatchF batch{
+      dlm::Span<const dlm::vector::Vector3F>{vectors}};
+  dlm::vector::Vector3BatchF normalized;
+
+  dlm::vector::FastNormalize(batch, normalized);
+
+  ASSERT_EQ(normalized.Size(), vectors.size());
+  for (std::size_t i = 0; i < vectors.size(); ++i) {
+    const dlm::vector::Vector3F expected =
+        dlm::vector::FastNormalize(vectors[i]);
+    ASSERT_NEAR(normalized[i].x, expected.x, 1e-6f);
+    ASSERT_NEAR(normalized[i].y, expected.y, 1e-6f);
+    ASSERT_NEAR(normalized[i].z, expected.z, 1e-6f);
+  }
+}
+
+TEST_F(FastNormalizeTest, normalize_batch_double) {
+  dlm::vector::Vector3Batch<double> batch;
+  batch.PushBack({3.0, 0.0, 4.0});
+  dlm::vector::Vector3Batch<double> normalized;
+
+  dlm::vector::FastNormalize<dlm::vector::precision::NewtonRaphson<2>>(
+      batch, normalized);
+
+  ASSERT_NEAR(normalized[0].x, 0.6, 1e-12);
+  ASSERT_NEAR(normalized[0].z, 0.8, 1e-12);
+}
@@ -0,0 +1,138 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "dlm/fixed.hpp"
+#include "dlm/vector2.hpp"
+#include "dlm/vector3.hpp"
+
+class FixedTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(FixedTest, converts_from_float) {
+  static_assert(dlm::Fixed{1.0f}.raw == 0x10000);
+  static_assert(dlm::Fixed{-1.5f}.raw == -0x18000);
+  static_assert(dlm::Fixed{3}.raw == 0x30000);
+  static_assert(static_cast<float>(dlm::Fixed::FromRaw(1)) ==
+                1.0f / 65536.0f);
+  ASSERT_EQ(dlm::Fixed{0.1}.raw, 6554);
+}
+
+TEST_F(FixedTest, rounds_to_nearest_even) {
+  const float half_step = 1.0f / 131072.0f;
+
+  ASSERT_EQ(dlm::Fixed{half_step}.raw, 0);
+  ASSERT_EQ(dlm::Fixed{3.0f * half_step}.raw, 2);
+  ASSERT_EQ(dlm::Fixed{-3.0f * half_step}.raw, -2);
+  ASSERT_EQ(dlm::Fixed{-half_step}.raw, 0);
+}
+
+TEST_F(FixedTest, clamps_out_of_range_values) {
+  ASSERT_EQ(dlm::Fixed{1e9f}.raw, 2147483520);
+  ASSERT_EQ(dlm::Fixed{-1e9f}.raw, std::numeric_limits<std::int32_t>::min());
+  ASSERT_EQ(dlm::Fixed{std::numeric_limits<float>::quiet_NaN()}.raw,
+            std::numeric_limits<std::int32_t>::min());
+  static_assert(dlm::Fixed{40000}.raw ==
+                std::numeric_limits<std::int32_t>::max());
+  ASSERT_EQ(dlm::Fixed{-40000}.raw, std::numeric_limits<std::int32_t>::min());
+  ASSERT_EQ(dlm::Fixed{-32768}.raw, std::numeric_limits<std::int32_t>::min());
+}
+
+TEST_F(FixedTest, arithmetic) {
+  constexpr dlm::Fixed kA{2.5f};
+  constexpr dlm::Fixed kB{-0.75f};
+
+  static_assert(kA + kB == dlm::Fixed{1.75f});
+  static_assert(kA - kB == dlm::Fixed{3.25f});
+  static_assert(kA * kB == dlm::Fixed{-1.875f});
+  static_assert(kA / kB == dlm::Fixed{-3.3333333});
+  static_assert(-kA == dlm::Fixed{-2.5f});
+  static_assert(kB < kA && kA >= kA);
+  ASSERT_EQ(sqrt(dlm::Fixed{2.25f}), dlm::Fixed{1.5f});
+}
+
+TEST_F(FixedTest, multiply_and_divide_round_to_nearest) {
+  const dlm::Fixed step = dlm::Fixed::FromRaw(1);
+
+  // 2^-16 * 0.5 is exactly half a step and rounds up, 2^-16 * 0.25 rounds
+  // down.
+  ASSERT_EQ((step * dlm::Fixed{0.5f}).raw, 1);
+  ASSERT_EQ((step * dlm::Fixed{0.25f}).raw, 0);
+  ASSERT_EQ((dlm::Fixed{1} / dlm::Fixed{3}).raw, 21845);
+  ASSERT_EQ((dlm::Fixed{2} / dlm::Fixed{3}).raw, 43691);
+  ASSERT_EQ((dlm::Fixed{-2} / dlm::Fixed{3}).raw, -43691);
+}
+
+TEST_F(FixedTest, divide_by_zero_saturates) {
+  constexpr dlm::Fixed kZero{};
+
+  static_assert((dlm::Fixed{3} / kZero).raw ==
+                std::numeric_limits<std::int32_t>::max());
+  ASSERT_EQ((dlm::Fixed::FromRaw(1) / kZero).raw,
+            std::numeric_limits<std::int32_t>::max());
+  ASSERT_EQ((dlm::Fixed{-0.5f} / kZero).raw,
+            std::numeric_limits<std::int32_t>::min());
+  ASSERT_EQ((kZero / kZero).raw, 0);
+
+  dlm::Fixed value{2};
+  value /= kZero;
+  ASSERT_EQ(value.raw, std::numeric_limits<std::int32_t>::max());
+}
+
+TEST_F(FixedTest, addition_wraps_around) {
+  const dlm::Fixed max =
+      dlm::Fixed::FromRaw(std::numeric_limits<std::int32_t>::max());
+
+  ASSERT_EQ((max + dlm::Fixed::FromRaw(1)).raw,
+            std::numeric_limits<std::int32_t>::min());
+}
+
+TEST_F(FixedTest, fixed_vectors) {
+  using Vector3X = dlm::vector::Vector3<dlm::Fixed>;
+  constexpr Vector3X kA =
+      dlm::vector::Convert<dlm::Fixed>(dlm::vector::Vector3F{1.0f, 2.0f, 2.0f});
+  constexpr Vector3X kB{dlm::Fixed{0.5f}, dlm::Fixed{0.5f}, dlm::Fixed{-1}};
+
+  static_assert(kA + kB == Vector3X{dlm::Fixed{1.5f}, dlm::Fixed{2.5f},
+                                    dlm::Fixed{1}});
+  static_assert((kA | kB) == dlm::Fixed{-0.5f});
+  static_assert((kA ^ kB).x == dlm::Fixed{-3});
+  ASSERT_EQ(kA.Length(), dlm::Fixed{3});
+  ASSERT_EQ(dlm::vector::Convert<float>(kA - kB),
+            (dlm::vector::Vector3F{0.5f, 1.5f, 3.0f}));
+}
+
+TEST_F(FixedTest, pack_matches_scalar_conversion) {
+  std::vector<dlm::vector::Vector2F> floats;
+  for (int i = 0; i < 21; ++i) {
+    const float f = static_cast<float>(i);
+    floats.push_back({f * 0.1f - 1.0f, (f - 10.0f) * 4000.0f});
+  }
+  floats.push_back({1e9f, -std::numeric_limits<float>::infinity()});
+  floats.push_back({std::numeric_limits<float>::quiet_NaN(), 0.5f / 65536});
+  std::vector<dlm::vector::Vector2<dlm::Fixed>> fixed(floats.size());
+  std::vector<dlm::vector::Vector2F> unpacked(floats.size());
+
+  dlm::vector::Pack(dlm::Span<const dlm::vector::Vector2F>{floats},
+                    dlm::Span<dlm::vector::Vector2<dlm::Fixed>>{fixed});
+  dlm::vector::Unpack(
+      dlm::Span<const dlm::vector::Vector2<dlm::Fixed>>{fixed},
+      dlm::Span<dlm::vector::Vector2F>{unpacked});
+
+  for (std::size_t i = 0; i < floats.size(); ++i) {
+    for (int c = 0; c < 2; ++c) {
+      const dlm::Fixed expected{floats[i][c]};
+      ASSERT_EQ(fixed[i][c].raw, expected.raw);
+      ASSERT_EQ(unpacked[i][c], static_cast<float>(expected));
+    }
+  }
+}
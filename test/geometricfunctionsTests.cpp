@@ -2,9 +2,84 @@
 #include "gtest/gtest.h"
 // clang-format on
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include "dlm/geometricfunctions.hpp"
 #include "dlm/vector2.hpp"
 #include "dlm/vector3.hpp"
+#include "dlm/vector4.hpp"
+
+namespace {
+// Checks the span Reflect and Refract against the single vector ones, in
+// place and with a tail, on directions that include total internal
+// reflection.
+template <typename vector_type>
+void ExpectReflectRefractSpansMatch() {
+  using T = typename vector_type::ValueType;
+  std::vector<vector_type> incident;
+  std::vector<vector_type> normals;
+  std::vector<vector_type> unit_normals;
+  for (int i = 0; i < 11; ++i) {
+    vector_type v;
+    vector_type n;
+    for (int c = 0; c < static_cast<int>(vector_type::kSize); ++c) {
+      v[c] = static_cast<T>((i * 7 + c * 3) % 5) - static_cast<T>(2.5);
+      n[c] = static_cast<T>((i + c) % 3) + static_cast<T>(0.5);
+    }
+    incident.push_back(dlm::vector::Normalize(v));
+    normals.push_back(n * static_cast<T>(i + 1));
+    unit_normals.push_back(dlm::vector::Normalize(n));
+  }
+  using Spans = dlm::Span<const vector_type>;
+  const auto eta = static_cast<T>(1.3);
+  const auto tolerance = static_cast<T>(1e-5);
+  const auto expect_near = [tolerance](const vector_type& a,
+                                       const vector_type& b) {
+    for (int c = 0; c < static_cast<int>(vector_type::kSize); ++c) {
+      ASSERT_NEAR(a[c], b[c], tolerance);
+    }
+  };
+
+  std::vector<vector_type> out(incident.size());
+  dlm::vector::Reflect(Spans{incident}, Spans{normals},
+                       dlm::Span<vector_type>{out});
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    expect_near(out[i], dlm::vector::Reflect(incident[i], normals[i]));
+  }
+  dlm::vector::Refract(Spans{incident}, Spans{normals}, eta,
+                       dlm::Span<vector_type>{out});
+  int reflected = 0;
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    const vector_type expected =
+        dlm::vector::Refract(incident[i], normals[i], eta);
+    reflected += expected == vector_type{} ? 1 : 0;
+    expect_near(out[i], expected);
+  }
+  ASSERT_GT(reflected, 0);
+  ASSERT_LT(reflected, static_cast<int>(out.size()));
+
+  // In place with unit normals.
+  std::vector<vector_type> reflect = incident;
+  std::vector<vector_type> refract = incident;
+  dlm::vector::Reflect(Spans{reflect}, Spans{unit_normals},
+                       dlm::Span<vector_type>{reflect},
+                       dlm::vector::kUnitNormal);
+  dlm::vector::Refract(Spans{refract}, Spans{unit_normals}, eta,
+                       dlm::Span<vector_type>{refract},
+                       dlm::vector::kUnitNormal);
+  for (std::size_t i = 0; i < incident.size(); ++i) {
+    expect_near(reflect[i],
+                dlm::vector::Reflect(incident[i], unit_normals[i],
+                                     dlm::vector::kUnitNormal));
+    expect_near(refract[i],
+                dlm::vector::Refract(incident[i], unit_normals[i], eta,
+                                     dlm::vector::kUnitNormal));
+  }
+}
+}  // namespace
 
 class GeometricFunctionsTest : public ::testing::Test {
  protected:
@@ -91,6 +166,91 @@ TEST_F(GeometricFunctionsTest, reflect) {
   ASSERT_EQ(reflected.y, 3.0f);
 }
 
+TEST_F(GeometricFunctionsTest, reflect_about_zero_normal_negates) {
+  const dlm::vector::Vector3F v{1.0f, -2.0f, 3.0f};
+  // Zero normals in the four wide part and in the tail of the span.
+  std::vector<dlm::vector::Vector3F> vectors(6, v);
+  std::vector<dlm::vector::Vector3F> normals(6, {0.0f, 0.0f, 2.0f});
+  normals[1] = normals[5] = dlm::vector::Vector3F{};
+  std::vector<dlm::vector::Vector3F> out(vectors.size());
+
+  ASSERT_EQ(dlm::vector::Reflect(v, dlm::vector::Vector3F{}), -v);
+  static_assert(dlm::vector::Reflect(dlm::vector::Vector2F{1.0f, 2.0f},
+                                     dlm::vector::Vector2F{}) ==
+                dlm::vector::Vector2F{-1.0f, -2.0f});
+
+  dlm::vector::Reflect(dlm::Span<const dlm::vector::Vector3F>{vectors},
+                       dlm::Span<const dlm::vector::Vector3F>{normals},
+                       dlm::Span<dlm::vector::Vector3F>{out});
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    ASSERT_EQ(out[i], dlm::vector::Reflect(vectors[i], normals[i]));
+  }
+  ASSERT_EQ(out[1], -v);
+  ASSERT_EQ(out[5], -v);
+}
+
+TEST_F(GeometricFunctionsTest, refract_about_zero_normal_gives_zero) {
+  const dlm::vector::Vector3F incident{0.6f, 0.0f, -0.8f};
+  // Zero normals in the four wide part and in the tail of the span.
+  std::vector<dlm::vector::Vector3F> incidents(6, incident);
+  std::vector<dlm::vector::Vector3F> normals(6, {0.0f, 0.0f, 2.0f});
+  normals[1] = normals[5] = dlm::vector::Vector3F{};
+  std::vector<dlm::vector::Vector3F> out(incidents.size());
+
+  ASSERT_EQ(dlm::vector::Refract(incident, dlm::vector::Vector3F{}, 0.9f),
+            dlm::vector::Vector3F{});
+
+  dlm::vector::Refract(dlm::Span<const dlm::vector::Vector3F>{incidents},
+                       dlm::Span<const dlm::vector::Vector3F>{normals}, 0.9f,
+                       dlm::Span<dlm::vector::Vector3F>{out});
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    const auto expected = dlm::vector::Refract(incidents[i], normals[i], 0.9f);
+    ASSERT_FLOAT_EQ(out[i].x, expected.x);
+    ASSERT_FLOAT_EQ(out[i].y, expected.y);
+    ASSERT_FLOAT_EQ(out[i].z, expected.z);
+  }
+  ASSERT_EQ(out[1], dlm::vector::Vector3F{});
+  ASSERT_EQ(out[5], dlm::vector::Vector3F{});
+}
+
+TEST_F(GeometricFunctionsTest, reflect_any_normal_length_and_type) {
+  constexpr dlm::vector::Vector3<double> kV{1.0, 2.0, 3.0};
+  constexpr dlm::vector::Vector3<double> kN{0.0, 0.0, 4.0};
+  constexpr dlm::vector::Vector3<double> kUnitN{0.0, 0.0, 1.0};
+
+  static_assert(dlm::vector::Reflect(kV, kN) ==
+                dlm::vector::Vector3<double>{-1.0, -2.0, 3.0});
+  static_assert(dlm::vector::Reflect(kV, kUnitN, dlm::vector::kUnitNormal) ==
+                dlm::vector::Reflect(kV, kN));
+  // A ray going down bounces back up.
+  const dlm::vector::Vector2F direction{1.0f, -1.0f};
+  ASSERT_EQ(dlm::vector::Reflect(-direction, dlm::vector::Vector2F{0.0f, 3.0f}),
+            (dlm::vector::Vector2F{1.0f, 1.0f}));
+}
+
+TEST_F(GeometricFunctionsTest, refract) {
+  const dlm::vector::Vector3<double> n{0.0, 0.0, 2.0};
+  const dlm::vector::Vector3<double> incident =
+      dlm::vector::Normalize(dlm::vector::Vector3<double>{1.0, 0.0, -1.0});
+
+  // Same index, no bend.
+  const auto straight = dlm::vector::Refract(incident, n, 1.0);
+  ASSERT_NEAR(dlm::vector::Distance(straight, incident), 0.0, 1e-12);
+
+  // Snell: sin(out) = eta * sin(in).
+  const auto bent = dlm::vector::Refract(incident, n, 1.0 / 1.5);
+  ASSERT_NEAR(bent.Length(), 1.0, 1e-12);
+  ASSERT_NEAR(bent.x, std::sqrt(0.5) / 1.5, 1e-12);
+  ASSERT_LT(bent.z, 0.0);
+  ASSERT_EQ(dlm::vector::Refract(incident, dlm::vector::Normalize(n), 1.0 / 1.5,
+                                 dlm::vector::kUnitNormal),
+            bent);
+
+  // Total internal reflection.
+  ASSERT_EQ(dlm::vector::Refract(incident, n, 1.5),
+            (dlm::vector::Vector3<double>{}));
+}
+
 TEST_F(GeometricFunctionsTest, projection) {
   dlm::vector::Vector2F v1{3.0f, 3.0f};
   dlm::vector::Vector2F v2{4.0f, 0.0f};
@@ -100,3 +260,252 @@ TEST_F(GeometricFunctionsTest, projection) {
   ASSERT_EQ(reflected.x, 3.0f);
   ASSERT_EQ(reflected.y, 0.0f);
 }
+
+TEST_F(GeometricFunctionsTest, rejection) {
+  const dlm::vector::Vector3F v1{3.0f, 3.0f, 1.0f};
+  const dlm::vector::Vector3F v2{4.0f, 0.0f, 0.0f};
+
+  const dlm::vector::Vector3F rejected = dlm::vector::Reject(v1, v2);
+
+  ASSERT_EQ(rejected, (dlm::vector::Vector3F{0.0f, 3.0f, 1.0f}));
+  ASSERT_EQ(rejected + dlm::vector::Project(v1, v2), v1);
+}
+
+TEST_F(GeometricFunctionsTest, project_and_reject_spans) {
+  std::vector<dlm::vector::Vector3F> v1;
+  std::vector<dlm::vector::Vector3F> v2;
+  for (int i = 1; i < 12; ++i) {
+    v1.push_back({static_cast<float>(i), static_cast<float>(2 - i), 1.0f});
+    v2.push_back({1.0f, static_cast<float>(i % 3), static_cast<float>(i)});
+  }
+  std::vector<dlm::vector::Vector3F> projected(v1.size());
+  std::vector<dlm::vector::Vector3F> rejected(v1.size());
+
+  dlm::vector::Project(dlm::Span<const dlm::vector::Vector3F>{v1},
+                       dlm::Span<const dlm::vector::Vector3F>{v2},
+                       dlm::Span<dlm::vector::Vector3F>{projected});
+  dlm::vector::Reject(dlm::Span<const dlm::vector::Vector3F>{v1},
+                      dlm::Span<const dlm::vector::Vector3F>{v2},
+                      dlm::Span<dlm::vector::Vector3F>{rejected});
+
+  for (std::size_t i = 0; i < v1.size(); ++i) {
+    ASSERT_EQ(projected[i], dlm::vector::Project(v1[i], v2[i]));
+    ASSERT_EQ(rejected[i], dlm::vector::Reject(v1[i], v2[i]));
+  }
+}
+
+TEST_F(GeometricFunctionsTest, project_and_reject_span_onto_single_vector) {
+  std::vector<dlm::vector::Vector2F> v;
+  for (int i = 0; i < 9; ++i) {
+    v.push_back({static_cast<float>(i), static_cast<float>(3 - i)});
+  }
+  const dlm::vector::Vector2F onto{3.0f, 4.0f};
+  std::vector<dlm::vector::Vector2F> projected(v.size());
+
+  dlm::vector::Project(dlm::Span<const dlm::vector::Vector2F>{v}, onto,
+                       dlm::Span<dlm::vector::Vector2F>{projected});
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    const dlm::vector::Vector2F expected = dlm::vector::Project(v[i], onto);
+    ASSERT_FLOAT_EQ(projected[i].x, expected.x);
+    ASSERT_FLOAT_EQ(projected[i].y, expected.y);
+  }
+
+  // In place.
+  dlm::vector::Reject(dlm::Span<const dlm::vector::Vector2F>{v}, onto,
+                      dlm::Span<dlm::vector::Vector2F>{v});
+  for (const dlm::vector::Vector2F& rejected : v) {
+    ASSERT_NEAR(rejected | onto, 0.0f, 1e-5f);
+  }
+}
+
+TEST_F(GeometricFunctionsTest, project_onto_zero_vector_is_zero) {
+  const dlm::vector::Vector3F v{1.0f, -2.0f, 3.0f};
+  const dlm::vector::Vector3F zero{};
+  std::vector<dlm::vector::Vector3F> vectors{v, zero, {0.5f, 0.0f, 0.0f}};
+  std::vector<dlm::vector::Vector3F> projected(vectors.size());
+  std::vector<dlm::vector::Vector3F> rejected(vectors.size());
+
+  ASSERT_EQ(v.ProjectOnTo(zero), zero);
+  ASSERT_EQ(dlm::vector::Reject(v, zero), v);
+  ASSERT_EQ((dlm::vector::Vector4<double>{1.0, 2.0, 3.0, 4.0}.ProjectOnTo({})),
+            (dlm::vector::Vector4<double>{}));
+  static_assert(dlm::vector::Vector2F{3.0f, 4.0f}.ProjectOnTo({}) ==
+                dlm::vector::Vector2F{});
+
+  dlm::vector::Project(dlm::Span<const dlm::vector::Vector3F>{vectors}, zero,
+                       dlm::Span<dlm::vector::Vector3F>{projected});
+  dlm::vector::Reject(dlm::Span<const dlm::vector::Vector3F>{vectors}, zero,
+                      dlm::Span<dlm::vector::Vector3F>{rejected});
+  ASSERT_EQ(projected, std::vector<dlm::vector::Vector3F>(vectors.size()));
+  ASSERT_EQ(rejected, vectors);
+}
+
+TEST_F(GeometricFunctionsTest, constexpr_helpers_fold_at_compile_time) {
+  constexpr dlm::vector::Vector3F kRight{1.0f, 0.0f, 0.0f};
+  constexpr dlm::vector::Vector3F kUp{0.0f, 1.0f, 0.0f};
+  constexpr dlm::vector::Vector2F kOrigin{0.0f, 0.0f};
+  constexpr dlm::vector::Vector2F kCorner{3.0f, 4.0f};
+  constexpr dlm::vector::Vector2F kUp2{0.0f, 2.0f};
+
+  static_assert(dlm::vector::Dot(kRight, kUp) == 0.0f);
+  static_assert(dlm::vector::Cross(kRight, kUp).z == 1.0f);
+  static_assert(dlm::vector::DistanceSquared(kOrigin, kCorner) == 25.0f);
+  static_assert(dlm::vector::Project(kCorner, kUp2) ==
+                dlm::vector::Vector2F{0.0f, 4.0f});
+  static_assert(dlm::vector::Reject(kCorner, kUp2) ==
+                dlm::vector::Vector2F{3.0f, 0.0f});
+  ASSERT_EQ(dlm::vector::Cross(kRight, kUp).z, 1.0f);
+}
+
+TEST_F(GeometricFunctionsTest, distance_of_every_width) {
+  const dlm::vector::Vector3F a{1.0f, 2.0f, 3.0f};
+  const dlm::vector::Vector3F b{4.0f, 6.0f, 3.0f};
+  const dlm::vector::Vector4<double> c{1.0, 1.0, 1.0, 1.0};
+
+  ASSERT_EQ(dlm::vector::Distance(a, b), 5.0f);
+  ASSERT_EQ(dlm::vector::DistanceSquared(a, b), 25.0f);
+  ASSERT_EQ(dlm::vector::Distance(c, -c), 4.0);
+  ASSERT_EQ(dlm::vector::Distance(dlm::vector::Vector4F{0.0f, 0.0f, 3.0f, 4.0f},
+                                  dlm::vector::Vector4F{}),
+            5.0f);
+  constexpr dlm::vector::Vector3<double> kCorner{1.0, 2.0, 2.0};
+  static_assert(dlm::vector::DistanceSquared(kCorner, {}) == 9.0);
+}
+
+TEST_F(GeometricFunctionsTest, distance_spans_match_single_calls) {
+  // Not a multiple of the block size so the tail is covered.
+  std::vector<dlm::vector::Vector3F> a;
+  std::vector<dlm::vector::Vector3F> b;
+  for (int i = 0; i < 37; ++i) {
+    const float f = static_cast<float>(i);
+    a.push_back({f * 0.5f, 3.0f - f, f * f * 0.01f});
+    if (i % 2 == 0) {
+      b.push_back({-f, f * 0.25f, 1.0f});
+    }
+  }
+  const dlm::vector::Vector3F point{1.0f, -2.0f, 0.5f};
+  std::vector<float> distances(a.size());
+  std::vector<float> squared(a.size());
+  std::vector<float> pairwise(a.size() * b.size());
+
+  dlm::vector::Distance(dlm::Span<const dlm::vector::Vector3F>{a}, point,
+                        dlm::Span<float>{distances});
+  dlm::vector::DistanceSquared(dlm::Span<const dlm::vector::Vector3F>{a},
+                               point, dlm::Span<float>{squared});
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_FLOAT_EQ(distances[i], dlm::vector::Distance(a[i], point));
+    ASSERT_FLOAT_EQ(squared[i], dlm::vector::DistanceSquared(a[i], point));
+  }
+
+  dlm::vector::PairwiseDistance(dlm::Span<const dlm::vector::Vector3F>{a},
+                                dlm::Span<const dlm::vector::Vector3F>{b},
+                                dlm::Span<float>{pairwise});
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    for (std::size_t j = 0; j < b.size(); ++j) {
+      ASSERT_FLOAT_EQ(pairwise[i * b.size() + j],
+                      dlm::vector::Distance(a[i], b[j]));
+    }
+  }
+}
+
+TEST_F(GeometricFunctionsTest, nearest_and_k_nearest) {
+  // Points on a line at distance |i - 300| from the query, in a scrambled
+  // order over more than one block.
+  std::vector<dlm::vector::Vector2<double>> points;
+  for (int i = 0; i < 601; ++i) {
+    const int position = (i * 7) % 601;
+    points.push_back({static_cast<double>(position), 0.0});
+  }
+  const dlm::vector::Vector2<double> query{300.0, 0.0};
+  const dlm::Span<const dlm::vector::Vector2<double>> span{points};
+
+  ASSERT_EQ(points[dlm::vector::Nearest(span, query)], query);
+  ASSERT_EQ(dlm::vector::Nearest(span.subspan(0, 0), query), 0u);
+
+  std::size_t nearest[5];
+  ASSERT_EQ(dlm::vector::KNearest(span, query, dlm::Span<std::size_t>{nearest}),
+            5u);
+  const double expected[5] = {0.0, 1.0, 1.0, 2.0, 2.0};
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(dlm::vector::Distance(points[nearest[i]], query), expected[i]);
+  }
+  // Equal distances come out by index.
+  ASSERT_LT(nearest[1], nearest[2]);
+  ASSERT_LT(nearest[3], nearest[4]);
+
+  // NaN distances are skipped, ties go to the lower index.
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const std::vector<dlm::vector::Vector2<double>> few{
+      {nan, 0.0}, {1.0, 0.0}, {-1.0, 0.0}, {0.0, nan}};
+  const dlm::Span<const dlm::vector::Vector2<double>> few_span{few};
+  ASSERT_EQ(dlm::vector::Nearest(few_span, {}), 1u);
+  ASSERT_EQ(dlm::vector::Nearest(few_span.subspan(0, 1), {}), 1u);
+  std::size_t all[4];
+  ASSERT_EQ(dlm::vector::KNearest(few_span, {}, dlm::Span<std::size_t>{all}),
+            2u);
+  ASSERT_EQ(all[0], 1u);
+  ASSERT_EQ(all[1], 2u);
+
+  // Float spans take a vector path, with the minimum in the scalar tail,
+  // tied inside the vector part and with only infinite distances.
+  const float infinity = std::numeric_limits<float>::infinity();
+  std::vector<dlm::vector::Vector3F> floats(11, {5.0f, 0.0f, 0.0f});
+  floats[2] = floats[6] = {0.0f, 0.0f, 1.0f};
+  const dlm::Span<const dlm::vector::Vector3F> float_span{floats};
+  ASSERT_EQ(dlm::vector::Nearest(float_span, {}), 2u);
+  floats[9] = {0.0f, 0.5f, 0.0f};
+  ASSERT_EQ(dlm::vector::Nearest(float_span, {}), 9u);
+  std::fill(floats.begin(), floats.end(),
+            dlm::vector::Vector3F{infinity, 0.0f, 0.0f});
+  floats[3].x = std::numeric_limits<float>::quiet_NaN();
+  ASSERT_EQ(dlm::vector::Nearest(float_span.subspan(3, 8), {}), 1u);
+}
+
+TEST_F(GeometricFunctionsTest, threaded_searches_match_one_thread) {
+  // Enough points for several chunks, on a coarse grid so distances tie
+  // across chunk boundaries, with some NaN.
+  std::vector<dlm::vector::Vector3F> points;
+  for (int i = 0; i < 70000; ++i) {
+    points.push_back({static_cast<float>(i % 13), static_cast<float>(i % 7),
+                      static_cast<float>((i * 5) % 11)});
+  }
+  for (std::size_t i = 3; i < points.size(); i += 1001) {
+    points[i].y = std::numeric_limits<float>::quiet_NaN();
+  }
+  const dlm::Span<const dlm::vector::Vector3F> span{points};
+
+  for (const dlm::vector::Vector3F& query :
+       {dlm::vector::Vector3F{6.0f, 3.0f, 5.0f},
+        dlm::vector::Vector3F{-4.0f, 2.5f, 20.0f}}) {
+    ASSERT_EQ(dlm::vector::Nearest(span, query, 4),
+              dlm::vector::Nearest(span, query, 1));
+    for (std::size_t k : {1u, 9u, 300u}) {
+      std::vector<std::size_t> threaded(k);
+      std::vector<std::size_t> serial(k);
+      ASSERT_EQ(
+          dlm::vector::KNearest(span, query, dlm::Span<std::size_t>{threaded},
+                                4),
+          dlm::vector::KNearest(span, query, dlm::Span<std::size_t>{serial},
+                                1));
+      ASSERT_EQ(threaded, serial);
+    }
+  }
+
+  const auto a = span.subspan(0, 300);
+  const auto b = span.subspan(1000, 200);
+  std::vector<float> threaded(a.size() * b.size());
+  std::vector<float> serial(a.size() * b.size());
+  dlm::vector::PairwiseDistance(a, b, dlm::Span<float>{threaded}, 4);
+  dlm::vector::PairwiseDistance(a, b, dlm::Span<float>{serial}, 1);
+  for (std::size_t i = 0; i < serial.size(); ++i) {
+    ASSERT_TRUE(threaded[i] == serial[i] ||
+                (threaded[i] != threaded[i] && serial[i] != serial[i]));
+  }
+}
+
+TEST_F(GeometricFunctionsTest, reflect_and_refract_spans_match_single_calls) {
+  ExpectReflectRefractSpansMatch<dlm::vector::Vector2F>();
+  ExpectReflectRefractSpansMatch<dlm::vector::Vector3F>();
+  ExpectReflectRefractSpansMatch<dlm::vector::Vector4F>();
+  ExpectReflectRefractSpansMatch<dlm::vector::Vector3<double>>();
+}
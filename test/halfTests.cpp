@@ -0,0 +1,148 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "dlm/half.hpp"
+#include "dlm/vector3.hpp"
+#include "dlm/vector4.hpp"
+
+class HalfTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(HalfTest, converts_exact_values) {
+  ASSERT_EQ(dlm::Half{1.0f}.bits, 0x3C00);
+  ASSERT_EQ(dlm::Half{-2.0f}.bits, 0xC000);
+  ASSERT_EQ(dlm::Half{0.0f}.bits, 0x0000);
+  ASSERT_EQ(dlm::Half{-0.0f}.bits, 0x8000);
+  ASSERT_EQ(dlm::Half{65504.0f}.bits, 0x7BFF);
+  ASSERT_EQ(dlm::Half{std::ldexp(1.0f, -14)}.bits, 0x0400);
+  ASSERT_EQ(dlm::Half{std::ldexp(1.0f, -24)}.bits, 0x0001);
+}
+
+TEST_F(HalfTest, rounds_to_nearest_even) {
+  // Halfway between 1 and the next half rounds down to the even 1, halfway
+  // between the next two rounds up to the even one.
+  ASSERT_EQ(dlm::Half{1.0f + std::ldexp(1.0f, -11)}.bits, 0x3C00);
+  ASSERT_EQ(dlm::Half{1.0f + 3.0f * std::ldexp(1.0f, -11)}.bits, 0x3C02);
+  ASSERT_EQ(dlm::Half{std::ldexp(1.0f, -25)}.bits, 0x0000);
+  ASSERT_EQ(dlm::Half{3.0f * std::ldexp(1.0f, -25)}.bits, 0x0002);
+  ASSERT_EQ(dlm::Half{65519.0f}.bits, 0x7BFF);
+  ASSERT_EQ(dlm::Half{65520.0f}.bits, 0x7C00);
+}
+
+TEST_F(HalfTest, infinity_and_nan) {
+  ASSERT_EQ(dlm::Half{std::numeric_limits<float>::infinity()}.bits, 0x7C00);
+  ASSERT_EQ(dlm::Half{-1e10f}.bits, 0xFC00);
+  ASSERT_TRUE(std::isnan(static_cast<float>(
+      dlm::Half{std::numeric_limits<float>::quiet_NaN()})));
+  ASSERT_TRUE(std::isinf(static_cast<float>(dlm::Half::FromBits(0xFC00))));
+}
+
+TEST_F(HalfTest, every_half_round_trips_through_float) {
+  for (std::uint32_t bits = 0; bits <= 0xFFFF; ++bits) {
+    const dlm::Half half =
+        dlm::Half::FromBits(static_cast<std::uint16_t>(bits));
+    const float value = static_cast<float>(half);
+    if (std::isnan(value)) {
+      ASSERT_EQ(bits & 0x7C00, 0x7C00u);
+      continue;
+    }
+    ASSERT_EQ(dlm::Half{value}.bits, bits);
+  }
+}
+
+TEST_F(HalfTest, arithmetic_rounds_once) {
+  const dlm::Half a{1.5f};
+  const dlm::Half b{0.25f};
+
+  ASSERT_EQ(static_cast<float>(a + b), 1.75f);
+  ASSERT_EQ(static_cast<float>(a - b), 1.25f);
+  ASSERT_EQ(static_cast<float>(a * b), 0.375f);
+  ASSERT_EQ(static_cast<float>(a / b), 6.0f);
+  ASSERT_EQ(static_cast<float>(-a), -1.5f);
+  ASSERT_EQ(static_cast<float>(sqrt(dlm::Half{16.0f})), 4.0f);
+  // 1/3 rounded to half, not to float first.
+  ASSERT_EQ((dlm::Half{1.0f} / dlm::Half{3.0f}).bits,
+            dlm::Half{1.0f / 3.0f}.bits);
+  ASSERT_TRUE(dlm::Half{0.0f} == dlm::Half{-0.0f});
+  ASSERT_TRUE(b < a);
+}
+
+TEST_F(HalfTest, half_vectors) {
+  using Vector3H = dlm::vector::Vector3<dlm::Half>;
+  const Vector3H a =
+      dlm::vector::Convert<dlm::Half>(dlm::vector::Vector3F{1.0f, 2.0f, 2.0f});
+  const Vector3H b{dlm::Half{0.5f}, dlm::Half{0.5f}, dlm::Half{-1.0f}};
+
+  ASSERT_EQ(dlm::vector::Convert<float>(a + b),
+            (dlm::vector::Vector3F{1.5f, 2.5f, 1.0f}));
+  ASSERT_EQ(static_cast<float>(a | b), -0.5f);
+  ASSERT_EQ(static_cast<float>(a.Length()), 3.0f);
+  ASSERT_TRUE(Vector3H{}.IsZero());
+  static_assert(sizeof(Vector3H) == 6);
+}
+
+TEST_F(HalfTest, pack_matches_scalar_conversion) {
+  std::vector<dlm::vector::Vector4F> floats;
+  for (int i = 0; i < 37; ++i) {
+    const float f = static_cast<float>(i);
+    floats.push_back({f * 0.1f, -f * 1000.0f, std::ldexp(f, -20), 1.0f / f});
+  }
+  std::vector<dlm::vector::Vector4<dlm::Half>> halves(floats.size());
+  std::vector<dlm::vector::Vector4F> unpacked(floats.size());
+
+  dlm::vector::Pack(dlm::Span<const dlm::vector::Vector4F>{floats},
+                    dlm::Span<dlm::vector::Vector4<dlm::Half>>{halves});
+  dlm::vector::Unpack(
+      dlm::Span<const dlm::vector::Vector4<dlm::Half>>{halves},
+      dlm::Span<dlm::vector::Vector4F>{unpacked});
+
+  for (std::size_t i = 0; i < floats.size(); ++i) {
+    for (int c = 0; c < 4; ++c) {
+      const dlm::Half expected{floats[i][c]};
+      ASSERT_EQ(halves[i][c].bits, expected.bits);
+      ASSERT_EQ(unpacked[i][c], static_cast<float>(expected));
+    }
+  }
+}
+
+TEST_F(HalfTest, bulk_conversion_matches_scalar_conversion) {
+  std::vector<dlm::Half> halves(0x10000);
+  for (std::uint32_t bits = 0; bits <= 0xFFFF; ++bits) {
+    halves[bits] = dlm::Half::FromBits(static_cast<std::uint16_t>(bits));
+  }
+  std::vector<float> floats(halves.size());
+  dlm::ToFloat(dlm::Span<const dlm::Half>{halves}, dlm::Span<float>{floats});
+  for (std::size_t i = 0; i < halves.size(); ++i) {
+    const float expected = static_cast<float>(halves[i]);
+    ASSERT_EQ(std::memcmp(&floats[i], &expected, sizeof(float)), 0) << i;
+  }
+
+  // A sweep over the float bit patterns, covering every exponent with
+  // rounding ties, subnormal results, overflow and NaN.
+  floats.clear();
+  for (std::uint64_t bits = 0; bits <= 0xFFFFFFFF; bits += 4099) {
+    const std::uint32_t pattern = static_cast<std::uint32_t>(bits);
+    for (std::uint32_t low : {0x0000u, 0x1000u, 0x0FFFu, 0x3000u}) {
+      float value;
+      const std::uint32_t tie = (pattern & ~0x1FFFu) | low;
+      std::memcpy(&value, &tie, sizeof(value));
+      floats.push_back(value);
+    }
+  }
+  halves.resize(floats.size());
+  dlm::ToHalf(dlm::Span<const float>{floats}, dlm::Span<dlm::Half>{halves});
+  for (std::size_t i = 0; i < floats.size(); ++i) {
+    ASSERT_EQ(halves[i].bits, dlm::Half{floats[i]}.bits) << floats[i];
+  }
+}
@@ -0,0 +1,244 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "dlm/intersection.hpp"
+#include "testhelpers.hpp"
+
+namespace {
+using dlm::test::Random;
+using dlm::test::RandomVector;
+
+// Rays from a shell around the origin towards points near it, so about
+// half of them hit the primitives below.
+template <typename T>
+dlm::geometry::Ray<T> MakeRay(std::uint32_t& state) {
+  const auto origin = RandomVector<T>(state, -6, 6);
+  return {origin, RandomVector<T>(state, -2, 2) - origin};
+}
+
+template <typename T>
+void Make(std::uint32_t& state, dlm::geometry::Plane<T>& plane) {
+  plane = {RandomVector<T>(state, -1, 1), Random<T>(state, -2, 2)};
+}
+
+template <typename T>
+void Make(std::uint32_t& state, dlm::geometry::Sphere<T>& sphere) {
+  sphere = {RandomVector<T>(state, -3, 3), Random<T>(state, 0.5, 2)};
+}
+
+template <typename T>
+void Make(std::uint32_t& state, dlm::geometry::AABB3<T>& box) {
+  const auto corner = RandomVector<T>(state, -3, 3);
+  box = {corner, corner + RandomVector<T>(state, 0, 2)};
+}
+
+template <typename T>
+void Make(std::uint32_t& state, dlm::geometry::Triangle<T>& triangle) {
+  const auto a = RandomVector<T>(state, -3, 3);
+  triangle = {a, a + RandomVector<T>(state, -3, 3),
+              a + RandomVector<T>(state, -3, 3)};
+}
+
+template <typename T>
+void ExpectDistance(T actual, T expected, std::size_t i) {
+  if (expected == std::numeric_limits<T>::infinity()) {
+    ASSERT_EQ(actual, expected) << i;
+  } else {
+    ASSERT_NEAR(actual, expected, std::fabs(expected) * 1e-4f + 1e-4f) << i;
+  }
+}
+
+// Checks one ray against many primitives and many rays against one against
+// the single Intersect, for sizes with and without a partial packet and
+// word, and 13 for an eight, a four and a single pair.
+template <typename T, typename primitive_type>
+void ExpectBatchMatches() {
+  std::uint32_t state = 11;
+  for (std::size_t count : {0u, 3u, 4u, 13u, 64u, 130u}) {
+    std::vector<dlm::geometry::Ray<T>> rays;
+    std::vector<primitive_type> primitives(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      rays.push_back(MakeRay<T>(state));
+      Make(state, primitives[i]);
+    }
+    const dlm::geometry::Ray<T> ray = MakeRay<T>(state);
+    primitive_type primitive;
+    Make(state, primitive);
+
+    std::vector<T> to_primitives(count);
+    std::vector<T> from_rays(count);
+    std::vector<std::uint64_t> primitives_mask((count + 63) / 64,
+                                               ~std::uint64_t{0});
+    std::vector<std::uint64_t> rays_mask = primitives_mask;
+    dlm::geometry::Intersect(ray,
+                             dlm::Span<const primitive_type>{primitives},
+                             dlm::Span<T>{to_primitives},
+                             dlm::Span<std::uint64_t>{primitives_mask});
+    dlm::geometry::Intersect(dlm::Span<const dlm::geometry::Ray<T>>{rays},
+                             primitive, dlm::Span<T>{from_rays},
+                             dlm::Span<std::uint64_t>{rays_mask});
+
+    std::size_t hits = 0;
+    for (std::size_t i = 0; i < primitives_mask.size() * 64; ++i) {
+      const bool primitive_bit = ((primitives_mask[i / 64] >> (i % 64)) & 1u);
+      const bool ray_bit = ((rays_mask[i / 64] >> (i % 64)) & 1u);
+      if (i >= count) {
+        ASSERT_FALSE(primitive_bit || ray_bit) << i;
+        continue;
+      }
+      const T to_primitive = dlm::geometry::Intersect(ray, primitives[i]);
+      const T from_ray = dlm::geometry::Intersect(rays[i], primitive);
+      ExpectDistance(to_primitives[i], to_primitive, i);
+      ExpectDistance(from_rays[i], from_ray, i);
+      ASSERT_EQ(primitive_bit,
+                to_primitive < std::numeric_limits<T>::infinity())
+          << i;
+      ASSERT_EQ(ray_bit, from_ray < std::numeric_limits<T>::infinity()) << i;
+      hits += primitive_bit + ray_bit;
+    }
+    // Both outcomes are covered.
+    if (count >= 64) {
+      ASSERT_GT(hits, 0u);
+      ASSERT_LT(hits, 2 * count);
+    }
+  }
+}
+}  // namespace
+
+class IntersectionTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(IntersectionTest, ray_plane) {
+  constexpr dlm::geometry::PlaneF kPlane{{0.0f, 0.0f, 2.0f}, 4.0f};
+  constexpr dlm::geometry::RayF kDown{{1.0f, 1.0f, 5.0f}, {0.0f, 0.0f, -2.0f}};
+
+  static_assert(dlm::geometry::Intersect(kDown, kPlane) == 1.5f);
+  // From below and from behind.
+  static_assert(dlm::geometry::Intersect(
+                    dlm::geometry::RayF{{0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 1.0f}},
+                    kPlane) == 2.0f);
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::RayF{{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}},
+                kPlane),
+            std::numeric_limits<float>::infinity());
+  // Parallel, next to and in the plane.
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::RayF{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+                kPlane),
+            std::numeric_limits<float>::infinity());
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::RayF{{0.0f, 0.0f, 2.0f}, {1.0f, 0.0f, 0.0f}},
+                kPlane),
+            std::numeric_limits<float>::infinity());
+}
+
+TEST_F(IntersectionTest, ray_sphere) {
+  const dlm::geometry::Sphere<double> sphere{{0.0, 0.0, 4.0}, 1.0};
+
+  ASSERT_DOUBLE_EQ(dlm::geometry::Intersect(
+                       dlm::geometry::Ray<double>{{0.0, 0.0, 0.0},
+                                                  {0.0, 0.0, 2.0}},
+                       sphere),
+                   1.5);
+  // Starting inside hits the far side.
+  ASSERT_DOUBLE_EQ(dlm::geometry::Intersect(
+                       dlm::geometry::Ray<double>{{0.0, 0.0, 4.5},
+                                                  {0.0, 0.0, 1.0}},
+                       sphere),
+                   0.5);
+  // Tangent, behind and beside.
+  ASSERT_DOUBLE_EQ(dlm::geometry::Intersect(
+                       dlm::geometry::Ray<double>{{1.0, 0.0, 0.0},
+                                                  {0.0, 0.0, 1.0}},
+                       sphere),
+                   4.0);
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::Ray<double>{{0.0, 0.0, 0.0}, {0.0, 0.0, -1.0}},
+                sphere),
+            std::numeric_limits<double>::infinity());
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::Ray<double>{{1.5, 0.0, 0.0}, {0.0, 0.0, 1.0}},
+                sphere),
+            std::numeric_limits<double>::infinity());
+}
+
+TEST_F(IntersectionTest, ray_box) {
+  constexpr dlm::geometry::AABB3F kBox{{1.0f, 1.0f, 1.0f},
+                                       {2.0f, 3.0f, 4.0f}};
+
+  static_assert(dlm::geometry::Intersect(
+                    dlm::geometry::RayF{{0.0f, 0.0f, 0.0f},
+                                        {1.0f, 1.0f, 1.0f}},
+                    kBox) == 1.0f);
+  // Parallel to two axes, from inside, through and past the box.
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::RayF{{1.5f, 2.0f, 2.0f}, {0.0f, 0.0f, -1.0f}},
+                kBox),
+            0.0f);
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::RayF{{1.5f, 2.0f, 10.0f}, {0.0f, 0.0f, -2.0f}},
+                kBox),
+            3.0f);
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::RayF{{2.5f, 2.0f, 10.0f}, {0.0f, 0.0f, -2.0f}},
+                kBox),
+            std::numeric_limits<float>::infinity());
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::RayF{{0.0f, 0.0f, 0.0f}, {-1.0f, -1.0f, -1.0f}},
+                kBox),
+            std::numeric_limits<float>::infinity());
+  ASSERT_EQ(dlm::geometry::Intersect(dlm::geometry::RayF{{0.0f, 0.0f, 0.0f},
+                                                         {1.0f, 1.0f, 1.0f}},
+                                     dlm::geometry::AABB3F{}),
+            std::numeric_limits<float>::infinity());
+}
+
+TEST_F(IntersectionTest, ray_triangle) {
+  constexpr dlm::geometry::TriangleF kTriangle{
+      {0.0f, 0.0f, 2.0f}, {4.0f, 0.0f, 2.0f}, {0.0f, 4.0f, 2.0f}};
+
+  static_assert(dlm::geometry::Intersect(
+                    dlm::geometry::RayF{{1.0f, 1.0f, 0.0f},
+                                        {0.0f, 0.0f, 1.0f}},
+                    kTriangle) == 2.0f);
+  // Either side, on an edge, outside the edge and parallel.
+  static_assert(dlm::geometry::Intersect(
+                    dlm::geometry::RayF{{1.0f, 1.0f, 3.0f},
+                                        {0.0f, 0.0f, -0.5f}},
+                    kTriangle) == 2.0f);
+  static_assert(dlm::geometry::Intersect(
+                    dlm::geometry::RayF{{2.0f, 2.0f, 0.0f},
+                                        {0.0f, 0.0f, 1.0f}},
+                    kTriangle) == 2.0f);
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::RayF{{2.5f, 2.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+                kTriangle),
+            std::numeric_limits<float>::infinity());
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::RayF{{1.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+                kTriangle),
+            std::numeric_limits<float>::infinity());
+  ASSERT_EQ(dlm::geometry::Intersect(
+                dlm::geometry::RayF{{1.0f, 1.0f, 3.0f}, {0.0f, 0.0f, 1.0f}},
+                kTriangle),
+            std::numeric_limits<float>::infinity());
+}
+
+TEST_F(IntersectionTest, batches_match_single_calls) {
+  ExpectBatchMatches<float, dlm::geometry::PlaneF>();
+  ExpectBatchMatches<float, dlm::geometry::SphereF>();
+  ExpectBatchMatches<float, dlm::geometry::AABB3F>();
+  ExpectBatchMatches<float, dlm::geometry::TriangleF>();
+  ExpectBatchMatches<double, dlm::geometry::Sphere<double>>();
+  ExpectBatchMatches<double, dlm::geometry::Triangle<double>>();
+}
@@ -0,0 +1,137 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <limits>
+#include <vector>
+
+#include "dlm/kdtree.hpp"
+#include "testhelpers.hpp"
+
+namespace {
+using dlm::test::MakePoints;
+
+// Binds the points to a tree so it answers the single queries the way
+// SpatialHash does.
+template <std::size_t N>
+struct BoundTree {
+  void Within(const dlm::vector::Vector<N, float>& point, float radius,
+              std::vector<std::size_t>& out) const {
+    tree.Within(points, point, radius, out);
+  }
+
+  std::size_t KNearest(const dlm::vector::Vector<N, float>& point,
+                       dlm::Span<std::size_t> out) const {
+    return tree.KNearest(points, point, out);
+  }
+
+  const dlm::geometry::KDTree<N, float>& tree;
+  dlm::Span<const dlm::vector::Vector<N, float>> points;
+};
+
+// Compares Within, KNearest and the batched KNearest with testing every
+// point.
+template <std::size_t N>
+void ExpectQueriesMatchBruteForce(
+    const dlm::geometry::KDTree<N, float>& tree,
+    const std::vector<dlm::vector::Vector<N, float>>& points) {
+  const dlm::Span<const dlm::vector::Vector<N, float>> span{points};
+  dlm::test::ExpectQueriesMatchBruteForce(BoundTree<N>{tree, span}, points);
+
+  const auto queries = MakePoints<N>(200, 11);
+  constexpr std::size_t kK = 5;
+  std::vector<std::size_t> batch(queries.size() * kK);
+  tree.KNearest(span, dlm::Span<const dlm::vector::Vector<N, float>>{queries},
+                kK, dlm::Span<std::size_t>{batch}, 3);
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    std::size_t expected[kK];
+    const std::size_t count = dlm::vector::KNearest(
+        span, queries[q], dlm::Span<std::size_t>{expected});
+    for (std::size_t i = 0; i < kK; ++i) {
+      ASSERT_EQ(batch[q * kK + i], i < count ? expected[i] : points.size());
+    }
+  }
+}
+}  // namespace
+
+class KDTreeTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(KDTreeTest, empty_and_small) {
+  const std::vector<dlm::vector::Vector3F> none;
+  const dlm::Span<const dlm::vector::Vector3F> empty{none};
+  const dlm::geometry::KDTree3F tree{empty};
+  std::vector<std::size_t> found{1, 2, 3};
+  std::size_t nearest[2];
+
+  tree.Within(empty, {0.0f, 0.0f, 0.0f}, 5.0f, found);
+  ASSERT_TRUE(found.empty());
+  ASSERT_EQ(
+      tree.KNearest(empty, {0.0f, 0.0f, 0.0f}, dlm::Span<std::size_t>{nearest}),
+      0u);
+
+  // Fewer points than a leaf holds and fewer than asked for.
+  const auto points = MakePoints<3>(5, 1);
+  const dlm::geometry::KDTree3F small{
+      dlm::Span<const dlm::vector::Vector3F>{points}};
+  ExpectQueriesMatchBruteForce(small, points);
+}
+
+TEST_F(KDTreeTest, vector3_queries_match_brute_force) {
+  const auto points = MakePoints<3>(5000, 2);
+  const dlm::geometry::KDTree3F tree{
+      dlm::Span<const dlm::vector::Vector3F>{points}, 1};
+
+  ExpectQueriesMatchBruteForce(tree, points);
+}
+
+TEST_F(KDTreeTest, vector2_queries_match_brute_force) {
+  const auto points = MakePoints<2>(4000, 3);
+  const dlm::geometry::KDTree2F tree{
+      dlm::Span<const dlm::vector::Vector2F>{points}};
+
+  ExpectQueriesMatchBruteForce(tree, points);
+}
+
+TEST_F(KDTreeTest, nan_points_are_never_found) {
+  constexpr float kNaN = std::numeric_limits<float>::quiet_NaN();
+  auto points = MakePoints<3>(1000, 4);
+  for (std::size_t i = 0; i < points.size(); i += 37) {
+    points[i].y = kNaN;
+  }
+  const dlm::geometry::KDTree3F tree{
+      dlm::Span<const dlm::vector::Vector3F>{points}};
+
+  ExpectQueriesMatchBruteForce(tree, points);
+}
+
+TEST_F(KDTreeTest, threaded_build_and_queries_are_identical) {
+  const auto points = MakePoints<3>(60000, 5);
+  const dlm::Span<const dlm::vector::Vector3F> span{points};
+  const dlm::geometry::KDTree3F serial{span, 1};
+  const dlm::geometry::KDTree3F threaded{span, 4};
+
+  ASSERT_EQ(serial.Indices().size(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_EQ(serial.Indices()[i], threaded.Indices()[i]);
+  }
+
+  constexpr std::size_t kK = 3;
+  const auto queries = MakePoints<3>(3000, 6);
+  std::vector<std::size_t> batch(queries.size() * kK);
+  threaded.KNearest(span, dlm::Span<const dlm::vector::Vector3F>{queries}, kK,
+                    dlm::Span<std::size_t>{batch}, 4);
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    std::size_t nearest[kK];
+    ASSERT_EQ(
+        serial.KNearest(span, queries[q], dlm::Span<std::size_t>{nearest}),
+        kK);
+    for (std::size_t i = 0; i < kK; ++i) {
+      ASSERT_EQ(batch[q * kK + i], nearest[i]);
+    }
+  }
+}
@@ -2,6 +2,9 @@
 #include "gtest/gtest.h"
 // clang-format on
 
+#include <cstring>
+#include <vector>
+
 #include "dlm/matrix2x2.hpp"
 
 class Matrix2x2Test : public ::testing::Test {
@@ -31,6 +34,18 @@ TEST_F(Matrix2x2Test, movable) {
   ASSERT_EQ(moved_matrix[1][1], 4.0f);
 }
 
+TEST_F(Matrix2x2Test, trivially_copyable_round_trips_through_memcpy) {
+  const dlm::matrix::Matrix2x2F new_matrix{1.0f, 2.0f, 3.0f, 4.0f};
+
+  dlm::matrix::Matrix2x2F copied_matrix{};
+  std::memcpy(&copied_matrix, &new_matrix, sizeof(new_matrix));
+
+  ASSERT_EQ(copied_matrix[0][0], 1.0f);
+  ASSERT_EQ(copied_matrix[0][1], 2.0f);
+  ASSERT_EQ(copied_matrix[1][0], 3.0f);
+  ASSERT_EQ(copied_matrix[1][1], 4.0f);
+}
+
 TEST_F(Matrix2x2Test, minus_scalar) {
   const dlm::matrix::Matrix2x2F new_matrix{2.0f, 2.0f, 2.0f, 2.0f};
   const dlm::matrix::Matrix2x2F negated_matrix = new_matrix - 2.0f;
@@ -40,3 +55,136 @@ TEST_F(Matrix2x2Test, minus_scalar) {
   ASSERT_EQ(negated_matrix[1][0], 0.0f);
   ASSERT_EQ(negated_matrix[1][1], 0.0f);
 }
+
+TEST_F(Matrix2x2Test, constexpr_rotation_table_folds_at_compile_time) {
+  constexpr dlm::matrix::Matrix2x2F kRotations[] = {
+      {1.0f, 0.0f, 0.0f, 1.0f},
+      {0.0f, -1.0f, 1.0f, 0.0f},
+      {-1.0f, 0.0f, 0.0f, -1.0f},
+      {0.0f, 1.0f, -1.0f, 0.0f}};
+
+  static_assert(kRotations[1][0][1] == -1.0f);
+  static_assert((kRotations[0] + kRotations[2])[0].IsZero());
+  static_assert((kRotations[1] - 1.0f)[1][0] == 0.0f);
+  static_assert(dlm::matrix::Matrix2x2F{}[1][1] == 1.0f);
+  ASSERT_EQ(kRotations[3][1][0], -1.0f);
+}
+
+TEST_F(Matrix2x2Test, multiply_matrix) {
+  const dlm::matrix::Matrix2x2F a{1.0f, 2.0f, 3.0f, 4.0f};
+  const dlm::matrix::Matrix2x2F b{5.0f, 6.0f, 7.0f, 8.0f};
+  const dlm::matrix::Matrix2x2F product = a * b;
+
+  ASSERT_EQ(product[0][0], 19.0f);
+  ASSERT_EQ(product[0][1], 22.0f);
+  ASSERT_EQ(product[1][0], 43.0f);
+  ASSERT_EQ(product[1][1], 50.0f);
+}
+
+TEST_F(Matrix2x2Test, multiply_matrix_assign) {
+  dlm::matrix::Matrix2x2F a{1.0f, 2.0f, 3.0f, 4.0f};
+  a *= dlm::matrix::Matrix2x2F{};
+
+  ASSERT_EQ(a[0][0], 1.0f);
+  ASSERT_EQ(a[0][1], 2.0f);
+  ASSERT_EQ(a[1][0], 3.0f);
+  ASSERT_EQ(a[1][1], 4.0f);
+}
+
+TEST_F(Matrix2x2Test, multiply_vector) {
+  const dlm::matrix::Matrix2x2F rotate_90{0.0f, -1.0f, 1.0f, 0.0f};
+  const dlm::vector::Vector2F rotated =
+      rotate_90 * dlm::vector::Vector2F{1.0f, 0.0f};
+
+  ASSERT_EQ(rotated.x, 0.0f);
+  ASSERT_EQ(rotated.y, 1.0f);
+}
+
+TEST_F(Matrix2x2Test, transpose) {
+  const dlm::matrix::Matrix2x2F transposed =
+      dlm::matrix::Matrix2x2F{1.0f, 2.0f, 3.0f, 4.0f}.Transpose();
+
+  ASSERT_EQ(transposed[0][0], 1.0f);
+  ASSERT_EQ(transposed[0][1], 3.0f);
+  ASSERT_EQ(transposed[1][0], 2.0f);
+  ASSERT_EQ(transposed[1][1], 4.0f);
+}
+
+TEST_F(Matrix2x2Test, determinant) {
+  const dlm::matrix::Matrix2x2F new_matrix{1.0f, 2.0f, 3.0f, 4.0f};
+
+  ASSERT_EQ(new_matrix.Determinant(), -2.0f);
+}
+
+TEST_F(Matrix2x2Test, inverse_times_matrix_is_identity) {
+  const dlm::matrix::Matrix2x2F new_matrix{4.0f, 7.0f, 2.0f, 6.0f};
+  const dlm::matrix::Matrix2x2F identity = new_matrix.Inverse() * new_matrix;
+
+  ASSERT_FLOAT_EQ(identity[0][0], 1.0f);
+  ASSERT_NEAR(identity[0][1], 0.0f, 1e-6f);
+  ASSERT_NEAR(identity[1][0], 0.0f, 1e-6f);
+  ASSERT_FLOAT_EQ(identity[1][1], 1.0f);
+}
+
+TEST_F(Matrix2x2Test, try_inverse_rejects_singular_matrix) {
+  const dlm::matrix::Matrix2x2F singular{1.0f, 2.0f, 2.0f, 4.0f};
+  dlm::matrix::Matrix2x2F inverse{};
+
+  ASSERT_FALSE(singular.TryInverse(inverse));
+  ASSERT_EQ(inverse[0][0], 1.0f);
+  ASSERT_EQ(inverse[1][1], 1.0f);
+
+  const dlm::matrix::Matrix2x2F scale{2.0f, 0.0f, 0.0f, 4.0f};
+  ASSERT_TRUE(scale.TryInverse(inverse, 1e-6f));
+  ASSERT_EQ(inverse[0][0], 0.5f);
+  ASSERT_EQ(inverse[1][1], 0.25f);
+}
+
+TEST_F(Matrix2x2Test, transform_span_matches_single_multiply) {
+  const dlm::matrix::Matrix2x2F m{1.0f, 2.0f, -3.0f, 0.5f};
+  std::vector<dlm::vector::Vector2F> points;
+  for (int i = 0; i < 7; ++i) {
+    points.push_back({static_cast<float>(i), static_cast<float>(2 - i)});
+  }
+  std::vector<dlm::vector::Vector2F> transformed(points.size());
+
+  dlm::matrix::Transform(m, dlm::Span<const dlm::vector::Vector2F>{points},
+                         dlm::Span<dlm::vector::Vector2F>{transformed});
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_EQ(transformed[i], m * points[i]);
+  }
+}
+
+TEST_F(Matrix2x2Test, transform_odd_span_rounds_every_point_alike) {
+  const dlm::matrix::Matrix2x2F m{0.1f, 0.7f, -0.3f, 1.9f};
+  const dlm::vector::Vector2F point{1.3f, -2.7f};
+  // The last point is transformed alone, the first two as a pair.
+  const std::vector<dlm::vector::Vector2F> points(3, point);
+  std::vector<dlm::vector::Vector2F> transformed(points.size());
+
+  dlm::matrix::Transform(m, dlm::Span<const dlm::vector::Vector2F>{points},
+                         dlm::Span<dlm::vector::Vector2F>{transformed});
+  dlm::matrix::Transform(m, dlm::Span<const dlm::vector::Vector2F>{},
+                         dlm::Span<dlm::vector::Vector2F>{});
+
+  ASSERT_EQ(transformed[2], transformed[0]);
+  ASSERT_EQ(transformed[1], transformed[0]);
+}
+
+TEST_F(Matrix2x2Test, only_float_is_over_aligned) {
+  static_assert(alignof(dlm::matrix::Matrix2x2F) == 16);
+  static_assert(alignof(dlm::matrix::Matrix2x2<double>) == alignof(double));
+  static_assert(alignof(dlm::matrix::Matrix2x2<int>) == alignof(int));
+}
+
+TEST_F(Matrix2x2Test, constexpr_products_fold_at_compile_time) {
+  constexpr dlm::matrix::Matrix2x2F kRotate90{0.0f, -1.0f, 1.0f, 0.0f};
+  constexpr dlm::matrix::Matrix2x2F kRotate180 = kRotate90 * kRotate90;
+
+  static_assert(kRotate180[0][0] == -1.0f);
+  static_assert(kRotate90.Determinant() == 1.0f);
+  static_assert(kRotate90.Inverse()[0][1] == 1.0f);
+  static_assert(kRotate90.Transpose()[1][0] == -1.0f);
+  ASSERT_EQ(kRotate180[1][1], -1.0f);
+}
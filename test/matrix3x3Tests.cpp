@@ -0,0 +1,128 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cstring>
+
+#include "dlm/matrix3x3.hpp"
+
+class Matrix3x3Test : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(Matrix3x3Test, default_constructor_generate_identity) {
+  const dlm::matrix::Matrix3x3F new_matrix{};
+
+  for (int row = 0; row < 3; ++row) {
+    for (int column = 0; column < 3; ++column) {
+      ASSERT_EQ(new_matrix[row][column], row == column ? 1.0f : 0.0f);
+    }
+  }
+}
+
+TEST_F(Matrix3x3Test, trivially_copyable_round_trips_through_memcpy) {
+  const dlm::matrix::Matrix3x3F new_matrix{1.0f, 2.0f, 3.0f, 4.0f, 5.0f,
+                                           6.0f, 7.0f, 8.0f, 9.0f};
+
+  dlm::matrix::Matrix3x3F copied_matrix{};
+  std::memcpy(&copied_matrix, &new_matrix, sizeof(new_matrix));
+
+  ASSERT_EQ(copied_matrix[0][0], 1.0f);
+  ASSERT_EQ(copied_matrix[1][1], 5.0f);
+  ASSERT_EQ(copied_matrix[2][2], 9.0f);
+}
+
+TEST_F(Matrix3x3Test, add_and_subtract_matrix) {
+  const dlm::matrix::Matrix3x3F a{1.0f, 2.0f, 3.0f, 4.0f, 5.0f,
+                                  6.0f, 7.0f, 8.0f, 9.0f};
+  dlm::matrix::Matrix3x3F sum = a + a;
+  sum -= a;
+
+  ASSERT_EQ(sum[0][2], 3.0f);
+  ASSERT_EQ(sum[2][0], 7.0f);
+  ASSERT_EQ((a - 1.0f)[1][1], 4.0f);
+}
+
+TEST_F(Matrix3x3Test, multiply_matrix) {
+  const dlm::matrix::Matrix3x3F a{1.0f, 2.0f, 3.0f, 4.0f, 5.0f,
+                                  6.0f, 7.0f, 8.0f, 9.0f};
+  const dlm::matrix::Matrix3x3F b{9.0f, 8.0f, 7.0f, 6.0f, 5.0f,
+                                  4.0f, 3.0f, 2.0f, 1.0f};
+  const dlm::matrix::Matrix3x3F product = a * b;
+
+  ASSERT_EQ(product[0][0], 30.0f);
+  ASSERT_EQ(product[0][1], 24.0f);
+  ASSERT_EQ(product[0][2], 18.0f);
+  ASSERT_EQ(product[1][0], 84.0f);
+  ASSERT_EQ(product[2][2], 90.0f);
+}
+
+TEST_F(Matrix3x3Test, multiply_vector) {
+  const dlm::matrix::Matrix3x3F rotate_z{0.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+                                         0.0f, 0.0f,  0.0f, 1.0f};
+  const dlm::vector::Vector3F rotated =
+      rotate_z * dlm::vector::Vector3F{1.0f, 0.0f, 2.0f};
+
+  ASSERT_EQ(rotated, (dlm::vector::Vector3F{0.0f, 1.0f, 2.0f}));
+}
+
+TEST_F(Matrix3x3Test, transpose) {
+  const dlm::matrix::Matrix3x3F transposed =
+      dlm::matrix::Matrix3x3F{1.0f, 2.0f, 3.0f, 4.0f, 5.0f,
+                              6.0f, 7.0f, 8.0f, 9.0f}
+          .Transpose();
+
+  ASSERT_EQ(transposed[0][1], 4.0f);
+  ASSERT_EQ(transposed[1][0], 2.0f);
+  ASSERT_EQ(transposed[2][0], 3.0f);
+}
+
+TEST_F(Matrix3x3Test, determinant) {
+  const dlm::matrix::Matrix3x3F new_matrix{2.0f, 0.0f, 1.0f, 1.0f, 3.0f,
+                                           2.0f, 1.0f, 1.0f, 2.0f};
+
+  ASSERT_EQ(new_matrix.Determinant(), 6.0f);
+}
+
+TEST_F(Matrix3x3Test, inverse_times_matrix_is_identity) {
+  const dlm::matrix::Matrix3x3F new_matrix{2.0f, 0.0f, 1.0f, 1.0f, 3.0f,
+                                           2.0f, 1.0f, 1.0f, 2.0f};
+  const dlm::matrix::Matrix3x3F identity = new_matrix.Inverse() * new_matrix;
+
+  for (int row = 0; row < 3; ++row) {
+    for (int column = 0; column < 3; ++column) {
+      ASSERT_NEAR(identity[row][column], row == column ? 1.0f : 0.0f, 1e-6f);
+    }
+  }
+}
+
+TEST_F(Matrix3x3Test, try_inverse_rejects_singular_matrix) {
+  const dlm::matrix::Matrix3x3F singular{1.0f, 2.0f, 3.0f, 4.0f, 5.0f,
+                                         6.0f, 7.0f, 8.0f, 9.0f};
+  dlm::matrix::Matrix3x3F inverse{};
+
+  ASSERT_FALSE(singular.TryInverse(inverse));
+  ASSERT_EQ(inverse[0][0], 1.0f);
+
+  const dlm::matrix::Matrix3x3F scale{2.0f, 0.0f, 0.0f, 0.0f, 4.0f,
+                                      0.0f, 0.0f, 0.0f, 8.0f};
+  ASSERT_TRUE(scale.TryInverse(inverse, 1e-6f));
+  ASSERT_EQ(inverse[0][0], 0.5f);
+  ASSERT_EQ(inverse[1][1], 0.25f);
+  ASSERT_EQ(inverse[2][2], 0.125f);
+}
+
+TEST_F(Matrix3x3Test, constexpr_products_fold_at_compile_time) {
+  constexpr dlm::matrix::Matrix3x3F kRotateZ{0.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+                                             0.0f, 0.0f,  0.0f, 1.0f};
+  constexpr dlm::matrix::Matrix3x3F kRotate180 = kRotateZ * kRotateZ;
+
+  static_assert(kRotate180[0][0] == -1.0f);
+  static_assert(kRotateZ.Determinant() == 1.0f);
+  static_assert(kRotateZ.Inverse()[0][1] == 1.0f);
+  static_assert(kRotateZ.Transpose()[1][0] == -1.0f);
+  ASSERT_EQ(kRotate180[2][2], 1.0f);
+}
@@ -0,0 +1,211 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cstring>
+#include <vector>
+
+#include "dlm/matrix4x4.hpp"
+
+namespace {
+// Rotation of 90 degrees around z followed by a translation.
+constexpr dlm::matrix::Matrix4x4F kAffine{0.0f, -1.0f, 0.0f, 3.0f,  //
+                                          1.0f, 0.0f,  0.0f, -2.0f,  //
+                                          0.0f, 0.0f,  2.0f, 1.0f,   //
+                                          0.0f, 0.0f,  0.0f, 1.0f};
+
+constexpr dlm::matrix::Matrix4x4F kGeneral{1.0f, 2.0f, 0.0f, 1.0f,   //
+                                           0.0f, 1.0f, 3.0f, 0.0f,   //
+                                           2.0f, 0.0f, 1.0f, 4.0f,   //
+                                           1.0f, 1.0f, 0.0f, 2.0f};
+
+void ExpectNear(const dlm::matrix::Matrix4x4F& a,
+                const dlm::matrix::Matrix4x4F& b) {
+  for (int row = 0; row < 4; ++row) {
+    for (int column = 0; column < 4; ++column) {
+      EXPECT_NEAR(a[row][column], b[row][column], 1e-5f)
+          << "row " << row << " column " << column;
+    }
+  }
+}
+}  // namespace
+
+class Matrix4x4Test : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(Matrix4x4Test, default_constructor_generate_identity) {
+  const dlm::matrix::Matrix4x4F new_matrix{};
+
+  for (int row = 0; row < 4; ++row) {
+    for (int column = 0; column < 4; ++column) {
+      ASSERT_EQ(new_matrix[row][column], row == column ? 1.0f : 0.0f);
+    }
+  }
+}
+
+TEST_F(Matrix4x4Test, trivially_copyable_round_trips_through_memcpy) {
+  dlm::matrix::Matrix4x4F copied_matrix{};
+  std::memcpy(&copied_matrix, &kGeneral, sizeof(kGeneral));
+
+  ASSERT_EQ(copied_matrix[0][1], 2.0f);
+  ASSERT_EQ(copied_matrix[2][3], 4.0f);
+  ASSERT_EQ(copied_matrix[3][3], 2.0f);
+}
+
+TEST_F(Matrix4x4Test, add_and_subtract_matrix) {
+  dlm::matrix::Matrix4x4F sum = kGeneral + kGeneral;
+  sum -= kGeneral;
+
+  ExpectNear(sum, kGeneral);
+  ASSERT_EQ((kGeneral - 1.0f)[0][0], 0.0f);
+  ASSERT_EQ((kGeneral * 2.0f)[2][3], 8.0f);
+}
+
+TEST_F(Matrix4x4Test, multiply_matrix) {
+  const dlm::matrix::Matrix4x4F product = kGeneral * kAffine;
+
+  ASSERT_EQ(product[0][0], 2.0f);
+  ASSERT_EQ(product[0][1], -1.0f);
+  ASSERT_EQ(product[0][2], 0.0f);
+  ASSERT_EQ(product[0][3], 0.0f);
+  ASSERT_EQ(product[1][2], 6.0f);
+  ASSERT_EQ(product[2][3], 11.0f);
+  ASSERT_EQ(product[3][0], 1.0f);
+  ASSERT_EQ(product[3][3], 3.0f);
+}
+
+TEST_F(Matrix4x4Test, multiply_identity_is_unchanged) {
+  dlm::matrix::Matrix4x4F product = kGeneral;
+  product *= dlm::matrix::Matrix4x4F{};
+
+  ExpectNear(product, kGeneral);
+}
+
+TEST_F(Matrix4x4Test, multiply_vector) {
+  const dlm::vector::Vector4F transformed =
+      kAffine * dlm::vector::Vector4F{1.0f, 0.0f, 1.0f, 1.0f};
+
+  ASSERT_EQ(transformed, (dlm::vector::Vector4F{3.0f, -1.0f, 3.0f, 1.0f}));
+}
+
+TEST_F(Matrix4x4Test, transpose) {
+  const dlm::matrix::Matrix4x4F transposed = kGeneral.Transpose();
+
+  for (int row = 0; row < 4; ++row) {
+    for (int column = 0; column < 4; ++column) {
+      ASSERT_EQ(transposed[row][column], kGeneral[column][row]);
+    }
+  }
+}
+
+TEST_F(Matrix4x4Test, determinant) {
+  ASSERT_FLOAT_EQ(kGeneral.Determinant(), 7.0f);
+  ASSERT_FLOAT_EQ(kAffine.Determinant(), 2.0f);
+}
+
+TEST_F(Matrix4x4Test, inverse_times_matrix_is_identity) {
+  ExpectNear(kGeneral.Inverse() * kGeneral, dlm::matrix::Matrix4x4F{});
+  ExpectNear(kGeneral * kGeneral.Inverse(), dlm::matrix::Matrix4x4F{});
+}
+
+TEST_F(Matrix4x4Test, try_inverse_rejects_singular_matrix) {
+  const dlm::matrix::Matrix4x4F singular{1.0f, 2.0f, 3.0f, 4.0f,  //
+                                         2.0f, 4.0f, 6.0f, 8.0f,  //
+                                         0.0f, 1.0f, 0.0f, 1.0f,  //
+                                         1.0f, 0.0f, 1.0f, 0.0f};
+  dlm::matrix::Matrix4x4F inverse{};
+
+  ASSERT_FALSE(singular.TryInverse(inverse));
+  ASSERT_EQ(inverse[0][0], 1.0f);
+
+  ASSERT_TRUE(kGeneral.TryInverse(inverse, 1e-6f));
+  ExpectNear(inverse, kGeneral.Inverse());
+}
+
+TEST_F(Matrix4x4Test, is_affine) {
+  ASSERT_TRUE(kAffine.IsAffine());
+  ASSERT_TRUE(dlm::matrix::Matrix4x4F{}.IsAffine());
+  ASSERT_FALSE(kGeneral.IsAffine());
+}
+
+TEST_F(Matrix4x4Test, multiply_affine_matches_full_multiply) {
+  const dlm::matrix::Matrix4x4F scale_translate{2.0f, 0.0f, 0.0f, 1.0f,  //
+                                                0.0f, 3.0f, 0.0f, 2.0f,  //
+                                                0.0f, 0.0f, 4.0f, 3.0f,  //
+                                                0.0f, 0.0f, 0.0f, 1.0f};
+
+  ExpectNear(kAffine.MultiplyAffine(scale_translate),
+             kAffine * scale_translate);
+  ExpectNear(scale_translate.MultiplyAffine(kAffine),
+             scale_translate * kAffine);
+}
+
+TEST_F(Matrix4x4Test, inverse_affine_matches_full_inverse) {
+  ExpectNear(kAffine.InverseAffine(), kAffine.Inverse());
+  ExpectNear(kAffine.MultiplyAffine(kAffine.InverseAffine()),
+             dlm::matrix::Matrix4x4F{});
+}
+
+TEST_F(Matrix4x4Test, linear_and_translation) {
+  const dlm::matrix::Matrix3x3F linear = kAffine.Linear();
+
+  ASSERT_EQ(linear[0][1], -1.0f);
+  ASSERT_EQ(linear[2][2], 2.0f);
+  ASSERT_EQ(kAffine.Translation(),
+            (dlm::vector::Vector3F{3.0f, -2.0f, 1.0f}));
+}
+
+TEST_F(Matrix4x4Test, transform_span_matches_single_multiply) {
+  std::vector<dlm::vector::Vector4F> points;
+  for (int i = 0; i < 7; ++i) {
+    points.push_back({static_cast<float>(i), static_cast<float>(2 - i),
+                      static_cast<float>(i * i), 1.0f});
+  }
+  std::vector<dlm::vector::Vector4F> transformed(points.size());
+
+  dlm::matrix::Transform(kGeneral,
+                         dlm::Span<const dlm::vector::Vector4F>{points},
+                         dlm::Span<dlm::vector::Vector4F>{transformed});
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const dlm::vector::Vector4F expected = kGeneral * points[i];
+    for (int component = 0; component < 4; ++component) {
+      ASSERT_FLOAT_EQ(transformed[i][component], expected[component]);
+    }
+  }
+}
+
+TEST_F(Matrix4x4Test, transform_affine_span_keeps_w) {
+  std::vector<dlm::vector::Vector4F> points;
+  for (int i = 0; i < 7; ++i) {
+    points.push_back({static_cast<float>(i), static_cast<float>(2 - i),
+                      static_cast<float>(i * i), i % 2 ? 1.0f : 0.0f});
+  }
+  std::vector<dlm::vector::Vector4F> transformed(points.size());
+
+  dlm::matrix::TransformAffine(kAffine,
+                               dlm::Span<const dlm::vector::Vector4F>{points},
+                               dlm::Span<dlm::vector::Vector4F>{transformed});
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const dlm::vector::Vector4F expected = kAffine * points[i];
+    for (int component = 0; component < 4; ++component) {
+      ASSERT_FLOAT_EQ(transformed[i][component], expected[component]);
+    }
+  }
+}
+
+TEST_F(Matrix4x4Test, constexpr_products_fold_at_compile_time) {
+  constexpr dlm::matrix::Matrix4x4F kSquared = kAffine * kAffine;
+
+  static_assert(kSquared[0][0] == -1.0f);
+  static_assert(kAffine.Determinant() == 2.0f);
+  static_assert(kAffine.IsAffine());
+  static_assert(kAffine.Transpose()[3][0] == 3.0f);
+  static_assert(kAffine.InverseAffine()[2][2] == 0.5f);
+  ASSERT_EQ(kSquared[3][3], 1.0f);
+}
@@ -0,0 +1,133 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cmath>
+#include <vector>
+
+#include "dlm/muladd.hpp"
+
+class MulAddTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(MulAddTest, scalar) {
+  ASSERT_EQ(dlm::vector::MulAdd(2.0f, 3.0f, 1.0f), 7.0f);
+  ASSERT_EQ(dlm::vector::MulSub(2.0f, 3.0f, 1.0f), 5.0f);
+  ASSERT_EQ(dlm::vector::NegMulAdd(2.0f, 3.0f, 1.0f), -5.0f);
+  ASSERT_EQ(dlm::vector::MulAdd(2, 3, 1), 7);
+}
+
+TEST_F(MulAddTest, every_vector_width) {
+  const dlm::vector::Vector2F a2{1.0f, 2.0f};
+  const dlm::vector::Vector3<double> a3{1.0, 2.0, 3.0};
+  const dlm::vector::Vector4F a4{1.0f, 2.0f, 3.0f, 4.0f};
+  const dlm::vector::Vector4<double> a4d{1.0, 2.0, 3.0, 4.0};
+
+  ASSERT_EQ(dlm::vector::MulAdd(a2, a2, a2),
+            (dlm::vector::Vector2F{2.0f, 6.0f}));
+  ASSERT_EQ(dlm::vector::MulSub(a3, 2.0, a3),
+            (dlm::vector::Vector3<double>{1.0, 2.0, 3.0}));
+  ASSERT_EQ(dlm::vector::NegMulAdd(a4, a4, a4),
+            (dlm::vector::Vector4F{0.0f, -2.0f, -6.0f, -12.0f}));
+  ASSERT_EQ(dlm::vector::MulAdd(a4, 0.5f, a4),
+            (dlm::vector::Vector4F{1.5f, 3.0f, 4.5f, 6.0f}));
+  ASSERT_EQ(dlm::vector::MulSub(a4d, a4d, a4d),
+            (dlm::vector::Vector4<double>{0.0, 2.0, 6.0, 12.0}));
+}
+
+TEST_F(MulAddTest, rounds_once_when_fma_is_available) {
+  // (1 + 2^-12)^2 = 1 + 2^-11 + 2^-24, the last term is lost when the
+  // product is rounded before the addition.
+  const float e = 1.0f + std::ldexp(1.0f, -12);
+  const float c = -(1.0f + std::ldexp(1.0f, -11));
+  const dlm::vector::Vector4F a{e, e, e, e};
+
+  const dlm::vector::Vector4F result =
+      dlm::vector::MulAdd(a, a, dlm::vector::Vector4F{c, c, c, c});
+  const dlm::vector::Vector3F result3 =
+      dlm::vector::MulSub(dlm::vector::Vector3F{e, e, e}, e,
+                          dlm::vector::Vector3F{-c, -c, -c});
+
+#if defined(DLM_FMA)
+  ASSERT_EQ(result.w, std::ldexp(1.0f, -24));
+  ASSERT_EQ(result3.z, std::ldexp(1.0f, -24));
+#else
+  ASSERT_EQ(result.w, e * e + c);
+  ASSERT_EQ(result3.z, e * e + c);
+#endif
+}
+
+TEST_F(MulAddTest, matrix2x2) {
+  const dlm::matrix::Matrix2x2F a{1.0f, 2.0f, 3.0f, 4.0f};
+  const dlm::matrix::Matrix2x2F c{1.0f, 1.0f, 1.0f, 1.0f};
+
+  const dlm::matrix::Matrix2x2F result = dlm::matrix::MulAdd(a, a, c);
+  const dlm::matrix::Matrix2x2F scaled = dlm::matrix::NegMulAdd(a, 2.0f, c);
+  const dlm::matrix::Matrix2x2F difference = dlm::matrix::MulSub(a, c, c);
+
+  ASSERT_EQ(result[0], (dlm::vector::Vector2F{2.0f, 5.0f}));
+  ASSERT_EQ(result[1], (dlm::vector::Vector2F{10.0f, 17.0f}));
+  ASSERT_EQ(scaled[1], (dlm::vector::Vector2F{-5.0f, -7.0f}));
+  ASSERT_EQ(difference[0], (dlm::vector::Vector2F{0.0f, 1.0f}));
+}
+
+TEST_F(MulAddTest, constexpr_evaluation) {
+  constexpr dlm::vector::Vector3F kPosition = dlm::vector::MulAdd(
+      dlm::vector::Vector3F{1.0f, 2.0f, 3.0f}, 0.5f,
+      dlm::vector::Vector3F{1.0f, 1.0f, 1.0f});
+  constexpr dlm::matrix::Matrix2x2F kMatrix =
+      dlm::matrix::MulSub(dlm::matrix::Matrix2x2F{}, 2.0f,
+                          dlm::matrix::Matrix2x2F{});
+
+  static_assert(kPosition == dlm::vector::Vector3F{1.5f, 2.0f, 2.5f});
+  static_assert(kMatrix[0][0] == 1.0f && kMatrix[0][1] == 0.0f);
+  ASSERT_EQ(kPosition.z, 2.5f);
+}
+
+TEST_F(MulAddTest, span_matches_single_vector) {
+  std::vector<dlm::vector::Vector3F> a;
+  std::vector<dlm::vector::Vector3F> b;
+  std::vector<dlm::vector::Vector3F> c;
+  for (int i = 0; i < 37; ++i) {
+    const float f = static_cast<float>(i);
+    a.push_back({f, f + 0.5f, -f});
+    b.push_back({2.0f - f, 0.25f * f, f * f});
+    c.push_back({f * 3.0f, 1.0f, -0.5f * f});
+  }
+  std::vector<dlm::vector::Vector3F> out(a.size());
+  using ConstSpan = dlm::Span<const dlm::vector::Vector3F>;
+  using Span = dlm::Span<dlm::vector::Vector3F>;
+
+  dlm::vector::MulAdd(ConstSpan{a}, ConstSpan{b}, ConstSpan{c}, Span{out});
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(out[i], dlm::vector::MulAdd(a[i], b[i], c[i]));
+  }
+
+  dlm::vector::MulSub(ConstSpan{a}, 0.5f, ConstSpan{c}, Span{out});
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(out[i], dlm::vector::MulSub(a[i], 0.5f, c[i]));
+  }
+
+  dlm::vector::NegMulAdd(ConstSpan{a}, ConstSpan{b}, ConstSpan{c}, Span{out});
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(out[i], dlm::vector::NegMulAdd(a[i], b[i], c[i]));
+  }
+}
+
+TEST_F(MulAddTest, span_updates_in_place) {
+  std::vector<dlm::vector::Vector4F> positions(9, {1.0f, 2.0f, 3.0f, 0.0f});
+  const std::vector<dlm::vector::Vector4F> velocities(
+      9, {2.0f, -4.0f, 8.0f, 0.0f});
+
+  dlm::vector::MulAdd(dlm::Span<const dlm::vector::Vector4F>{velocities},
+                      0.25f, dlm::Span<const dlm::vector::Vector4F>{positions},
+                      dlm::Span<dlm::vector::Vector4F>{positions});
+
+  for (const auto& position : positions) {
+    ASSERT_EQ(position, (dlm::vector::Vector4F{1.5f, 1.0f, 5.0f, 0.0f}));
+  }
+}
@@ -0,0 +1,199 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "dlm/packing.hpp"
+
+class PackingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Directions spread over the whole sphere, with the axes and the
+    // octahedron edges where the encoding folds. Odd count so the batch
+    // functions have a scalar tail.
+    for (float axis : {1.0f, -1.0f}) {
+      normals.push_back({axis, 0.0f, 0.0f});
+      normals.push_back({0.0f, axis, 0.0f});
+      normals.push_back({0.0f, 0.0f, axis});
+      normals.push_back(Normalized({axis, axis, 0.0f}));
+      normals.push_back(Normalized({axis, 0.0f, -1.0f}));
+    }
+    normals.push_back({-0.0f, -0.0f, -1.0f});
+    const float golden_angle = 2.39996323f;
+    for (int i = 0; i < 1001; ++i) {
+      const float z = 1.0f - (2.0f * i + 1.0f) / 1001.0f;
+      const float radius = std::sqrt(1.0f - z * z);
+      const float angle = golden_angle * static_cast<float>(i);
+      normals.push_back(
+          Normalized({radius * std::cos(angle), radius * std::sin(angle), z}));
+    }
+  }
+
+  void TearDown() override {}
+
+  static dlm::vector::Vector3F Normalized(dlm::vector::Vector3F v) {
+    v.Normalize();
+    return v;
+  }
+
+  static float Angle(const dlm::vector::Vector3F& a,
+                     const dlm::vector::Vector3F& b) {
+    return std::atan2((a ^ b).Length(), a | b);
+  }
+
+  std::vector<dlm::vector::Vector3F> normals;
+};
+
+TEST_F(PackingTest, octahedral_encodes_axes_exactly) {
+  static_assert(
+      dlm::vector::EncodeOctahedral({0.0f, 0.0f, 1.0f}).bits == 0x00000000u);
+  static_assert(
+      dlm::vector::EncodeOctahedral({1.0f, 0.0f, 0.0f}).bits == 0x00007FFFu);
+  static_assert(
+      dlm::vector::EncodeOctahedral({0.0f, -1.0f, 0.0f}).bits == 0x80010000u);
+
+  for (const auto& axis : {dlm::vector::Vector3F{1.0f, 0.0f, 0.0f},
+                           dlm::vector::Vector3F{0.0f, -1.0f, 0.0f},
+                           dlm::vector::Vector3F{0.0f, 0.0f, -1.0f}}) {
+    ASSERT_EQ(dlm::vector::DecodeOctahedral(
+                  dlm::vector::EncodeOctahedral(axis)),
+              axis);
+  }
+}
+
+TEST_F(PackingTest, octahedral_error_is_bounded) {
+  float max_angle = 0.0f;
+  for (const auto& normal : normals) {
+    const dlm::vector::Vector3F decoded =
+        dlm::vector::DecodeOctahedral(dlm::vector::EncodeOctahedral(normal));
+    ASSERT_NEAR(decoded.Length(), 1.0f, 1e-6f);
+    max_angle = std::max(max_angle, Angle(normal, decoded));
+  }
+  ASSERT_LT(max_angle, 7e-5f);
+}
+
+TEST_F(PackingTest, octahedral_batch_matches_scalar) {
+  std::vector<dlm::vector::OctahedralNormal> encoded(normals.size());
+  std::vector<dlm::vector::Vector3F> decoded(normals.size());
+
+  dlm::vector::EncodeOctahedral(dlm::Span<const dlm::vector::Vector3F>{normals},
+                                dlm::Span<dlm::vector::OctahedralNormal>{
+                                    encoded});
+  dlm::vector::DecodeOctahedral(
+      dlm::Span<const dlm::vector::OctahedralNormal>{encoded},
+      dlm::Span<dlm::vector::Vector3F>{decoded});
+
+  for (std::size_t i = 0; i < normals.size(); ++i) {
+    const auto expected = dlm::vector::EncodeOctahedral(normals[i]);
+    ASSERT_EQ(encoded[i].bits, expected.bits) << i;
+    const auto expected_decoded = dlm::vector::DecodeOctahedral(expected);
+    for (int c = 0; c < 3; ++c) {
+      ASSERT_FLOAT_EQ(decoded[i][c], expected_decoded[c]) << i;
+    }
+  }
+}
+
+TEST_F(PackingTest, packed_vector4_round_trips) {
+  constexpr dlm::vector::Vector4F kV{1.0f, -1.0f, 0.0f, -1.0f};
+  static_assert(dlm::vector::Encode1010102(kV).bits == 0xC00805FFu);
+  static_assert(dlm::vector::Decode1010102(dlm::vector::Encode1010102(kV)) ==
+                kV);
+  // Out of range values clamp, -512 decodes to -1.
+  static_assert(dlm::vector::Encode1010102({2.0f, -3.0f, 0.5f, 0.75f}).bits ==
+                dlm::vector::Encode1010102({1.0f, -1.0f, 0.5f, 1.0f}).bits);
+  static_assert(
+      dlm::vector::Decode1010102(dlm::vector::PackedVector4{0x80000200u}) ==
+      dlm::vector::Vector4F{-1.0f, 0.0f, 0.0f, -1.0f});
+
+  for (int i = -1000; i <= 1000; ++i) {
+    const float f = static_cast<float>(i) / 1000.0f;
+    const dlm::vector::Vector4F v{f, -f, f * f, f < 0.0f ? -1.0f : 1.0f};
+    const dlm::vector::Vector4F decoded =
+        dlm::vector::Decode1010102(dlm::vector::Encode1010102(v));
+    for (int c = 0; c < 3; ++c) {
+      ASSERT_LE(std::fabs(decoded[c] - v[c]), 0.5f / 511.0f + 1e-7f);
+    }
+    ASSERT_EQ(decoded.w, v.w);
+  }
+}
+
+TEST_F(PackingTest, packed_vector4_batch_matches_scalar) {
+  std::vector<dlm::vector::Vector4F> vectors;
+  for (int i = 0; i < 43; ++i) {
+    const float f = static_cast<float>(i - 21) / 20.0f;
+    vectors.push_back({f, -0.5f * f, f * f - 1.0f, f});
+  }
+  vectors.push_back({std::numeric_limits<float>::quiet_NaN(), 0.5f / 511.0f,
+                     1.5f / 511.0f, 0.5f});
+  std::vector<dlm::vector::PackedVector4> packed(vectors.size());
+  std::vector<dlm::vector::Vector4F> unpacked(vectors.size());
+
+  dlm::vector::Encode1010102(dlm::Span<const dlm::vector::Vector4F>{vectors},
+                             dlm::Span<dlm::vector::PackedVector4>{packed});
+  dlm::vector::Decode1010102(
+      dlm::Span<const dlm::vector::PackedVector4>{packed},
+      dlm::Span<dlm::vector::Vector4F>{unpacked});
+
+  for (std::size_t i = 0; i < vectors.size(); ++i) {
+    const auto expected = dlm::vector::Encode1010102(vectors[i]);
+    ASSERT_EQ(packed[i].bits, expected.bits) << i;
+    ASSERT_EQ(unpacked[i], dlm::vector::Decode1010102(expected)) << i;
+  }
+}
+
+TEST_F(PackingTest, quantized_position_error_is_bounded) {
+  const dlm::vector::PositionQuantizer quantizer{{-100.0f, 0.0f, 5.0f},
+                                                 {100.0f, 10.0f, 5.0f}};
+  const dlm::vector::Vector3F max_error = quantizer.MaxError();
+
+  for (int i = 0; i <= 1000; ++i) {
+    const float f = static_cast<float>(i) / 1000.0f;
+    const dlm::vector::Vector3F position{200.0f * f - 100.0f,
+                                         10.0f * f * f, 5.0f};
+    const dlm::vector::Vector3F decoded =
+        quantizer.Decode(quantizer.Encode(position));
+    for (int c = 0; c < 3; ++c) {
+      ASSERT_LE(std::fabs(decoded[c] - position[c]),
+                max_error[c] * 1.001f + 1e-5f)
+          << i;
+    }
+  }
+
+  // Outside the box clamps to it.
+  const auto clamped = quantizer.Encode({1000.0f, -1.0f, 7.0f});
+  ASSERT_EQ(clamped.x, 65535);
+  ASSERT_EQ(clamped.y, 0);
+  ASSERT_EQ(clamped.z, 0);
+}
+
+TEST_F(PackingTest, quantized_position_batch_matches_scalar) {
+  const dlm::vector::PositionQuantizer quantizer{{-1.0f, -2.0f, -3.0f},
+                                                 {1.0f, 2.0f, 3.0f}};
+  std::vector<dlm::vector::Vector3F> positions;
+  for (const auto& normal : normals) {
+    positions.push_back(normal * dlm::vector::Vector3F{1.0f, 2.5f, 3.0f});
+  }
+  positions.push_back({std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f});
+  std::vector<dlm::vector::QuantizedPosition> encoded(positions.size());
+  std::vector<dlm::vector::Vector3F> decoded(positions.size());
+
+  quantizer.Encode(dlm::Span<const dlm::vector::Vector3F>{positions},
+                   dlm::Span<dlm::vector::QuantizedPosition>{encoded});
+  quantizer.Decode(dlm::Span<const dlm::vector::QuantizedPosition>{encoded},
+                   dlm::Span<dlm::vector::Vector3F>{decoded});
+
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    const auto expected = quantizer.Encode(positions[i]);
+    ASSERT_EQ(encoded[i].x, expected.x) << i;
+    ASSERT_EQ(encoded[i].y, expected.y) << i;
+    ASSERT_EQ(encoded[i].z, expected.z) << i;
+    const auto expected_decoded = quantizer.Decode(expected);
+    for (int c = 0; c < 3; ++c) {
+      ASSERT_FLOAT_EQ(decoded[i][c], expected_decoded[c]) << i;
+    }
+  }
+}
@@ -0,0 +1,125 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <type_traits>
+
+#include "dlm/approx.hpp"
+#include "dlm/geometricfunctions.hpp"
+#include "dlm/muladd.hpp"
+#include "dlm/paddedvector3.hpp"
+
+class PaddedVector3Test : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(PaddedVector3Test, occupies_one_simd_register) {
+  ASSERT_EQ(sizeof(dlm::vector::PaddedVector3F), 16u);
+  ASSERT_EQ(alignof(dlm::vector::PaddedVector3F), 16u);
+}
+
+TEST_F(PaddedVector3Test, converts_from_and_to_vector3) {
+  const dlm::vector::Vector3F source{2.0f, 3.0f, 4.0f};
+  const dlm::vector::PaddedVector3F padded{source};
+
+  ASSERT_EQ(dlm::vector::Vector3F{padded}, source);
+  static_assert(!std::is_convertible<dlm::vector::Vector3F,
+                                     dlm::vector::PaddedVector3F>::value);
+  static_assert(!std::is_convertible<dlm::vector::PaddedVector3F,
+                                     dlm::vector::Vector3F>::value);
+}
+
+TEST_F(PaddedVector3Test, arithmetic_matches_vector3) {
+  const dlm::vector::PaddedVector3F a{2.0f, 3.0f, 4.0f};
+  const dlm::vector::PaddedVector3F b{1.0f, -2.0f, 8.0f};
+  const dlm::vector::Vector3F a3{a};
+  const dlm::vector::Vector3F b3{b};
+
+  ASSERT_EQ(dlm::vector::Vector3F{a + b}, a3 + b3);
+  ASSERT_EQ(dlm::vector::Vector3F{a - b}, a3 - b3);
+  ASSERT_EQ(dlm::vector::Vector3F{a * b}, a3 * b3);
+  ASSERT_EQ(dlm::vector::Vector3F{a / b}, a3 / b3);
+  ASSERT_EQ(dlm::vector::Vector3F{a * 2.0f}, a3 * 2.0f);
+  ASSERT_EQ(dlm::vector::Vector3F{-a}, -a3);
+}
+
+TEST_F(PaddedVector3Test, padding_is_ignored_by_comparisons_and_dot) {
+  dlm::vector::PaddedVector3F a{2.0f, 3.0f, 4.0f};
+  a += 1.0f;
+  a -= 1.0f;
+  a.padding = 100.0f;
+
+  ASSERT_EQ(a, (dlm::vector::PaddedVector3F{2.0f, 3.0f, 4.0f}));
+  ASSERT_EQ(a | a, 29.0f);
+  ASSERT_EQ(a.LengthSquared(), 29.0f);
+  ASSERT_TRUE(a.Equals({2.0f, 3.0f, 4.0f}, 0.0f));
+  ASSERT_FALSE(a < a);
+  ASSERT_TRUE(a <= a);
+  ASSERT_EQ(a[2], 4.0f);
+  ASSERT_EQ(a.Component(2), 4.0f);
+}
+
+TEST_F(PaddedVector3Test, cross) {
+  const dlm::vector::PaddedVector3F right{1.0f, 0.0f, 0.0f};
+  const dlm::vector::PaddedVector3F up{0.0f, 1.0f, 0.0f};
+
+  ASSERT_EQ(right ^ up, (dlm::vector::PaddedVector3F{0.0f, 0.0f, 1.0f}));
+  ASSERT_EQ(up ^ right, (dlm::vector::PaddedVector3F{0.0f, 0.0f, -1.0f}));
+}
+
+TEST_F(PaddedVector3Test, normalize_return_length_one) {
+  dlm::vector::PaddedVector3F v{0.0f, 3.0f, 4.0f};
+  v.Normalize();
+
+  ASSERT_EQ(v.Length(), 1.0f);
+  ASSERT_FLOAT_EQ(v.y, 0.6f);
+  ASSERT_FLOAT_EQ(v.z, 0.8f);
+}
+
+TEST_F(PaddedVector3Test, constexpr_operations_fold_at_compile_time) {
+  constexpr dlm::vector::PaddedVector3F kRight{1.0f, 0.0f, 0.0f};
+  constexpr dlm::vector::PaddedVector3F kUp{0.0f, 1.0f, 0.0f};
+
+  static_assert((kRight ^ kUp).z == 1.0f);
+  static_assert((kRight + kUp).LengthSquared() == 2.0f);
+  ASSERT_EQ((kRight ^ kUp).z, 1.0f);
+}
+
+TEST_F(PaddedVector3Test, project_on_to) {
+  const dlm::vector::PaddedVector3F projected =
+      dlm::vector::PaddedVector3F{1.0f, 2.0f, 3.0f}.ProjectOnTo(
+          {0.0f, 0.0f, 2.0f});
+
+  ASSERT_EQ(projected, (dlm::vector::PaddedVector3F{0.0f, 0.0f, 3.0f}));
+}
+
+TEST_F(PaddedVector3Test, project_on_to_zero_vector_is_zero) {
+  const dlm::vector::PaddedVector3F projected =
+      dlm::vector::PaddedVector3F{1.0f, 2.0f, 3.0f}.ProjectOnTo({});
+
+  ASSERT_TRUE(projected.IsZero());
+}
+
+TEST_F(PaddedVector3Test, free_functions_match_vector3) {
+  const dlm::vector::PaddedVector3F a{2.0f, -3.0f, 4.0f};
+  const dlm::vector::PaddedVector3F b{1.0f, 5.0f, -8.0f};
+  const dlm::vector::Vector3F a3{a};
+  const dlm::vector::Vector3F b3{b};
+
+  ASSERT_EQ(dlm::vector::Vector3F{dlm::vector::Min(a, b)},
+            dlm::vector::Min(a3, b3));
+  ASSERT_EQ(dlm::vector::Vector3F{dlm::vector::Max(a, b)},
+            dlm::vector::Max(a3, b3));
+  ASSERT_EQ(dlm::vector::Vector3F{dlm::vector::MulAdd(a, b, a)},
+            dlm::vector::MulAdd(a3, b3, a3));
+  ASSERT_EQ(dlm::vector::Vector3F{dlm::vector::MulAdd(a, 2.0f, b)},
+            dlm::vector::MulAdd(a3, 2.0f, b3));
+  ASSERT_EQ(dlm::vector::DistanceSquared(a, b),
+            dlm::vector::DistanceSquared(a3, b3));
+  ASSERT_TRUE(dlm::vector::AbsoluteEqual(a, a + 1e-7f, 1e-6f));
+  ASSERT_TRUE(dlm::vector::UlpsEqual(a, a, 0));
+  ASSERT_FALSE(dlm::vector::RelativeEqual(a, b, 1e-6f));
+}
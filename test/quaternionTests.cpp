@@ -0,0 +1,249 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "dlm/quaternion.hpp"
+
+namespace {
+constexpr float kPi = 3.14159265358979f;
+
+void ExpectNear(const dlm::vector::Vector3F& a, const dlm::vector::Vector3F& b,
+                float tolerance) {
+  EXPECT_NEAR(a.x, b.x, tolerance);
+  EXPECT_NEAR(a.y, b.y, tolerance);
+  EXPECT_NEAR(a.z, b.z, tolerance);
+}
+
+// Reference slerp evaluated with acos and sin in double precision.
+dlm::Quaternion<double> ExactSlerp(const dlm::Quaternion<double>& q1,
+                                   dlm::Quaternion<double> q2, double t) {
+  double cos_angle = q1 | q2;
+  if (cos_angle < 0.0) {
+    q2 = -q2;
+    cos_angle = -cos_angle;
+  }
+  if (cos_angle > 1.0 - 1e-12) {
+    return q1 * (1.0 - t) + q2 * t;
+  }
+  const double angle = std::acos(cos_angle);
+  return q1 * (std::sin((1.0 - t) * angle) / std::sin(angle)) +
+         q2 * (std::sin(t * angle) / std::sin(angle));
+}
+}  // namespace
+
+class QuaternionTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(QuaternionTest, default_constructor_generate_identity) {
+  const dlm::QuaternionF q{};
+
+  ASSERT_EQ(q.Imaginary(), (dlm::vector::Vector3F{0.0f, 0.0f, 0.0f}));
+  ASSERT_EQ(q.Real(), 1.0f);
+}
+
+TEST_F(QuaternionTest, trivially_copyable_round_trips_through_memcpy) {
+  const dlm::QuaternionF q{1.0f, 2.0f, 3.0f, 4.0f};
+
+  dlm::QuaternionF copied{};
+  std::memcpy(&copied, &q, sizeof(q));
+
+  ASSERT_EQ(copied, q);
+}
+
+TEST_F(QuaternionTest, multiply_follows_hamilton_rules) {
+  const dlm::QuaternionF i{1.0f, 0.0f, 0.0f, 0.0f};
+  const dlm::QuaternionF j{0.0f, 1.0f, 0.0f, 0.0f};
+  const dlm::QuaternionF k{0.0f, 0.0f, 1.0f, 0.0f};
+
+  ASSERT_EQ(i * j, k);
+  ASSERT_EQ(j * k, i);
+  ASSERT_EQ(k * i, j);
+  ASSERT_EQ(j * i, -k);
+  ASSERT_EQ(i * i, (dlm::QuaternionF{0.0f, 0.0f, 0.0f, -1.0f}));
+}
+
+TEST_F(QuaternionTest, multiply_matches_scalar_formula) {
+  const dlm::QuaternionF a{1.0f, -2.0f, 3.0f, 0.5f};
+  const dlm::QuaternionF b{-0.5f, 4.0f, 1.0f, 2.0f};
+  dlm::QuaternionF product = a;
+  product *= b;
+
+  ASSERT_FLOAT_EQ(product[0], 0.5f * -0.5f + 1.0f * 2.0f + -2.0f * 1.0f -
+                                  3.0f * 4.0f);
+  ASSERT_FLOAT_EQ(product[1], 0.5f * 4.0f - 1.0f * 1.0f + -2.0f * 2.0f +
+                                  3.0f * -0.5f);
+  ASSERT_FLOAT_EQ(product[2], 0.5f * 1.0f + 1.0f * 4.0f - -2.0f * -0.5f +
+                                  3.0f * 2.0f);
+  ASSERT_FLOAT_EQ(product[3], 0.5f * 2.0f - 1.0f * -0.5f - -2.0f * 4.0f -
+                                  3.0f * 1.0f);
+}
+
+TEST_F(QuaternionTest, conjugate_and_inverse) {
+  const dlm::QuaternionF q{1.0f, 2.0f, 3.0f, 4.0f};
+
+  ASSERT_EQ(q.Conjugate(), (dlm::QuaternionF{-1.0f, -2.0f, -3.0f, 4.0f}));
+
+  const dlm::QuaternionF identity = q * q.Inverse();
+  ASSERT_NEAR(identity[0], 0.0f, 1e-6f);
+  ASSERT_NEAR(identity[1], 0.0f, 1e-6f);
+  ASSERT_NEAR(identity[2], 0.0f, 1e-6f);
+  ASSERT_FLOAT_EQ(identity[3], 1.0f);
+}
+
+TEST_F(QuaternionTest, length_and_normalize) {
+  dlm::QuaternionF q{1.0f, 1.0f, 1.0f, 1.0f};
+
+  ASSERT_EQ(q.LengthSquared(), 4.0f);
+  ASSERT_EQ(q.Length(), 2.0f);
+  q.Normalize();
+  ASSERT_FLOAT_EQ(q.Length(), 1.0f);
+}
+
+TEST_F(QuaternionTest, rotate_around_axis) {
+  const dlm::QuaternionF q = dlm::QuaternionF::FromAxisAngle(
+      dlm::vector::Vector3F{0.0f, 0.0f, 1.0f}, kPi / 2.0f);
+
+  ExpectNear(q.Rotate(dlm::vector::Vector3F{1.0f, 0.0f, 0.0f}),
+             dlm::vector::Vector3F{0.0f, 1.0f, 0.0f}, 1e-6f);
+  ExpectNear(q.Rotate(dlm::vector::Vector3F{0.0f, 0.0f, 2.0f}),
+             dlm::vector::Vector3F{0.0f, 0.0f, 2.0f}, 1e-6f);
+}
+
+TEST_F(QuaternionTest, rotate_matches_sandwich_product) {
+  dlm::QuaternionF q{0.3f, -0.2f, 0.9f, 0.4f};
+  q.Normalize();
+  const dlm::vector::Vector3F v{1.5f, -2.0f, 0.25f};
+
+  const dlm::vector::Vector3F sandwich =
+      (q * dlm::QuaternionF{v, 0.0f} * q.Conjugate()).Imaginary();
+
+  ExpectNear(q.Rotate(v), sandwich, 1e-5f);
+  ExpectNear(q.ToMatrix() * v, sandwich, 1e-5f);
+}
+
+TEST_F(QuaternionTest, multiply_composes_rotations) {
+  const dlm::QuaternionF a = dlm::QuaternionF::FromAxisAngle(
+      dlm::vector::Vector3F{0.0f, 0.0f, 1.0f}, kPi / 2.0f);
+  const dlm::QuaternionF b = dlm::QuaternionF::FromAxisAngle(
+      dlm::vector::Vector3F{1.0f, 0.0f, 0.0f}, kPi / 2.0f);
+  const dlm::vector::Vector3F v{0.0f, 1.0f, 0.0f};
+
+  ExpectNear((a * b).Rotate(v), a.Rotate(b.Rotate(v)), 1e-6f);
+}
+
+TEST_F(QuaternionTest, nlerp_takes_shortest_arc) {
+  const dlm::QuaternionF a{};
+  const dlm::QuaternionF b = -dlm::QuaternionF::FromAxisAngle(
+      dlm::vector::Vector3F{0.0f, 1.0f, 0.0f}, kPi / 2.0f);
+
+  const dlm::QuaternionF half = dlm::Nlerp(a, b, 0.5f);
+  const dlm::QuaternionF expected = dlm::QuaternionF::FromAxisAngle(
+      dlm::vector::Vector3F{0.0f, 1.0f, 0.0f}, kPi / 4.0f);
+
+  ASSERT_FLOAT_EQ(half.Length(), 1.0f);
+  ASSERT_NEAR(half | expected, 1.0f, 1e-6f);
+}
+
+TEST_F(QuaternionTest, slerp_end_points) {
+  const dlm::QuaternionF a = dlm::QuaternionF::FromAxisAngle(
+      dlm::vector::Vector3F{1.0f, 0.0f, 0.0f}, 0.3f);
+  const dlm::QuaternionF b = dlm::QuaternionF::FromAxisAngle(
+      dlm::vector::Vector3F{0.0f, 1.0f, 0.0f}, 2.0f);
+
+  const dlm::QuaternionF start = dlm::Slerp(a, b, 0.0f);
+  const dlm::QuaternionF end = dlm::Slerp(a, b, 1.0f);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_NEAR(start[i], a[i], 1e-6f);
+    ASSERT_NEAR(end[i], b[i], 1e-6f);
+  }
+}
+
+TEST_F(QuaternionTest, slerp_estimate_matches_exact_slerp) {
+  const dlm::vector::Vector3<double> axis{0.0, 0.6, 0.8};
+  const dlm::Quaternion<double> a{};
+  float max_error = 0.0f;
+  // Angles between the quaternions from 0 to just under pi, which covers
+  // rotations from 0 to 2 pi, both signs via the shortest arc.
+  for (int angle_step = 0; angle_step <= 64; ++angle_step) {
+    const double angle = 6.28 * angle_step / 64.0;
+    const dlm::Quaternion<double> b =
+        dlm::Quaternion<double>::FromAxisAngle(axis, angle);
+    const dlm::QuaternionF a_f{static_cast<float>(a[0]),
+                               static_cast<float>(a[1]),
+                               static_cast<float>(a[2]),
+                               static_cast<float>(a[3])};
+    const dlm::QuaternionF b_f{static_cast<float>(b[0]),
+                               static_cast<float>(b[1]),
+                               static_cast<float>(b[2]),
+                               static_cast<float>(b[3])};
+    for (int t_step = 0; t_step <= 16; ++t_step) {
+      const double t = t_step / 16.0;
+      const dlm::Quaternion<double> exact = ExactSlerp(a, b, t);
+      const dlm::QuaternionF estimate =
+          dlm::Slerp(a_f, b_f, static_cast<float>(t));
+      for (int i = 0; i < 4; ++i) {
+        max_error = std::max(
+            max_error, static_cast<float>(std::abs(estimate[i] - exact[i])));
+      }
+    }
+  }
+
+  ASSERT_LT(max_error, 2.5e-5f);
+}
+
+TEST_F(QuaternionTest, rotate_span_matches_single_rotate) {
+  dlm::QuaternionF q{0.3f, -0.2f, 0.9f, 0.4f};
+  q.Normalize();
+  std::vector<dlm::vector::Vector3F> points;
+  for (int i = 0; i < 37; ++i) {
+    points.push_back({static_cast<float>(i), static_cast<float>(2 - i),
+                      static_cast<float>(i % 5)});
+  }
+  std::vector<dlm::vector::Vector3F> rotated(points.size());
+
+  dlm::Rotate(q, dlm::Span<const dlm::vector::Vector3F>{points},
+              dlm::Span<dlm::vector::Vector3F>{rotated});
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ExpectNear(rotated[i], q.Rotate(points[i]), 1e-4f);
+  }
+}
+
+TEST_F(QuaternionTest, rotate_batch_matches_single_rotate) {
+  dlm::QuaternionF q{0.3f, -0.2f, 0.9f, 0.4f};
+  q.Normalize();
+  dlm::vector::Vector3BatchF points;
+  for (int i = 0; i < 37; ++i) {
+    points.PushBack({static_cast<float>(i), static_cast<float>(2 - i),
+                     static_cast<float>(i % 5)});
+  }
+  dlm::vector::Vector3BatchF rotated;
+
+  dlm::Rotate(q, points, rotated);
+
+  ASSERT_EQ(rotated.Size(), points.Size());
+  for (std::size_t i = 0; i < points.Size(); ++i) {
+    ExpectNear(rotated[i], q.Rotate(points[i]), 1e-4f);
+  }
+}
+
+TEST_F(QuaternionTest, constexpr_operations_fold_at_compile_time) {
+  constexpr dlm::QuaternionF kRotateZ{0.0f, 0.0f, 1.0f, 0.0f};
+  constexpr dlm::vector::Vector3F kRotated =
+      kRotateZ.Rotate(dlm::vector::Vector3F{1.0f, 2.0f, 3.0f});
+
+  static_assert(kRotated == dlm::vector::Vector3F{-1.0f, -2.0f, 3.0f});
+  static_assert((kRotateZ * kRotateZ).Real() == -1.0f);
+  static_assert(kRotateZ.Conjugate()[2] == -1.0f);
+  static_assert(kRotateZ.ToMatrix()[0][0] == -1.0f);
+  static_assert(dlm::Slerp(dlm::QuaternionF{}, kRotateZ, 0.0f).Real() == 1.0f);
+  ASSERT_EQ(kRotated.z, 3.0f);
+}
@@ -0,0 +1,102 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "dlm/spatialhash.hpp"
+#include "testhelpers.hpp"
+
+namespace {
+using dlm::test::ExpectQueriesMatchBruteForce;
+using dlm::test::MakePoints;
+}  // namespace
+
+class SpatialHashTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(SpatialHashTest, empty) {
+  const dlm::geometry::SpatialHash3F unbuilt{1.0f};
+  std::vector<std::size_t> found{1, 2, 3};
+  std::size_t nearest[2];
+
+  unbuilt.Within({0.0f, 0.0f, 0.0f}, 5.0f, found);
+  ASSERT_TRUE(found.empty());
+  ASSERT_EQ(unbuilt.KNearest({0.0f, 0.0f, 0.0f},
+                             dlm::Span<std::size_t>{nearest}),
+            0u);
+
+  dlm::geometry::SpatialHash3F hash{1.0f};
+  hash.Build(dlm::Span<const dlm::vector::Vector3F>{});
+  ASSERT_EQ(hash.Size(), 0u);
+  hash.Within({0.0f, 0.0f, 0.0f}, 5.0f, found);
+  ASSERT_TRUE(found.empty());
+}
+
+TEST_F(SpatialHashTest, vector3_queries_match_brute_force) {
+  const auto points = MakePoints<3>(5000, 1);
+  dlm::geometry::SpatialHash3F hash{1.0f};
+  hash.Build(dlm::Span<const dlm::vector::Vector3F>{points}, 1);
+
+  ASSERT_EQ(hash.Size(), points.size());
+  ExpectQueriesMatchBruteForce(hash, points);
+
+  // Rebuilding over moved points reuses the arrays.
+  const auto moved = MakePoints<3>(3000, 2);
+  hash.Build(dlm::Span<const dlm::vector::Vector3F>{moved});
+  ExpectQueriesMatchBruteForce(hash, moved);
+}
+
+TEST_F(SpatialHashTest, vector2_queries_match_brute_force) {
+  const auto points = MakePoints<2>(4000, 3);
+  dlm::geometry::SpatialHash2F hash{0.5f};
+  hash.Build(dlm::Span<const dlm::vector::Vector2F>{points});
+
+  ExpectQueriesMatchBruteForce(hash, points);
+}
+
+TEST_F(SpatialHashTest, far_and_nan_points) {
+  constexpr float kNaN = std::numeric_limits<float>::quiet_NaN();
+  // Past the outermost cells the points share a cell and stay findable, a
+  // NaN point is never found.
+  const std::vector<dlm::vector::Vector3F> points{
+      {0.0f, 0.0f, 0.0f},  {1e9f, 0.0f, 0.0f}, {1e9f, 2.0f, 0.0f},
+      {-3e9f, 1e9f, 5.0f}, {kNaN, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f},
+      {1e9f, 1e9f, 1e9f}};
+  dlm::geometry::SpatialHash3F hash{1.0f};
+  hash.Build(dlm::Span<const dlm::vector::Vector3F>{points});
+
+  ExpectQueriesMatchBruteForce(hash, points);
+  std::vector<std::size_t> found;
+  hash.Within({1e9f, 1.0f, 0.0f}, 1.5f, found);
+  std::sort(found.begin(), found.end());
+  ASSERT_EQ(found, (std::vector<std::size_t>{1, 2}));
+  std::size_t nearest[7];
+  ASSERT_EQ(hash.KNearest({1e9f, 3.0f, 0.0f}, dlm::Span<std::size_t>{nearest}),
+            6u);
+  ASSERT_EQ(nearest[0], 2u);
+  ASSERT_EQ(nearest[1], 1u);
+}
+
+TEST_F(SpatialHashTest, threaded_build_is_identical) {
+  const auto points = MakePoints<3>(60000, 5);
+  const dlm::Span<const dlm::vector::Vector3F> span{points};
+  dlm::geometry::SpatialHash3F serial{0.5f};
+  serial.Build(span, 1);
+  dlm::geometry::SpatialHash3F threaded{0.5f};
+  threaded.Build(span, 4);
+
+  std::vector<std::size_t> serial_found;
+  std::vector<std::size_t> threaded_found;
+  for (const auto& query : MakePoints<3>(100, 9)) {
+    serial.Within(query, 1.0f, serial_found);
+    threaded.Within(query, 1.0f, threaded_found);
+    ASSERT_EQ(serial_found, threaded_found);
+  }
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "dlm/geometricfunctions.hpp"
+#include "dlm/span.hpp"
+#include "dlm/vector.hpp"
+#include "dlm/vector3.hpp"
+
+namespace dlm {
+namespace test {
+
+// Scalar that counts how often it is copied, a compound operator that
+// returns the vector by value copies every component.
+struct CountedScalar {
+  constexpr CountedScalar(double value) : value{value} {}
+  CountedScalar(const CountedScalar& other) : value{other.value} {
+    ++copies;
+  }
+  CountedScalar& operator=(const CountedScalar& other) = default;
+  CountedScalar& operator+=(const CountedScalar& other) {
+    value += other.value;
+    return *this;
+  }
+
+  static inline long copies = 0;
+  double value;
+};
+
+// Advances the linear congruential generator every randomized test draws
+// from, so a seed gives the same sequence on every platform.
+inline std::uint32_t NextRandom(std::uint32_t& state) {
+  state = state * 1664525u + 1013904223u;
+  return state;
+}
+
+// Uniform value in [low, high) from the top 24 bits of the next state.
+template <typename T>
+T Random(std::uint32_t& state, T low, T high) {
+  return low + (high - low) * static_cast<T>(NextRandom(state) >> 8) /
+                   static_cast<T>(1u << 24);
+}
+
+template <typename T>
+vector::Vector3<T> RandomVector(std::uint32_t& state, T low, T high) {
+  return {Random(state, low, high), Random(state, low, high),
+          Random(state, low, high)};
+}
+
+// Points through a cube with a dense cluster near the origin and repeated
+// points, so spatial structures see uneven densities and equal coordinates.
+template <std::size_t N>
+std::vector<vector::Vector<N, float>> MakePoints(std::size_t count,
+                                                 std::uint32_t state) {
+  std::vector<vector::Vector<N, float>> points(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i % 10 == 9) {
+      points[i] = points[i / 2];
+      continue;
+    }
+    const float spread = i % 4 == 0 ? 1.0f : 20.0f;
+    for (int axis = 0; axis < static_cast<int>(N); ++axis) {
+      points[i][axis] = Random(state, -spread, spread);
+    }
+  }
+  return points;
+}
+
+// Compares the Within and KNearest of a spatial structure built over points
+// with testing every point.
+template <typename structure_type, std::size_t N>
+void ExpectQueriesMatchBruteForce(
+    const structure_type& structure,
+    const std::vector<vector::Vector<N, float>>& points) {
+  const Span<const vector::Vector<N, float>> span{points};
+  std::vector<std::size_t> found;
+  std::size_t total = 0;
+  for (const auto& query : MakePoints<N>(200, 11)) {
+    for (float radius : {0.0f, 0.3f, 1.0f, 2.5f, 100.0f}) {
+      structure.Within(query, radius, found);
+      std::sort(found.begin(), found.end());
+      std::vector<std::size_t> expected;
+      for (std::size_t i = 0; i < points.size(); ++i) {
+        if (vector::DistanceSquared(points[i], query) <= radius * radius) {
+          expected.push_back(i);
+        }
+      }
+      ASSERT_EQ(found, expected) << radius;
+      total += found.size();
+    }
+    for (std::size_t k : {1u, 7u, 40u}) {
+      std::vector<std::size_t> nearest(k);
+      std::vector<std::size_t> expected(k);
+      ASSERT_EQ(structure.KNearest(query, Span<std::size_t>{nearest}),
+                vector::KNearest(span, query, Span<std::size_t>{expected}));
+      ASSERT_EQ(nearest, expected);
+    }
+  }
+  ASSERT_GT(total, points.size() / 10);
+}
+
+}  // namespace test
+}  // namespace dlm
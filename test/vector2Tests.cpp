@@ -2,6 +2,8 @@
 #include "gtest/gtest.h"
 // clang-format on
 
+#include <cstring>
+
 #include "dlm/vector2.hpp"
 
 class Vector2Test : public ::testing::Test {
@@ -27,6 +29,15 @@ TEST_F(Vector2Test, movable) {
   ASSERT_EQ(moved_vector.y, 3.0f);
 }
 
+TEST_F(Vector2Test, trivially_copyable_round_trips_through_memcpy) {
+  const dlm::vector::Vector2F new_vector{2.0f, 3.0f};
+
+  dlm::vector::Vector2F copied_vector{};
+  std::memcpy(&copied_vector, &new_vector, sizeof(new_vector));
+  ASSERT_EQ(copied_vector.x, 2.0f);
+  ASSERT_EQ(copied_vector.y, 3.0f);
+}
+
 TEST_F(Vector2Test, unary_minus) {
   const dlm::vector::Vector2F new_vector{2.0f, 2.0f};
   const dlm::vector::Vector2F negated_vector = -new_vector;
@@ -206,3 +217,64 @@ TEST_F(Vector2Test, subscript_operator_returns_expected_element) {
   ASSERT_EQ(new_vector[0], 3.0f);
   ASSERT_EQ(new_vector[1], 4.0f);
 }
+
+TEST_F(Vector2Test, subscript_operator_writes_named_member) {
+  dlm::vector::Vector2F new_vector{3.0f, 4.0f};
+
+  new_vector[0] = 10.0f;
+  new_vector[1] = 11.0f;
+
+  ASSERT_EQ(new_vector.x, 10.0f);
+  ASSERT_EQ(new_vector.y, 11.0f);
+}
+
+TEST_F(Vector2Test, component_matches_named_member_for_runtime_index) {
+  const dlm::vector::Vector2<double> new_vector{3.0, 4.0};
+  const double expected[] = {new_vector.x, new_vector.y};
+
+  for (int index = 0; index < 2; ++index) {
+    ASSERT_EQ(new_vector.Component(index), expected[index]);
+  }
+}
+
+#if DLM_CHECKED_INDEXING
+TEST_F(Vector2Test, out_of_range_index_traps) {
+  dlm::vector::Vector2F new_vector{};
+  volatile int index = 2;
+
+  EXPECT_DEATH(new_vector[index] = 1.0f, "");
+  EXPECT_DEATH(new_vector.Component(-index), "");
+}
+#endif
+
+namespace {
+constexpr dlm::vector::Vector2F ZeroedVector2() {
+  dlm::vector::Vector2F v{2.0f, 3.0f};
+  v.Zero();
+  return v;
+}
+}  // namespace
+
+TEST_F(Vector2Test, constexpr_grid_table_folds_at_compile_time) {
+  constexpr dlm::vector::Vector2F kGrid[] = {
+      dlm::vector::Vector2F{0.0f, 0.0f} * 2.0f,
+      dlm::vector::Vector2F{1.0f, 0.0f} * 2.0f,
+      dlm::vector::Vector2F{0.0f, 1.0f} * 2.0f,
+      dlm::vector::Vector2F{1.0f, 1.0f} * 2.0f};
+
+  static_assert(kGrid[3] == dlm::vector::Vector2F{2.0f, 2.0f});
+  static_assert((kGrid[1] | kGrid[2]) == 0.0f);
+  static_assert(kGrid[3].LengthSquared() == 8.0f);
+  static_assert(kGrid[3][1] == 2.0f);
+  static_assert(ZeroedVector2().IsZero());
+  ASSERT_EQ(kGrid[3].x, 2.0f);
+}
+
+TEST_F(Vector2Test, project_on_to) {
+  constexpr dlm::vector::Vector2F kProjected =
+      dlm::vector::Vector2F{3.0f, 3.0f}.ProjectOnTo({4.0f, 0.0f});
+
+  static_assert(kProjected == dlm::vector::Vector2F{3.0f, 0.0f});
+  ASSERT_EQ(kProjected.x, 3.0f);
+  ASSERT_EQ(kProjected.y, 0.0f);
+}
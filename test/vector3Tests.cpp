@@ -2,6 +2,9 @@
 #include "gtest/gtest.h"
 // clang-format on
 
+#include <cstring>
+#include <type_traits>
+
 #include "dlm/vector3.hpp"
 
 class Vector3Test : public ::testing::Test {
@@ -29,6 +32,16 @@ TEST_F(Vector3Test, movable) {
   ASSERT_EQ(moved_vector.z, 4.0f);
 }
 
+TEST_F(Vector3Test, trivially_copyable_round_trips_through_memcpy) {
+  const dlm::vector::Vector3F new_vector{2.0f, 3.0f, 4.0f};
+
+  dlm::vector::Vector3F copied_vector{};
+  std::memcpy(&copied_vector, &new_vector, sizeof(new_vector));
+  ASSERT_EQ(copied_vector.x, 2.0f);
+  ASSERT_EQ(copied_vector.y, 3.0f);
+  ASSERT_EQ(copied_vector.z, 4.0f);
+}
+
 TEST_F(Vector3Test, unary_minus) {
   const dlm::vector::Vector3F new_vector{2.0f, 2.0f, 2.0f};
   const dlm::vector::Vector3F negated_vector = -new_vector;
@@ -227,3 +240,87 @@ TEST_F(Vector3Test, subscript_operator_returns_expected_element) {
   ASSERT_EQ(new_vector[1], 4.0f);
   ASSERT_EQ(new_vector[2], 5.0f);
 }
+
+TEST_F(Vector3Test, subscript_operator_writes_named_member) {
+  dlm::vector::Vector3F new_vector{3.0f, 4.0f, 5.0f};
+
+  new_vector[0] = 10.0f;
+  new_vector[1] = 11.0f;
+  new_vector[2] = 12.0f;
+
+  ASSERT_EQ(new_vector.x, 10.0f);
+  ASSERT_EQ(new_vector.y, 11.0f);
+  ASSERT_EQ(new_vector.z, 12.0f);
+}
+
+TEST_F(Vector3Test, component_matches_named_member_for_runtime_index) {
+  const dlm::vector::Vector3<double> new_vector{3.0, 4.0, 5.0};
+  const double expected[] = {new_vector.x, new_vector.y, new_vector.z};
+
+  for (int index = 0; index < 3; ++index) {
+    ASSERT_EQ(new_vector.Component(index), expected[index]);
+  }
+}
+
+#if DLM_CHECKED_INDEXING
+TEST_F(Vector3Test, out_of_range_index_traps) {
+  dlm::vector::Vector3F new_vector{};
+  volatile int index = 3;
+
+  EXPECT_DEATH(new_vector[index] = 1.0f, "");
+  EXPECT_DEATH(new_vector.Component(-index), "");
+}
+#endif
+
+TEST_F(Vector3Test, compound_operators_return_reference) {
+  dlm::vector::Vector3F new_vector{1.0f, 2.0f, 3.0f};
+
+  static_assert(std::is_same<decltype(new_vector += new_vector),
+                             dlm::vector::Vector3F&>::value);
+  static_assert(std::is_same<decltype(new_vector /= 2.0f),
+                             dlm::vector::Vector3F&>::value);
+  ASSERT_EQ(&(new_vector -= 1.0f), &new_vector);
+
+  (new_vector += dlm::vector::Vector3F{1.0f, 1.0f, 1.0f}) *= 2.0f;
+
+  ASSERT_EQ(new_vector, (dlm::vector::Vector3F{2.0f, 4.0f, 6.0f}));
+}
+
+namespace {
+constexpr dlm::vector::Vector3F AccumulatedVector3() {
+  dlm::vector::Vector3F v{1.0f, 2.0f, 3.0f};
+  v += dlm::vector::Vector3F{1.0f, 1.0f, 1.0f};
+  v *= 2.0f;
+  v.Component(2) = 0.0f;
+  return v;
+}
+}  // namespace
+
+TEST_F(Vector3Test, constexpr_basis_table_folds_at_compile_time) {
+  constexpr dlm::vector::Vector3F kBasis[] = {{1.0f, 0.0f, 0.0f},
+                                              {0.0f, 1.0f, 0.0f},
+                                              {0.0f, 0.0f, 1.0f}};
+
+  static_assert((kBasis[0] ^ kBasis[1]) == kBasis[2]);
+  static_assert((kBasis[1] ^ kBasis[2]) == kBasis[0]);
+  static_assert((kBasis[0] | kBasis[1]) == 0.0f);
+  static_assert((kBasis[0] + kBasis[1] + kBasis[2]).LengthSquared() == 3.0f);
+  static_assert(-kBasis[0] < kBasis[1] + kBasis[2]);
+  static_assert(AccumulatedVector3() ==
+                dlm::vector::Vector3F{4.0f, 6.0f, 0.0f});
+  ASSERT_EQ(kBasis[2].z, 1.0f);
+}
+
+TEST_F(Vector3Test, project_on_to) {
+  constexpr dlm::vector::Vector3F kProjected =
+      dlm::vector::Vector3F{1.0f, 2.0f, 3.0f}.ProjectOnTo({0.0f, 0.0f, 2.0f});
+
+  static_assert(kProjected == dlm::vector::Vector3F{0.0f, 0.0f, 3.0f});
+  ASSERT_EQ(kProjected.z, 3.0f);
+
+  const dlm::vector::Vector3F diagonal =
+      dlm::vector::Vector3F{2.0f, 0.0f, 0.0f}.ProjectOnTo({1.0f, 1.0f, 0.0f});
+  ASSERT_FLOAT_EQ(diagonal.x, 1.0f);
+  ASSERT_FLOAT_EQ(diagonal.y, 1.0f);
+  ASSERT_EQ(diagonal.z, 0.0f);
+}
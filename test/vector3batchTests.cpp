@@ -0,0 +1,173 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <cstdint>
+#include <vector>
+
+#include "dlm/geometricfunctions.hpp"
+#include "dlm/vector3batch.hpp"
+
+class Vector3BatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Odd size so the last block is partially filled.
+    for (int i = 0; i < 37; ++i) {
+      const float f = static_cast<float>(i);
+      points.push_back({f + 1.0f, 2.0f * f - 3.0f, 0.5f * f + 2.0f});
+      directions.push_back({-f, f + 4.0f, 1.0f});
+    }
+  }
+
+  void TearDown() override {}
+
+  std::vector<dlm::vector::Vector3F> points;
+  std::vector<dlm::vector::Vector3F> directions;
+};
+
+TEST_F(Vector3BatchTest, default_constructor_is_empty) {
+  dlm::vector::Vector3BatchF batch;
+
+  ASSERT_TRUE(batch.Empty());
+  ASSERT_EQ(batch.Size(), 0u);
+}
+
+TEST_F(Vector3BatchTest, streams_are_aligned_and_padded) {
+  dlm::vector::Vector3BatchF batch{37};
+
+  ASSERT_EQ(batch.Capacity() % dlm::vector::Vector3BatchF::kLanes, 0u);
+  ASSERT_EQ(batch.PaddedSize(), 48u);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(batch.X()) % 64, 0u);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(batch.Y()) % 64, 0u);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(batch.Z()) % 64, 0u);
+  ASSERT_TRUE(batch[36].IsZero());
+}
+
+TEST_F(Vector3BatchTest, round_trips_through_span) {
+  const dlm::vector::Vector3BatchF batch{points};
+  std::vector<dlm::vector::Vector3F> copied(points.size());
+  batch.CopyTo(copied);
+
+  ASSERT_EQ(batch.Size(), points.size());
+  ASSERT_EQ(copied, points);
+}
+
+TEST_F(Vector3BatchTest, push_back_grows) {
+  dlm::vector::Vector3BatchF batch;
+  for (const auto& point : points) {
+    batch.PushBack(point);
+  }
+
+  ASSERT_EQ(batch.Size(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_EQ(batch[i], points[i]);
+  }
+}
+
+TEST_F(Vector3BatchTest, copy_and_move) {
+  dlm::vector::Vector3BatchF batch{points};
+  dlm::vector::Vector3BatchF copied = batch;
+  dlm::vector::Vector3BatchF moved = std::move(batch);
+
+  ASSERT_EQ(copied.Size(), points.size());
+  ASSERT_EQ(moved.Size(), points.size());
+  ASSERT_EQ(copied[20], points[20]);
+  ASSERT_EQ(moved[20], points[20]);
+}
+
+TEST_F(Vector3BatchTest, add_sub_scale_match_scalar) {
+  const dlm::vector::Vector3BatchF a{points};
+  const dlm::vector::Vector3BatchF b{directions};
+  dlm::vector::Vector3BatchF sum, difference, scaled;
+
+  dlm::vector::Add(a, b, sum);
+  dlm::vector::Subtract(a, b, difference);
+  dlm::vector::Scale(a, 3.0f, scaled);
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_EQ(sum[i], points[i] + directions[i]);
+    ASSERT_EQ(difference[i], points[i] - directions[i]);
+    ASSERT_EQ(scaled[i], points[i] * 3.0f);
+  }
+}
+
+TEST_F(Vector3BatchTest, in_place_add) {
+  dlm::vector::Vector3BatchF a{points};
+  const dlm::vector::Vector3BatchF b{directions};
+
+  dlm::vector::Add(a, b, a);
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_EQ(a[i], points[i] + directions[i]);
+  }
+}
+
+TEST_F(Vector3BatchTest, dot_cross_match_scalar) {
+  const dlm::vector::Vector3BatchF a{points};
+  const dlm::vector::Vector3BatchF b{directions};
+  std::vector<float> dots(points.size());
+  dlm::vector::Vector3BatchF crosses;
+
+  dlm::vector::Dot(a, b, dlm::Span<float>{dots});
+  dlm::vector::Cross(a, b, crosses);
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_EQ(dots[i], dlm::vector::Dot(points[i], directions[i]));
+    ASSERT_EQ(crosses[i], dlm::vector::Cross(points[i], directions[i]));
+  }
+}
+
+TEST_F(Vector3BatchTest, length_distance_normalize_match_scalar) {
+  const dlm::vector::Vector3BatchF a{points};
+  const dlm::vector::Vector3BatchF b{directions};
+  std::vector<float> lengths(points.size());
+  std::vector<float> distances(points.size());
+  dlm::vector::Vector3BatchF normalized;
+
+  dlm::vector::Length(a, dlm::Span<float>{lengths});
+  dlm::vector::Distance(a, b, dlm::Span<float>{distances});
+  dlm::vector::Normalize(a, normalized);
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const auto expected = dlm::vector::Normalize(points[i]);
+    ASSERT_FLOAT_EQ(lengths[i], points[i].Length());
+    ASSERT_FLOAT_EQ(distances[i], (points[i] - directions[i]).Length());
+    ASSERT_FLOAT_EQ(normalized[i].x, expected.x);
+    ASSERT_FLOAT_EQ(normalized[i].y, expected.y);
+    ASSERT_FLOAT_EQ(normalized[i].z, expected.z);
+  }
+}
+
+TEST_F(Vector3BatchTest, project_matches_scalar) {
+  const dlm::vector::Vector3BatchF a{points};
+  const dlm::vector::Vector3BatchF b{directions};
+  dlm::vector::Vector3BatchF projected;
+
+  dlm::vector::Project(a, b, projected);
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const auto expected = dlm::vector::Project(points[i], directions[i]);
+    ASSERT_FLOAT_EQ(projected[i].x, expected.x);
+    ASSERT_FLOAT_EQ(projected[i].y, expected.y);
+    ASSERT_FLOAT_EQ(projected[i].z, expected.z);
+  }
+}
+
+TEST_F(Vector3BatchTest, project_onto_zero_element_gives_zero) {
+  directions[5] = {0.0f, 0.0f, 0.0f};
+  const dlm::vector::Vector3BatchF a{points};
+  const dlm::vector::Vector3BatchF b{directions};
+  dlm::vector::Vector3BatchF projected;
+
+  dlm::vector::Project(a, b, projected);
+
+  ASSERT_EQ(projected[5].x, 0.0f);
+  ASSERT_EQ(projected[5].y, 0.0f);
+  ASSERT_EQ(projected[5].z, 0.0f);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const auto expected = dlm::vector::Project(points[i], directions[i]);
+    ASSERT_FLOAT_EQ(projected[i].x, expected.x);
+    ASSERT_FLOAT_EQ(projected[i].y, expected.y);
+    ASSERT_FLOAT_EQ(projected[i].z, expected.z);
+  }
+}
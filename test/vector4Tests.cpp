@@ -2,6 +2,9 @@
 #include "gtest/gtest.h"
 // clang-format on
 
+#include <cstring>
+#include <type_traits>
+
 #include "dlm/vector4.hpp"
 
 class Vector4Test : public ::testing::Test {
@@ -31,6 +34,17 @@ TEST_F(Vector4Test, movable) {
   ASSERT_EQ(moved_vector.w, 5.0f);
 }
 
+TEST_F(Vector4Test, trivially_copyable_round_trips_through_memcpy) {
+  const dlm::vector::Vector4F new_vector{2.0f, 3.0f, 4.0f, 5.0f};
+
+  dlm::vector::Vector4F copied_vector{};
+  std::memcpy(&copied_vector, &new_vector, sizeof(new_vector));
+  ASSERT_EQ(copied_vector.x, 2.0f);
+  ASSERT_EQ(copied_vector.y, 3.0f);
+  ASSERT_EQ(copied_vector.z, 4.0f);
+  ASSERT_EQ(copied_vector.w, 5.0f);
+}
+
 TEST_F(Vector4Test, unary_minus) {
   const dlm::vector::Vector4F new_vector{2.0f, 2.0f, 2.0f, 2.0f};
   const dlm::vector::Vector4F negated_vector = -new_vector;
@@ -232,3 +246,111 @@ TEST_F(Vector4Test, subscript_operator_returns_expected_element) {
   ASSERT_EQ(new_vector[2], 4.0f);
   ASSERT_EQ(new_vector[3], 5.0f);
 }
+
+TEST_F(Vector4Test, subscript_operator_writes_named_member) {
+  dlm::vector::Vector4F new_vector{2.0f, 3.0f, 4.0f, 5.0f};
+
+  new_vector[0] = 10.0f;
+  new_vector[1] = 11.0f;
+  new_vector[2] = 12.0f;
+  new_vector[3] = 13.0f;
+
+  ASSERT_EQ(new_vector.x, 10.0f);
+  ASSERT_EQ(new_vector.y, 11.0f);
+  ASSERT_EQ(new_vector.z, 12.0f);
+  ASSERT_EQ(new_vector.w, 13.0f);
+}
+
+TEST_F(Vector4Test, component_matches_named_member_for_runtime_index) {
+  const dlm::vector::Vector4<double> new_vector{2.0, 3.0, 4.0, 5.0};
+  const double expected[] = {new_vector.x, new_vector.y, new_vector.z,
+                             new_vector.w};
+
+  for (int index = 0; index < 4; ++index) {
+    ASSERT_EQ(new_vector.Component(index), expected[index]);
+  }
+}
+
+#if DLM_CHECKED_INDEXING
+TEST_F(Vector4Test, out_of_range_index_traps) {
+  dlm::vector::Vector4F new_vector{};
+  volatile int index = 4;
+
+  EXPECT_DEATH(new_vector[index] = 1.0f, "");
+  EXPECT_DEATH(new_vector.Component(-index), "");
+}
+#endif
+
+TEST_F(Vector4Test, compound_operators_return_reference) {
+  dlm::vector::Vector4F new_vector{1.0f, 2.0f, 3.0f, 4.0f};
+
+  static_assert(std::is_same<decltype(new_vector += new_vector),
+                             dlm::vector::Vector4F&>::value);
+  static_assert(std::is_same<decltype(new_vector /= 2.0f),
+                             dlm::vector::Vector4F&>::value);
+  ASSERT_EQ(&(new_vector -= 1.0f), &new_vector);
+
+  (new_vector += dlm::vector::Vector4F{1.0f, 1.0f, 1.0f, 1.0f}) *= 2.0f;
+
+  ASSERT_EQ(new_vector, (dlm::vector::Vector4F{2.0f, 4.0f, 6.0f, 8.0f}));
+}
+
+namespace {
+constexpr dlm::vector::Vector4F ScaledVector4() {
+  dlm::vector::Vector4F v{2.0f, 4.0f, 6.0f, 8.0f};
+  v /= 2.0f;
+  v -= 1.0f;
+  return v;
+}
+}  // namespace
+
+TEST_F(Vector4Test, constexpr_table_folds_at_compile_time) {
+  constexpr dlm::vector::Vector4F kPoints[] = {{1.0f, 0.0f, 0.0f, 1.0f},
+                                               {0.0f, 1.0f, 0.0f, 1.0f}};
+
+  static_assert((kPoints[0] | kPoints[1]) == 1.0f);
+  static_assert((kPoints[0] - kPoints[1]).LengthSquared() == 2.0f);
+  static_assert(kPoints[1][3] == 1.0f);
+  static_assert(ScaledVector4() ==
+                dlm::vector::Vector4F{0.0f, 1.0f, 2.0f, 3.0f});
+  ASSERT_EQ(kPoints[0].w, 1.0f);
+}
+
+TEST_F(Vector4Test, length_and_normalize) {
+  dlm::vector::Vector4F new_vector{1.0f, 1.0f, 1.0f, 1.0f};
+
+  ASSERT_EQ(new_vector.Length(), 2.0f);
+  new_vector.Normalize();
+  ASSERT_EQ(new_vector, (dlm::vector::Vector4F{0.5f, 0.5f, 0.5f, 0.5f}));
+}
+
+TEST_F(Vector4Test, comparisons_require_every_component) {
+  const dlm::vector::Vector4F small{1.0f, 1.0f, 1.0f, 1.0f};
+  const dlm::vector::Vector4F large{2.0f, 2.0f, 2.0f, 0.0f};
+
+  ASSERT_FALSE(small < large);
+  ASSERT_FALSE(large > small);
+  ASSERT_TRUE(small != large);
+  ASSERT_TRUE(small <= small);
+  ASSERT_TRUE(small >= small);
+}
+
+TEST_F(Vector4Test, project_on_to) {
+  constexpr dlm::vector::Vector4F kProjected =
+      dlm::vector::Vector4F{1.0f, 2.0f, 3.0f, 4.0f}.ProjectOnTo(
+          {0.0f, 0.0f, 0.0f, 2.0f});
+  static_assert(kProjected == dlm::vector::Vector4F{0.0f, 0.0f, 0.0f, 4.0f});
+
+  const dlm::vector::Vector4F projected =
+      dlm::vector::Vector4F{2.0f, 0.0f, 0.0f, 2.0f}.ProjectOnTo(
+          {1.0f, 1.0f, 0.0f, 0.0f});
+  ASSERT_FLOAT_EQ(projected.x, 1.0f);
+  ASSERT_FLOAT_EQ(projected.y, 1.0f);
+  ASSERT_EQ(projected.z, 0.0f);
+  ASSERT_EQ(projected.w, 0.0f);
+
+  const dlm::vector::Vector4<double> projected_double =
+      dlm::vector::Vector4<double>{1.0, 2.0, 3.0, 4.0}.ProjectOnTo(
+          {0.0, 3.0, 0.0, 0.0});
+  ASSERT_EQ(projected_double.y, 2.0);
+}
@@ -0,0 +1,156 @@
+// clang-format off
+#include "gtest/gtest.h"
+// clang-format on
+
+#include <type_traits>
+#include <utility>
+
+#include "dlm/paddedvector3.hpp"
+#include "dlm/vector.hpp"
+#include "dlm/vector2.hpp"
+#include "dlm/vector3.hpp"
+#include "dlm/vector4.hpp"
+#include "testhelpers.hpp"
+
+namespace {
+template <typename vector_type, typename = void>
+struct HasCross : std::false_type {};
+
+template <typename vector_type>
+struct HasCross<vector_type, std::void_t<decltype(std::declval<vector_type>() ^
+                                                  std::declval<vector_type>())>>
+    : std::true_type {};
+
+// Runs every operator once, constant evaluated when called from a constant
+// expression and on the SIMD paths otherwise.
+template <typename vector_type>
+constexpr vector_type Exercise(vector_type a, const vector_type& b) {
+  using T = typename vector_type::ValueType;
+  vector_type result = -a + b * static_cast<T>(2) - b / static_cast<T>(2);
+  result += a;
+  result -= static_cast<T>(1);
+  result *= b;
+  result /= vector_type{} + static_cast<T>(2);
+  a.Zero();
+  if (a.IsZero() && result != a && !(result < a)) {
+    result[0] = result | b;
+  }
+  return result.ProjectOnTo(b) + result;
+}
+}  // namespace
+
+class VectorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(VectorTest, aliases_name_the_generic_template) {
+  static_assert(std::is_same<dlm::vector::Vector2F,
+                             dlm::vector::Vector<2, float>>::value);
+  static_assert(std::is_same<dlm::vector::Vector3<double>,
+                             dlm::vector::Vector<3, double>>::value);
+  static_assert(std::is_same<dlm::vector::Vector4F,
+                             dlm::vector::Vector<4, float>>::value);
+  static_assert(dlm::vector::Vector4<int>::kSize == 4);
+}
+
+TEST_F(VectorTest, cross_product_only_for_three_components) {
+  static_assert(!HasCross<dlm::vector::Vector2F>::value);
+  static_assert(HasCross<dlm::vector::Vector3F>::value);
+  static_assert(!HasCross<dlm::vector::Vector4F>::value);
+
+  constexpr dlm::vector::Vector<3, int> kCross =
+      dlm::vector::Vector<3, int>{1, 0, 0} ^
+      dlm::vector::Vector<3, int>{0, 1, 0};
+  static_assert(kCross == dlm::vector::Vector<3, int>{0, 0, 1});
+}
+
+TEST_F(VectorTest, every_width_is_usable_in_constant_expressions) {
+  constexpr dlm::vector::Vector<2, int> kInt =
+      Exercise(dlm::vector::Vector<2, int>{3, 4},
+               dlm::vector::Vector<2, int>{2, 6});
+  constexpr dlm::vector::Vector3<double> kDouble =
+      Exercise(dlm::vector::Vector3<double>{1.0, 2.0, 3.0},
+               dlm::vector::Vector3<double>{4.0, 5.0, 6.0});
+  constexpr dlm::vector::Vector4F kFloat =
+      Exercise(dlm::vector::Vector4F{1.0f, 2.0f, 3.0f, 4.0f},
+               dlm::vector::Vector4F{4.0f, 3.0f, 2.0f, 1.0f});
+
+  static_assert(kInt.Component(1) == kInt.y);
+  static_assert(kDouble.LengthSquared() > 0.0);
+  static_assert(kFloat[3] == kFloat.w);
+}
+
+TEST_F(VectorTest, simd_paths_match_constant_evaluation) {
+  constexpr dlm::vector::Vector4F kA{1.0f, -2.0f, 3.5f, 4.0f};
+  constexpr dlm::vector::Vector4F kB{4.0f, 3.0f, -2.0f, 0.5f};
+  constexpr dlm::vector::Vector4F kExpected = Exercise(kA, kB);
+
+  dlm::vector::Vector4F a = kA;
+  dlm::vector::Vector4F b = kB;
+  ASSERT_EQ(Exercise(a, b), kExpected);
+  ASSERT_TRUE(a.Equals(kA, 1e-6f));
+  ASSERT_FALSE(a.Equals(b, 1e-6f));
+  ASSERT_FALSE(a >= b);
+  ASSERT_TRUE(a <= a);
+  ASSERT_TRUE(a > b - 10.0f);
+}
+
+TEST_F(VectorTest, padded_layout_matches_constant_evaluation) {
+  constexpr dlm::vector::PaddedVector3F kA{1.0f, -2.0f, 3.5f};
+  constexpr dlm::vector::PaddedVector3F kB{4.0f, 3.0f, -2.0f};
+  constexpr dlm::vector::PaddedVector3F kExpected = Exercise(kA, kB);
+  static_assert(kExpected[2] == kExpected.z);
+
+  dlm::vector::PaddedVector3F a = kA;
+  dlm::vector::PaddedVector3F b = kB;
+  ASSERT_EQ(Exercise(a, b), kExpected);
+  ASSERT_EQ(dlm::vector::Vector3F{Exercise(a, b)},
+            Exercise(dlm::vector::Vector3F{kA}, dlm::vector::Vector3F{kB}));
+  ASSERT_EQ(a ^ b, (dlm::vector::PaddedVector3F{
+                       dlm::vector::Vector3F{kA} ^ dlm::vector::Vector3F{kB}}));
+}
+
+TEST_F(VectorTest, integer_components) {
+  dlm::vector::Vector<4, int> v{1, 2, 3, 4};
+
+  v += dlm::vector::Vector<4, int>{1, 1, 1, 1};
+  v *= 3;
+  ASSERT_EQ(v, (dlm::vector::Vector<4, int>{6, 9, 12, 15}));
+  ASSERT_EQ(v / 3, (dlm::vector::Vector<4, int>{2, 3, 4, 5}));
+  ASSERT_EQ((v | dlm::vector::Vector<4, int>{1, 0, 0, 1}), 21);
+}
+
+template <typename vector_type>
+class VectorAccumulateTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+using CountedVectors =
+    ::testing::Types<dlm::vector::Vector2<dlm::test::CountedScalar>,
+                     dlm::vector::Vector3<dlm::test::CountedScalar>,
+                     dlm::vector::Vector4<dlm::test::CountedScalar>>;
+TYPED_TEST_SUITE(VectorAccumulateTest, CountedVectors);
+
+TYPED_TEST(VectorAccumulateTest, accumulate_loop_does_not_copy) {
+  TypeParam step;
+  TypeParam sum;
+  for (int i = 0; i < static_cast<int>(TypeParam::kSize); ++i) {
+    step[i] = 1.0;
+  }
+
+  dlm::test::CountedScalar::copies = 0;
+  for (int i = 0; i < 10000000; ++i) {
+    sum += step;
+  }
+
+  ASSERT_EQ(dlm::test::CountedScalar::copies, 0);
+  for (int i = 0; i < static_cast<int>(TypeParam::kSize); ++i) {
+    ASSERT_EQ(sum[i].value, 10000000.0);
+  }
+}